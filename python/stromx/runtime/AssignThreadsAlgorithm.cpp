@@ -15,6 +15,7 @@
 */
 
 #include <stromx/runtime/AssignThreadsAlgorithm.h>
+#include <stromx/runtime/Operator.h>
 #include <stromx/runtime/Stream.h>
 
 #include <boost/python.hpp>
@@ -24,7 +25,21 @@ using namespace stromx::runtime;
 
 void exportAssignThreadsAlgorithm()
 {
-    class_<AssignThreadsAlgorithm>("AssignThreadsAlgorithm")
-        .def("apply", &AssignThreadsAlgorithm::apply)
-    ;
+    {
+        scope in_AssignThreadsAlgorithm =
+        class_<AssignThreadsAlgorithm>("AssignThreadsAlgorithm")
+            .def("apply", &AssignThreadsAlgorithm::apply)
+            .def("mode", &AssignThreadsAlgorithm::mode)
+            .def("setMode", &AssignThreadsAlgorithm::setMode)
+            .def("numCores", &AssignThreadsAlgorithm::numCores)
+            .def("setNumCores", &AssignThreadsAlgorithm::setNumCores)
+            .def("setCost", &AssignThreadsAlgorithm::setCost)
+            .def("clearCosts", &AssignThreadsAlgorithm::clearCosts)
+        ;
+        
+        enum_<AssignThreadsAlgorithm::Mode>("Mode")
+            .value("CONNECTED", AssignThreadsAlgorithm::CONNECTED)
+            .value("BALANCED", AssignThreadsAlgorithm::BALANCED)
+            ;
+    }
 }
\ No newline at end of file
@@ -29,8 +29,18 @@ void exportDescription()
         .def("defaultType", &ConnectorDescription::defaultType)
     ;
     
-    class_<Input, bases<ConnectorDescription> >("Input", no_init)
-    ;
+    {
+        scope in_Input =
+        class_<Input, bases<ConnectorDescription> >("Input", no_init)
+            .def("overflowPolicy", &Input::overflowPolicy)
+        ;
+        
+        enum_<Input::OverflowPolicy>("OverflowPolicy")
+            .value("BLOCK", Input::BLOCK)
+            .value("DROP_NEWEST", Input::DROP_NEWEST)
+            .value("DROP_OLDEST", Input::DROP_OLDEST)
+            ;
+    }
     
     class_<Output, bases<ConnectorDescription> >("Output", no_init)
     ;
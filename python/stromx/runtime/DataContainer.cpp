@@ -16,6 +16,7 @@
 
 #include <stromx/runtime/DataContainer.h>
 #include <stromx/runtime/Data.h>
+#include <stromx/runtime/Metadata.h>
 
 #include <memory>
 #include <boost/python.hpp>
@@ -43,11 +44,26 @@ namespace
 
 void exportDataContainer()
 {       
+    class_<Metadata>("Metadata", init<>())
+        .def(init<uint64_t, uint64_t>())
+        .def("currentTime", &Metadata::currentTime)
+        .staticmethod("currentTime")
+        .def("isValid", &Metadata::isValid)
+        .def("timestamp", &Metadata::timestamp)
+        .def("sequenceNumber", &Metadata::sequenceNumber)
+        .def("setTimestamp", &Metadata::setTimestamp)
+        .def("setSequenceNumber", &Metadata::setSequenceNumber)
+    ;
+    
     class_<DataContainer>("DataContainer", no_init)
         .def("__init__", make_constructor(&allocate))
         .def("__init__", make_constructor(&allocateFromData))
         .def("__init__", make_constructor(&allocateFromDataWithReadOnlyOption))
         .def("empty", &DataContainer::empty)
         .def("release", &DataContainer::release)
+        .def("isCopyOnWrite", &DataContainer::isCopyOnWrite)
+        .def("setCopyOnWrite", &DataContainer::setCopyOnWrite)
+        .def("metadata", &DataContainer::metadata)
+        .def("setMetadata", &DataContainer::setMetadata)
     ;
 }
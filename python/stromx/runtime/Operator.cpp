@@ -171,6 +171,11 @@ namespace
         }
         Py_END_ALLOW_THREADS
     }
+    
+    void setReplicationWrap(Operator & op, const unsigned int numReplicas)
+    {
+        op.setReplication(numReplicas);
+    }
 }
 
 stromx::runtime::Data* get_pointer(const stromx::runtime::DataRef & p)
@@ -198,6 +203,16 @@ void exportOperator()
         .def("clearOutputData", &clearOutputDataWrap)
         .def("addObserver", &Operator::addObserver)
         .def("removeObserver", &Operator::removeObserver)
+        .def("statisticsEnabled", &Operator::statisticsEnabled)
+        .def("setStatisticsEnabled", &Operator::setStatisticsEnabled)
+        .def("statistics", &Operator::statistics)
+        .def("resetStatistics", &Operator::resetStatistics)
+        .def("numReplicas", &Operator::numReplicas)
+        .def("dispatch", &Operator::dispatch)
+        .def("setReplication", &Operator::setReplication)
+        .def("setReplication", &setReplicationWrap)
+        .def("overflowPolicy", &Operator::overflowPolicy)
+        .def("setOverflowPolicy", &Operator::setOverflowPolicy)
         .def("setFactory", &Operator::setFactory)
         .def("factory", &Operator::factory, return_internal_reference<>())
         .def("__eq__", &stromx::python::eq<Operator>)
@@ -211,6 +226,11 @@ void exportOperator()
         .value("EXECUTING", Operator::EXECUTING)
         ;
         
+    enum_<Operator::Dispatch>("Dispatch")
+        .value("ROUND_ROBIN", Operator::ROUND_ROBIN)
+        .value("LEAST_LOADED", Operator::LEAST_LOADED)
+        ;
+        
     register_ptr_to_python< boost::shared_ptr<Data> >();
 }
 
@@ -0,0 +1,57 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stromx/runtime/OperatorStatistics.h>
+
+#include <boost/python.hpp>
+
+using namespace boost::python;
+using namespace stromx::runtime;
+
+namespace
+{
+    list histogramWrap(const OperatorStatistics & statistics)
+    {
+        list histogram;
+        for(std::vector<uint64_t>::const_iterator iter = statistics.histogram().begin();
+            iter != statistics.histogram().end();
+            ++iter)
+        {
+            histogram.append(*iter);
+        }
+        
+        return histogram;
+    }
+}
+
+void exportOperatorStatistics()
+{       
+    class_<OperatorStatistics>("OperatorStatistics")
+        .def("numExecutions", &OperatorStatistics::numExecutions)
+        .def("numErrors", &OperatorStatistics::numErrors)
+        .def("executionTime", &OperatorStatistics::executionTime)
+        .def("receiveTime", &OperatorStatistics::receiveTime)
+        .def("sendTime", &OperatorStatistics::sendTime)
+        .def("numDroppedData", static_cast<uint64_t (OperatorStatistics::*)() const>(&OperatorStatistics::numDroppedData))
+        .def("numDroppedData", static_cast<uint64_t (OperatorStatistics::*)(const unsigned int) const>(&OperatorStatistics::numDroppedData))
+        .def("histogram", &histogramWrap)
+        .def("bucketLowerBound", &OperatorStatistics::bucketLowerBound)
+        .staticmethod("bucketLowerBound")
+        .def("bucket", &OperatorStatistics::bucket)
+        .staticmethod("bucket")
+    ;
+}
@@ -81,12 +81,20 @@ void exportOutputProvider()
             .def("text", pure_virtual(&OutputProvider::text), return_internal_reference<>())
             .def("openFile", pure_virtual(&OutputProvider::openFile), return_internal_reference<>())
             .def("file", pure_virtual(&OutputProvider::file), return_internal_reference<>())
+            .def("encoding", &OutputProvider::encoding)
         ;
         
         enum_<OutputProvider::OpenMode>("OpenMode")
             .value("TEXT", OutputProvider::TEXT)
             .value("BINARY", OutputProvider::BINARY)
             ;
+        
+        enum_<OutputProvider::Encoding>("Encoding")
+            .value("DEFAULT", OutputProvider::DEFAULT)
+            .value("RAW", OutputProvider::RAW)
+            .value("FAST", OutputProvider::FAST)
+            .value("PNG", OutputProvider::PNG)
+            ;
     }
     
     class_<FileOutputWrap, bases<OutputProvider>, boost::noncopyable>("FileOutput", no_init)
@@ -94,6 +102,7 @@ void exportOutputProvider()
         .def("getFilename", pure_virtual(&FileOutput::getFilename), return_internal_reference<>())
         .def("getText", pure_virtual(&FileOutput::getText))
         .def("close", pure_virtual(&FileOutput::close))
+        .def("setEncoding", &FileOutput::setEncoding)
     ;
     
     class_<DirectoryFileOutput, bases<FileOutput>, boost::noncopyable>("DirectoryFileOutput", init<std::string>())
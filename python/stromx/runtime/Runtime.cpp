@@ -20,15 +20,18 @@
 #include <stromx/runtime/Compare.h>
 #include <stromx/runtime/ConstData.h>
 #include <stromx/runtime/Counter.h>
+#include <stromx/runtime/DataBuffer.h>
 #include <stromx/runtime/Dump.h>
 #include <stromx/runtime/Filter.h>
 #include <stromx/runtime/Fork.h>
 #include <stromx/runtime/Join.h>
+#include <stromx/runtime/LatencyProbe.h>
 #include <stromx/runtime/Merge.h>
 #include <stromx/runtime/PeriodicDelay.h>
 #include <stromx/runtime/Push.h>
 #include <stromx/runtime/Queue.h>
 #include <stromx/runtime/Receive.h>
+#include <stromx/runtime/Record.h>
 #include <stromx/runtime/Registry.h>
 #include <stromx/runtime/Repeat.h>
 #include <stromx/runtime/Send.h>
@@ -56,6 +59,7 @@ void exportNone();
 void exportOperator();
 void exportOperatorInfo();
 void exportOperatorKernel();
+void exportOperatorStatistics();
 void exportOutputProvider();
 void exportParameter();
 void exportPosition();
@@ -106,6 +110,7 @@ BOOST_PYTHON_MODULE(libruntime)
     exportOperator();
     exportOperatorInfo();
     exportOperatorKernel();
+    exportOperatorStatistics();
     exportOutputProvider();
     exportParameter();
     exportPosition();
@@ -134,13 +139,16 @@ BOOST_PYTHON_MODULE(libruntime)
     stromx::python::exportOperatorKernel<Dump>("Dump");
     stromx::python::exportOperatorKernel<Queue>("Queue");
     stromx::python::exportOperatorKernel<Counter>("Counter");
+    stromx::python::exportOperatorKernel<DataBuffer>("DataBuffer");
     stromx::python::exportOperatorKernel<Filter>("Filter");
     stromx::python::exportOperatorKernel<Fork>("Fork");
     stromx::python::exportOperatorKernel<Join>("Join");
+    stromx::python::exportOperatorKernel<LatencyProbe>("LatencyProbe");
     stromx::python::exportOperatorKernel<Merge>("Merge");
     stromx::python::exportOperatorKernel<PeriodicDelay>("PeriodicDelay");
     stromx::python::exportOperatorKernel<Push>("Push");
     stromx::python::exportOperatorKernel<Receive>("Receive");
+    stromx::python::exportOperatorKernel<Record>("Record");
     stromx::python::exportOperatorKernel<Repeat>("Repeat");
     stromx::python::exportOperatorKernel<Send>("Send");
     stromx::python::exportOperatorKernel<Split>("Split");
@@ -24,6 +24,7 @@
 #include <stromx/runtime/Thread.h>
 
 #include <boost/python.hpp>
+#include <sstream>
 
 using namespace boost::python;
 using namespace stromx::runtime;
@@ -67,6 +68,13 @@ namespace
         return newOp;
     }
             
+    std::string stopTraceWrap(Stream & stream)
+    {
+        std::ostringstream trace;
+        stream.stopTrace(trace);
+        return trace.str();
+    }
+            
     void setConnectorTypeWithoutUpdateBehavior(Stream & stream, Operator* const op, 
         const unsigned int id, const Description::Type type)
     {
@@ -107,10 +115,18 @@ void exportStream()
             .def("join", &joinWrap)
             .def("pause", &Stream::pause)
             .def("resume", &Stream::resume)
+            .def("startTrace", &Stream::startTrace)
+            .def("stopTrace", &stopTraceWrap)
             .def("setFactory", &Stream::setFactory)
             .def("factory", &Stream::factory, return_internal_reference<>())
             .def("delay", &Stream::delay)
             .def("setDelay", &Stream::setDelay)
+            .def("executionMode", &Stream::executionMode)
+            .def("setExecutionMode", &Stream::setExecutionMode)
+            .def("workerPoolSize", &Stream::workerPoolSize)
+            .def("setWorkerPoolSize", &Stream::setWorkerPoolSize)
+            .def("fusionEnabled", &Stream::fusionEnabled)
+            .def("setFusionEnabled", &Stream::setFusionEnabled)
             .def("setConnectorType", &Stream::setConnectorType)
             .def("setConnectorType", &setConnectorTypeWithoutUpdateBehavior)
         ;
@@ -121,5 +137,10 @@ void exportStream()
             .value("DEACTIVATING", Stream::DEACTIVATING)
             .value("PAUSED", Stream::PAUSED)
         ;
+        
+        enum_<Stream::ExecutionMode>("ExecutionMode")
+            .value("THREADS", Stream::THREADS)
+            .value("WORKER_POOL", Stream::WORKER_POOL)
+        ;
     }
 }
\ No newline at end of file
@@ -38,6 +38,11 @@ void exportThread()
             .def("setName", &Thread::setName)
             .def("color", &Thread::color, return_internal_reference<>())
             .def("setColor", &Thread::setColor)
+            .def("affinity", &Thread::affinity)
+            .def("setAffinity", &Thread::setAffinity)
+            .def("schedulingPolicy", &Thread::schedulingPolicy)
+            .def("priority", &Thread::priority)
+            .def("setScheduling", &Thread::setScheduling)
             .def("inputSequence", &Thread::inputSequence, return_internal_reference<>())
             .def("addInput", &Thread::addInput)
             .def("insertInput", &Thread::insertInput)
@@ -53,6 +58,12 @@ void exportThread()
             .value("DEACTIVATING", Thread::DEACTIVATING)
             ;
             
+        enum_<Thread::SchedulingPolicy>("SchedulingPolicy")
+            .value("OTHER", Thread::OTHER)
+            .value("FIFO", Thread::FIFO)
+            .value("ROUND_ROBIN", Thread::ROUND_ROBIN)
+            ;
+            
         register_ptr_to_python< boost::shared_ptr<Thread> >();
     }
 }
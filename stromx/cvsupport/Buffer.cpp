@@ -101,18 +101,10 @@ namespace stromx
         
         void Buffer::execute(DataProvider& provider)
         {
-            Data* buffer = 0;
-            
-            // try to get a free buffer
-            try
-            {
-                provider.unlockParameters();
-                buffer = m_buffers();
-                provider.lockParameters();
-            }
-            catch(Timeout&)
-            {
-            }
+            // wait for a free buffer
+            provider.unlockParameters();
+            Data* buffer = m_buffers();
+            provider.lockParameters();
             
             if(buffer)
             {
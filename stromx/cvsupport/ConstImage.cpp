@@ -85,9 +85,8 @@ namespace stromx
         
         void ConstImage::execute(DataProvider& provider)
         {
-            provider.unlockParameters();
-            Data* outData = m_imageAccess();
-            provider.lockParameters();
+            // reuse the previous image if it is not referenced anymore
+            Data* outData = m_imageAccess.tryGet();
             
             if(! outData)
                 outData = new cvsupport::Image(m_image->width(), m_image->height(), m_image->pixelType());
@@ -105,7 +105,7 @@ namespace stromx
             Id2DataPair inputDataMapper(INPUT);
             provider.receiveInputData(inputDataMapper);
             
-            DataContainer container = inputDataMapper.data();
+            DataContainer container = inputDataMapper.release();
             WriteAccess access(container);
             runtime::Image& image = access.get<runtime::Image>();
             
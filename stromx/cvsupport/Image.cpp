@@ -22,6 +22,7 @@
 #include "stromx/cvsupport/Utilities.h"
 #include <stromx/runtime/Exception.h>
 #include <stromx/runtime/InputProvider.h>
+#include <stromx/runtime/MatrixCodec.h>
 #include <stromx/runtime/OutputProvider.h>
 
 namespace stromx
@@ -116,6 +117,14 @@ namespace stromx
             if(width() == 0 || height() == 0)
                 return;
             
+            if(runtime::MatrixCodec::supports(output.encoding()))
+            {
+                std::ostream & outStream = output.openFile(runtime::MatrixCodec::extension(output.encoding()),
+                                                           runtime::OutputProvider::BINARY);
+                runtime::MatrixCodec::encode(*this, output.encoding(), outStream);
+                return;
+            }
+            
             std::vector<uchar> data;
             try
             {
@@ -154,6 +163,25 @@ namespace stromx
             
             input.openFile(runtime::InputProvider::BINARY);
             
+            // images which are not encoded by the matrix codec are decoded by OpenCV
+            if(runtime::MatrixCodec::isEncoded(input.file()))
+            {
+                const runtime::MatrixCodec::Header header = runtime::MatrixCodec::readHeader(input.file());
+                
+                // the header has been validated against the payload, i.e. the image
+                // can be allocated if it matches the header
+                const PixelType pixelType = PixelType(type);
+                if(header.rows != (unsigned int)(height) || header.cols != width * runtime::Image::numChannels(pixelType)
+                   || header.valueType != runtime::Image::valueTypeFromPixelType(pixelType))
+                {
+                    throw runtime::Exception("Image does not match the encoded data.");
+                }
+                
+                allocate(width, height, pixelType);
+                runtime::MatrixCodec::decode(input.file(), header, *this);
+                return;
+            }
+            
             unsigned int dataSize = 0;
             const unsigned int CHUNK_SIZE = 100000;
             std::vector<uchar> data;
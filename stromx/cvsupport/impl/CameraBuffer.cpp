@@ -19,6 +19,7 @@
 #include <stromx/runtime/DataProvider.h>
 #include <stromx/runtime/Id2DataComposite.h>
 #include <stromx/runtime/Id2DataPair.h>
+#include <stromx/runtime/Metadata.h>
 #include <stromx/runtime/NumericParameter.h>
 #include <stromx/runtime/OperatorException.h>
 #include <stromx/runtime/Variant.h>
@@ -111,15 +112,12 @@ namespace stromx
                 Id2DataPair inputMapper(INPUT);
                 provider.receiveInputData(inputMapper);
                 
+                // this is where the frame enters the stream, i.e. stamp it
+                DataContainer inputContainer = inputMapper.data();
+                inputContainer.setMetadata(Metadata(Metadata::currentTime(), m_id, this));
+                
                 // try to get a free buffer
-                Data* buffer = 0;
-                try
-                {
-                    buffer = m_buffers(0);
-                }
-                catch(Timeout&)
-                {
-                }
+                Data* buffer = m_buffers.tryGet();
                 
                 if(buffer)
                 {
@@ -62,6 +62,8 @@ namespace stromx
             
             CPPUNIT_ASSERT_EQUAL(UInt32(0), ReadAccess(output1).get<UInt32>());
             CPPUNIT_ASSERT_EQUAL(UInt32(0), ReadAccess(outputIndex1).get<UInt32>());
+            CPPUNIT_ASSERT(output1.metadata().isValid());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), output1.metadata().sequenceNumber());
             
             // clear all outpout
             m_operator->clearOutputData(CameraBuffer::OUTPUT);
@@ -84,6 +86,7 @@ namespace stromx
             
             CPPUNIT_ASSERT_EQUAL(UInt32(1), ReadAccess(output2).get<UInt32>());
             CPPUNIT_ASSERT_EQUAL(UInt32(2), ReadAccess(outputIndex2).get<UInt32>());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), output2.metadata().sequenceNumber());
         }
 
         void CameraBufferTest::tearDown()
@@ -20,7 +20,10 @@
 #include <boost/functional/hash.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/undirected_dfs.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
 #include <iostream>
+#include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Input.h"
 #include "stromx/runtime/InputConnector.h"
 #include "stromx/runtime/Operator.h"
@@ -128,6 +131,49 @@ namespace
     private:
         int & m_numThreads;
     };
+    
+    // a connection between two operators which is visited by a thread
+    struct Connection
+    {
+        const stromx::runtime::Operator* source;
+        stromx::runtime::Operator* target;
+        unsigned int inputId;
+        unsigned int sourceThread;
+        unsigned int targetThread;
+        double cost;
+    };
+    
+    // a set of connections which are visited by the same thread
+    struct Stage
+    {
+        std::vector<unsigned int> connections;
+        double cost;
+        
+        // the operator thread of each operator the stage is connected to
+        std::map<const stromx::runtime::Operator*, unsigned int> operatorThreads;
+    };
+    
+    // two stages can be merged if they share an operator and agree on the
+    // operator threads of all their common operators
+    bool canMerge(const Stage & stage1, const Stage & stage2)
+    {
+        bool isAdjacent = false;
+        
+        typedef std::map<const stromx::runtime::Operator*, unsigned int>::const_iterator iter_t;
+        for (iter_t iter = stage1.operatorThreads.begin(); iter != stage1.operatorThreads.end(); ++iter)
+        {
+            iter_t other = stage2.operatorThreads.find(iter->first);
+            if (other == stage2.operatorThreads.end())
+                continue;
+            
+            if (other->second != iter->second)
+                return false;
+            
+            isAdjacent = true;
+        }
+        
+        return isAdjacent;
+    }
 }
 
 namespace stromx
@@ -135,7 +181,201 @@ namespace stromx
     namespace runtime
     {
         
+        void AssignThreadsAlgorithm::setCost(const Operator* const op, const double cost)
+        {
+            if (! op)
+                throw WrongArgument("Operator must not be null.");
+            
+            if (cost < 0.0)
+                throw WrongArgument("Cost must not be negative.");
+            
+            m_costs[op] = cost;
+        }
+        
         void AssignThreadsAlgorithm::apply(Stream& stream)
+        {
+            if (m_mode == BALANCED)
+                applyBalanced(stream);
+            else
+                applyConnected(stream);
+        }
+        
+        void AssignThreadsAlgorithm::applyBalanced(Stream& stream)
+        {
+            const std::vector<Operator*> & operators = stream.initializedOperators();
+            if (operators.size() == 0)
+                return;
+            
+            // determine the costs of the operators, operators without declared
+            // costs and without statistics are assigned the average cost
+            std::map<const Operator*, double> costs;
+            double sumKnownCosts = 0.0;
+            for(std::vector<Operator*>::const_iterator op = operators.begin();
+                op != operators.end();
+                ++op)
+            {
+                std::map<const Operator*, double>::const_iterator declared = m_costs.find(*op);
+                if (declared != m_costs.end())
+                {
+                    costs[*op] = declared->second;
+                }
+                else
+                {
+                    const OperatorStatistics statistics = (*op)->statistics();
+                    if (statistics.numExecutions() == 0)
+                        continue;
+                    
+                    // do not count the time the operator was blocked
+                    const uint64_t waitTime = statistics.receiveTime() + statistics.sendTime();
+                    const uint64_t busyTime = statistics.executionTime() > waitTime ?
+                                              statistics.executionTime() - waitTime : 0;
+                    costs[*op] = double(busyTime) / double(statistics.numExecutions());
+                }
+                
+                sumKnownCosts += costs[*op];
+            }
+            
+            const double defaultCost = costs.size() ? sumKnownCosts / costs.size() : 1.0;
+            for(std::vector<Operator*>::const_iterator op = operators.begin();
+                op != operators.end();
+                ++op)
+            {
+                if (costs.count(*op) == 0)
+                    costs[*op] = defaultCost;
+            }
+            
+            // collect the connections in the same order as the other mode
+            std::vector<Connection> connections;
+            std::map<const Operator*, unsigned int> numInputConnections;
+            std::map<const Operator*, unsigned int> numOutputConnections;
+            for(std::vector<Operator*>::const_iterator op = operators.begin();
+                op != operators.end();
+                ++op)
+            {
+                const std::vector<const Input*> & inputs = (*op)->info().inputs();
+                for(std::vector<const Input*>::const_iterator input = inputs.begin();
+                    input != inputs.end();
+                    ++input)
+                {
+                    OutputConnector connector = stream.connectionSource(*op, (*input)->id());
+                    if(connector.valid())
+                    {
+                        Connection connection;
+                        connection.source = connector.op();
+                        connection.target = *op;
+                        connection.inputId = (*input)->id();
+                        connection.sourceThread = connector.op()->info().output(connector.id()).operatorThread();
+                        connection.targetThread = (*input)->operatorThread();
+                        connection.cost = 0.0;
+                        connections.push_back(connection);
+                        
+                        numInputConnections[connection.target]++;
+                        numOutputConnections[connection.source]++;
+                    }
+                }
+            }
+            
+            // an operator is executed by the threads which pass data to its inputs,
+            // operators without connected inputs are executed by the threads which
+            // fetch their outputs
+            double totalCost = 0.0;
+            double maxCost = 0.0;
+            for(std::vector<Connection>::iterator connection = connections.begin();
+                connection != connections.end();
+                ++connection)
+            {
+                connection->cost = costs[connection->target] / numInputConnections[connection->target];
+                if (numInputConnections[connection->source] == 0)
+                    connection->cost += costs[connection->source] / numOutputConnections[connection->source];
+                
+                totalCost += connection->cost;
+                maxCost = std::max(maxCost, connection->cost);
+            }
+            
+            // start with one stage per connection
+            std::vector<Stage> stages;
+            for(unsigned int i = 0; i < connections.size(); ++i)
+            {
+                Stage stage;
+                stage.connections.push_back(i);
+                stage.cost = connections[i].cost;
+                stage.operatorThreads[connections[i].source] = connections[i].sourceThread;
+                stage.operatorThreads[connections[i].target] = connections[i].targetThread;
+                stages.push_back(stage);
+            }
+            
+            unsigned int numCores = m_numCores ? m_numCores : boost::thread::hardware_concurrency();
+            if (numCores == 0)
+                numCores = 1;
+            
+            // the load each core should carry, no stage can be cheaper than
+            // its most expensive connection
+            const double capacity = std::max(totalCost / numCores, maxCost);
+            
+            // greedily merge the cheapest pair of adjacent stages, each merge removes
+            // a hand-over between threads; stop if the merged stage would exceed the
+            // capacity and there are no more stages than cores
+            while (true)
+            {
+                bool found = false;
+                unsigned int first = 0;
+                unsigned int second = 0;
+                double mergedCost = 0.0;
+                for (unsigned int i = 0; i < stages.size(); ++i)
+                {
+                    for (unsigned int j = i + 1; j < stages.size(); ++j)
+                    {
+                        const double cost = stages[i].cost + stages[j].cost;
+                        if ((! found || cost < mergedCost) && canMerge(stages[i], stages[j]))
+                        {
+                            found = true;
+                            first = i;
+                            second = j;
+                            mergedCost = cost;
+                        }
+                    }
+                }
+                
+                if (! found)
+                    break;
+                
+                // allow for rounding errors when comparing with the capacity
+                if (mergedCost > capacity * (1.0 + 1e-9) && stages.size() <= numCores)
+                    break;
+                
+                Stage & stage = stages[first];
+                const Stage & other = stages[second];
+                stage.connections.insert(stage.connections.end(), other.connections.begin(),
+                                         other.connections.end());
+                stage.operatorThreads.insert(other.operatorThreads.begin(), other.operatorThreads.end());
+                stage.cost = mergedCost;
+                stages.erase(stages.begin() + second);
+            }
+            
+            // delete all threads
+            while(stream.threads().size())
+                stream.removeThread(stream.threads().front());
+            
+            // create a thread for each stage and add the inputs in the order
+            // of the connections
+            for (std::vector<Stage>::iterator stage = stages.begin();
+                 stage != stages.end();
+                 ++stage)
+            {
+                Thread* thread = stream.addThread();
+                
+                std::sort(stage->connections.begin(), stage->connections.end());
+                for (std::vector<unsigned int>::const_iterator index = stage->connections.begin();
+                     index != stage->connections.end();
+                     ++index)
+                {
+                    const Connection & connection = connections[*index];
+                    thread->addInput(connection.target, connection.inputId);
+                }
+            }
+        }
+        
+        void AssignThreadsAlgorithm::applyConnected(Stream& stream)
         {            
             const std::vector<Operator*> & operators = stream.initializedOperators();
             if (operators.size() == 0)
@@ -17,27 +17,84 @@
 #ifndef STROMX_RUNTIME_ASSIGNTHREADSALGORITHM_H
 #define STROMX_RUNTIME_ASSIGNTHREADSALGORITHM_H
 
+#include <map>
 #include "stromx/runtime/Config.h"
 
 namespace stromx
 {
     namespace runtime
     {
+        class Operator;
         class Stream;
         
         /** \brief Algorithm which assigns threads to the stream. */
         class STROMX_RUNTIME_API AssignThreadsAlgorithm
         {
         public:
+            /** The strategies to assign threads. */
+            enum Mode
+            {
+                /** 
+                 * Each group of connected inputs which can be visited by the same
+                 * thread is assigned to one thread.
+                 */
+                CONNECTED,
+                /**
+                 * The stream is partitioned into pipeline stages such that the
+                 * costs of the operators are balanced across numCores() threads
+                 * and as few data objects as possible are passed between threads.
+                 */
+                BALANCED
+            };
+            
             /** Constructs a thread assigning algorithm. */
-            AssignThreadsAlgorithm() {}
+            AssignThreadsAlgorithm() : m_mode(CONNECTED), m_numCores(0) {}
+            
+            /** Returns the assignment strategy. The default is CONNECTED. */
+            Mode mode() const { return m_mode; }
+            
+            /** Sets the assignment strategy. */
+            void setMode(const Mode mode) { m_mode = mode; }
+            
+            /** 
+             * Returns the number of cores the stream is balanced for in BALANCED
+             * mode. A value of 0 stands for the number of hardware threads of the
+             * system.
+             */
+            unsigned int numCores() const { return m_numCores; }
+            
+            /** Sets the number of cores the stream is balanced for in BALANCED mode. */
+            void setNumCores(const unsigned int numCores) { m_numCores = numCores; }
+            
+            /**
+             * Declares the cost of executing \c op once in microseconds. Operators
+             * without declared cost are estimated from their execution statistics
+             * (see Operator::setStatisticsEnabled()). Operators without statistics
+             * are assumed to cost as much as the average of the known operators.
+             * The costs are only used in BALANCED mode.
+             * 
+             * \throws WrongArgument If \c op is null or \c cost is negative.
+             */
+            void setCost(const Operator* const op, const double cost);
+            
+            /** Removes all declared costs. */
+            void clearCosts() { m_costs.clear(); }
             
             /**
              * Creates threads and assigns the connected inputs of the stream to
              * them such that connectors with different operator threads are 
-             * never part of the same thread.
+             * never part of the same thread. All existing threads of the stream
+             * are removed.
              */ 
             void apply(Stream & stream);
+            
+        private:
+            void applyConnected(Stream & stream);
+            void applyBalanced(Stream & stream);
+            
+            Mode m_mode;
+            unsigned int m_numCores;
+            std::map<const Operator*, double> m_costs;
         };
     }
 }
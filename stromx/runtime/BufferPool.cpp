@@ -0,0 +1,223 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/AbstractFactory.h"
+#include "stromx/runtime/BufferPool.h"
+#include "stromx/runtime/Data.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/ImageWrapper.h"
+#include "stromx/runtime/List.h"
+#include "stromx/runtime/MatrixWrapper.h"
+#include "stromx/runtime/impl/BufferPoolImpl.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            void deleteBuffers(std::vector<Data*> & buffers)
+            {
+                for(std::vector<Data*>::iterator iter = buffers.begin();
+                    iter != buffers.end();
+                    ++iter)
+                {
+                    delete *iter;
+                }
+            }
+        }
+        
+        BufferShape::BufferShape()
+          : m_type(NONE),
+            m_rows(0),
+            m_cols(0),
+            m_pixelType(Image::NONE),
+            m_valueType(Matrix::NONE)
+        {
+        }
+        
+        const BufferShape BufferShape::image(const unsigned int width, const unsigned int height,
+                                             const Image::PixelType pixelType)
+        {
+            BufferShape shape;
+            shape.m_type = IMAGE;
+            shape.m_rows = height;
+            shape.m_cols = width;
+            shape.m_pixelType = pixelType;
+            
+            return shape;
+        }
+        
+        const BufferShape BufferShape::matrix(const unsigned int rows, const unsigned int cols,
+                                              const Matrix::ValueType valueType)
+        {
+            BufferShape shape;
+            shape.m_type = MATRIX;
+            shape.m_rows = rows;
+            shape.m_cols = cols;
+            shape.m_valueType = valueType;
+            
+            return shape;
+        }
+        
+        const BufferShape BufferShape::list(const unsigned int numItems)
+        {
+            BufferShape shape;
+            shape.m_type = LIST;
+            shape.m_rows = numItems;
+            
+            return shape;
+        }
+        
+        void BufferShape::apply(Data & data) const
+        {
+            switch(m_type)
+            {
+            case NONE:
+                break;
+            case IMAGE:
+            {
+                ImageWrapper* image = dynamic_cast<ImageWrapper*>(&data);
+                if(! image)
+                    throw WrongArgument("Image shapes can only be applied to image wrappers.");
+                
+                image->resize(m_cols, m_rows, m_pixelType);
+                break;
+            }
+            case MATRIX:
+            {
+                MatrixWrapper* matrix = dynamic_cast<MatrixWrapper*>(&data);
+                if(! matrix)
+                    throw WrongArgument("Matrix shapes can only be applied to matrix wrappers.");
+                
+                matrix->resize(m_rows, m_cols, m_valueType);
+                break;
+            }
+            case LIST:
+            {
+                List* list = dynamic_cast<List*>(&data);
+                if(! list)
+                    throw WrongArgument("List shapes can only be applied to lists.");
+                
+                list->content().reserve(m_rows);
+                break;
+            }
+            default:
+                throw WrongArgument("Unknown buffer shape.");
+            }
+        }
+        
+        BufferPoolStatistics::BufferPoolStatistics()
+          : m_numHits(0),
+            m_numMisses(0),
+            m_highWaterMark(0),
+            m_waitTime(0)
+        {
+        }
+        
+        BufferPool::BufferPool()
+          : m_impl(new impl::BufferPoolImpl(std::vector<Data*>()))
+        {
+        }
+        
+        void BufferPool::allocate(const Data& prototype, const unsigned int numBuffers, const BufferShape& shape)
+        {
+            std::vector<Data*> buffers;
+            try
+            {
+                for(unsigned int i = 0; i < numBuffers; ++i)
+                {
+                    Data* buffer = prototype.clone();
+                    try
+                    {
+                        shape.apply(*buffer);
+                        buffers.push_back(buffer);
+                    }
+                    catch(...)
+                    {
+                        delete buffer;
+                        throw;
+                    }
+                }
+            }
+            catch(...)
+            {
+                deleteBuffers(buffers);
+                throw;
+            }
+            
+            m_impl = std::tr1::shared_ptr<impl::BufferPoolImpl>(new impl::BufferPoolImpl(buffers));
+        }
+        
+        void BufferPool::allocate(const AbstractFactory& factory, const std::string& package,
+                                  const std::string& type, const unsigned int numBuffers,
+                                  const BufferShape& shape)
+        {
+            Data* prototype = factory.newData(package, type);
+            try
+            {
+                allocate(*prototype, numBuffers, shape);
+            }
+            catch(...)
+            {
+                delete prototype;
+                throw;
+            }
+            
+            delete prototype;
+        }
+        
+        void BufferPool::deallocate()
+        {
+            m_impl = std::tr1::shared_ptr<impl::BufferPoolImpl>(new impl::BufferPoolImpl(std::vector<Data*>()));
+        }
+        
+        unsigned int BufferPool::numBuffers() const
+        {
+            return m_impl->numBuffers();
+        }
+        
+        unsigned int BufferPool::numFreeBuffers() const
+        {
+            return m_impl->numFreeBuffers();
+        }
+        
+        DataContainer BufferPool::get()
+        {
+            return m_impl->get(true, false);
+        }
+        
+        DataContainer BufferPool::get(const unsigned int timeout)
+        {
+            return m_impl->get(true, true, timeout);
+        }
+        
+        DataContainer BufferPool::tryGet()
+        {
+            return m_impl->get(false, false);
+        }
+        
+        BufferPoolStatistics BufferPool::statistics() const
+        {
+            return m_impl->statistics();
+        }
+        
+        void BufferPool::resetStatistics()
+        {
+            m_impl->resetStatistics();
+        }
+    }
+}
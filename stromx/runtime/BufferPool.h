@@ -0,0 +1,225 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_BUFFERPOOL_H
+#define STROMX_RUNTIME_BUFFERPOOL_H
+
+#ifdef __GNUG__
+    #include <tr1/memory>
+#else
+    #include <memory>
+#endif
+
+#include <stdint.h>
+#include <string>
+#include "stromx/runtime/Config.h"
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Image.h"
+#include "stromx/runtime/Matrix.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class AbstractFactory;
+        class Data;
+        
+        namespace impl
+        {
+            class BufferPoolImpl;
+        }
+        
+        /** 
+         * \brief The shape of the buffers of a buffer pool.
+         * 
+         * A shape is applied to each buffer when the buffer is allocated. Image shapes
+         * can be applied to instances of ImageWrapper, matrix shapes to instances of
+         * MatrixWrapper and list shapes to instances of List.
+         */
+        class STROMX_RUNTIME_API BufferShape
+        {
+        public:
+            enum Type
+            {
+                /** The buffers are used as they are allocated. */
+                NONE,
+                /** The buffers are images of a given size and pixel type. */
+                IMAGE,
+                /** The buffers are matrices of a given size and value type. */
+                MATRIX,
+                /** The buffers are lists with space for a given number of items. */
+                LIST
+            };
+            
+            /** Constructs a shape of the type NONE. */
+            BufferShape();
+            
+            /** Returns an image shape. */
+            static const BufferShape image(const unsigned int width, const unsigned int height,
+                                           const Image::PixelType pixelType);
+            
+            /** Returns a matrix shape. */
+            static const BufferShape matrix(const unsigned int rows, const unsigned int cols,
+                                            const Matrix::ValueType valueType);
+            
+            /** Returns a list shape which reserves space for \c numItems items. */
+            static const BufferShape list(const unsigned int numItems);
+            
+            /** Returns the type of the shape. */
+            Type type() const { return m_type; }
+            
+            /** Returns the number of rows of a matrix, the height of an image or the number of list items. */
+            unsigned int rows() const { return m_rows; }
+            
+            /** Returns the number of columns of a matrix or the width of an image. */
+            unsigned int cols() const { return m_cols; }
+            
+            /** Returns the pixel type of an image shape. */
+            Image::PixelType pixelType() const { return m_pixelType; }
+            
+            /** Returns the value type of a matrix shape. */
+            Matrix::ValueType valueType() const { return m_valueType; }
+            
+            /** 
+             * Applies the shape to \c data.
+             * 
+             * \throws WrongArgument If the shape can not be applied to \c data.
+             */
+            void apply(Data & data) const;
+            
+        private:
+            Type m_type;
+            unsigned int m_rows;
+            unsigned int m_cols;
+            Image::PixelType m_pixelType;
+            Matrix::ValueType m_valueType;
+        };
+        
+        /** 
+         * \brief Usage statistics of a buffer pool. 
+         * 
+         * All times are measured in microseconds.
+         */
+        class STROMX_RUNTIME_API BufferPoolStatistics
+        {
+            friend class impl::BufferPoolImpl;
+            
+        public:
+            /** Constructs empty statistics. */
+            BufferPoolStatistics();
+            
+            /** Returns the number of requests which were served by a free buffer. */
+            uint64_t numHits() const { return m_numHits; }
+            
+            /** Returns the number of requests which found no free buffer. */
+            uint64_t numMisses() const { return m_numMisses; }
+            
+            /** Returns the maximal number of buffers which were in use at the same time. */
+            unsigned int highWaterMark() const { return m_highWaterMark; }
+            
+            /** Returns the total time spent waiting for free buffers. */
+            uint64_t waitTime() const { return m_waitTime; }
+            
+        private:
+            uint64_t m_numHits;
+            uint64_t m_numMisses;
+            unsigned int m_highWaterMark;
+            uint64_t m_waitTime;
+        };
+        
+        /** 
+         * \brief A pool of reusable data buffers.
+         * 
+         * The pool allocates a fixed number of data objects and hands them out
+         * in data containers. As soon as a container and all its copies have been
+         * destructed the data object returns to the pool and can be handed out 
+         * again, i.e. the data objects are allocated only once. If the pool is 
+         * destructed or reallocated while buffers are in use, these buffers are
+         * deleted as soon as they are not used anymore.
+         * 
+         * Copies of a pool share the same buffers.
+         */
+        class STROMX_RUNTIME_API BufferPool
+        {
+        public:
+            /** Constructs a pool without buffers. */
+            BufferPool();
+            
+            /** 
+             * Replaces the buffers of the pool by \c numBuffers copies of \c prototype.
+             * The copies are created by Data::clone() and \c shape is applied to each
+             * of them. The pool is not changed if an exception is thrown.
+             * 
+             * \throws WrongArgument If \c shape can not be applied to the copies.
+             */
+            void allocate(const Data & prototype, const unsigned int numBuffers,
+                          const BufferShape & shape = BufferShape());
+            
+            /** 
+             * Replaces the buffers of the pool by \c numBuffers data objects which are
+             * allocated by \c factory and initialized to \c shape. The pool is not
+             * changed if an exception is thrown.
+             * 
+             * \throws DataAllocationFailed If \c factory does not know the data type.
+             * \throws WrongArgument If \c shape can not be applied to the data type.
+             */
+            void allocate(const AbstractFactory & factory, const std::string & package,
+                          const std::string & type, const unsigned int numBuffers,
+                          const BufferShape & shape = BufferShape());
+            
+            /** Deletes all buffers of the pool. */
+            void deallocate();
+            
+            /** Returns the number of buffers owned by the pool. */
+            unsigned int numBuffers() const;
+            
+            /** Returns the number of buffers which are not in use. */
+            unsigned int numFreeBuffers() const;
+            
+            /** 
+             * Waits for a free buffer and returns it.
+             * 
+             * \throws WrongState If the pool has no buffers.
+             * \throws Interrupt If the thread was interrupted while waiting.
+             */
+            DataContainer get();
+            
+            /** 
+             * Waits for a free buffer and returns it.
+             * 
+             * \param timeout The maximal time to wait in milliseconds.
+             * \throws WrongState If the pool has no buffers.
+             * \throws Timeout If no buffer was freed during the timeout.
+             * \throws Interrupt If the thread was interrupted while waiting.
+             */
+            DataContainer get(const unsigned int timeout);
+            
+            /** Returns a free buffer or an empty container if all buffers are in use. */
+            DataContainer tryGet();
+            
+            /** Returns the statistics of the pool. */
+            BufferPoolStatistics statistics() const;
+            
+            /** Resets the statistics of the pool. */
+            void resetStatistics();
+            
+        private:
+            std::tr1::shared_ptr<impl::BufferPoolImpl> m_impl;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_BUFFERPOOL_H
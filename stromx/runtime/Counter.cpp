@@ -18,6 +18,7 @@
 #include "stromx/runtime/Counter.h"
 #include "stromx/runtime/DataProvider.h"
 #include "stromx/runtime/Id2DataPair.h"
+#include "stromx/runtime/Metadata.h"
 #include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/Variant.h"
 
@@ -53,10 +54,12 @@ namespace stromx
         void Counter::execute(DataProvider& provider)
         {
             Data* outData = new UInt32(m_counter);
+            DataContainer outContainer(outData);
+            outContainer.setMetadata(Metadata(Metadata::currentTime(), m_counter, this));
             
             m_counter++;
             
-            Id2DataPair outputDataMapper(OUTPUT, DataContainer(outData));
+            Id2DataPair outputDataMapper(OUTPUT, outContainer);
             provider.sendOutputData(outputDataMapper);
         }
         
@@ -25,7 +25,7 @@ namespace stromx
 {
     namespace runtime
     {
-        /** \brief Outputs an increasing integer value. */
+        /** \brief Outputs an increasing integer value and stamps it with metadata. */
         class STROMX_RUNTIME_API Counter : public OperatorKernel
         {
         public:
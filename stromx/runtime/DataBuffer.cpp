@@ -0,0 +1,271 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/DataBuffer.h"
+
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/EnumParameter.h"
+#include "stromx/runtime/Id2DataPair.h"
+#include "stromx/runtime/NumericParameter.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/Variant.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        const std::string DataBuffer::TYPE("DataBuffer");
+        const std::string DataBuffer::PACKAGE(STROMX_RUNTIME_PACKAGE_NAME);
+        const Version DataBuffer::VERSION(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
+        
+        DataBuffer::DataBuffer()
+          : OperatorKernel(TYPE, PACKAGE, VERSION, std::vector<const Input*>(), 
+                           setupOutputs(), setupParameters()),
+            m_dataPackage(STROMX_RUNTIME_PACKAGE_NAME),
+            m_dataType("None"),
+            m_numBuffers(1),
+            m_shape(BufferShape::NONE),
+            m_rows(0),
+            m_cols(0),
+            m_pixelType(Image::MONO_8),
+            m_valueType(Matrix::UINT_8)
+        {
+        }
+        
+        void DataBuffer::setParameter(unsigned int id, const Data& value)
+        {
+            try
+            {
+                switch(id)
+                {
+                case DATA_PACKAGE:
+                    m_dataPackage = data_cast<String>(value);
+                    break;
+                case DATA_TYPE:
+                    m_dataType = data_cast<String>(value);
+                    break;
+                case NUM_BUFFERS:
+                {
+                    const UInt32 & numBuffers = data_cast<UInt32>(value);
+                    if(numBuffers < 1)
+                        throw WrongParameterValue(parameter(NUM_BUFFERS), *this);
+                    m_numBuffers = numBuffers;
+                    break;
+                }
+                case SHAPE:
+                    m_shape = data_cast<Enum>(value);
+                    break;
+                case ROWS:
+                    m_rows = data_cast<UInt32>(value);
+                    break;
+                case COLS:
+                    m_cols = data_cast<UInt32>(value);
+                    break;
+                case PIXEL_TYPE:
+                    m_pixelType = data_cast<Enum>(value);
+                    break;
+                case VALUE_TYPE:
+                    m_valueType = data_cast<Enum>(value);
+                    break;
+                default:
+                    throw WrongParameterId(id, *this);
+                }
+            }
+            catch(std::bad_cast&)
+            {
+                throw WrongParameterType(parameter(id), *this);
+            }
+        }
+        
+        const DataRef DataBuffer::getParameter(const unsigned int id) const
+        {
+            switch(id)
+            {
+            case DATA_PACKAGE:
+                return m_dataPackage;
+            case DATA_TYPE:
+                return m_dataType;
+            case NUM_BUFFERS:
+                return m_numBuffers;
+            case SHAPE:
+                return m_shape;
+            case ROWS:
+                return m_rows;
+            case COLS:
+                return m_cols;
+            case PIXEL_TYPE:
+                return m_pixelType;
+            case VALUE_TYPE:
+                return m_valueType;
+            case NUM_HITS:
+                return UInt64(m_pool.statistics().numHits());
+            case NUM_MISSES:
+                return UInt64(m_pool.statistics().numMisses());
+            case HIGH_WATER_MARK:
+                return UInt64(m_pool.statistics().highWaterMark());
+            case WAIT_TIME:
+                return UInt64(m_pool.statistics().waitTime());
+            default:
+                throw WrongParameterId(id, *this);
+            }
+        }
+        
+        void DataBuffer::activate()
+        {
+            m_pool.deallocate();
+        }
+        
+        void DataBuffer::deactivate()
+        {
+            m_pool.deallocate();
+        }
+        
+        void DataBuffer::execute(DataProvider& provider)
+        {
+            if(m_pool.numBuffers() == 0)
+                allocateBuffers(provider.factory());
+            
+            // allow parameter access while waiting for a free buffer
+            provider.unlockParameters();
+            DataContainer buffer = m_pool.get();
+            provider.lockParameters();
+            
+            Id2DataPair outputMapper(OUTPUT, buffer);
+            provider.sendOutputData(outputMapper);
+        }
+        
+        void DataBuffer::allocateBuffers(const AbstractFactory& factory)
+        {
+            try
+            {
+                m_pool.allocate(factory, m_dataPackage, m_dataType, m_numBuffers, shape());
+            }
+            catch(DataAllocationFailed&)
+            {
+                throw WrongParameterValue(parameter(DATA_TYPE), *this, "Failed to allocate data of this type.");
+            }
+            catch(WrongArgument&)
+            {
+                throw WrongParameterValue(parameter(SHAPE), *this, "The shape can not be applied to this data type.");
+            }
+        }
+        
+        const BufferShape DataBuffer::shape() const
+        {
+            switch(m_shape)
+            {
+            case BufferShape::IMAGE:
+                return BufferShape::image(m_cols, m_rows, Image::PixelType((unsigned int)(m_pixelType)));
+            case BufferShape::MATRIX:
+                return BufferShape::matrix(m_rows, m_cols, Matrix::ValueType((unsigned int)(m_valueType)));
+            case BufferShape::LIST:
+                return BufferShape::list(m_rows);
+            default:
+                return BufferShape();
+            }
+        }
+        
+        const std::vector<const Output*> DataBuffer::setupOutputs()
+        {
+            std::vector<const Output*> outputs;
+            
+            Output* output = new Output(OUTPUT, Variant::DATA);
+            output->setTitle("Output");
+            outputs.push_back(output);
+            
+            return outputs;
+        }
+        
+        const std::vector<const Parameter*> DataBuffer::setupParameters()
+        {
+            std::vector<const Parameter*> parameters;
+            
+            Parameter* dataPackage = new Parameter(DATA_PACKAGE, Variant::STRING);
+            dataPackage->setTitle("Package of the data type");
+            dataPackage->setAccessMode(Parameter::INITIALIZED_WRITE);
+            parameters.push_back(dataPackage);
+            
+            Parameter* dataType = new Parameter(DATA_TYPE, Variant::STRING);
+            dataType->setTitle("Data type");
+            dataType->setAccessMode(Parameter::INITIALIZED_WRITE);
+            parameters.push_back(dataType);
+            
+            NumericParameter<UInt32>* numBuffers = new NumericParameter<UInt32>(NUM_BUFFERS);
+            numBuffers->setTitle("Number of buffers");
+            numBuffers->setAccessMode(Parameter::INITIALIZED_WRITE);
+            numBuffers->setMin(UInt32(1));
+            parameters.push_back(numBuffers);
+            
+            EnumParameter* shape = new EnumParameter(SHAPE);
+            shape->setTitle("Shape");
+            shape->setAccessMode(Parameter::INITIALIZED_WRITE);
+            shape->add(EnumDescription(Enum(BufferShape::NONE), "None"));
+            shape->add(EnumDescription(Enum(BufferShape::IMAGE), "Image"));
+            shape->add(EnumDescription(Enum(BufferShape::MATRIX), "Matrix"));
+            shape->add(EnumDescription(Enum(BufferShape::LIST), "List"));
+            parameters.push_back(shape);
+            
+            NumericParameter<UInt32>* rows = new NumericParameter<UInt32>(ROWS);
+            rows->setTitle("Rows (image height, number of list items)");
+            rows->setAccessMode(Parameter::INITIALIZED_WRITE);
+            parameters.push_back(rows);
+            
+            NumericParameter<UInt32>* cols = new NumericParameter<UInt32>(COLS);
+            cols->setTitle("Columns (image width)");
+            cols->setAccessMode(Parameter::INITIALIZED_WRITE);
+            parameters.push_back(cols);
+            
+            EnumParameter* pixelType = new EnumParameter(PIXEL_TYPE);
+            pixelType->setTitle("Pixel type");
+            pixelType->setAccessMode(Parameter::INITIALIZED_WRITE);
+            pixelType->add(EnumDescription(Enum(Image::MONO_8), "Mono image 8-bit"));
+            pixelType->add(EnumDescription(Enum(Image::MONO_16), "Mono image 16-bit"));
+            pixelType->add(EnumDescription(Enum(Image::RGB_24), "RGB image 24-bit"));
+            pixelType->add(EnumDescription(Enum(Image::RGB_48), "RGB image 48-bit"));
+            pixelType->add(EnumDescription(Enum(Image::BGR_24), "BGR image 24-bit"));
+            pixelType->add(EnumDescription(Enum(Image::BGR_48), "BGR image 48-bit"));
+            parameters.push_back(pixelType);
+            
+            EnumParameter* valueType = new EnumParameter(VALUE_TYPE);
+            valueType->setTitle("Value type");
+            valueType->setAccessMode(Parameter::INITIALIZED_WRITE);
+            valueType->add(EnumDescription(Enum(Matrix::INT_8), "8-bit signed integer"));
+            valueType->add(EnumDescription(Enum(Matrix::UINT_8), "8-bit unsigned integer"));
+            valueType->add(EnumDescription(Enum(Matrix::INT_16), "16-bit signed integer"));
+            valueType->add(EnumDescription(Enum(Matrix::UINT_16), "16-bit unsigned integer"));
+            valueType->add(EnumDescription(Enum(Matrix::INT_32), "32-bit signed integer"));
+            valueType->add(EnumDescription(Enum(Matrix::UINT_32), "32-bit unsigned integer"));
+            valueType->add(EnumDescription(Enum(Matrix::FLOAT_32), "32-bit float"));
+            valueType->add(EnumDescription(Enum(Matrix::FLOAT_64), "64-bit float"));
+            parameters.push_back(valueType);
+            
+            const unsigned int ids[] = { NUM_HITS, NUM_MISSES, HIGH_WATER_MARK, WAIT_TIME };
+            const char* titles[] = { "Number of hits", "Number of misses",
+                                     "High-water mark", "Time waited for buffers" };
+            for(unsigned int i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+            {
+                Parameter* statistic = new Parameter(ids[i], Variant::UINT_64);
+                statistic->setTitle(titles[i]);
+                statistic->setAccessMode(Parameter::INITIALIZED_READ);
+                statistic->setUpdateBehavior(Parameter::PULL);
+                parameters.push_back(statistic);
+            }
+            
+            return parameters;
+        }
+    }
+}
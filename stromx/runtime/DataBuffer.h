@@ -0,0 +1,95 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_DATABUFFER_H
+#define STROMX_RUNTIME_DATABUFFER_H
+
+#include "stromx/runtime/BufferPool.h"
+#include "stromx/runtime/Enum.h"
+#include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/String.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /** 
+         * \brief Outputs reusable data buffers.
+         * 
+         * Upon its first execution after activation the operator allocates a
+         * pool of buffers of the given data type. The data is allocated by the
+         * factory of the operator and initialized to the given shape. Each 
+         * execution sends a free buffer to the output and waits if all buffers
+         * are in use. The usage statistics of the pool are available as 
+         * read-only parameters. All times are measured in microseconds.
+         * 
+         * \sa BufferPool
+         */
+        class STROMX_RUNTIME_API DataBuffer : public OperatorKernel
+        {
+        public:
+            enum DataId
+            {
+                OUTPUT,
+                DATA_PACKAGE,
+                DATA_TYPE,
+                NUM_BUFFERS,
+                SHAPE,
+                ROWS,
+                COLS,
+                PIXEL_TYPE,
+                VALUE_TYPE,
+                NUM_HITS,
+                NUM_MISSES,
+                HIGH_WATER_MARK,
+                WAIT_TIME
+            };
+            
+            DataBuffer();
+            
+            virtual OperatorKernel* clone() const { return new DataBuffer; }
+            virtual void setParameter(const unsigned int id, const Data& value);
+            virtual const DataRef getParameter(const unsigned int id) const;
+            virtual void execute(DataProvider& provider);
+            virtual void activate();
+            virtual void deactivate();
+            
+        private:
+            static const std::vector<const Output*> setupOutputs();
+            static const std::vector<const Parameter*> setupParameters();
+            
+            static const std::string TYPE;
+            static const std::string PACKAGE;
+            static const Version VERSION;
+            
+            void allocateBuffers(const AbstractFactory & factory);
+            const BufferShape shape() const;
+            
+            String m_dataPackage;
+            String m_dataType;
+            UInt32 m_numBuffers;
+            Enum m_shape;
+            UInt32 m_rows;
+            UInt32 m_cols;
+            Enum m_pixelType;
+            Enum m_valueType;
+            BufferPool m_pool;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_DATABUFFER_H
@@ -0,0 +1,72 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_DATACHANNEL_H
+#define STROMX_RUNTIME_DATACHANNEL_H
+
+#include "stromx/runtime/DataContainer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /**
+         * \brief Passes data from an input directly to an output of an operator.
+         * 
+         * An operator kernel can provide a data channel for some of its connectors
+         * (see OperatorKernel::channel()). While the operator is active, data which
+         * is set at such an input is pushed to the channel and data which is requested
+         * from such an output is taken from the channel. The operator is \em not
+         * executed in this case and the connectors do not notify connector observers.
+         * 
+         * Data is pushed by exactly one thread and taken by exactly one thread.
+         * Implementations must not block but return immediately if the
+         * channel is full or empty.
+         */
+        class DataChannel
+        {
+        public:
+            virtual ~DataChannel() {}
+            
+            /** 
+             * Appends \c data to the channel. Returns false if the channel is full.
+             * Must only be called by the pushing thread.
+             */
+            virtual bool tryPush(const DataContainer & data) = 0;
+            
+            /** 
+             * Returns the oldest data in the channel without removing it. Returns an
+             * empty container if the channel is empty. Must only be called by the
+             * consuming thread.
+             */
+            virtual DataContainer front() = 0;
+            
+            /**
+             * Removes the oldest data from the channel. Returns false if the 
+             * channel is empty. Must only be called by the consuming thread.
+             */
+            virtual bool pop() = 0;
+            
+            /** Returns true if the channel contains no data. */
+            virtual bool isEmpty() const = 0;
+            
+            /** Returns true if no more data can be pushed to the channel. */
+            virtual bool isFull() const = 0;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_DATACHANNEL_H
@@ -14,21 +14,31 @@
  *  limitations under the License.
  */
 
+#include <boost/make_shared.hpp>
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Recycler.h"
 #include "stromx/runtime/impl/DataContainerImpl.h"
+#include "stromx/runtime/impl/SmallObjectStlAllocator.h"
+
+namespace
+{
+    // the container implementation and its reference count are allocated 
+    // as one small object
+    typedef stromx::runtime::impl::SmallObjectStlAllocator<stromx::runtime::impl::DataContainerImpl> ImplAllocator;
+}
 
 namespace stromx
 {
     namespace runtime
     {
         DataContainer::DataContainer(Data* data)
-          : m_impl(new impl::DataContainerImpl(data))
+          : m_impl(boost::allocate_shared<impl::DataContainerImpl>(ImplAllocator(), data))
         {
         }
         
         DataContainer::DataContainer(Data* data, const bool isReadOnly)
-          : m_impl(new impl::DataContainerImpl(data, isReadOnly))
+          : m_impl(boost::allocate_shared<impl::DataContainerImpl>(ImplAllocator(), data, isReadOnly))
         {
         }
         
@@ -62,5 +72,31 @@ namespace stromx
         { 
             return m_impl.get() == 0 ? true : m_impl->isReadOnly();
         }
+        
+        bool DataContainer::isCopyOnWrite() const
+        {
+            return m_impl.get() == 0 ? false : m_impl->isCopyOnWrite();
+        }
+        
+        void DataContainer::setCopyOnWrite(const bool copyOnWrite)
+        {
+            if(m_impl.get() == 0)
+                throw WrongState("Can not set the copy-on-write mode of an empty data container.");
+            
+            m_impl->setCopyOnWrite(copyOnWrite);
+        }
+        
+        Metadata DataContainer::metadata() const
+        {
+            return m_impl.get() == 0 ? Metadata() : m_impl->metadata();
+        }
+        
+        void DataContainer::setMetadata(const Metadata& metadata)
+        {
+            if(m_impl.get() == 0)
+                throw WrongState("Can not set the metadata of an empty data container.");
+            
+            m_impl->setMetadata(metadata);
+        }
     }
 }
\ No newline at end of file
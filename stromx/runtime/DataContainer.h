@@ -17,13 +17,9 @@
 #ifndef STROMX_RUNTIME_DATACONTAINER_H
 #define STROMX_RUNTIME_DATACONTAINER_H
 
+#include <boost/shared_ptr.hpp>
 #include "stromx/runtime/Config.h"
-
-#ifdef __GNUG__
-    #include <tr1/memory>
-#else
-    #include <memory>
-#endif
+#include "stromx/runtime/Metadata.h"
 
 namespace stromx
 {
@@ -33,6 +29,7 @@ namespace stromx
         
         namespace impl
         {
+            class BufferPoolImpl;
             class ReadAccessImpl;
             class WriteAccessImpl;
             class DataContainerImpl;
@@ -42,6 +39,7 @@ namespace stromx
         /** \brief Container which manages the life-cycle of data objects. */
         class STROMX_RUNTIME_API DataContainer
         {
+            friend class impl::BufferPoolImpl;
             friend class impl::WriteAccessImpl;
             friend class impl::ReadAccessImpl;
             friend class impl::RecycleAccessImpl;
@@ -83,8 +81,39 @@ namespace stromx
              */
             bool isReadOnly() const;
             
+            /** 
+             * Returns true if the container is in copy-on-write mode. False for
+             * empty containers.
+             */
+            bool isCopyOnWrite() const;
+            
+            /** 
+             * Enables or disables the copy-on-write mode of the container. The mode is
+             * shared by all copies of the container. In copy-on-write mode a WriteAccess
+             * which is constructed from a non-const container does not wait for the other
+             * read and write accesses to finish. Instead the data is copied, the container
+             * passed to the write access is replaced by a container holding the copy and
+             * the write access refers to the copy. All other copies of the original
+             * container keep the original data.
+             * \throws WrongState If the container is empty.
+             */
+            void setCopyOnWrite(const bool copyOnWrite);
+            
+            /** 
+             * Returns the metadata of the container. Returns invalid metadata
+             * if the container is empty or no metadata has been set.
+             */
+            Metadata metadata() const;
+            
+            /** 
+             * Sets the metadata of the container. The metadata is shared by all
+             * copies of the container.
+             * \throws WrongState If the container is empty.
+             */
+            void setMetadata(const Metadata & metadata);
+            
         private:
-            std::tr1::shared_ptr<impl::DataContainerImpl> m_impl;
+            boost::shared_ptr<impl::DataContainerImpl> m_impl;
         };     
         
         /** Returns \c true if the addresses in \c lhs and \c rhs are the same. */
@@ -17,6 +17,8 @@
 #include <boost/filesystem.hpp>
 #include "stromx/runtime/DirectoryFileInput.h"
 #include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/MappedFile.h"
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
 
 namespace stromx
 {
@@ -24,10 +26,18 @@ namespace stromx
     {
         const std::string DirectoryFileInput::PATH_SEPARATOR = boost::filesystem::path("/").string();
         
+        DirectoryFileInput::DirectoryFileInput(const std::string & directory)
+          : m_initialized(false),
+            m_directory(directory),
+            m_mappedFile(0),
+            m_mappedBuffer(0),
+            m_mappedStream(0)
+        {
+        }
+        
         DirectoryFileInput::~DirectoryFileInput()
         {
-            if(m_currentFile.is_open())
-                m_currentFile.close();
+            closeFile();
         }
 
         void DirectoryFileInput::initialize(const std::string& text, const std::string& filename)
@@ -35,8 +45,7 @@ namespace stromx
             m_currentText.clear();
             m_currentText.str(text);
             
-            if(m_currentFile.is_open())
-                m_currentFile.close();
+            closeFile();
             
             m_currentFilename = filename;
             m_initialized = true;
@@ -44,8 +53,7 @@ namespace stromx
         
         void DirectoryFileInput::close()
         {
-            if(m_currentFile.is_open())
-                m_currentFile.close();
+            closeFile();
         }
 
         std::istream& DirectoryFileInput::text()
@@ -69,23 +77,39 @@ namespace stromx
             if(! m_initialized)
                 throw WrongState("Directory file has not been initialized.");
             
-            if(m_currentFile.is_open())
+            if(isOpen())
                 throw WrongState("File has already been opened.");
             
             if(! hasFile())
                 throw NoInputFile();
             
-            std::ios_base::openmode iosmode = std::ios_base::in;
-            if(mode == BINARY)
-                iosmode |= std::ios_base::binary;
-            
             std::string filename = m_directory + PATH_SEPARATOR + m_currentFilename;
-            m_currentFile.open(filename.c_str(), iosmode);
             
-            if(m_currentFile.fail())
+            // text files are read by a file stream because the line endings
+            // might have to be converted
+            if(mode == TEXT)
+            {
+                m_currentFile.open(filename.c_str(), std::ios_base::in);
+                
+                if(m_currentFile.fail())
+                    throw FileAccessFailed(filename, m_directory, "");
+                
+                return m_currentFile;
+            }
+            
+            try
+            {
+                m_mappedFile = new impl::MappedFile(filename);
+            }
+            catch(FileAccessFailed &)
+            {
                 throw FileAccessFailed(filename, m_directory, "");
+            }
             
-            return m_currentFile;
+            m_mappedBuffer = new impl::MemoryInputBuffer(m_mappedFile->data(), m_mappedFile->size());
+            m_mappedStream = new std::istream(m_mappedBuffer);
+            
+            return *m_mappedStream;
         }
 
         std::istream& DirectoryFileInput::file()
@@ -93,10 +117,33 @@ namespace stromx
             if(! m_initialized)
                 throw WrongState("Directory file has not been initialized.");
             
-            if(! m_currentFile.is_open())
+            if(! isOpen())
                 throw WrongState("File has not been opened.");
             
+            if(m_mappedStream)
+                return *m_mappedStream;
+            
             return m_currentFile;
         }
+        
+        bool DirectoryFileInput::isOpen() const
+        {
+            return m_currentFile.is_open() || m_mappedStream;
+        }
+        
+        void DirectoryFileInput::closeFile()
+        {
+            if(m_currentFile.is_open())
+                m_currentFile.close();
+            
+            m_currentFile.clear();
+            
+            delete m_mappedStream;
+            m_mappedStream = 0;
+            delete m_mappedBuffer;
+            m_mappedBuffer = 0;
+            delete m_mappedFile;
+            m_mappedFile = 0;
+        }
     }
 }
\ No newline at end of file
@@ -26,7 +26,18 @@ namespace stromx
 {
     namespace runtime
     {
-        /** \brief File input which reads the input files from a common directory. */
+        namespace impl
+        {
+            class MappedFile;
+            class MemoryInputBuffer;
+        }
+        
+        /** 
+         * \brief File input which reads the input files from a common directory. 
+         * 
+         * Binary files are memory-mapped, i.e. their data is only loaded when 
+         * it is accessed.
+         */
         class STROMX_RUNTIME_API DirectoryFileInput : public FileInput
         {
         public:
@@ -35,7 +46,7 @@ namespace stromx
              * 
              * \param directory The path to the directory.
              */
-            explicit DirectoryFileInput(const std::string & directory) : m_initialized(false), m_directory(directory) {}
+            explicit DirectoryFileInput(const std::string & directory);
             virtual ~DirectoryFileInput();
             
             virtual void initialize(const std::string & text, const std::string & filename);
@@ -49,10 +60,16 @@ namespace stromx
         private:
             static const std::string PATH_SEPARATOR;
             
+            bool isOpen() const;
+            void closeFile();
+            
             bool m_initialized;
             std::string m_directory;
             std::string m_currentFilename;
             std::ifstream m_currentFile;
+            impl::MappedFile* m_mappedFile;
+            impl::MemoryInputBuffer* m_mappedBuffer;
+            std::istream* m_mappedStream;
             std::istringstream m_currentText;
         };
     }
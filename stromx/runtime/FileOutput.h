@@ -27,6 +27,8 @@ namespace stromx
         class FileOutput : public OutputProvider
         {
         public:
+            FileOutput() : m_encoding(DEFAULT) {}
+            
             /**
              * Initializes the output provider.
              * \param filename The name of the file which accepts the file data without file 
@@ -57,7 +59,15 @@ namespace stromx
              */
             virtual void close() = 0;
             
+            /** Sets the encoding of images and matrices written to this output. */
+            void setEncoding(const Encoding encoding) { m_encoding = encoding; }
+            
+            virtual Encoding encoding() const { return m_encoding; }
+            
             virtual ~FileOutput() {}
+            
+        private:
+            Encoding m_encoding;
         };
     }
 }
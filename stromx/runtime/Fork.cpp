@@ -20,7 +20,6 @@
 #include <boost/lexical_cast.hpp>
 
 #include "stromx/runtime/DataProvider.h"
-#include "stromx/runtime/Id2DataComposite.h"
 #include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/NumericParameter.h"
 #include "stromx/runtime/OperatorException.h"
@@ -45,7 +44,8 @@ namespace stromx
         
         Fork::Fork()
           : OperatorKernel(TYPE, PACKAGE, VERSION, setupParameters()),
-            m_numOutputs(2)
+            m_numOutputs(2),
+            m_outputMapper(Id2DataComposite::OR)
         {
         }
         
@@ -86,67 +86,36 @@ namespace stromx
                                        std::vector<const Parameter*>());
         }
         
+        void Fork::activate()
+        {
+            std::vector<unsigned int> ids;
+            for(unsigned int i = 0; i < (unsigned int)(m_numOutputs); ++i)
+                ids.push_back(OUTPUTS_BASE + i);
+            
+            m_outputMapper = Id2DataArray(ids, Id2DataComposite::OR);
+        }
+        
         void Fork::execute(DataProvider& provider)
         {
             Id2DataPair input(INPUT);
             
             provider.receiveInputData(input);
             
-            unsigned int numOutputs = (unsigned int)(m_numOutputs);
             BOOST_ASSERT(MIN_OUTPUTS >= 2);
             
-            std::vector<Id2DataPair*> outputPairs;
-            for(unsigned int i = 0; i < numOutputs; ++i)
-                outputPairs.push_back(new Id2DataPair(OUTPUTS_BASE + i, input.data()));
-            
-            std::vector<Id2DataComposite*> outputComposites;
-            outputComposites.push_back(new Id2DataComposite(*outputPairs[0],
-                                                            *outputPairs[1],
-                                                            Id2DataComposite::OR));
-            
-            for(unsigned int i = 1; i < numOutputs - 1; ++i)
-            {
-                outputComposites.push_back(new Id2DataComposite(*outputComposites[i - 1],
-                                                                *outputPairs[i + 1],
-                                                                Id2DataComposite::OR));
-            }
-            
+            // the data which is not sent must not remain in the mapper
+            m_outputMapper.setAllData(input.data());
             try
             {
-                provider.sendOutputData(*outputComposites.back());
-                
-                for(std::vector<Id2DataPair*>::const_iterator iter = outputPairs.begin();
-                    iter != outputPairs.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
-                for(std::vector<Id2DataComposite*>::const_iterator iter = outputComposites.begin();
-                    iter != outputComposites.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
+                provider.sendOutputData(m_outputMapper);
             }
             catch(...)
             {
-                for(std::vector<Id2DataPair*>::const_iterator iter = outputPairs.begin();
-                    iter != outputPairs.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
-                for(std::vector<Id2DataComposite*>::const_iterator iter = outputComposites.begin();
-                    iter != outputComposites.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
+                m_outputMapper.clear();
                 throw;
             }
+            
+            m_outputMapper.clear();
         }
         
         const std::vector<const Input*> Fork::setupInputs()
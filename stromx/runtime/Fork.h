@@ -17,6 +17,7 @@
 #ifndef STROMX_RUNTIME_FORK_H
 #define STROMX_RUNTIME_FORK_H
 
+#include "stromx/runtime/Id2DataArray.h"
 #include "stromx/runtime/OperatorKernel.h"
 
 namespace stromx
@@ -40,6 +41,7 @@ namespace stromx
             virtual void setParameter(const unsigned int id, const Data& value);
             const DataRef getParameter(const unsigned int id) const;
             virtual void initialize();
+            virtual void activate();
             virtual void execute(DataProvider& provider);
             
         private:
@@ -55,6 +57,7 @@ namespace stromx
             static const unsigned int MAX_OUTPUTS;
             
             UInt32 m_numOutputs;
+            Id2DataArray m_outputMapper;
         };
     }
 }
@@ -0,0 +1,226 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/assert.hpp>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Id2DataArray.h"
+#include "stromx/runtime/impl/Id2DataMap.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        Id2DataArray::Id2DataArray(const Id2DataComposite::NodeType type)
+          : m_type(type)
+        {
+        }
+        
+        Id2DataArray::Id2DataArray(const std::vector<unsigned int> & ids, const Id2DataComposite::NodeType type)
+          : m_ids(ids),
+            m_data(ids.size()),
+            m_type(type)
+        {
+        }
+        
+        unsigned int Id2DataArray::id(const unsigned int index) const
+        {
+            if(index >= m_ids.size())
+                throw WrongArgument("Index is out of range.");
+            
+            return m_ids[index];
+        }
+        
+        const DataContainer & Id2DataArray::data(const unsigned int index) const
+        {
+            if(index >= m_data.size())
+                throw WrongArgument("Index is out of range.");
+            
+            return m_data[index];
+        }
+        
+        const DataContainer & Id2DataArray::firstData() const
+        {
+            for(std::vector<DataContainer>::const_iterator iter = m_data.begin();
+                iter != m_data.end();
+                ++iter)
+            {
+                if(! iter->empty())
+                    return *iter;
+            }
+            
+            static const DataContainer EMPTY;
+            return EMPTY;
+        }
+        
+        void Id2DataArray::setData(const unsigned int index, const DataContainer & data)
+        {
+            if(index >= m_data.size())
+                throw WrongArgument("Index is out of range.");
+            
+            m_data[index] = data;
+        }
+        
+        void Id2DataArray::setAllData(const DataContainer & data)
+        {
+            for(std::vector<DataContainer>::iterator iter = m_data.begin();
+                iter != m_data.end();
+                ++iter)
+            {
+                *iter = data;
+            }
+        }
+        
+        void Id2DataArray::clear()
+        {
+            setAllData(DataContainer());
+        }
+        
+        bool Id2DataArray::trySet(const impl::Id2DataMap& id2DataMap) const
+        {
+            switch(m_type)
+            {
+            case Id2DataComposite::AND:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(! trySet(id2DataMap, i))
+                        return false;
+                }
+                return true;
+            case Id2DataComposite::OR:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(trySet(id2DataMap, i))
+                        return true;
+                }
+                return false;
+            default:
+                BOOST_ASSERT(false);
+                return false;
+            } 
+        }
+        
+        bool Id2DataArray::tryGet(const impl::Id2DataMap& id2DataMap) const
+        {
+            switch(m_type)
+            {
+            case Id2DataComposite::AND:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(! tryGet(id2DataMap, i))
+                        return false;
+                }
+                return true;
+            case Id2DataComposite::OR:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(tryGet(id2DataMap, i))
+                        return true;
+                }
+                return false;
+            default:
+                BOOST_ASSERT(false);
+                return false;
+            } 
+        }
+        
+        void Id2DataArray::get(impl::Id2DataMap& id2DataMap) const
+        {
+            switch(m_type)
+            {
+            case Id2DataComposite::AND:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                    get(id2DataMap, i);
+                break;
+            case Id2DataComposite::OR:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(tryGet(id2DataMap, i) || i + 1 == m_ids.size())
+                    {
+                        get(id2DataMap, i);
+                        break;
+                    }
+                }
+                break;
+            default:
+                BOOST_ASSERT(false);
+            }
+        }
+        
+        void Id2DataArray::set(impl::Id2DataMap& id2DataMap) const
+        {
+            switch(m_type)
+            {
+            case Id2DataComposite::AND:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                    set(id2DataMap, i);
+                break;
+            case Id2DataComposite::OR:
+                for(unsigned int i = 0; i < m_ids.size(); ++i)
+                {
+                    if(trySet(id2DataMap, i) || i + 1 == m_ids.size())
+                    {
+                        set(id2DataMap, i);
+                        break;
+                    }
+                }
+                break;
+            default:
+                BOOST_ASSERT(false);
+            }
+        }
+        
+        bool Id2DataArray::trySet(const impl::Id2DataMap& id2DataMap, const unsigned int index) const
+        {
+            return id2DataMap.canBeSet(m_ids[index]);
+        }
+        
+        bool Id2DataArray::tryGet(const impl::Id2DataMap& id2DataMap, const unsigned int index) const
+        {
+            return ! id2DataMap.get(m_ids[index]).empty();
+        }
+        
+        void Id2DataArray::get(impl::Id2DataMap& id2DataMap, const unsigned int index) const
+        {
+            const unsigned int id = m_ids[index];
+            DataContainer & data = m_data[index];
+            
+            if(! data.empty())
+                throw WrongState("Data has already been assigned to this ID-data pair.");
+                
+            if(id2DataMap.get(id).empty())
+                throw WrongState("The requested output is empty.");
+            
+            data = id2DataMap.get(id);
+            if (id2DataMap.mustBeReset(id)) 
+                id2DataMap.set(id, DataContainer());
+        }
+        
+        void Id2DataArray::set(impl::Id2DataMap& id2DataMap, const unsigned int index) const
+        {
+            const unsigned int id = m_ids[index];
+            DataContainer & data = m_data[index];
+            
+            if(data.empty())
+                throw WrongState("This ID-data pair contains no data");
+            
+            if (! id2DataMap.canBeSet(id))
+                throw WrongState("Data has already been assigned to this connector ID.");
+            
+            id2DataMap.set(id, data);
+            data = DataContainer();
+        }
+    }
+}
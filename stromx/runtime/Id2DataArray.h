@@ -0,0 +1,86 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_ID2DATAARRAY_H
+#define STROMX_RUNTIME_ID2DATAARRAY_H
+
+#include <vector>
+#include "stromx/runtime/Config.h"
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Id2DataComposite.h"
+#include "stromx/runtime/Id2DataMapper.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /** 
+         * \brief An AND or OR expression of an arbitrary number of ID-to-data pairs.
+         * 
+         * The expression behaves like a chain of Id2DataPair objects combined by
+         * Id2DataComposite objects of the same type but stores the IDs and the data
+         * in contiguous arrays. Operators can construct it once (e.g. in activate())
+         * and reuse it for each execution without allocating any memory.
+         */
+        class STROMX_RUNTIME_API Id2DataArray : public Id2DataMapper
+        {
+        public:
+            /** Constructs an empty expression of the type \c type. */
+            explicit Id2DataArray(const Id2DataComposite::NodeType type = Id2DataComposite::AND);
+            
+            /** Constructs an expression of the type \c type for the connectors \c ids. */
+            Id2DataArray(const std::vector<unsigned int> & ids, const Id2DataComposite::NodeType type);
+            
+            /** Returns the number of ID-to-data pairs. */
+            unsigned int size() const { return (unsigned int)(m_ids.size()); }
+            
+            /** Returns the ID of the pair \c index. */
+            unsigned int id(const unsigned int index) const;
+            
+            /** Returns the data of the pair \c index. */
+            const DataContainer & data(const unsigned int index) const;
+            
+            /** Returns the data of the first pair which is not empty or an empty container. */
+            const DataContainer & firstData() const;
+            
+            /** Sets the data of the pair \c index. */
+            void setData(const unsigned int index, const DataContainer & data);
+            
+            /** Sets the data of all pairs to \c data. */
+            void setAllData(const DataContainer & data);
+            
+            /** Resets the data of all pairs to empty containers. */
+            void clear();
+            
+            virtual bool trySet(const impl::Id2DataMap& id2DataMap) const;
+            virtual bool tryGet(const impl::Id2DataMap& id2DataMap) const;
+            virtual void get(impl::Id2DataMap& id2DataMap) const; 
+            virtual void set(impl::Id2DataMap& id2DataMap) const;
+            
+        private:
+            bool trySet(const impl::Id2DataMap& id2DataMap, const unsigned int index) const;
+            bool tryGet(const impl::Id2DataMap& id2DataMap, const unsigned int index) const;
+            void get(impl::Id2DataMap& id2DataMap, const unsigned int index) const;
+            void set(impl::Id2DataMap& id2DataMap, const unsigned int index) const;
+            
+            std::vector<unsigned int> m_ids;
+            mutable std::vector<DataContainer> m_data;
+            Id2DataComposite::NodeType m_type;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_ID2DATAARRAY_H
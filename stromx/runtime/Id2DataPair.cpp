@@ -33,6 +33,13 @@ namespace stromx
             return ! id2DataMap.get(m_id).empty();
         }
         
+        DataContainer Id2DataPair::release()
+        {
+            DataContainer data = m_data;
+            m_data = DataContainer();
+            return data;
+        }
+        
         void Id2DataPair::get(runtime::impl::Id2DataMap& id2DataMap) const
         {
             if(! m_data.empty())
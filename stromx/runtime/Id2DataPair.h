@@ -49,6 +49,13 @@ namespace stromx
             unsigned int id() const { return m_id; }
             const DataContainer & data() const { return m_data; }
             
+            /** 
+             * Returns the data and removes it from the pair. Call this instead of
+             * data() to obtain a write access to copy-on-write data without
+             * the pair holding a further copy of the container.
+             */
+            DataContainer release();
+            
             virtual bool trySet(const impl::Id2DataMap& id2DataMap) const;
             virtual bool tryGet(const impl::Id2DataMap& id2DataMap) const;
             virtual void get(impl::Id2DataMap& id2DataMap) const; 
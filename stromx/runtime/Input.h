@@ -28,17 +28,39 @@ namespace stromx
         class STROMX_RUNTIME_API Input : public ConnectorDescription
         {
         public:
+            /** The behavior of an input which receives data while it is still occupied. */
+            enum OverflowPolicy
+            {
+                /** The sender waits until the input is free. */
+                BLOCK,
+                /** The new data is dropped, i.e. the input keeps the older data. */
+                DROP_NEWEST,
+                /** The new data replaces the older data, i.e. the input holds the latest data. */
+                DROP_OLDEST
+            };
+            
             /** Constructs a description. */
             Input(const unsigned int id, const VariantHandle& variant)
-              : ConnectorDescription(id, variant, INPUT)
+              : ConnectorDescription(id, variant, INPUT),
+                m_overflowPolicy(BLOCK)
             {}
             
             virtual Type originalType() const { return INPUT; }
             virtual Type currentType() const { return INPUT; }
             
+            /** 
+             * Returns the default overflow policy of the input. It can be overridden
+             * for each operator by Operator::setOverflowPolicy().
+             */
+            OverflowPolicy overflowPolicy() const { return m_overflowPolicy; }
+            
+            /** Sets the default overflow policy of the input. */
+            void setOverflowPolicy(const OverflowPolicy policy) { m_overflowPolicy = policy; }
+            
         private:
             unsigned int m_operatorThread;
             Type m_defaultType;
+            OverflowPolicy m_overflowPolicy;
         };
     }
 }
@@ -20,7 +20,6 @@
 #include <boost/lexical_cast.hpp>
 
 #include "stromx/runtime/DataProvider.h"
-#include "stromx/runtime/Id2DataComposite.h"
 #include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/NumericParameter.h"
 #include "stromx/runtime/OperatorException.h"
@@ -45,7 +44,8 @@ namespace stromx
         
         Join::Join()
           : OperatorKernel(TYPE, PACKAGE, VERSION, setupParameters()),
-            m_numInputs(2)
+            m_numInputs(2),
+            m_inputMapper(Id2DataComposite::OR)
         {
         }
         
@@ -86,76 +86,25 @@ namespace stromx
                                        std::vector<const Parameter*>());
         }
         
+        void Join::activate()
+        {
+            std::vector<unsigned int> ids;
+            for(unsigned int i = 0; i < (unsigned int)(m_numInputs); ++i)
+                ids.push_back(INPUTS_BASE + i);
+            
+            m_inputMapper = Id2DataArray(ids, Id2DataComposite::OR);
+        }
+        
         void Join::execute(DataProvider& provider)
         {
-            unsigned int numInputs = (unsigned int)(m_numInputs);
             BOOST_ASSERT(MIN_INPUTS >= 2);
             
-            std::vector<Id2DataPair*> inputPairs;
-            for(unsigned int i = 0; i < numInputs; ++i)
-                inputPairs.push_back(new Id2DataPair(INPUTS_BASE + i));
+            provider.receiveInputData(m_inputMapper);
             
-            std::vector<Id2DataComposite*> inputComposites;
-            inputComposites.push_back(new Id2DataComposite(*inputPairs[0],
-                                                           *inputPairs[1],
-                                                           Id2DataComposite::OR));
-            for(unsigned int i = 1; i < numInputs - 1; ++i)
-            {
-                inputComposites.push_back(new Id2DataComposite(*inputComposites[i - 1],
-                                                               *inputPairs[i + 1],
-                                                               Id2DataComposite::OR));
-                
-                
-            }
+            Id2DataPair outputMapper(OUTPUT, m_inputMapper.firstData());
+            m_inputMapper.clear();
             
-            try
-            {
-                provider.receiveInputData(*inputComposites.back());
-                
-                for(std::vector<Id2DataPair*>::const_iterator iter = inputPairs.begin();
-                    iter != inputPairs.end();
-                    ++iter)
-                {
-                    if(! (*iter)->data().empty())
-                    {
-                        Id2DataPair outputMapper(OUTPUT, (*iter)->data());
-                        provider.sendOutputData(outputMapper);
-                        break;
-                    }
-                }
-                
-                for(std::vector<Id2DataPair*>::const_iterator iter = inputPairs.begin();
-                    iter != inputPairs.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
-                for(std::vector<Id2DataComposite*>::const_iterator iter = inputComposites.begin();
-                    iter != inputComposites.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-            }
-            catch(...)
-            {
-                for(std::vector<Id2DataPair*>::const_iterator iter = inputPairs.begin();
-                    iter != inputPairs.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
-                for(std::vector<Id2DataComposite*>::const_iterator iter = inputComposites.begin();
-                    iter != inputComposites.end();
-                    ++iter)
-                {
-                    delete *iter;
-                }
-                
-                throw;
-            }
+            provider.sendOutputData(outputMapper);
         }
         
         const std::vector<const Output*> Join::setupOutputs()
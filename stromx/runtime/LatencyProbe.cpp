@@ -0,0 +1,189 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/Id2DataPair.h"
+#include "stromx/runtime/LatencyProbe.h"
+#include "stromx/runtime/Metadata.h"
+#include "stromx/runtime/NumericParameter.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/Variant.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        const std::string LatencyProbe::TYPE("LatencyProbe");
+        const std::string LatencyProbe::PACKAGE(STROMX_RUNTIME_PACKAGE_NAME);
+        const Version LatencyProbe::VERSION(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
+        
+        LatencyProbe::LatencyProbe()
+          : OperatorKernel(TYPE, PACKAGE, VERSION, setupInputs(), setupOutputs(), setupParameters()),
+            m_windowSize(1000),
+            m_numMeasurements(0),
+            m_numMissingMetadata(0)
+        {
+        }
+        
+        void LatencyProbe::setParameter(unsigned int id, const Data& value)
+        {
+            try
+            {
+                switch(id)
+                {
+                case WINDOW_SIZE:
+                {
+                    const UInt32 & windowSize = data_cast<UInt32>(value);
+                    if(windowSize == 0)
+                        throw WrongParameterValue(parameter(WINDOW_SIZE), *this);
+                    
+                    m_windowSize = windowSize;
+                    while(m_latencies.size() > m_windowSize)
+                        m_latencies.pop_front();
+                    break;
+                }
+                default:
+                    throw WrongParameterId(id, *this);
+                }
+            }
+            catch(std::bad_cast&)
+            {
+                throw WrongParameterValue(parameter(id), *this);
+            }
+        }
+        
+        const DataRef LatencyProbe::getParameter(const unsigned int id) const
+        {
+            switch(id)
+            {
+            case WINDOW_SIZE:
+                return m_windowSize;
+            case MEDIAN:
+                return UInt64(percentile(50));
+            case PERCENTILE_90:
+                return UInt64(percentile(90));
+            case PERCENTILE_99:
+                return UInt64(percentile(99));
+            case MAXIMUM:
+                return UInt64(percentile(100));
+            case NUM_MEASUREMENTS:
+                return UInt64(m_numMeasurements);
+            case NUM_MISSING_METADATA:
+                return UInt64(m_numMissingMetadata);
+            default:
+                throw WrongParameterId(id, *this);
+            }
+        }
+        
+        void LatencyProbe::activate()
+        {
+            m_latencies.clear();
+            m_numMeasurements = 0;
+            m_numMissingMetadata = 0;
+        }
+        
+        void LatencyProbe::execute(DataProvider& provider)
+        {
+            Id2DataPair inputMapper(INPUT);
+            provider.receiveInputData(inputMapper);
+            
+            const Metadata metadata = inputMapper.data().metadata();
+            if(metadata.isValid())
+            {
+                const uint64_t now = Metadata::currentTime();
+                const uint64_t latency = now > metadata.timestamp() ? now - metadata.timestamp() : 0;
+                
+                if(m_latencies.size() == m_windowSize)
+                    m_latencies.pop_front();
+                m_latencies.push_back(latency);
+                m_numMeasurements++;
+            }
+            else
+            {
+                m_numMissingMetadata++;
+            }
+            
+            Id2DataPair outputMapper(OUTPUT, inputMapper.data());
+            provider.sendOutputData(outputMapper);
+        }
+        
+        uint64_t LatencyProbe::percentile(const unsigned int percent) const
+        {
+            if(m_latencies.empty())
+                return 0;
+            
+            // the nearest-rank percentile of the current window
+            std::vector<uint64_t> latencies(m_latencies.begin(), m_latencies.end());
+            const std::size_t rank = (percent * latencies.size() + 99) / 100;
+            const std::size_t index = rank > 0 ? rank - 1 : 0;
+            std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+            
+            return latencies[index];
+        }
+        
+        const std::vector<const Input*> LatencyProbe::setupInputs()
+        {
+            std::vector<const Input*> inputs;
+            
+            Input* input = new Input(INPUT, Variant::DATA);
+            input->setTitle("Input");
+            inputs.push_back(input);
+            
+            return inputs;
+        }
+        
+        const std::vector<const Output*> LatencyProbe::setupOutputs()
+        {
+            std::vector<const Output*> outputs;
+            
+            Output* output = new Output(OUTPUT, Variant::DATA);
+            output->setTitle("Output");
+            outputs.push_back(output);
+            
+            return outputs;
+        }
+        
+        const std::vector<const Parameter*> LatencyProbe::setupParameters()
+        {
+            std::vector<const Parameter*> parameters;
+            
+            NumericParameter<UInt32>* windowSize = new NumericParameter<UInt32>(WINDOW_SIZE);
+            windowSize->setTitle("Window size");
+            windowSize->setMin(UInt32(1));
+            windowSize->setAccessMode(Parameter::ACTIVATED_WRITE);
+            parameters.push_back(windowSize);
+            
+            const unsigned int ids[] = { MEDIAN, PERCENTILE_90, PERCENTILE_99, MAXIMUM,
+                                         NUM_MEASUREMENTS, NUM_MISSING_METADATA };
+            const char* titles[] = { "Median latency", "90th percentile latency",
+                                     "99th percentile latency", "Maximal latency",
+                                     "Number of measurements", "Number of data without metadata" };
+            for(unsigned int i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+            {
+                Parameter* statistic = new Parameter(ids[i], Variant::UINT_64);
+                statistic->setTitle(titles[i]);
+                statistic->setAccessMode(Parameter::INITIALIZED_READ);
+                statistic->setUpdateBehavior(Parameter::PULL);
+                parameters.push_back(statistic);
+            }
+            
+            return parameters;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_LATENCYPROBE_H
+#define STROMX_RUNTIME_LATENCYPROBE_H
+
+#include <deque>
+#include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/Primitive.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /** 
+         * \brief Measures the latency of the data passing through the operator.
+         * 
+         * The operator forwards its input to its output. For each input 
+         * the time since the capture of the data is computed from the 
+         * timestamp in the metadata of the data container. The latency 
+         * percentiles of the last inputs are available as read-only parameters.
+         * All latencies are measured in microseconds.
+         * 
+         * \sa Metadata
+         */
+        class STROMX_RUNTIME_API LatencyProbe : public OperatorKernel
+        {
+        public:
+            enum DataId
+            {
+                INPUT,
+                OUTPUT,
+                WINDOW_SIZE,
+                MEDIAN,
+                PERCENTILE_90,
+                PERCENTILE_99,
+                MAXIMUM,
+                NUM_MEASUREMENTS,
+                NUM_MISSING_METADATA
+            };
+            
+            LatencyProbe();
+            
+            virtual OperatorKernel* clone() const { return new LatencyProbe; }
+            virtual void setParameter(const unsigned int id, const Data& value);
+            virtual const DataRef getParameter(const unsigned int id) const;
+            virtual void execute(DataProvider& provider);
+            virtual void activate();
+            
+        private:
+            static const std::vector<const Input*> setupInputs();
+            static const std::vector<const Output*> setupOutputs();
+            static const std::vector<const Parameter*> setupParameters();
+            
+            static const std::string TYPE;
+            static const std::string PACKAGE;
+            static const Version VERSION;
+            
+            uint64_t percentile(const unsigned int percent) const;
+            
+            UInt32 m_windowSize;
+            std::deque<uint64_t> m_latencies;
+            uint64_t m_numMeasurements;
+            uint64_t m_numMissingMetadata;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_LATENCYPROBE_H
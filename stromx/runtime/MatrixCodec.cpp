@@ -0,0 +1,260 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/MatrixCodec.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/LzCodec.h"
+
+namespace
+{
+    const char MAGIC[] = { 'S', 'X', 'M', 'C' };
+    const unsigned int MAGIC_SIZE = 4;
+    const uint8_t FORMAT_VERSION = 1;
+    
+    void write32(uint8_t* const data, const uint32_t value)
+    {
+        for(unsigned int i = 0; i < 4; ++i)
+            data[i] = uint8_t((value >> (8 * i)) & 0xff);
+    }
+    
+    void write64(uint8_t* const data, const uint64_t value)
+    {
+        for(unsigned int i = 0; i < 8; ++i)
+            data[i] = uint8_t((value >> (8 * i)) & 0xff);
+    }
+    
+    uint32_t read32(const uint8_t* const data)
+    {
+        uint32_t value = 0;
+        for(unsigned int i = 0; i < 4; ++i)
+            value |= uint32_t(data[i]) << (8 * i);
+        return value;
+    }
+    
+    uint64_t read64(const uint8_t* const data)
+    {
+        uint64_t value = 0;
+        for(unsigned int i = 0; i < 8; ++i)
+            value |= uint64_t(data[i]) << (8 * i);
+        return value;
+    }
+    
+    std::size_t rowSize(const stromx::runtime::Matrix & matrix)
+    {
+        return std::size_t(matrix.cols()) * matrix.valueSize();
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        const unsigned int MatrixCodec::HEADER_SIZE = 28;
+        
+        bool MatrixCodec::supports(const OutputProvider::Encoding encoding)
+        {
+            return encoding == OutputProvider::RAW || encoding == OutputProvider::FAST;
+        }
+        
+        const std::string MatrixCodec::extension(const OutputProvider::Encoding encoding)
+        {
+            return encoding == OutputProvider::FAST ? ".sxz" : ".sxm";
+        }
+        
+        void MatrixCodec::encode(const Matrix & matrix, const OutputProvider::Encoding encoding, std::ostream & out)
+        {
+            if(! supports(encoding))
+                throw WrongArgument("Unsupported matrix encoding.");
+            
+            const std::size_t size = rowSize(matrix) * matrix.rows();
+            
+            // pack the rows if they are padded
+            std::vector<uint8_t> packed;
+            const uint8_t* rows = matrix.data();
+            if(matrix.stride() != rowSize(matrix))
+            {
+                packed.resize(size);
+                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                    std::memcpy(&packed[0] + i * rowSize(matrix), matrix.data() + i * matrix.stride(), rowSize(matrix));
+                rows = &packed[0];
+            }
+            
+            const uint8_t* payload = rows;
+            std::size_t payloadSize = size;
+            std::vector<uint8_t> compressed;
+            if(encoding == OutputProvider::FAST && size > 0)
+            {
+                compressed.resize(impl::LzCodec::maxCompressedSize(size));
+                payloadSize = impl::LzCodec::compress(rows, size, &compressed[0]);
+                payload = &compressed[0];
+            }
+            
+            uint8_t header[HEADER_SIZE];
+            std::memcpy(header, MAGIC, MAGIC_SIZE);
+            header[4] = FORMAT_VERSION;
+            header[5] = uint8_t(encoding);
+            header[6] = 0;
+            header[7] = 0;
+            write32(header + 8, matrix.rows());
+            write32(header + 12, matrix.cols());
+            write32(header + 16, matrix.valueType());
+            write64(header + 20, payloadSize);
+            
+            out.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+            out.write(reinterpret_cast<const char*>(payload), payloadSize);
+            
+            if(out.fail())
+                throw Exception("Failed to write matrix.");
+        }
+        
+        bool MatrixCodec::isEncoded(std::istream & in)
+        {
+            const std::istream::pos_type position = in.tellg();
+            
+            char magic[MAGIC_SIZE];
+            in.read(magic, MAGIC_SIZE);
+            const bool result = in.gcount() == std::streamsize(MAGIC_SIZE) 
+                                && std::memcmp(magic, MAGIC, MAGIC_SIZE) == 0;
+            
+            in.clear();
+            in.seekg(position);
+            
+            return result;
+        }
+        
+        const MatrixCodec::Header MatrixCodec::readHeader(std::istream & in)
+        {
+            uint8_t data[HEADER_SIZE];
+            in.read(reinterpret_cast<char*>(data), HEADER_SIZE);
+            
+            if(in.gcount() != std::streamsize(HEADER_SIZE) || std::memcmp(data, MAGIC, MAGIC_SIZE) != 0)
+                throw Exception("Invalid matrix header.");
+            
+            if(data[4] > FORMAT_VERSION)
+                throw Exception("Unsupported matrix format version.");
+            
+            Header header;
+            header.encoding = OutputProvider::Encoding(data[5]);
+            header.rows = read32(data + 8);
+            header.cols = read32(data + 12);
+            header.valueType = Matrix::ValueType(read32(data + 16));
+            header.payloadSize = read64(data + 20);
+            
+            if(! supports(header.encoding) || header.valueType > Matrix::FLOAT_64)
+                throw Exception("Invalid matrix header.");
+            
+            validatePayloadSize(header);
+            
+            // the payload must be available before the matrix is allocated, 
+            // streams which can not seek are checked while they are decoded
+            const std::istream::pos_type start = in.tellg();
+            if(start != std::istream::pos_type(-1))
+            {
+                in.seekg(0, std::ios::end);
+                const std::istream::pos_type end = in.tellg();
+                in.seekg(start);
+                
+                if(end != std::istream::pos_type(-1) && uint64_t(end - start) < header.payloadSize)
+                    throw Exception("Truncated matrix data.");
+            }
+            
+            return header;
+        }
+        
+        void MatrixCodec::validatePayloadSize(const Header & header)
+        {
+            const uint64_t numValues = uint64_t(header.rows) * header.cols;
+            const unsigned int valueSize = Matrix::valueSize(header.valueType);
+            if(numValues > std::numeric_limits<std::size_t>::max() / valueSize)
+                throw Exception("Invalid size of the matrix data.");
+            
+            const std::size_t size = std::size_t(numValues) * valueSize;
+            if(header.encoding == OutputProvider::RAW)
+            {
+                if(header.payloadSize != size)
+                    throw Exception("Invalid size of the matrix data.");
+                
+                return;
+            }
+            
+            if(size == 0)
+                return;
+            
+            if(header.payloadSize < impl::LzCodec::minCompressedSize(size)
+               || header.payloadSize == 0 || header.payloadSize > impl::LzCodec::maxCompressedSize(size))
+            {
+                throw Exception("Invalid size of the matrix data.");
+            }
+        }
+        
+        void MatrixCodec::decode(std::istream & in, const Header & header, Matrix & matrix)
+        {
+            if(matrix.rows() != header.rows || matrix.cols() != header.cols 
+               || matrix.valueType() != header.valueType)
+            {
+                throw Exception("Matrix does not match the encoded data.");
+            }
+            
+            validatePayloadSize(header);
+            
+            const std::size_t size = rowSize(matrix) * matrix.rows();
+            const bool isPacked = matrix.stride() == rowSize(matrix);
+            
+            if(header.encoding == OutputProvider::RAW)
+            {
+                // read the rows directly to the matrix
+                if(isPacked)
+                {
+                    in.read(reinterpret_cast<char*>(matrix.data()), size);
+                }
+                else
+                {
+                    for(unsigned int i = 0; i < matrix.rows(); ++i)
+                        in.read(reinterpret_cast<char*>(matrix.data() + i * matrix.stride()), rowSize(matrix));
+                }
+                
+                if(in.fail())
+                    throw Exception("Truncated matrix data.");
+                
+                return;
+            }
+            
+            if(size == 0)
+                return;
+            
+            std::vector<uint8_t> payload(std::size_t(header.payloadSize));
+            in.read(reinterpret_cast<char*>(&payload[0]), payload.size());
+            if(in.fail())
+                throw Exception("Truncated matrix data.");
+            
+            // decompress directly to the matrix if its rows are not padded
+            if(isPacked)
+            {
+                impl::LzCodec::decompress(&payload[0], payload.size(), matrix.data(), size);
+                return;
+            }
+            
+            std::vector<uint8_t> packed(size);
+            impl::LzCodec::decompress(&payload[0], payload.size(), &packed[0], size);
+            for(unsigned int i = 0; i < matrix.rows(); ++i)
+                std::memcpy(matrix.data() + i * matrix.stride(), &packed[0] + i * rowSize(matrix), rowSize(matrix));
+        }
+    }
+}
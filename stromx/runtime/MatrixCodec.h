@@ -0,0 +1,104 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_MATRIXCODEC_H
+#define STROMX_RUNTIME_MATRIXCODEC_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include "stromx/runtime/Config.h"
+#include "stromx/runtime/Matrix.h"
+#include "stromx/runtime/OutputProvider.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /** 
+         * \brief Encodes the rows of matrices and images without or with fast compression.
+         * 
+         * The encoded data starts with a header of 28 bytes which contains 
+         * the magic bytes <tt>"SXMC"</tt>, the encoding, the dimensions and the value type
+         * of the matrix and the size of the payload. All integers are 
+         * encoded little-endian. The header is followed by the packed rows of
+         * the matrix, which are compressed if the encoding is OutputProvider::FAST.
+         */
+        class STROMX_RUNTIME_API MatrixCodec
+        {
+        public:
+            /** The header of encoded matrix data. */
+            struct Header
+            {
+                Header() : encoding(OutputProvider::RAW), rows(0), cols(0), valueType(Matrix::NONE), payloadSize(0) {}
+                
+                OutputProvider::Encoding encoding;
+                unsigned int rows;
+                unsigned int cols;
+                Matrix::ValueType valueType;
+                uint64_t payloadSize;
+            };
+            
+            /** 
+             * Returns true if \c encoding is supported by the codec, i.e. if it
+             * is OutputProvider::RAW or OutputProvider::FAST.
+             */
+            static bool supports(const OutputProvider::Encoding encoding);
+            
+            /** Returns the file extension of data in \c encoding including the leading dot. */
+            static const std::string extension(const OutputProvider::Encoding encoding);
+            
+            /** 
+             * Writes \c matrix to \c out.
+             * 
+             * \throws WrongArgument If the codec does not support \c encoding.
+             */
+            static void encode(const Matrix & matrix, const OutputProvider::Encoding encoding, std::ostream & out);
+            
+            /** 
+             * Returns true if \c in starts with encoded matrix data. The position
+             * of the stream is not changed.
+             */
+            static bool isEncoded(std::istream & in);
+            
+            /** 
+             * Reads the header of encoded matrix data from \c in. The header is 
+             * valid if the size of the matrix is consistent with the size of the
+             * payload and if \c in contains the complete payload, i.e. it is safe
+             * to allocate the matrix afterwards.
+             * 
+             * \throws Exception If \c in does not contain a valid header.
+             */
+            static const Header readHeader(std::istream & in);
+            
+            /** 
+             * Reads the payload described by \c header from \c in to \c matrix. 
+             * The dimensions and the value type of \c matrix must match the header.
+             * 
+             * \throws Exception If the matrix does not match the header or if the 
+             *                   payload is corrupt.
+             */
+            static void decode(std::istream & in, const Header & header, Matrix & matrix);
+            
+        private:
+            static void validatePayloadSize(const Header & header);
+            
+            static const unsigned int HEADER_SIZE;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_MATRIXCODEC_H
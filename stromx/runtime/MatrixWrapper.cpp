@@ -19,6 +19,7 @@
 #include <fstream>
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/InputProvider.h"
+#include "stromx/runtime/MatrixCodec.h"
 #include "stromx/runtime/MatrixWrapper.h"
 #include "stromx/runtime/OutputProvider.h"
 #include "stromx/runtime/Variant.h"
@@ -120,6 +121,15 @@ namespace stromx
         
         void MatrixWrapper::serialize(runtime::OutputProvider& output) const
         {
+            // matrices are stored as numpy files unless another encoding is requested
+            if(MatrixCodec::supports(output.encoding()))
+            {
+                std::ostream & outStream = output.openFile(MatrixCodec::extension(output.encoding()),
+                                                           runtime::OutputProvider::BINARY);
+                MatrixCodec::encode(*this, output.encoding(), outStream);
+                return;
+            }
+            
             // open the output file
             std::ostream & outStream = output.openFile(".npy", runtime::OutputProvider::BINARY);
             
@@ -132,6 +142,15 @@ namespace stromx
             // open the file
             input.openFile(runtime::InputProvider::BINARY);
             
+            // detect the encoding of the matrix
+            if(MatrixCodec::isEncoded(input.file()))
+            {
+                const MatrixCodec::Header header = MatrixCodec::readHeader(input.file());
+                allocate(header.rows, header.cols, header.valueType);
+                MatrixCodec::decode(input.file(), header, *this);
+                return;
+            }
+            
             // call the actual deserialization method
             doDeserialize(input.file(), *this);
         }
@@ -199,6 +218,19 @@ namespace stromx
             // get the value type and allocate the matrix
             std::string type = what[2];
             Matrix::ValueType valueType = valueTypeFromNpyHeader(type[0], wordSize);
+            
+            // make sure the data is available before the matrix is allocated
+            const uint64_t size = uint64_t(numRows) * uint64_t(numCols) * Matrix::valueSize(valueType);
+            const std::istream::pos_type start = in.tellg();
+            in.seekg(0, std::ios::end);
+            const std::istream::pos_type end = in.tellg();
+            in.seekg(start);
+            if(start == std::istream::pos_type(-1) || end == std::istream::pos_type(-1) 
+               || uint64_t(end - start) < size)
+            {
+                throw stromx::runtime::Exception("Truncated numpy data.");
+            }
+            
             matrix.allocate(numRows, numCols, valueType);
             
             // read data
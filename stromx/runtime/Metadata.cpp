@@ -0,0 +1,32 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/chrono.hpp>
+#include "stromx/runtime/Metadata.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        uint64_t Metadata::currentTime()
+        {
+            using namespace boost::chrono;
+            
+            // add 1 to make sure that a valid timestamp is never 0
+            return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() + 1;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_METADATA_H
+#define STROMX_RUNTIME_METADATA_H
+
+#include <stdint.h>
+#include "stromx/runtime/Config.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class OperatorInfo;
+        
+        /** 
+         * \brief Metadata of the data in a data container.
+         * 
+         * The metadata identifies a frame while it travels through a stream.
+         * It is stored in the data container and thus passed along with the
+         * container by all operators which forward their input containers.
+         * Timestamps are measured in microseconds by a monotonic clock.
+         * 
+         * \sa DataContainer::metadata()
+         */
+        class STROMX_RUNTIME_API Metadata
+        {
+        public:
+            /** Constructs invalid metadata, i.e. all members are set to 0. */
+            Metadata() : m_timestamp(0), m_sequenceNumber(0), m_origin(0) {}
+            
+            /** Constructs metadata from its members. */
+            Metadata(const uint64_t timestamp, const uint64_t sequenceNumber,
+                     const OperatorInfo* const origin = 0)
+              : m_timestamp(timestamp),
+                m_sequenceNumber(sequenceNumber),
+                m_origin(origin)
+            {}
+            
+            /** 
+             * Returns the current time of the clock which is used for
+             * timestamps in microseconds.
+             */
+            static uint64_t currentTime();
+            
+            /** Returns true if a timestamp has been set. */
+            bool isValid() const { return m_timestamp != 0; }
+            
+            /** Returns the time in microseconds when the frame was captured. */
+            uint64_t timestamp() const { return m_timestamp; }
+            
+            /** Returns the sequence number of the frame. */
+            uint64_t sequenceNumber() const { return m_sequenceNumber; }
+            
+            /** 
+             * Returns the operator which created the frame or null if it is 
+             * not known. The returned pointer serves as identification of
+             * the operator and might not be valid anymore if the operator
+             * has been destroyed.
+             */
+            const OperatorInfo* origin() const { return m_origin; }
+            
+            /** Sets the capture time. */
+            void setTimestamp(const uint64_t timestamp) { m_timestamp = timestamp; }
+            
+            /** Sets the sequence number. */
+            void setSequenceNumber(const uint64_t sequenceNumber) { m_sequenceNumber = sequenceNumber; }
+            
+            /** Sets the origin of the frame. */
+            void setOrigin(const OperatorInfo* const origin) { m_origin = origin; }
+            
+        private:
+            uint64_t m_timestamp;
+            uint64_t m_sequenceNumber;
+            const OperatorInfo* m_origin;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_METADATA_H
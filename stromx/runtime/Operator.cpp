@@ -166,6 +166,22 @@ namespace stromx
             m_kernel->clearOutputData(id);
         }
         
+        DataContainer Operator::process(const unsigned int inputId, const DataContainer & data,
+                                        const unsigned int outputId)
+        {
+            return m_kernel->process(inputId, data, outputId);
+        }
+        
+        bool Operator::hasOutputData(const unsigned int id) const
+        {
+            return m_kernel->hasOutputData(id);
+        }
+        
+        bool Operator::canSetInputData(const unsigned int id) const
+        {
+            return m_kernel->canSetInputData(id);
+        }
+        
         void Operator::initialize()
         {
             m_kernel->initialize(m_inputObserver, m_outputObserver);
@@ -376,6 +392,67 @@ namespace stromx
             return m_kernel->factoryPtr();
         }
         
+        bool Operator::statisticsEnabled() const
+        {
+            return m_kernel->statisticsEnabled();
+        }
+        
+        void Operator::setStatisticsEnabled(const bool enabled)
+        {
+            m_kernel->setStatisticsEnabled(enabled);
+        }
+        
+        OperatorStatistics Operator::statistics() const
+        {
+            return m_kernel->statistics();
+        }
+        
+        void Operator::resetStatistics()
+        {
+            m_kernel->resetStatistics();
+        }
+        
+        unsigned int Operator::numReplicas() const
+        {
+            return m_kernel->numReplicas();
+        }
+        
+        Operator::Dispatch Operator::dispatch() const
+        {
+            switch(m_kernel->dispatch())
+            {
+            case impl::ReplicaPool::LEAST_LOADED:
+                return LEAST_LOADED;
+            default:
+                return ROUND_ROBIN;
+            }
+        }
+        
+        void Operator::setReplication(const unsigned int numReplicas, const Dispatch dispatch)
+        {
+            switch(dispatch)
+            {
+            case ROUND_ROBIN:
+                m_kernel->setReplication(numReplicas, impl::ReplicaPool::ROUND_ROBIN);
+                break;
+            case LEAST_LOADED:
+                m_kernel->setReplication(numReplicas, impl::ReplicaPool::LEAST_LOADED);
+                break;
+            default:
+                throw WrongArgument("Unknown dispatch strategy.");
+            }
+        }
+        
+        Input::OverflowPolicy Operator::overflowPolicy(const unsigned int id) const
+        {
+            return m_kernel->overflowPolicy(id);
+        }
+        
+        void Operator::setOverflowPolicy(const unsigned int id, const Input::OverflowPolicy policy)
+        {
+            m_kernel->setOverflowPolicy(id, policy);
+        }
+        
         void Operator::setConnectorType(const unsigned int id, const Description::Type type,
                                         const Parameter::UpdateBehavior behavior)
         {
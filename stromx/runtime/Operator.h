@@ -24,7 +24,9 @@
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/DataRef.h"
 #include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Input.h"
 #include "stromx/runtime/OperatorInfo.h"
+#include "stromx/runtime/OperatorStatistics.h"
 #include "stromx/runtime/Position.h"
 
 namespace stromx
@@ -38,6 +40,7 @@ namespace stromx
         
         namespace impl
         {
+            class FusedChain;
             class InputNode;
             class Network;
             class MutexHandle;
@@ -60,15 +63,19 @@ namespace stromx
         class STROMX_RUNTIME_API Operator
         {
             friend class FactoryTest;
+            friend class FusedChainTest;
             friend class OperatorTest;
             friend class InputNodeTest;
             friend class NetworkTest;
             friend class OperatorTester;
             friend class OutputNodeTest;
             friend class ThreadImplTest;
+            friend class WorkerPoolTest;
             friend class SendReceiveTest;
             friend class Stream;
             friend class Thread;
+            friend class impl::FusedChain;
+            friend class impl::InputNode;
             friend class impl::Network;
             
         public:
@@ -85,6 +92,15 @@ namespace stromx
                 EXECUTING
             };
             
+            /** The strategies to distribute the input data among the replicas of an operator. */
+            enum Dispatch
+            {
+                /** The replicas receive the input data in turns. */
+                ROUND_ROBIN,
+                /** The replica with the fewest queued input data receives the next input. */
+                LEAST_LOADED
+            };
+            
             /** 
              * Constructs an operator from an operator kernel.
              * 
@@ -247,6 +263,71 @@ namespace stromx
              */
             void setFactory(const AbstractFactory* const factory);
             
+            /**
+             * Returns whether the operator collects execution statistics. This is
+             * disabled by default.
+             */
+            bool statisticsEnabled() const;
+            
+            /**
+             * Enables or disables the collection of execution statistics. Collected
+             * statistics are kept if the collection is disabled. 
+             */
+            void setStatisticsEnabled(const bool enabled);
+            
+            /** 
+             * Returns a snapshot of the execution statistics of the operator. The
+             * function can be called at any time, also while the operator is executed.
+             */
+            OperatorStatistics statistics() const;
+            
+            /** Resets all execution statistics. */
+            void resetStatistics();
+            
+            /** Returns the number of replicas which execute the operator. */
+            unsigned int numReplicas() const;
+            
+            /** Returns how the input data is distributed among the replicas. */
+            Dispatch dispatch() const;
+            
+            /**
+             * Executes the operator on \c numReplicas clones of its kernel. Each clone
+             * is executed by a dedicated thread and receives input data according to
+             * \c dispatch. The output data is emitted in the order the input data
+             * has been received. Pass 1 to execute the kernel itself as usual.
+             * 
+             * Only kernels which do not keep state between executions, receive each
+             * input and send each output once per execution and do not replace 
+             * connectors by data channels can be replicated. Parameters which are
+             * set while the operator is active are passed to all clones before 
+             * their next execution.
+             * 
+             * \throws WrongState If the operator is active or executing.
+             * \throws WrongArgument If \c numReplicas is 0.
+             */
+            void setReplication(const unsigned int numReplicas, const Dispatch dispatch = ROUND_ROBIN);
+            
+            /** 
+             * Returns the overflow policy of the input \c id.
+             * 
+             * \throws WrongId If the operator has no input \c id.
+             */
+            Input::OverflowPolicy overflowPolicy(const unsigned int id) const;
+            
+            /**
+             * Sets the overflow policy of the input \c id. This overrides the default
+             * policy of the input description and defines what happens if data is 
+             * passed to the input while it is still occupied. The policy can be changed
+             * at any time after the operator has been initialized. The number of 
+             * dropped data objects is reported by the operator statistics. Inputs which
+             * are replaced by a data channel always block.
+             * 
+             * \throws WrongId If the operator has no input \c id.
+             * \throws WrongArgument If \c policy drops data and the input is replaced by
+             *                       a data channel.
+             */
+            void setOverflowPolicy(const unsigned int id, const Input::OverflowPolicy policy);
+            
         private:
             class InternalObserver;
             
@@ -258,6 +339,10 @@ namespace stromx
                                   const Parameter::UpdateBehavior behavior);
             impl::InputNode* getInputNode(const unsigned int id) const;
             impl::OutputNode* getOutputNode(const unsigned int id) const;
+            bool hasOutputData(const unsigned int id) const;
+            bool canSetInputData(const unsigned int id) const;
+            DataContainer process(const unsigned int inputId, const DataContainer & data,
+                                  const unsigned int outputId);
             void activate();
             void deactivate();
             void interrupt();
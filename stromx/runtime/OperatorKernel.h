@@ -27,11 +27,13 @@ namespace stromx
 {
     namespace runtime
     {
+        class DataChannel;
         class DataContainer;
         class DataProvider;
         
         namespace impl
         {
+            class ReplicaPool;
             class SynchronizedOperatorKernel;
         }
         
@@ -45,6 +47,7 @@ namespace stromx
          */
         class STROMX_RUNTIME_API OperatorKernel : public OperatorInfo
         {
+            friend class impl::ReplicaPool;
             friend class impl::SynchronizedOperatorKernel;
             friend class OperatorKernelTest;
             
@@ -124,6 +127,26 @@ namespace stromx
              */
             virtual void interrupt() {}
             
+            /**
+             * Returns the data channel which replaces the input or output \c id
+             * or null if the data of this connector is processed by execute().
+             * The function is called after the operator has been activated. The
+             * returned channel is used until the operator is deactivated and
+             * must remain valid until then.
+             * 
+             * \sa DataChannel
+             */
+            virtual DataChannel* channel(const unsigned int) { return 0; }
+            
+            /**
+             * Returns true if channel() will return a data channel for the input or 
+             * output \c id once the operator has been activated. In contrast to 
+             * channel() this function is called while the operator is inactive.
+             * 
+             * \sa channel()
+             */
+            virtual bool usesChannel(const unsigned int) const { return false; }
+            
         protected:
             /**
              * Constructs an operator kernel.
@@ -0,0 +1,77 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/OperatorStatistics.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        const unsigned int OperatorStatistics::NUM_BUCKETS;
+        
+        OperatorStatistics::OperatorStatistics()
+          : m_numExecutions(0),
+            m_numErrors(0),
+            m_executionTime(0),
+            m_receiveTime(0),
+            m_sendTime(0),
+            m_numDroppedData(0),
+            m_histogram(NUM_BUCKETS, 0)
+        {
+        }
+        
+        uint64_t OperatorStatistics::bucketLowerBound(const unsigned int bucket)
+        {
+            if(bucket >= NUM_BUCKETS)
+                throw WrongArgument("Bucket index is out of range.");
+            
+            // the buckets grow by powers of 2 starting with [0, 2) 
+            return bucket == 0 ? 0 : uint64_t(1) << bucket;
+        }
+        
+        unsigned int OperatorStatistics::bucket(const uint64_t duration)
+        {
+            unsigned int bucket = 0;
+            for(uint64_t value = duration >> 1; value && bucket < NUM_BUCKETS - 1; value >>= 1)
+                ++bucket;
+            
+            return bucket;
+        }
+        
+        void OperatorStatistics::addExecution(const uint64_t duration, const bool failed)
+        {
+            ++m_numExecutions;
+            if(failed)
+                ++m_numErrors;
+            
+            m_executionTime += duration;
+            ++m_histogram[bucket(duration)];
+        }
+        
+        uint64_t OperatorStatistics::numDroppedData(const unsigned int id) const
+        {
+            std::map<unsigned int, uint64_t>::const_iterator iter = m_droppedData.find(id);
+            return iter != m_droppedData.end() ? iter->second : 0;
+        }
+        
+        void OperatorStatistics::addDroppedData(const unsigned int id)
+        {
+            ++m_numDroppedData;
+            ++m_droppedData[id];
+        }
+    }
+}
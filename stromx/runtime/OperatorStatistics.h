@@ -0,0 +1,117 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_OPERATORSTATISTICS_H
+#define STROMX_RUNTIME_OPERATORSTATISTICS_H
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+#include "stromx/runtime/Config.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            class SynchronizedOperatorKernel;
+        }
+        
+        /** 
+         * \brief Execution statistics of an operator.
+         * 
+         * The statistics are collected while the operator is active if this 
+         * has been enabled by Operator::setStatisticsEnabled(). All times are 
+         * measured in microseconds. Data which passes a data channel (see 
+         * OperatorKernel::channel()) is not executed, in this case only the 
+         * time spent waiting for the channel is counted as receive and send time.
+         */
+        class STROMX_RUNTIME_API OperatorStatistics
+        {
+            friend class impl::SynchronizedOperatorKernel;
+            
+        public:
+            /** The number of buckets of the latency histogram. */
+            static const unsigned int NUM_BUCKETS = 32;
+            
+            /** Constructs empty statistics. */
+            OperatorStatistics();
+            
+            /** Returns the number of executions of the operator including the failed ones. */
+            uint64_t numExecutions() const { return m_numExecutions; }
+            
+            /** Returns the number of executions which ended with an error. */
+            uint64_t numErrors() const { return m_numErrors; }
+            
+            /** 
+             * Returns the total wall time spent in OperatorKernel::execute(). This
+             * includes the time the operator was blocked while receiving and sending
+             * data.
+             */
+            uint64_t executionTime() const { return m_executionTime; }
+            
+            /** Returns the total time the operator waited for input data. */
+            uint64_t receiveTime() const { return m_receiveTime; }
+            
+            /** Returns the total time the operator waited until it could send output data. */
+            uint64_t sendTime() const { return m_sendTime; }
+            
+            /** 
+             * Returns the number of data objects which have been dropped at the inputs
+             * of the operator because of their overflow policies. Dropped data is 
+             * counted even if the collection of statistics is disabled.
+             * 
+             * \sa Input::OverflowPolicy
+             */
+            uint64_t numDroppedData() const { return m_numDroppedData; }
+            
+            /** Returns the number of data objects which have been dropped at the input \c id. */
+            uint64_t numDroppedData(const unsigned int id) const;
+            
+            /**
+             * Returns the latency histogram of the executions. The bucket \c i counts
+             * the executions which took at least bucketLowerBound(\c i) and less than
+             * bucketLowerBound(\c i + 1) microseconds. The last bucket counts all
+             * executions which took longer.
+             */
+            const std::vector<uint64_t> & histogram() const { return m_histogram; }
+            
+            /** Returns the smallest execution time in microseconds counted by \c bucket. */
+            static uint64_t bucketLowerBound(const unsigned int bucket);
+            
+            /** Returns the index of the histogram bucket which counts \c duration. */
+            static unsigned int bucket(const uint64_t duration);
+            
+        private:
+            void addExecution(const uint64_t duration, const bool failed);
+            void addReceiveTime(const uint64_t duration) { m_receiveTime += duration; }
+            void addSendTime(const uint64_t duration) { m_sendTime += duration; }
+            void addDroppedData(const unsigned int id);
+            
+            uint64_t m_numExecutions;
+            uint64_t m_numErrors;
+            uint64_t m_executionTime;
+            uint64_t m_receiveTime;
+            uint64_t m_sendTime;
+            uint64_t m_numDroppedData;
+            std::vector<uint64_t> m_histogram;
+            std::map<unsigned int, uint64_t> m_droppedData;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_OPERATORSTATISTICS_H
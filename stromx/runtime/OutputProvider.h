@@ -36,6 +36,19 @@ namespace stromx
                 TEXT 
             };
             
+            /** The possible encodings of the file representation of images and matrices. */
+            enum Encoding
+            {
+                /** The default encoding of the data type, e.g. PNG for OpenCV images. */
+                DEFAULT,
+                /** The uncompressed rows of the data preceded by a small header. */
+                RAW,
+                /** The rows of the data compressed by a fast LZ codec. */
+                FAST,
+                /** PNG compression. Data types which do not support PNG use their default encoding. */
+                PNG
+            };
+            
             /** 
              * Returns an output stream which accepts the text representation of the data.
              * \throws WrongState If the input provider has not been correctly initialized.
@@ -56,6 +69,14 @@ namespace stromx
              *                    or if openFile() has not been called before calling this function.
              */
             virtual std::ostream & file() = 0;
+            
+            /** 
+             * Returns the encoding which images and matrices should use for 
+             * their file representation. Data types which do not support the
+             * encoding use their default encoding. Deserializing the data
+             * detects the encoding automatically.
+             */
+            virtual Encoding encoding() const { return DEFAULT; }
         };
     }
 }
@@ -24,6 +24,7 @@
 #endif
 
 #include "stromx/runtime/Data.h"
+#include "stromx/runtime/SmallObjectAllocator.h"
 #include "stromx/runtime/Version.h"
 
 namespace stromx
@@ -69,6 +70,12 @@ namespace stromx
                 return *this;
             }
             
+            /** Allocates the memory of a primitive by the small object allocator. */
+            static void* operator new(const std::size_t size) { return SmallObjectAllocator::allocate(size); }
+            
+            /** Releases the memory of a primitive to the small object allocator. */
+            static void operator delete(void* const ptr, const std::size_t size) { SmallObjectAllocator::deallocate(ptr, size); }
+            
             /** The minimal value which can be stored by this primitive. */
             static const Primitive MIN;
             
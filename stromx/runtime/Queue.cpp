@@ -14,8 +14,11 @@
 *  limitations under the License.
 */
 
+#include <boost/assert.hpp>
+#include "stromx/runtime/DataChannel.h"
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/EnumParameter.h"
 #include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/NumericParameter.h"
 #include "stromx/runtime/OperatorException.h"
@@ -23,6 +26,7 @@
 #include "stromx/runtime/Queue.h"
 #include "stromx/runtime/Try.h"
 #include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/SpscRing.h"
 
 namespace 
 {
@@ -34,6 +38,29 @@ namespace stromx
 {
     namespace runtime
     {
+        /** \cond */
+        class Queue::RingChannel : public DataChannel
+        {
+        public:
+            explicit RingChannel(const unsigned int capacity) : m_ring(capacity) {}
+            
+            virtual bool tryPush(const DataContainer & data) { return m_ring.tryPush(data); }
+            
+            virtual DataContainer front()
+            {
+                DataContainer* data = m_ring.front();
+                return data ? *data : DataContainer();
+            }
+            
+            virtual bool pop() { return m_ring.pop(); }
+            virtual bool isEmpty() const { return m_ring.empty(); }
+            virtual bool isFull() const { return m_ring.full(); }
+            
+        private:
+            impl::SpscRing<DataContainer> m_ring;
+        };
+        /** \endcond */
+        
         const std::string Queue::TYPE("Queue");
         
         const std::string Queue::PACKAGE(STROMX_RUNTIME_PACKAGE_NAME);
@@ -41,8 +68,15 @@ namespace stromx
         
         Queue::Queue()
         : OperatorKernel(TYPE, PACKAGE, VERSION, setupInputs(), setupOutputs(), setupParameters()),
-            m_size(1)
+            m_size(1),
+            m_mode(DEQUE),
+            m_ring(0)
+        {
+        }
+        
+        Queue::~Queue()
         {
+            delete m_ring;
         }
 
         void Queue::setParameter(unsigned int id, const Data& value)
@@ -57,6 +91,15 @@ namespace stromx
                     
                     m_size = data_cast<UInt32>(value);
                     break;
+                case MODE:
+                {
+                    Enum mode = data_cast<Enum>(value);
+                    if(int(mode) != DEQUE && int(mode) != RING)
+                        throw WrongParameterValue(parameter(MODE), *this);
+                    
+                    m_mode = mode;
+                    break;
+                }
                 default:
                     throw WrongParameterId(id, *this);
                 }
@@ -73,14 +116,40 @@ namespace stromx
             {
             case SIZE:
                 return m_size;
+            case MODE:
+                return m_mode;
             default:
                 throw WrongParameterId(id, *this);
             }
         }  
         
+        void Queue::activate()
+        {
+            BOOST_ASSERT(! m_ring);
+            
+            if(int(m_mode) == RING)
+                m_ring = new RingChannel(m_size);
+        }
+        
         void Queue::deactivate()
         {
             m_deque.clear();
+            
+            delete m_ring;
+            m_ring = 0;
+        }
+        
+        DataChannel* Queue::channel(const unsigned int id)
+        {
+            if(id == INPUT || id == OUTPUT)
+                return m_ring;
+            
+            return 0;
+        }
+        
+        bool Queue::usesChannel(const unsigned int id) const
+        {
+            return int(m_mode) == RING && (id == INPUT || id == OUTPUT);
         }
         
         void Queue::execute(DataProvider& provider)
@@ -163,6 +232,13 @@ namespace stromx
             size->setMin(UInt32(1));
             size->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
             parameters.push_back(size);
+            
+            EnumParameter* mode = new EnumParameter(MODE);
+            mode->setTitle("Mode");
+            mode->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            mode->add(EnumDescription(Enum(DEQUE), "Deque"));
+            mode->add(EnumDescription(Enum(RING), "Lock-free ring"));
+            parameters.push_back(mode);
                                         
             return parameters;
         }
@@ -20,6 +20,7 @@
 #include <deque>
 #include "stromx/runtime/Config.h"
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Enum.h"
 #include "stromx/runtime/OperatorKernel.h"
 #include "stromx/runtime/Primitive.h"
 
@@ -27,7 +28,15 @@ namespace stromx
 {
     namespace runtime
     {
-        /** \brief A data queue of configurable length. */
+        /** 
+         * \brief A data queue of configurable length. 
+         * 
+         * In the mode RING the data is stored in a lock-free ring buffer which
+         * is directly accessed by the thread which sets the input and the thread 
+         * which reads the output. The operator is never executed in this mode. 
+         * Exactly one thread must set the input and exactly one thread must read
+         * the output.
+         */
         class STROMX_RUNTIME_API Queue : public OperatorKernel
         {
         public:
@@ -35,18 +44,33 @@ namespace stromx
             {
                 INPUT,
                 OUTPUT,
-                SIZE
+                SIZE,
+                MODE
+            };
+            
+            enum QueueMode
+            {
+                /** The data is passed through the execution of the operator. */
+                DEQUE,
+                /** The data is passed through a lock-free ring buffer. */
+                RING
             };
             
             Queue();
+            virtual ~Queue();
             
             virtual OperatorKernel* clone() const { return new Queue; }
             virtual void setParameter(const unsigned int id, const runtime::Data& value);
             virtual const DataRef getParameter(const unsigned int id) const;
+            virtual void activate();
             virtual void deactivate();
             virtual void execute(runtime::DataProvider& provider);
+            virtual DataChannel* channel(const unsigned int id);
+            virtual bool usesChannel(const unsigned int id) const;
             
         private:
+            class RingChannel;
+            
             static const std::vector<const runtime::Input*> setupInputs();
             static const std::vector<const runtime::Output*> setupOutputs();
             static const std::vector<const runtime::Parameter*> setupParameters();
@@ -56,8 +80,10 @@ namespace stromx
             static const runtime::Version VERSION;                       
             
             runtime::UInt32 m_size;
+            runtime::Enum m_mode;
             
             std::deque<runtime::DataContainer> m_deque;
+            RingChannel* m_ring;
         };
     }
 }
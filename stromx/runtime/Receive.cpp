@@ -125,17 +125,14 @@ namespace stromx
         void Receive::execute(DataProvider& provider)
         {
             DataContainer data;
-            try
-            {
-                data = m_client->receive(provider.factory());
-            }
-            catch(impl::Client::NoConnection&)
+            switch(m_client->tryReceive(provider.factory(), data))
             {
+            case impl::Client::NO_CONNECTION:
                 throw OperatorError(*this, "Lost the connection to send operator.");
-            }
-            catch(impl::Client::Stopped&)
-            {
+            case impl::Client::STOPPED:
                 return;
+            default:
+                break;
             }
             
             Id2DataPair outputMapper(OUTPUT, data);
@@ -0,0 +1,231 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/Record.h"
+
+#include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/EnumParameter.h"
+#include "stromx/runtime/Id2DataPair.h"
+#include "stromx/runtime/Metadata.h"
+#include "stromx/runtime/NumericParameter.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/OutputProvider.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/RecordWriter.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        const std::string Record::TYPE("Record");
+        const std::string Record::PACKAGE(STROMX_RUNTIME_PACKAGE_NAME);
+        const Version Record::VERSION(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
+        
+        Record::Record()
+          : OperatorKernel(TYPE, PACKAGE, VERSION, setupInputs(), setupOutputs(), setupParameters(), setupProperties()),
+            m_path("record"),
+            m_segmentSize(64 * 1024 * 1024),
+            m_queueSize(16),
+            m_encoding(OutputProvider::DEFAULT),
+            m_writer(0),
+            m_recordedFrames(0),
+            m_recordedBytes(0),
+            m_droppedFrames(0)
+        {
+        }
+        
+        Record::~Record()
+        {
+            delete m_writer;
+        }
+        
+        void Record::setParameter(unsigned int id, const Data& value)
+        {
+            try
+            {
+                switch(id)
+                {
+                case PATH:
+                    if(data_cast<String>(value).get().empty())
+                        throw WrongParameterValue(parameter(PATH), *this, "The path must not be empty.");
+                    m_path = data_cast<String>(value);
+                    break;
+                case SEGMENT_SIZE:
+                    if(data_cast<UInt32>(value) < 1024)
+                        throw WrongParameterValue(parameter(SEGMENT_SIZE), *this, "Too small segment size.");
+                    m_segmentSize = data_cast<UInt32>(value);
+                    break;
+                case QUEUE_SIZE:
+                    if(data_cast<UInt32>(value) < 1)
+                        throw WrongParameterValue(parameter(QUEUE_SIZE), *this, "Too small queue size.");
+                    m_queueSize = data_cast<UInt32>(value);
+                    break;
+                case ENCODING:
+                    m_encoding = data_cast<Enum>(value);
+                    break;
+                default:
+                    throw WrongParameterId(id, *this);
+                }
+            }
+            catch(std::bad_cast&)
+            {
+                throw WrongParameterValue(parameter(id), *this);
+            }
+        }
+        
+        const DataRef Record::getParameter(const unsigned int id) const
+        {
+            switch(id)
+            {
+            case PATH:
+                return m_path;
+            case SEGMENT_SIZE:
+                return m_segmentSize;
+            case QUEUE_SIZE:
+                return m_queueSize;
+            case ENCODING:
+                return m_encoding;
+            case RECORDED_FRAMES:
+                return UInt64(statistics().recordedFrames);
+            case RECORDED_BYTES:
+                return UInt64(statistics().recordedBytes);
+            case DROPPED_FRAMES:
+                return UInt64(statistics().droppedFrames);
+            default:
+                throw WrongParameterId(id, *this);
+            }
+        }
+        
+        void Record::activate()
+        {
+            try
+            {
+                m_writer = new impl::RecordWriter(m_path, m_segmentSize, m_queueSize,
+                                                  OutputProvider::Encoding(int(m_encoding)));
+            }
+            catch(std::exception&)
+            {
+                throw OperatorError(*this, "Failed to open record log.");
+            }
+            
+            m_recordedFrames = 0;
+            m_recordedBytes = 0;
+            m_droppedFrames = 0;
+        }
+        
+        void Record::deactivate()
+        {
+            // the statistics of the last recording remain available
+            m_writer->stop();
+            const impl::RecordStatistics statistics = m_writer->statistics();
+            m_recordedFrames = statistics.recordedFrames;
+            m_recordedBytes = statistics.recordedBytes;
+            m_droppedFrames = statistics.droppedFrames;
+            
+            delete m_writer;
+            m_writer = 0;
+        }
+        
+        void Record::execute(DataProvider& provider)
+        {
+            Id2DataPair inputMapper(INPUT);
+            provider.receiveInputData(inputMapper);
+            
+            m_writer->write(inputMapper.data(), Metadata::currentTime());
+        }
+        
+        const impl::RecordStatistics Record::statistics() const
+        {
+            if(m_writer)
+                return m_writer->statistics();
+            
+            impl::RecordStatistics statistics;
+            statistics.recordedFrames = m_recordedFrames;
+            statistics.recordedBytes = m_recordedBytes;
+            statistics.droppedFrames = m_droppedFrames;
+            return statistics;
+        }
+        
+        const std::vector<const Input*> Record::setupInputs()
+        {
+            std::vector<const Input*> inputs;
+            
+            Input* input = new Input(INPUT, Variant::DATA);
+            input->setTitle("Input");
+            inputs.push_back(input);
+            
+            return inputs;
+        }
+        
+        const std::vector<const Output*> Record::setupOutputs()
+        {
+            std::vector<const Output*> outputs;
+            return outputs;
+        }
+        
+        const std::vector<const Parameter*> Record::setupParameters()
+        {
+            std::vector<const Parameter*> parameters;
+            
+            Parameter* path = new Parameter(PATH, Variant::STRING);
+            path->setTitle("Path of the log");
+            path->setAccessMode(Parameter::INITIALIZED_WRITE);
+            parameters.push_back(path);
+            
+            NumericParameter<UInt32>* segmentSize = new NumericParameter<UInt32>(SEGMENT_SIZE);
+            segmentSize->setTitle("Size of a log segment in bytes");
+            segmentSize->setAccessMode(Parameter::INITIALIZED_WRITE);
+            segmentSize->setMin(UInt32(1024));
+            parameters.push_back(segmentSize);
+            
+            NumericParameter<UInt32>* queueSize = new NumericParameter<UInt32>(QUEUE_SIZE);
+            queueSize->setTitle("Queue size");
+            queueSize->setAccessMode(Parameter::INITIALIZED_WRITE);
+            queueSize->setMin(UInt32(1));
+            parameters.push_back(queueSize);
+            
+            EnumParameter* encoding = new EnumParameter(ENCODING);
+            encoding->setTitle("Encoding of images and matrices");
+            encoding->setAccessMode(Parameter::INITIALIZED_WRITE);
+            encoding->add(EnumDescription(Enum(OutputProvider::DEFAULT), "Default"));
+            encoding->add(EnumDescription(Enum(OutputProvider::RAW), "Raw"));
+            encoding->add(EnumDescription(Enum(OutputProvider::FAST), "Fast compression"));
+            encoding->add(EnumDescription(Enum(OutputProvider::PNG), "PNG"));
+            parameters.push_back(encoding);
+            
+            const unsigned int ids[] = { RECORDED_FRAMES, RECORDED_BYTES, DROPPED_FRAMES };
+            const char* titles[] = { "Recorded frames", "Recorded bytes", "Dropped frames" };
+            for(unsigned int i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+            {
+                Parameter* statistic = new Parameter(ids[i], Variant::UINT_64);
+                statistic->setTitle(titles[i]);
+                statistic->setAccessMode(Parameter::INITIALIZED_READ);
+                statistic->setUpdateBehavior(Parameter::PULL);
+                parameters.push_back(statistic);
+            }
+            
+            return parameters;
+        }
+        
+        const OperatorProperties Record::setupProperties()
+        {
+            OperatorProperties properties;
+            properties.isGreedy = true;
+            return properties;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_RECORD_H
+#define STROMX_RUNTIME_RECORD_H
+
+#include "stromx/runtime/Enum.h"
+#include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/String.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            class RecordWriter;
+            struct RecordStatistics;
+        }
+        
+        /** 
+         * \brief Appends its input to a log file.
+         * 
+         * The operator records each input in an append-only log which is split 
+         * into memory-mapped segments of the given size. Each entry of the log
+         * contains the time of the arrival of the data at the operator, the 
+         * serialization header of the data and its payload. The entries are 
+         * written by a background thread. If the queue of this thread is full 
+         * the incoming data is dropped and counted.
+         * 
+         * \sa impl::RecordLog
+         */
+        class STROMX_RUNTIME_API Record : public OperatorKernel
+        {
+        public:
+            enum DataId
+            {
+                INPUT,
+                PATH,
+                SEGMENT_SIZE,
+                QUEUE_SIZE,
+                ENCODING,
+                RECORDED_FRAMES,
+                RECORDED_BYTES,
+                DROPPED_FRAMES
+            };
+            
+            Record();
+            virtual ~Record();
+            
+            virtual OperatorKernel* clone() const { return new Record; }
+            virtual void setParameter(const unsigned int id, const Data& value);
+            virtual const DataRef getParameter(const unsigned int id) const;
+            virtual void activate();
+            virtual void deactivate();
+            virtual void execute(DataProvider& provider);
+            
+        private:
+            static const std::vector<const Input*> setupInputs();
+            static const std::vector<const Output*> setupOutputs();
+            static const std::vector<const Parameter*> setupParameters();
+            static const OperatorProperties setupProperties();
+            
+            static const std::string TYPE;
+            static const std::string PACKAGE;
+            static const Version VERSION;
+            
+            const impl::RecordStatistics statistics() const;
+            
+            String m_path;
+            UInt32 m_segmentSize;
+            UInt32 m_queueSize;
+            Enum m_encoding;
+            
+            impl::RecordWriter* m_writer;
+            
+            // the statistics of the last recording
+            uint64_t m_recordedFrames;
+            uint64_t m_recordedBytes;
+            uint64_t m_droppedFrames;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_RECORD_H
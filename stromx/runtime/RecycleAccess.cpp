@@ -51,6 +51,14 @@ namespace stromx
             return m_impl->get(true, timeout);
         }
         
+        Data* RecycleAccess::tryGet() const
+        {
+            if(! m_impl.get())
+                return 0;
+            
+            return m_impl->tryGet();
+        }
+        
         void RecycleAccess::add(const DataContainer & data)
         {
             if(! m_impl.get())
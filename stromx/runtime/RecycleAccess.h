@@ -110,6 +110,14 @@ namespace stromx
              */
             Data* get(const unsigned int timeout) const;
             
+            /**
+             * Returns data which has been added to the recycle access and is
+             * ready to be recycled, i.e. no other objects reference it. In contrast
+             * to get() this function does not wait. It returns 0 if no data is
+             * ready to be recycled at the moment.
+             */
+            Data* tryGet() const;
+            
             /** Releases the write access. The access is empty after calling this function. */
             void release() { m_impl.reset(); }
             
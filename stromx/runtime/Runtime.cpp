@@ -19,6 +19,7 @@
 #include "stromx/runtime/Compare.h"
 #include "stromx/runtime/ConstData.h"
 #include "stromx/runtime/Counter.h"
+#include "stromx/runtime/DataBuffer.h"
 #include "stromx/runtime/Dump.h"
 #include "stromx/runtime/Enum.h"
 #include "stromx/runtime/Exception.h"
@@ -29,6 +30,7 @@
 #include "stromx/runtime/IsEmpty.h"
 #include "stromx/runtime/IsNotEmpty.h"
 #include "stromx/runtime/Join.h"
+#include "stromx/runtime/LatencyProbe.h"
 #include "stromx/runtime/List.h"
 #include "stromx/runtime/Locale.h"
 #include "stromx/runtime/None.h"
@@ -39,6 +41,7 @@
 #include "stromx/runtime/Queue.h"
 #include "stromx/runtime/Runtime.h"
 #include "stromx/runtime/Receive.h"
+#include "stromx/runtime/Record.h"
 #include "stromx/runtime/Registry.h"
 #include "stromx/runtime/Repeat.h"
 #include "stromx/runtime/Send.h"
@@ -82,6 +85,7 @@ int stromxRegisterRuntime(stromx::runtime::Registry* registry)
         registry->registerOperator(new Compare);
         registry->registerOperator(new ConstData);
         registry->registerOperator(new Counter);
+        registry->registerOperator(new DataBuffer);
         registry->registerOperator(new Dump);
         registry->registerOperator(new Filter);
         registry->registerOperator(new Fork);
@@ -89,11 +93,13 @@ int stromxRegisterRuntime(stromx::runtime::Registry* registry)
         registry->registerOperator(new IsEmpty);
         registry->registerOperator(new IsNotEmpty);
         registry->registerOperator(new Join);
+        registry->registerOperator(new LatencyProbe);
         registry->registerOperator(new Merge);
         registry->registerOperator(new PeriodicDelay);
         registry->registerOperator(new Push);
         registry->registerOperator(new Queue);
         registry->registerOperator(new Receive);
+        registry->registerOperator(new Record);
         registry->registerOperator(new Repeat);
         registry->registerOperator(new Send);
         
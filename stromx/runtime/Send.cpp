@@ -16,8 +16,12 @@
 
 #include "stromx/runtime/Send.h"
 
+#include <sstream>
+#include <boost/atomic.hpp>
 #include "stromx/runtime/impl/Server.h"
+#include "stromx/runtime/impl/SharedMemoryRing.h"
 #include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/EnumParameter.h"
 #include "stromx/runtime/Id2DataComposite.h"
 #include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/NumericParameter.h"
@@ -26,6 +30,26 @@
 #include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/Variant.h"
 
+#ifdef WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    boost::atomic<unsigned int> gNumSharedMemories(0);
+    
+    unsigned int processId()
+    {
+#ifdef WIN32
+        return _getpid();
+#else
+        return getpid();
+#endif
+    }
+}
+
 namespace stromx
 {
     namespace runtime
@@ -41,6 +65,12 @@ namespace stromx
         Send::Send()
           : OperatorKernel(TYPE, PACKAGE, VERSION, setupParameters(), setupProperties()),
             m_port(MIN_PORT),
+            m_transport(TCP),
+            m_numSlots(4),
+            m_slotSize(16 * 1024 * 1024),
+            m_queuePolicy(BLOCKING),
+            m_queueSize(4),
+            m_encoding(OutputProvider::DEFAULT),
             m_server(0)
         {
         }
@@ -64,6 +94,30 @@ namespace stromx
                     throw WrongParameterValue(parameter(PORT), *this, "Too large port number.");
                 m_port = uintValue;
                 break;
+            case TRANSPORT:
+                m_transport = data_cast<Enum>(value);
+                break;
+            case NUM_SLOTS:
+                if(data_cast<UInt32>(value) < 1)
+                    throw WrongParameterValue(parameter(NUM_SLOTS), *this, "At least one slot is required.");
+                m_numSlots = data_cast<UInt32>(value);
+                break;
+            case SLOT_SIZE:
+                if(data_cast<UInt32>(value) < 1)
+                    throw WrongParameterValue(parameter(SLOT_SIZE), *this, "Too small slot size.");
+                m_slotSize = data_cast<UInt32>(value);
+                break;
+            case QUEUE_POLICY:
+                m_queuePolicy = data_cast<Enum>(value);
+                break;
+            case QUEUE_SIZE:
+                if(data_cast<UInt32>(value) < 1)
+                    throw WrongParameterValue(parameter(QUEUE_SIZE), *this, "Too small queue size.");
+                m_queueSize = data_cast<UInt32>(value);
+                break;
+            case ENCODING:
+                m_encoding = data_cast<Enum>(value);
+                break;
             default:
                 throw WrongParameterId(id, *this);
             }
@@ -75,6 +129,26 @@ namespace stromx
             {
             case PORT:
                 return m_port;
+            case TRANSPORT:
+                return m_transport;
+            case NUM_SLOTS:
+                return m_numSlots;
+            case SLOT_SIZE:
+                return m_slotSize;
+            case QUEUE_POLICY:
+                return m_queuePolicy;
+            case QUEUE_SIZE:
+                return m_queueSize;
+            case SENT_FRAMES:
+                return UInt64(statistics().sentFrames);
+            case DROPPED_FRAMES:
+                return UInt64(statistics().droppedFrames);
+            case SENT_BYTES:
+                return UInt64(statistics().sentBytes);
+            case DROPPED_BYTES:
+                return UInt64(statistics().droppedBytes);
+            case ENCODING:
+                return m_encoding;
             default:
                 throw WrongParameterId(id, *this);
             }
@@ -89,15 +163,22 @@ namespace stromx
         
         void Send::activate()
         {
+            impl::SharedMemoryRing* sharedMemory = 0;
+            
             try
             {
-                m_server = new impl::Server(m_port);
+                if(m_transport == SHARED_MEMORY)
+                    sharedMemory = new impl::SharedMemoryRing(sharedMemoryName(), m_numSlots, m_slotSize);
+                
+                m_server = new impl::Server(m_port, sharedMemory, 
+                                            impl::Server::QueuePolicy(int(m_queuePolicy)), m_queueSize,
+                                            OutputProvider::Encoding(int(m_encoding)));
             }
             catch(std::exception&)
             {
+                delete sharedMemory;
                 throw OperatorError(*this, "Failed to start server.");
             }
-            
         }
 
         void Send::deactivate()
@@ -117,6 +198,24 @@ namespace stromx
             m_server->send(inputMapper.data());
         }
         
+        const impl::ConnectionStatistics Send::statistics() const
+        {
+            if(! m_server)
+                return impl::ConnectionStatistics();
+            
+            return m_server->totalStatistics();
+        }
+        
+        const std::string Send::sharedMemoryName() const
+        {
+            // the name must be unique on this host because the segment of a 
+            // crashed process with the same name is removed
+            std::ostringstream name;
+            name << "stromx_send_" << (unsigned int)(m_port) << "_" << processId() 
+                 << "_" << gNumSharedMemories++;
+            return name.str();
+        }
+        
         const std::vector<const Input*> Send::setupInputs()
         {
             std::vector<const Input*> inputs;
@@ -144,6 +243,60 @@ namespace stromx
             port->setMax(UInt16(MAX_PORT));
             parameters.push_back(port);
             
+            EnumParameter* transport = new EnumParameter(TRANSPORT);
+            transport->setTitle("Transport");
+            transport->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            transport->add(EnumDescription(Enum(TCP), "TCP"));
+            transport->add(EnumDescription(Enum(SHARED_MEMORY), "Shared memory"));
+            parameters.push_back(transport);
+            
+            NumericParameter<UInt32>* numSlots = new NumericParameter<UInt32>(NUM_SLOTS);
+            numSlots->setTitle("Number of shared memory slots");
+            numSlots->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            numSlots->setMin(UInt32(1));
+            parameters.push_back(numSlots);
+            
+            NumericParameter<UInt32>* slotSize = new NumericParameter<UInt32>(SLOT_SIZE);
+            slotSize->setTitle("Size of a shared memory slot in bytes");
+            slotSize->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            slotSize->setMin(UInt32(1));
+            parameters.push_back(slotSize);
+            
+            EnumParameter* queuePolicy = new EnumParameter(QUEUE_POLICY);
+            queuePolicy->setTitle("Queue policy");
+            queuePolicy->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            queuePolicy->add(EnumDescription(Enum(BLOCKING), "Blocking"));
+            queuePolicy->add(EnumDescription(Enum(LATEST_ONLY), "Latest only"));
+            queuePolicy->add(EnumDescription(Enum(BOUNDED_FIFO), "Bounded FIFO"));
+            queuePolicy->add(EnumDescription(Enum(DISCONNECT_SLOW_CLIENT), "Disconnect slow client"));
+            parameters.push_back(queuePolicy);
+            
+            NumericParameter<UInt32>* queueSize = new NumericParameter<UInt32>(QUEUE_SIZE);
+            queueSize->setTitle("Queue size per client");
+            queueSize->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            queueSize->setMin(UInt32(1));
+            parameters.push_back(queueSize);
+            
+            EnumParameter* encoding = new EnumParameter(ENCODING);
+            encoding->setTitle("Encoding of images and matrices");
+            encoding->setAccessMode(runtime::Parameter::INITIALIZED_WRITE);
+            encoding->add(EnumDescription(Enum(OutputProvider::DEFAULT), "Default"));
+            encoding->add(EnumDescription(Enum(OutputProvider::RAW), "Raw"));
+            encoding->add(EnumDescription(Enum(OutputProvider::FAST), "Fast compression"));
+            encoding->add(EnumDescription(Enum(OutputProvider::PNG), "PNG"));
+            parameters.push_back(encoding);
+            
+            const unsigned int ids[] = { SENT_FRAMES, DROPPED_FRAMES, SENT_BYTES, DROPPED_BYTES };
+            const char* titles[] = { "Sent frames", "Dropped frames", "Sent bytes", "Dropped bytes" };
+            for(unsigned int i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+            {
+                runtime::Parameter* statistic = new runtime::Parameter(ids[i], Variant::UINT_64);
+                statistic->setTitle(titles[i]);
+                statistic->setAccessMode(runtime::Parameter::INITIALIZED_READ);
+                statistic->setUpdateBehavior(runtime::Parameter::PULL);
+                parameters.push_back(statistic);
+            }
+            
             return parameters;
         }
         
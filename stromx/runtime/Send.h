@@ -17,7 +17,9 @@
 #ifndef STROMX_RUNTIME_SEND_H
 #define STROMX_RUNTIME_SEND_H
 
+#include "stromx/runtime/Enum.h"
 #include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/Primitive.h"
 
 namespace stromx
 {
@@ -26,16 +28,63 @@ namespace stromx
         namespace impl
         {
             class Server;
+            struct ConnectionStatistics;
         }
         
-        /** \brief Distributes input data to TCP clients. */
+        /** 
+         * \brief Distributes input data to TCP clients.
+         * 
+         * If the transport is set to SHARED_MEMORY the payload of images and 
+         * matrices is stored in a ring of shared memory slots and only a 
+         * descriptor of the slot is sent to the client. This is only done for
+         * clients which connect via the loopback interface and announce that
+         * they can read from shared memory. All other clients, all other data 
+         * and images which do not fit into a slot are serialized and sent via 
+         * TCP. The same happens if all slots are in use because the clients did 
+         * not yet read them. 
+         * 
+         * Each input is serialized once and queued for every connected client.
+         * The queue policy determines what happens if a client can not keep up.
+         * By default (BLOCKING) the operator waits until each client has room
+         * for the input in its queue. The other policies never wait but drop
+         * frames or disconnect the client. The statistics parameters sum the sent and dropped 
+         * frames and bytes of all clients since the activation of the operator.
+         * 
+         * The encoding determines how images and matrices are serialized. 
+         * Clients which support the binary wire format receive the uncompressed 
+         * rows of images and matrices unless a compressing encoding is selected.
+         */
         class STROMX_RUNTIME_API Send : public OperatorKernel
         {
         public:
             enum DataId
             {
                 INPUT,
-                PORT
+                PORT,
+                TRANSPORT,
+                NUM_SLOTS,
+                SLOT_SIZE,
+                QUEUE_POLICY,
+                QUEUE_SIZE,
+                SENT_FRAMES,
+                DROPPED_FRAMES,
+                SENT_BYTES,
+                DROPPED_BYTES,
+                ENCODING
+            };
+            
+            enum Transport
+            {
+                TCP,
+                SHARED_MEMORY
+            };
+            
+            enum QueuePolicy
+            {
+                LATEST_ONLY,
+                BOUNDED_FIFO,
+                DISCONNECT_SLOW_CLIENT,
+                BLOCKING
             };
             
             Send ();
@@ -64,7 +113,16 @@ namespace stromx
             static const unsigned int MIN_PORT;
             static const unsigned int MAX_PORT;
             
+            const std::string sharedMemoryName() const;
+            const impl::ConnectionStatistics statistics() const;
+            
             UInt16 m_port;
+            Enum m_transport;
+            UInt32 m_numSlots;
+            UInt32 m_slotSize;
+            Enum m_queuePolicy;
+            UInt32 m_queueSize;
+            Enum m_encoding;
             
             impl::Server* m_server;
         };
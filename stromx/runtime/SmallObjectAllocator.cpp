@@ -0,0 +1,204 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/SmallObjectAllocator.h"
+
+#include <new>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace
+{
+    using stromx::runtime::SmallObjectAllocator;
+    
+    // the sizes of the blocks are multiples of this value
+    const std::size_t GRANULARITY = 16;
+    
+    const std::size_t NUM_SIZE_CLASSES = SmallObjectAllocator::MAX_OBJECT_SIZE / GRANULARITY;
+    
+    // the number of blocks which are exchanged between a thread and the global
+    // pool at once
+    const unsigned int BATCH_SIZE = 64;
+    
+    // the maximal number of blocks of a size class which is kept in a thread cache
+    const unsigned int MAX_CACHED_BLOCKS = 2 * BATCH_SIZE;
+    
+    struct Block
+    {
+        Block* next;
+    };
+    
+    struct FreeList
+    {
+        FreeList() : head(0), size(0) {}
+        
+        void push(Block* const block)
+        {
+            block->next = head;
+            head = block;
+            ++size;
+        }
+        
+        Block* pop()
+        {
+            Block* block = head;
+            head = block->next;
+            --size;
+            return block;
+        }
+        
+        Block* head;
+        unsigned int size;
+    };
+    
+    class ThreadCache;
+    
+    // shared pool of batches of free blocks
+    class GlobalPool
+    {
+    public:
+        bool takeBatch(const std::size_t sizeClass, FreeList & list)
+        {
+            lock_t lock(m_mutex);
+            
+            std::vector<FreeList> & batches = m_batches[sizeClass];
+            if(batches.empty())
+                return false;
+            
+            list = batches.back();
+            batches.pop_back();
+            return true;
+        }
+        
+        void putBatch(const std::size_t sizeClass, const FreeList & list)
+        {
+            lock_t lock(m_mutex);
+            m_batches[sizeClass].push_back(list);
+        }
+        
+        boost::thread_specific_ptr<ThreadCache> & caches() { return m_caches; }
+        
+    private:
+        typedef boost::lock_guard<boost::mutex> lock_t;
+        
+        boost::mutex m_mutex;
+        std::vector<FreeList> m_batches[NUM_SIZE_CLASSES];
+        boost::thread_specific_ptr<ThreadCache> m_caches;
+    };
+    
+    class ThreadCache
+    {
+    public:
+        explicit ThreadCache(GlobalPool & pool) : m_pool(pool) {}
+        
+        ~ThreadCache()
+        {
+            // return the cached blocks to the other threads
+            for(std::size_t sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+            {
+                if(m_lists[sizeClass].size)
+                    m_pool.putBatch(sizeClass, m_lists[sizeClass]);
+            }
+        }
+        
+        void* allocate(const std::size_t sizeClass)
+        {
+            FreeList & list = m_lists[sizeClass];
+            
+            if(! list.head && ! m_pool.takeBatch(sizeClass, list))
+                return ::operator new((sizeClass + 1) * GRANULARITY);
+            
+            return list.pop();
+        }
+        
+        void deallocate(void* const ptr, const std::size_t sizeClass)
+        {
+            FreeList & list = m_lists[sizeClass];
+            list.push(static_cast<Block*>(ptr));
+            
+            if(list.size > MAX_CACHED_BLOCKS)
+            {
+                // move a batch of blocks to the global pool
+                FreeList batch;
+                while(batch.size < BATCH_SIZE)
+                    batch.push(list.pop());
+                
+                m_pool.putBatch(sizeClass, batch);
+            }
+        }
+        
+    private:
+        GlobalPool & m_pool;
+        FreeList m_lists[NUM_SIZE_CLASSES];
+    };
+    
+    GlobalPool & globalPool()
+    {
+        // the pool is never destructed because objects might still be released
+        // during the destruction of static objects
+        static GlobalPool* pool = new GlobalPool;
+        return *pool;
+    }
+    
+    ThreadCache & threadCache()
+    {
+        GlobalPool & pool = globalPool();
+        ThreadCache* cache = pool.caches().get();
+        
+        if(! cache)
+        {
+            cache = new ThreadCache(pool);
+            pool.caches().reset(cache);
+        }
+        
+        return *cache;
+    }
+    
+    std::size_t sizeClass(const std::size_t size)
+    {
+        return size ? (size - 1) / GRANULARITY : 0;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void* SmallObjectAllocator::allocate(const std::size_t size)
+        {
+            if(size > MAX_OBJECT_SIZE)
+                return ::operator new(size);
+            
+            return threadCache().allocate(sizeClass(size));
+        }
+        
+        void SmallObjectAllocator::deallocate(void*const ptr, const std::size_t size)
+        {
+            if(! ptr)
+                return;
+            
+            if(size > MAX_OBJECT_SIZE)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+            
+            threadCache().deallocate(ptr, sizeClass(size));
+        }
+    }
+}
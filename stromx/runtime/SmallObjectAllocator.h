@@ -0,0 +1,56 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_SMALLOBJECTALLOCATOR_H
+#define STROMX_RUNTIME_SMALLOBJECTALLOCATOR_H
+
+#include <cstddef>
+#include "stromx/runtime/Config.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        /** 
+         * \brief Allocator for small objects which are frequently created and destroyed.
+         * 
+         * Memory for small objects is allocated in fixed size blocks. Released
+         * blocks are kept in a cache of the releasing thread and reused by later
+         * allocations of objects of the same size. Blocks are exchanged between 
+         * the threads in batches, i.e. after a short warm-up phase a stream which
+         * allocates and releases the same objects in each iteration does not
+         * allocate memory from the heap anymore. Allocations larger than 
+         * MAX_OBJECT_SIZE are forwarded to the global operator new.
+         * 
+         * Memory which has been allocated by this allocator must be released by
+         * deallocate() and the same size must be passed to both functions. 
+         */
+        class STROMX_RUNTIME_API SmallObjectAllocator
+        {
+        public:
+            /** The maximal size in bytes of an object which is allocated from the cached blocks. */
+            static const std::size_t MAX_OBJECT_SIZE = 256;
+            
+            /** Allocates memory for an object of \c size bytes. */
+            static void* allocate(const std::size_t size);
+            
+            /** Releases the memory at \c ptr which has been allocated for an object of \c size bytes. */
+            static void deallocate(void* const ptr, const std::size_t size);
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_SMALLOBJECTALLOCATOR_H
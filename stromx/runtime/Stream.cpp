@@ -16,6 +16,7 @@
 
 #include <boost/assert.hpp>
 #include <boost/thread.hpp>
+#include <iostream>
 #include "stromx/runtime/Enum.h"
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/ExceptionObserver.h"
@@ -30,7 +31,10 @@
 #include "stromx/runtime/impl/MutexHandle.h"
 #include "stromx/runtime/impl/Network.h"
 #include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/impl/ThreadImpl.h"
 #include "stromx/runtime/impl/ThreadImplObserver.h"
+#include "stromx/runtime/impl/Tracer.h"
+#include "stromx/runtime/impl/WorkerPool.h"
 
 namespace stromx
 {
@@ -79,7 +83,12 @@ namespace stromx
             m_status(INACTIVE),
             m_factory(0),
             m_delayMutex(new impl::MutexHandle),
-            m_delay(0)
+            m_delay(0),
+            m_executionMode(THREADS),
+            m_workerPoolSize(0),
+            m_workerPool(0),
+            m_isTracing(false),
+            m_fusionEnabled(true)
         {
             InternalNetworkObserver* observer = new InternalNetworkObserver(this);
             m_network->setObserver(observer);
@@ -87,6 +96,13 @@ namespace stromx
         
         Stream::~Stream()
         {
+            // discard the trace because it refers to the operators of the stream
+            if (m_isTracing)
+            {
+                std::ostream discard(0);
+                impl::Tracer::stop(discard);
+            }
+            
             // stop all visible threads
             for (std::vector<Thread*>::iterator iter = m_threads.begin();
                 iter != m_threads.end();
@@ -95,9 +111,16 @@ namespace stromx
                 (*iter)->stop();
             }
             
+            // stop the worker pool
+            if (m_workerPool)
+                m_workerPool->stop();
+            
             // interrupt the network
             m_network->interrupt();
             
+            // join and delete the worker pool
+            delete m_workerPool;
+            
             // in the meantime delete all uninitialized operators       
             for (std::set<Operator*>::iterator iter = m_uninitializedOperators.begin();
                 iter != m_uninitializedOperators.end();
@@ -164,6 +187,30 @@ namespace stromx
             return m_network->operators();
         }
         
+        void Stream::setExecutionMode(const ExecutionMode mode)
+        {
+            if (m_status != INACTIVE)
+                throw WrongState("Cannot set the execution mode while the stream is active.");
+            
+            m_executionMode = mode;
+        }
+        
+        void Stream::setWorkerPoolSize(const unsigned int size)
+        {
+            if (m_status != INACTIVE)
+                throw WrongState("Cannot set the worker pool size while the stream is active.");
+            
+            m_workerPoolSize = size;
+        }
+        
+        void Stream::setFusionEnabled(const bool enabled)
+        {
+            if (m_status != INACTIVE)
+                throw WrongState("Cannot enable or disable fusion while the stream is active.");
+            
+            m_fusionEnabled = enabled;
+        }
+        
         void Stream::start()
         {
             if (m_status != INACTIVE)
@@ -174,19 +221,82 @@ namespace stromx
             try
             {
                 m_network->activate();
-                for (std::vector<Thread*>::iterator iter = m_threads.begin();
-                    iter != m_threads.end();
-                    ++iter)
+                
+                if (m_executionMode == WORKER_POOL)
+                {
+                    // the input sequences of all threads are executed by a single pool
+                    BOOST_ASSERT(! m_workerPool);
+                    m_workerPool = new impl::WorkerPool(m_workerPoolSize);
+                    
+                    try
+                    {
+                        for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                            iter != m_threads.end();
+                            ++iter)
+                        {
+                            impl::ThreadImplObserver* observer = new InternalThreadObserver(this, *iter);
+                            m_workerPool->addThread(*iter, (*iter)->m_thread->inputSequence(), observer);
+                            m_workerPool->setDelay(*iter, delay());
+                        }
+                        
+                        m_workerPool->start();
+                    }
+                    catch(...)
+                    {
+                        // a worker could not be spawned, stop the workers which are
+                        // already running, the pool joins them when it is deleted
+                        m_workerPool->stop();
+                        m_network->interrupt();
+                        delete m_workerPool;
+                        m_workerPool = 0;
+                        
+                        // the network is deactivated below
+                        throw;
+                    }
+                }
+                else
                 {
-                    (*iter)->start();
+                    try
+                    {
+                        for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                            iter != m_threads.end();
+                            ++iter)
+                        {
+                            (*iter)->m_thread->setFusionEnabled(m_fusionEnabled);
+                            (*iter)->start();
+                        }
+                    }
+                    catch(...)
+                    {
+                        // a thread could not be started, e.g. because its scheduling
+                        // settings were refused, stop the threads which are already running
+                        for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                            iter != m_threads.end();
+                            ++iter)
+                        {
+                            (*iter)->stop();
+                        }
+                        
+                        m_network->interrupt();
+                        
+                        for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                            iter != m_threads.end();
+                            ++iter)
+                        {
+                            (*iter)->join();
+                        }
+                        
+                        // the network is deactivated below
+                        throw;
+                    }
                 }
                 
                 m_status = ACTIVE;
             }
-            catch(OperatorError &)
+            catch(...)
             {
-                // an error occurred while activating the network
-                // make sure all operators are deactivated
+                // an error occurred while activating the network or starting
+                // the threads, make sure all operators are deactivated
                 m_network->deactivate();
                 throw;
             }
@@ -199,11 +309,18 @@ namespace stromx
                 throw WrongState("Stream object not active.");
             }
             
-            for (std::vector<Thread*>::iterator iter = m_threads.begin();
-                iter != m_threads.end();
-                ++iter)
+            if (m_workerPool)
             {
-                (*iter)->pause();
+                m_workerPool->pause();
+            }
+            else
+            {
+                for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                    iter != m_threads.end();
+                    ++iter)
+                {
+                    (*iter)->pause();
+                }
             }
             
             m_status = PAUSED;
@@ -216,16 +333,38 @@ namespace stromx
                 throw WrongState("Stream object not active.");
             }
             
-            for (std::vector<Thread*>::iterator iter = m_threads.begin();
-                iter != m_threads.end();
-                ++iter)
+            if (m_workerPool)
             {
-                (*iter)->resume();
+                m_workerPool->resume();
+            }
+            else
+            {
+                for (std::vector<Thread*>::iterator iter = m_threads.begin();
+                    iter != m_threads.end();
+                    ++iter)
+                {
+                    (*iter)->resume();
+                }
             }
             
             m_status = ACTIVE;
         }
         
+        void Stream::startTrace()
+        {
+            impl::Tracer::start();
+            m_isTracing = true;
+        }
+        
+        void Stream::stopTrace(std::ostream & out)
+        {
+            if (! m_isTracing)
+                throw WrongState("No trace has been started for this stream.");
+            
+            m_isTracing = false;
+            impl::Tracer::stop(out);
+        }
+        
         void Stream::join()
         {
             if (m_status == INACTIVE)
@@ -246,6 +385,13 @@ namespace stromx
                 BOOST_ASSERT((*iter)->status() == Thread::INACTIVE);
             }
             
+            if (m_workerPool)
+            {
+                m_workerPool->join();
+                delete m_workerPool;
+                m_workerPool = 0;
+            }
+            
             try
             {
                 m_network->deactivate();
@@ -273,6 +419,9 @@ namespace stromx
                 (*iter)->stop();
             }
             
+            if (m_workerPool)
+                m_workerPool->stop();
+            
             m_network->interrupt();
             
             m_status = DEACTIVATING;
@@ -353,6 +502,9 @@ namespace stromx
                 ++iter)
             {
                 (*iter)->setDelay(delay);
+                
+                if (m_workerPool)
+                    m_workerPool->setDelay(*iter, delay);
             }
         }
         
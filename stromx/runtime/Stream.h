@@ -17,6 +17,7 @@
 #ifndef STROMX_RUNTIME_STREAM_H
 #define STROMX_RUNTIME_STREAM_H
 
+#include <iosfwd>
 #include <set>
 #include <string>
 #include <vector>
@@ -39,6 +40,7 @@ namespace stromx
         {
             class MutexHandle;
             class Network;
+            class WorkerPool;
         }
         
         /** \brief The core data processing pipeline of stromx. */
@@ -58,6 +60,19 @@ namespace stromx
                 PAUSED
             };
             
+            /** The possible ways to execute the threads of a stream. */
+            enum ExecutionMode
+            {
+                /** Each thread of the stream is executed by a dedicated system thread. */
+                THREADS,
+                /** 
+                 * The inputs of all threads are scheduled as tasks on a pool of 
+                 * worker threads. An input is processed by the first idle worker 
+                 * as soon as the data is available.
+                 */
+                WORKER_POOL
+            };
+            
             /** Constructs a stream object */
             Stream();
             ~Stream();
@@ -71,6 +86,50 @@ namespace stromx
             /** Returns the current state of the stream. */
             Status status() const { return m_status; }
             
+            /** Returns the execution mode of the stream. */
+            ExecutionMode executionMode() const { return m_executionMode; }
+            
+            /**
+             * Sets the execution mode of the stream. The default mode is THREADS.
+             * 
+             * \throws WrongState If the stream is not inactive.
+             */
+            void setExecutionMode(const ExecutionMode mode);
+            
+            /** 
+             * Returns the number of workers which execute the stream in the mode
+             * WORKER_POOL. The value 0 stands for the number of hardware threads.
+             */
+            unsigned int workerPoolSize() const { return m_workerPoolSize; }
+            
+            /** 
+             * Sets the number of workers which execute the stream in the mode 
+             * WORKER_POOL. Pass 0 to use the number of hardware threads. At most
+             * this number of workers process data at any time. Workers which
+             * wait inside an operator are temporarily replaced by additional
+             * system threads.
+             * 
+             * \throws WrongState If the stream is not inactive.
+             */
+            void setWorkerPoolSize(const unsigned int size);
+            
+            /** Returns whether linear operator chains are fused in the mode THREADS. */
+            bool fusionEnabled() const { return m_fusionEnabled; }
+            
+            /** 
+             * Enables or disables the fusion of linear operator chains. If enabled,
+             * each thread detects sequences of its inputs where each operator
+             * has a single input and a single output, and the output is only
+             * connected to the next input of the thread. The data of such a chain
+             * is passed directly from one operator execution to the next without
+             * going through the synchronization of the operator outputs. Observers
+             * and exceptions are reported as for unfused operators. Fusion is 
+             * enabled by default and has no effect in the mode WORKER_POOL.
+             * 
+             * \throws WrongState If the stream is not inactive.
+             */
+            void setFusionEnabled(const bool enabled);
+            
             /** Returns a list of the operators of the stream */
             const std::vector<Operator*>& operators() const;     
             
@@ -342,6 +401,23 @@ namespace stromx
              */
             void resume();
             
+            /**
+             * Starts to record a trace of the execution of the stream. The trace
+             * contains the time spent to pass data to operator inputs, executing 
+             * operators and waiting for data. Note that the trace is recorded for all
+             * streams of the process.
+             * \throws WrongState If a trace is already being recorded.
+             */
+            void startTrace();
+            
+            /**
+             * Stops the trace which has been started by startTrace() and writes it to
+             * \c out in the Chrome trace event format. The output can be loaded in 
+             * chrome://tracing or Perfetto.
+             * \throws WrongState If no trace has been started for this stream.
+             */
+            void stopTrace(std::ostream & out);
+            
         private:
             class InternalThreadObserver;
             class InternalNetworkObserver;
@@ -371,6 +447,11 @@ namespace stromx
             std::vector<Operator*> m_operators;
             std::set<Operator*> m_hiddenOperators;
             std::set<Thread*> m_hiddenThreads;
+            ExecutionMode m_executionMode;
+            unsigned int m_workerPoolSize;
+            impl::WorkerPool* m_workerPool;
+            bool m_isTracing;
+            bool m_fusionEnabled;
         };
     }
 }
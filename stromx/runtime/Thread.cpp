@@ -80,6 +80,31 @@ namespace stromx
             m_color = color;
         }
         
+        uint64_t Thread::affinity() const
+        {
+            return m_thread->affinity();
+        }
+        
+        void Thread::setAffinity(const uint64_t mask)
+        {
+            m_thread->setAffinity(mask);
+        }
+        
+        Thread::SchedulingPolicy Thread::schedulingPolicy() const
+        {
+            return SchedulingPolicy(m_thread->schedulingPolicy());
+        }
+        
+        int Thread::priority() const
+        {
+            return m_thread->priority();
+        }
+        
+        void Thread::setScheduling(const SchedulingPolicy policy, const int priority)
+        {
+            m_thread->setScheduling(impl::ThreadImpl::SchedulingPolicy(policy), priority);
+        }
+        
         const std::vector<InputConnector> & Thread::inputSequence() const
         { 
             return m_inputSequence;
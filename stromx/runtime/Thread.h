@@ -17,6 +17,7 @@
 #ifndef STROMX_RUNTIME_THREAD_H
 #define STROMX_RUNTIME_THREAD_H
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include "stromx/runtime/Color.h"
@@ -49,6 +50,10 @@ namespace stromx
          * passes it to the input. When data is passed as input to an operator
          * or output data is obtained from the operator the operator is implicitely
          * executed.
+         * 
+         * The CPU affinity and the scheduling settings of a thread apply to its system
+         * thread. They have no effect if the stream is executed by a worker pool
+         * (see Stream::WORKER_POOL).
          */
         class STROMX_RUNTIME_API Thread
         {    
@@ -70,6 +75,17 @@ namespace stromx
                 PAUSED
             };
             
+            /** The scheduling policies of a thread. */
+            enum SchedulingPolicy
+            {
+                /** The default time-sharing policy (SCHED_OTHER). */
+                OTHER,
+                /** The first-in first-out real-time policy (SCHED_FIFO). */
+                FIFO,
+                /** The round-robin real-time policy (SCHED_RR). */
+                ROUND_ROBIN
+            };
+            
             virtual ~Thread();
             
             /** Returns the current state of the thread. */
@@ -90,6 +106,46 @@ namespace stromx
              * of the thread. */
             void setColor(const Color & color);
             
+            /** 
+             * Returns the CPU affinity mask of the thread. Bit \em i of the mask
+             * is set if the thread may run on CPU \em i. A mask of 0 does not
+             * restrict the thread to any CPUs.
+             */
+            uint64_t affinity() const;
+            
+            /** 
+             * Sets the CPU affinity mask of the thread. The mask is applied when the
+             * thread is started.
+             * \throws WrongState If the thread state is not INACTIVE.
+             * \throws NotImplemented If \c mask is not 0 and CPU affinity is not supported
+             *                        on this platform.
+             */
+            void setAffinity(const uint64_t mask);
+            
+            /** Returns the scheduling policy of the thread. */
+            SchedulingPolicy schedulingPolicy() const;
+            
+            /** 
+             * Returns the priority of the thread. For the policy OTHER this is the nice level
+             * of the thread, for FIFO and ROUND_ROBIN it is the real-time priority.
+             */
+            int priority() const;
+            
+            /** 
+             * Sets the scheduling policy and the priority of the thread. The settings are 
+             * applied when the thread is started. For the policy OTHER \c priority is the
+             * nice level in the range [-20, 19], where 0 keeps the nice level of the process.
+             * For FIFO and ROUND_ROBIN it is the real-time priority in the range [1, 99].
+             * Note that negative nice levels and real-time policies usually require
+             * additional privileges. If the operating system refuses the settings the stream
+             * fails to start.
+             * \throws WrongState If the thread state is not INACTIVE.
+             * \throws WrongArgument If \c priority is out of range for \c policy.
+             * \throws NotImplemented If the settings are not the default settings and
+             *                        they are not supported on this platform.
+             */
+            void setScheduling(const SchedulingPolicy policy, const int priority);
+            
             /** Returns a list of the operator inputs which are assigned to this thread. */
             const std::vector<InputConnector> & inputSequence() const;
             
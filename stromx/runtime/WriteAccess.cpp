@@ -31,6 +31,16 @@ namespace stromx
         {
         }
             
+        WriteAccess::WriteAccess(DataContainer & data)
+          : m_impl(new impl::WriteAccessImpl(data, false))
+        {
+        }
+            
+        WriteAccess::WriteAccess(DataContainer & data, const unsigned int timeout)
+          : m_impl(new impl::WriteAccessImpl(data, true, timeout))
+        {
+        }
+            
         Data & WriteAccess::get() const
         {
             if(empty())
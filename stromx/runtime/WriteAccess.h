@@ -71,6 +71,42 @@ namespace stromx
              */
             WriteAccess(const DataContainer & data, const unsigned int timeout);
             
+            /** 
+             * Constructs a write access from a data container. If \c data is not in
+             * copy-on-write mode this function waits until write access is possible, 
+             * i.e. until no other read or write access to \c data exists. 
+             * Otherwise, if other copies of \c data or other accesses exist, \c data is
+             * replaced by a container with a copy of its data and the write access is
+             * obtained for the copy. The copy held by an ID-data pair counts as well,
+             * i.e. obtain \c data by Id2DataPair::release() to avoid the copy.
+             * 
+             * \param data The container which contains the data to be accessed.
+             * \throws WrongArgument The container is read-only.
+             * 
+             * \sa DataContainer::setCopyOnWrite(), Id2DataPair::release()
+             */
+            explicit WriteAccess(DataContainer & data);
+            
+            /** 
+             * Constructs a write access from a data container. If \c data is not in
+             * copy-on-write mode this function waits until write access is possible, 
+             * i.e. until no other read or write access to \c data exists. 
+             * Otherwise, if other copies of \c data or other accesses exist, \c data is
+             * replaced by a container with a copy of its data and the write access is
+             * obtained for the copy. The copy held by an ID-data pair counts as well,
+             * i.e. obtain \c data by Id2DataPair::release() to avoid the copy.
+             * 
+             * \param data The container which contains the data to be accessed.
+             * \param timeout The maximal time to wait in milliseconds.
+             * 
+             * \throws Timeout If no write access (or no read access to copy the data)
+             *                 could be obtained during the timeout.
+             * \throws WrongArgument The container is read-only.
+             * 
+             * \sa DataContainer::setCopyOnWrite(), Id2DataPair::release()
+             */
+            WriteAccess(DataContainer & data, const unsigned int timeout);
+            
             /** Returns \c true if the write access is empty. */
             bool empty() const { return m_impl.get() == 0; }
             
@@ -18,8 +18,9 @@
 
 #include <zip.h>
 #include "stromx/runtime/Exception.h"
-
-#include <vector>
+#include "stromx/runtime/impl/MappedFile.h"
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
+#include "stromx/runtime/impl/ZipIndex.h"
 
 namespace stromx
 {
@@ -29,7 +30,10 @@ namespace stromx
           : m_archiveHandle(0),
             m_initialized(false),
             m_archive(archive),
-            m_currentFile(0)
+            m_currentBuffer(0),
+            m_currentFile(0),
+            m_mappedArchive(0),
+            m_index(0)
         {
             int error = 0;
             m_archiveHandle = zip_open(m_archive.c_str(), 0, &error);
@@ -42,6 +46,10 @@ namespace stromx
         {
             if(m_archiveHandle)
                 zip_close(m_archiveHandle);
+            
+            closeFile();
+            delete m_index;
+            delete m_mappedArchive;
         }
 
         void ZipFileInput::close()
@@ -58,11 +66,7 @@ namespace stromx
             m_currentText.clear();
             m_currentText.str(text);
             
-            if(m_currentFile)
-            {
-                delete m_currentFile;
-                m_currentFile = 0;
-            }
+            closeFile();
             
             m_currentFilename = filename;
             m_initialized = true;
@@ -84,7 +88,7 @@ namespace stromx
             return m_currentText;
         }
 
-        std::istream& ZipFileInput::openFile(const stromx::runtime::InputProvider::OpenMode mode)
+        std::istream& ZipFileInput::openFile(const stromx::runtime::InputProvider::OpenMode)
         {            
             if(! m_initialized)
                 throw WrongState("Zip file input has not been initialized.");
@@ -95,10 +99,6 @@ namespace stromx
             if(! hasFile())
                 throw NoInputFile();
             
-            std::ios_base::openmode iosmode = std::ios_base::in;
-            if(mode == BINARY)
-                iosmode |= std::ios_base::binary;
-            
             struct zip_stat stat;
             if(zip_stat(m_archiveHandle, m_currentFilename.c_str(), 0, &stat) < 0)
                 throw FileAccessFailed(m_currentFilename, m_archive, "Failed to access file in zip archive.");
@@ -106,17 +106,34 @@ namespace stromx
             if(stat.size == 0)
                 throw FileAccessFailed(m_currentFilename, m_archive, "File in zip archive has zero size.");
             
-            unsigned int fileSize = (unsigned int)(stat.size);
-            std::vector<char> content(fileSize);
-                
-            zip_file* file = zip_fopen(m_archiveHandle, m_currentFilename.c_str(), 0);
-            if(! file)
-                throw FileAccessFailed(m_currentFilename, m_archive, "Failed to open file in zip archive.");
+            const std::size_t fileSize = std::size_t(stat.size);
+            const char* data = 0;
+            
+            // uncompressed files are not copied
+            if(stat.comp_method == ZIP_CM_STORE && stat.encryption_method == ZIP_EM_NONE)
+                data = mappedFile(fileSize);
             
-            if((unsigned int)(zip_fread(file, &content[0], fileSize)) != fileSize)
-                throw FileAccessFailed(m_currentFilename, m_archive, "Failed to read file in zip archive.");
+            if(! data)
+            {
+                m_currentContent.resize(fileSize);
+                
+                zip_file* file = zip_fopen(m_archiveHandle, m_currentFilename.c_str(), 0);
+                if(! file)
+                    throw FileAccessFailed(m_currentFilename, m_archive, "Failed to open file in zip archive.");
+                
+                const bool failed = std::size_t(zip_fread(file, &m_currentContent[0], fileSize)) != fileSize;
+                zip_fclose(file);
+                
+                if(failed)
+                    throw FileAccessFailed(m_currentFilename, m_archive, "Failed to read file in zip archive.");
+                
+                data = &m_currentContent[0];
+            }
             
-            m_currentFile = new std::istringstream(std::string(&content[0], fileSize), iosmode);
+            // the mode is irrelevant because the data is not converted in 
+            // either case
+            m_currentBuffer = new impl::MemoryInputBuffer(data, fileSize);
+            m_currentFile = new std::istream(m_currentBuffer);
             
             return *m_currentFile;
         }
@@ -131,5 +148,38 @@ namespace stromx
             
             return *m_currentFile;
         }
+        
+        const char* ZipFileInput::mappedFile(const std::size_t size)
+        {
+            // map the archive when the first uncompressed file is accessed
+            if(! m_index)
+            {
+                try
+                {
+                    m_mappedArchive = new impl::MappedFile(m_archive);
+                    m_index = new impl::ZipIndex(m_mappedArchive->data(), m_mappedArchive->size());
+                }
+                catch(FileAccessFailed &)
+                {
+                    // read all files by libzip if the archive can not be mapped
+                    m_index = new impl::ZipIndex(0, 0);
+                }
+            }
+            
+            const impl::ZipIndex::Entry* entry = m_index->find(m_currentFilename);
+            if(! entry || entry->size != size)
+                return 0;
+            
+            return m_mappedArchive->data() + entry->offset;
+        }
+        
+        void ZipFileInput::closeFile()
+        {
+            delete m_currentFile;
+            m_currentFile = 0;
+            delete m_currentBuffer;
+            m_currentBuffer = 0;
+            std::vector<char>().swap(m_currentContent);
+        }
     }
 }
@@ -18,6 +18,7 @@
 #define STROMX_RUNTIME_ZIPFILEINPUT_H
 
 #include <sstream>
+#include <vector>
 #include "stromx/runtime/Config.h"
 #include "stromx/runtime/FileInput.h"
 
@@ -27,7 +28,20 @@ namespace stromx
 {
     namespace runtime
     {
-        /** \brief File input which reads the input files from a zip file. */
+        namespace impl
+        {
+            class MappedFile;
+            class MemoryInputBuffer;
+            class ZipIndex;
+        }
+        
+        /** 
+         * \brief File input which reads the input files from a zip file. 
+         * 
+         * Uncompressed files are read directly from a memory mapping of the 
+         * zip file, i.e. their data is only loaded when it is accessed. Compressed 
+         * files are decompressed to memory when they are opened.
+         */
         class STROMX_RUNTIME_API ZipFileInput : public FileInput
         {
         public:
@@ -49,12 +63,19 @@ namespace stromx
             virtual void close();
             
         private:
+            const char* mappedFile(const std::size_t size);
+            void closeFile();
+            
             zip* m_archiveHandle;
             bool m_initialized;
             std::string m_archive;
             std::string m_currentFilename;
-            std::istringstream *m_currentFile;
+            std::vector<char> m_currentContent;
+            impl::MemoryInputBuffer* m_currentBuffer;
+            std::istream* m_currentFile;
             std::istringstream m_currentText;
+            impl::MappedFile* m_mappedArchive;
+            impl::ZipIndex* m_index;
         };
     }
 }
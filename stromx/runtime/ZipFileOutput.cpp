@@ -16,14 +16,10 @@
 
 #include "ZipFileOutput.h"
 
+#include <boost/filesystem.hpp>
 #include <zip.h>
 #include "stromx/runtime/Exception.h"
-
-// FIXME: remove this when libzip < 0.11 (i.e. Ubuntu Trusty)
-// is not supported any longer
-#if (LIBZIP_VERSION_MAJOR == 0 && LIBZIP_VERSION_MINOR < 11)
-#include <boost/filesystem.hpp>
-#endif
+#include "stromx/runtime/File.h"
 
 namespace stromx
 {
@@ -69,6 +65,9 @@ namespace stromx
             {
                 // ignore exceptions in destructor
             }
+            
+            delete m_currentFile;
+            removeTempFiles();
         }
         
         void ZipFileOutput::close()
@@ -81,6 +80,7 @@ namespace stromx
                     throw FileAccessFailed(m_archive, "Failed to save zip archive.");
                 
                 m_archiveHandle = 0;
+                removeTempFiles();
             }
         }
 
@@ -125,11 +125,21 @@ namespace stromx
             
             m_currentFilename = m_currentBasename + ext;
             
-            std::ios_base::openmode iosmode = std::ios_base::out;
+            std::ios_base::openmode iosmode = std::ios_base::out | std::ios_base::trunc;
             if(mode == BINARY)
                 iosmode |= std::ios_base::binary;
             
-            m_currentFile = new std::ostringstream(iosmode);
+            // the file data is not kept in memory but written to a temporary file
+            m_currentTempFile = File::tempPath(ext);
+            m_currentFile = new std::ofstream(m_currentTempFile.c_str(), iosmode);
+            m_tempFiles.push_back(m_currentTempFile);
+            
+            if(m_currentFile->fail())
+            {
+                delete m_currentFile;
+                m_currentFile = 0;
+                throw FileAccessFailed(m_currentFilename, m_archive, "Failed to open temporary file.");
+            }
             
             return *m_currentFile;
         }
@@ -149,11 +159,17 @@ namespace stromx
         {
             if(! m_currentFile)
                 return;
-                
-            m_bufferedFiles.push_back(m_currentFile->str());
-            std::string & fileContent = m_bufferedFiles.back();
             
-            zip_source* source = zip_source_buffer(m_archiveHandle, fileContent.c_str(), fileContent.size(), 0);
+            m_currentFile->close();
+            const bool failed = m_currentFile->fail();
+            delete m_currentFile;
+            m_currentFile = 0;
+            
+            if(failed)
+                throw FileAccessFailed(m_currentFilename, m_archive, "Failed to write temporary file.");
+            
+            // the content of the temporary file is read when the archive is closed
+            zip_source* source = zip_source_file(m_archiveHandle, m_currentTempFile.c_str(), 0, -1);
             if(! source)
                 throw FileAccessFailed(m_currentFilename, m_archive, "Failed to allocate ZLib source.");
             
@@ -179,9 +195,19 @@ namespace stromx
                     throw FileAccessFailed(m_currentFilename, m_archive, "Failed to replace file in zip archive.");
                 }
             }
+        }
+        
+        void ZipFileOutput::removeTempFiles()
+        {
+            for(std::vector<std::string>::const_iterator iter = m_tempFiles.begin();
+                iter != m_tempFiles.end();
+                ++iter)
+            {
+                boost::system::error_code error;
+                boost::filesystem::remove(*iter, error);
+            }
             
-            delete m_currentFile;
-            m_currentFile = 0;
+            m_tempFiles.clear();
         }
     }
 }
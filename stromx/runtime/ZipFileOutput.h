@@ -17,6 +17,7 @@
 #ifndef STROMX_RUNTIME_ZIPFILEOUTPUT_H
 #define STROMX_RUNTIME_ZIPFILEOUTPUT_H
 
+#include <fstream>
 #include <sstream>
 #include <vector>
 #include "stromx/runtime/Config.h"
@@ -28,7 +29,14 @@ namespace stromx
 {
     namespace runtime
     {
-        /** \brief File output which stores the output data in a zip file. */
+        /** 
+         * \brief File output which stores the output data in a zip file. 
+         * 
+         * Each file is written to a temporary file and added to the archive 
+         * as soon as it is completed. The archive is compressed from the
+         * temporary files when it is closed. Thus the memory consumption does
+         * not depend on the size of the archive.
+         */
         class STROMX_RUNTIME_API ZipFileOutput : public FileOutput
         {
         public:
@@ -52,15 +60,17 @@ namespace stromx
             
         private:
             void dumpFile();
+            void removeTempFiles();
             
             zip* m_archiveHandle;
             bool m_initialized;
             std::string m_archive;
             std::string m_currentBasename;
             std::string m_currentFilename;
-            std::ostringstream *m_currentFile;
+            std::string m_currentTempFile;
+            std::ofstream *m_currentFile;
             std::ostringstream m_currentText;
-            std::vector<std::string> m_bufferedFiles;
+            std::vector<std::string> m_tempFiles;
         };
     }
 }
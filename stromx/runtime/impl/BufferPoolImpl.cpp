@@ -0,0 +1,173 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/chrono.hpp>
+#include "stromx/runtime/Data.h"
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/BufferPoolImpl.h"
+#include "stromx/runtime/impl/DataContainerImpl.h"
+#include "stromx/runtime/impl/WorkerPool.h"
+
+namespace
+{
+    uint64_t elapsedTime(const boost::chrono::steady_clock::time_point & start)
+    {
+        using namespace boost::chrono;
+        return duration_cast<microseconds>(steady_clock::now() - start).count();
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            BufferPoolImpl::BufferPoolImpl(const std::vector<Data*> & buffers)
+              : m_numBuffers((unsigned int)(buffers.size())),
+                m_freeBuffers(buffers)
+            {
+                // reserve the space for all buffers now, i.e. handing out and 
+                // recycling buffers never allocates memory
+                m_usedBuffers.reserve(m_numBuffers);
+            }
+            
+            BufferPoolImpl::~BufferPoolImpl()
+            {
+                // the buffers in use are deleted by their containers
+                for(std::vector<DataContainerImpl*>::iterator iter = m_usedBuffers.begin();
+                    iter != m_usedBuffers.end();
+                    ++iter)
+                {
+                    (*iter)->returnRecycleAccess();
+                }
+                
+                for(std::vector<Data*>::iterator iter = m_freeBuffers.begin();
+                    iter != m_freeBuffers.end();
+                    ++iter)
+                {
+                    delete *iter;
+                }
+            }
+            
+            void BufferPoolImpl::recycle(DataContainerImpl* const container)
+            {
+                lock_t lock(m_mutex);
+                
+                std::vector<DataContainerImpl*>::iterator iter = 
+                    std::find(m_usedBuffers.begin(), m_usedBuffers.end(), container);
+                BOOST_ASSERT(iter != m_usedBuffers.end());
+                
+                *iter = m_usedBuffers.back();
+                m_usedBuffers.pop_back();
+                m_freeBuffers.push_back(container->data());
+                m_cond.notify_one();
+            }
+            
+            DataContainer BufferPoolImpl::get(const bool wait, const bool waitWithTimeout, const unsigned int timeout)
+            {
+                unique_lock_t lock(m_mutex);
+                
+                if(m_numBuffers == 0)
+                    throw WrongState("Buffer pool has no buffers.");
+                
+                if(m_freeBuffers.empty())
+                {
+                    m_statistics.m_numMisses++;
+                    if(! wait)
+                        return DataContainer();
+                    
+                    waitForBuffer(lock, waitWithTimeout, timeout);
+                }
+                else
+                {
+                    m_statistics.m_numHits++;
+                }
+                
+                Data* buffer = m_freeBuffers.back();
+                m_freeBuffers.pop_back();
+                
+                DataContainer container(buffer);
+                container.m_impl->getRecycleAccess(this);
+                m_usedBuffers.push_back(container.m_impl.get());
+                m_statistics.m_highWaterMark = std::max(m_statistics.m_highWaterMark,
+                                                        (unsigned int)(m_usedBuffers.size()));
+                
+                return container;
+            }
+            
+            void BufferPoolImpl::waitForBuffer(unique_lock_t & lock, const bool waitWithTimeout, const unsigned int timeout)
+            {
+                const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+                
+                try
+                {
+                    WorkerPool::BlockingScope scope;
+                    
+                    if(waitWithTimeout)
+                    {
+                        while(m_freeBuffers.empty())
+                        {
+                            if(m_cond.wait_for(lock, boost::chrono::milliseconds(timeout))
+                                == boost::cv_status::timeout)
+                            {
+                                throw Timeout();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        while(m_freeBuffers.empty())
+                            m_cond.wait(lock);
+                    }
+                }
+                catch(boost::thread_interrupted&)
+                {
+                    m_statistics.m_waitTime += elapsedTime(start);
+                    throw Interrupt();
+                }
+                catch(Timeout&)
+                {
+                    m_statistics.m_waitTime += elapsedTime(start);
+                    throw;
+                }
+                
+                m_statistics.m_waitTime += elapsedTime(start);
+            }
+            
+            unsigned int BufferPoolImpl::numFreeBuffers()
+            {
+                lock_t lock(m_mutex);
+                return (unsigned int)(m_freeBuffers.size());
+            }
+            
+            BufferPoolStatistics BufferPoolImpl::statistics()
+            {
+                lock_t lock(m_mutex);
+                return m_statistics;
+            }
+            
+            void BufferPoolImpl::resetStatistics()
+            {
+                lock_t lock(m_mutex);
+                m_statistics = BufferPoolStatistics();
+            }
+        }
+    } 
+}
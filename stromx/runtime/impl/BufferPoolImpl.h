@@ -0,0 +1,68 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_BUFFERPOOLIMPL_H
+#define STROMX_RUNTIME_IMPL_BUFFERPOOLIMPL_H
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <vector>
+#include "stromx/runtime/BufferPool.h"
+#include "stromx/runtime/Recycler.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+        class DataContainer;
+        
+        namespace impl
+        {
+            class DataContainerImpl;
+            
+            class BufferPoolImpl : public Recycler
+            {
+            public:
+                explicit BufferPoolImpl(const std::vector<Data*> & buffers);
+                ~BufferPoolImpl();
+                
+                void recycle(impl::DataContainerImpl* const container);
+                DataContainer get(const bool wait, const bool waitWithTimeout, const unsigned int timeout = 0);
+                unsigned int numBuffers() const { return m_numBuffers; }
+                unsigned int numFreeBuffers();
+                BufferPoolStatistics statistics();
+                void resetStatistics();
+                
+            private:
+                typedef boost::lock_guard<boost::mutex> lock_t;
+                typedef boost::unique_lock<boost::mutex> unique_lock_t;
+                
+                void waitForBuffer(unique_lock_t & lock, const bool waitWithTimeout, const unsigned int timeout);
+                
+                boost::mutex m_mutex;
+                boost::condition_variable_any m_cond;
+                const unsigned int m_numBuffers;
+                std::vector<Data*> m_freeBuffers;
+                std::vector<DataContainerImpl*> m_usedBuffers;
+                BufferPoolStatistics m_statistics;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_BUFFERPOOLIMPL_H
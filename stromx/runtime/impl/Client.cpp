@@ -16,23 +16,36 @@
 
 #include "Client.h"
 
+#include <algorithm>
+#include <cstring>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/bind.hpp>
+#include <boost/static_assert.hpp>
 #include "stromx/runtime/Data.h"
 #include "stromx/runtime/AbstractFactory.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/ImageWrapper.h"
 #include "stromx/runtime/InputProvider.h"
+#include "stromx/runtime/MatrixWrapper.h"
 #include "stromx/runtime/Version.h"
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
+#include "stromx/runtime/impl/SharedMemoryRing.h"
 
 using namespace boost::asio;
 
+BOOST_STATIC_ASSERT(stromx::runtime::impl::WireFormat::PREAMBLE_SIZE == 
+                    3 * stromx::runtime::impl::SerializationHeader::NUM_SIZE_DIGITS);
+
 namespace
 {
     class StreamInput : public stromx::runtime::InputProvider
     {            
     public:
-        StreamInput(std::string & textData, std::string & fileData)
-          : m_textStream(textData),
-            m_fileStream(fileData),
+        StreamInput(const std::vector<char> & textData, const std::vector<char> & fileData)
+          : m_textBuffer(textData.data(), textData.size()),
+            m_fileBuffer(fileData.data(), fileData.size()),
+            m_textStream(&m_textBuffer),
+            m_fileStream(&m_fileBuffer),
             m_hasFile(fileData.size() != 0)
         {}
         
@@ -57,8 +70,10 @@ namespace
         }
         
     private:
-        std::istringstream m_textStream;
-        std::istringstream m_fileStream;
+        stromx::runtime::impl::MemoryInputBuffer m_textBuffer;
+        stromx::runtime::impl::MemoryInputBuffer m_fileBuffer;
+        std::istream m_textStream;
+        std::istream m_fileStream;
         bool m_hasFile;
     };
     
@@ -77,9 +92,13 @@ namespace stromx
     {
         namespace impl
         {            
+            const uint32_t Client::MAX_HEADER_SIZE;
+            const uint64_t Client::MAX_PAYLOAD_SIZE;
+            
             Client::Client(const std::string& url, const std::string& port)
               : m_socket(m_ioService),
-                m_stopped(false)
+                m_stopped(false),
+                m_sharedMemory(0)
             {
                 try
                 {
@@ -88,6 +107,14 @@ namespace stromx
                     ip::tcp::resolver::iterator endpoint_iterator = resolver.resolve(query);
 
                     boost::asio::connect(m_socket, endpoint_iterator);
+                    
+                    // announce that this client understands the binary format and
+                    // can read payloads from shared memory if it runs on the host of
+                    // the server
+                    const bool isLoopback = m_socket.remote_endpoint().address().is_loopback();
+                    boost::array<char, WireFormat::HELLO_SIZE> hello;
+                    WireFormat::writeHello(hello.data(), isLoopback ? WireFormat::SHARED_MEMORY : 0);
+                    boost::asio::write(m_socket, buffer(hello));
                 }
                 catch (boost::system::system_error &)
                 {
@@ -98,105 +125,340 @@ namespace stromx
             Client::~Client()
             {
                 stop();
+                delete m_sharedMemory;
             }
             
             const DataContainer Client::receive(const AbstractFactory& factory)
+            {
+                DataContainer data;
+                switch (tryReceive(factory, data))
+                {
+                case STOPPED:
+                    throw Stopped();
+                case NO_CONNECTION:
+                    throw NoConnection();
+                default:
+                    return data;
+                }
+            }
+            
+            Client::Status Client::tryReceive(const AbstractFactory& factory, DataContainer & data)
+            {
+                const Status status = read(std::vector<mutable_buffer>(1, buffer(m_preamble)));
+                if (status != RECEIVED)
+                    return status;
+                
+                // the server sends binary frames only after it received the hello
+                // message, i.e. the format must be determined for each frame
+                if (WireFormat::hasMagic(m_preamble.data()))
+                    return receiveBinary(factory, data);
+                else
+                    return receiveText(factory, data);
+            }
+
+            void Client::stop()
+            {
+                lock_t l(m_mutex);
+                m_stopped = true;
+                m_ioService.stop();
+            }
+            
+            Client::Status Client::read(const std::vector<mutable_buffer> & buffers)
             {
                 {
                     lock_t l(m_mutex);
                     
                     if (m_stopped)
-                        throw Stopped();
+                        return STOPPED;
                     
                     m_ioService.reset();
                 }
                 
                 m_error.clear();
-                asyncReceive();
+                async_read(m_socket, buffers, boost::bind(&Client::handleRead, this,
+                                                          placeholders::error, placeholders::bytes_transferred)); 
                 m_ioService.run();
                 
                 {
                     lock_t l(m_mutex);
                     
                     if (m_stopped)
-                        throw Stopped();
+                        return STOPPED;
                 }
                 
                 if (m_error)
-                    throw NoConnection();
-                
+                    return NO_CONNECTION;
                 
-                return deserializeData(factory);
+                return RECEIVED;
             }
-
-            void Client::stop()
+            
+            void Client::handleRead(const boost::system::error_code& error, size_t /*bytes_transferred*/)
             {
-                lock_t l(m_mutex);
-                m_stopped = true;
-                m_ioService.stop();
+                if (error)
+                    m_error = error;
             }
             
-            void Client::asyncReceive()
+            Client::Status Client::receiveText(const AbstractFactory& factory, DataContainer & data)
             {
-                std::vector<mutable_buffer> sizeBuffers;
-                sizeBuffers.push_back(buffer(m_headerSizeBuffer));
-                sizeBuffers.push_back(buffer(m_textSizeBuffer));
-                sizeBuffers.push_back(buffer(m_fileSizeBuffer));
+                const char* sizes = m_preamble.data();
+                m_headerData.resize(sizeFromBuffer(sizes));
+                m_textData.resize(sizeFromBuffer(sizes + SerializationHeader::NUM_SIZE_DIGITS));
+                m_fileData.resize(sizeFromBuffer(sizes + 2 * SerializationHeader::NUM_SIZE_DIGITS));
+                
+                std::vector<mutable_buffer> dataBuffers;
+                dataBuffers.push_back(buffer(m_headerData));
+                dataBuffers.push_back(buffer(m_textData));
+                dataBuffers.push_back(buffer(m_fileData));
                 
-                async_read(m_socket, sizeBuffers, boost::bind(&Client::handleHeaderRead, this,
-                                                              placeholders::error, placeholders::bytes_transferred)); 
+                const Status status = read(dataBuffers);
+                if (status != RECEIVED)
+                    return status;
+                
+                SerializationHeader header;
+                MemoryInputBuffer headerBuffer(m_headerData.data(), m_headerData.size());
+                std::istream headerStream(&headerBuffer);
+                boost::archive::text_iarchive headerArchive(headerStream);
+                headerArchive >> header;
+                
+                if(header.payload != SerializationHeader::SERIALIZED)
+                    data = readSharedMemory(header, factory);
+                else
+                    data = deserializeData(header, factory);
+                
+                return RECEIVED;
             }
             
-            void Client::handleHeaderRead(const boost::system::error_code& error, size_t /*bytes_transferred*/)
+            Client::Status Client::receiveBinary(const AbstractFactory& factory, DataContainer & data)
             {
-                if (error)
+                WireFormat::Preamble preamble;
+                try
                 {
-                    m_error = error;
-                    return;
+                    preamble = WireFormat::readPreamble(m_preamble.data());
+                    
+                    if(preamble.headerSize > MAX_HEADER_SIZE || preamble.textSize > MAX_PAYLOAD_SIZE 
+                       || preamble.fileSize > MAX_PAYLOAD_SIZE - preamble.textSize)
+                    {
+                        throw DeserializationError("", "", "Frame exceeds the maximal size.");
+                    }
+                }
+                catch(DeserializationError &)
+                {
+                    // the following data can not be assigned to frames
+                    disconnect();
+                    throw;
                 }
                 
-                unsigned int headerSize = sizeFromBuffer(m_headerSizeBuffer.data());
-                unsigned int textSize = sizeFromBuffer(m_textSizeBuffer.data());
-                unsigned int fileSize = sizeFromBuffer(m_fileSizeBuffer.data());
+                m_headerData.resize(preamble.headerSize);
+                Status status = read(std::vector<mutable_buffer>(1, buffer(m_headerData)));
+                if (status != RECEIVED)
+                    return status;
                 
-                m_headerData.resize(headerSize);
-                m_textData.resize(textSize);
-                m_fileData.resize(fileSize);
+                const uint64_t payloadSize = preamble.textSize + preamble.fileSize;
+                SerializationHeader header;
+                DataContainer container;
+                Matrix* matrix = 0;
+                try
+                {
+                    WireFormat::readHeader(m_headerData.data(), m_headerData.size(), header);
+                    
+                    switch (header.payload)
+                    {
+                    case SerializationHeader::SHARED_IMAGE:
+                    case SerializationHeader::SHARED_MATRIX:
+                        if (payloadSize != 0)
+                            throw DeserializationError(header.package, header.type, "Unexpected payload of shared data.");
+                        break;
+                    case SerializationHeader::RAW_IMAGE:
+                    case SerializationHeader::RAW_MATRIX:
+                        // each element has at least one byte, i.e. wrong dimensions are
+                        // rejected before the data is allocated
+                        if (preamble.textSize != 0 || uint64_t(header.rows) * header.cols > preamble.fileSize)
+                            throw DeserializationError(header.package, header.type, "Payload does not match the size of the data.");
+                        
+                        matrix = newMatrix(header, factory, container);
+                        if (preamble.fileSize != uint64_t(matrix->cols()) * matrix->valueSize() * matrix->rows())
+                            throw DeserializationError(header.package, header.type, "Payload does not match the size of the data.");
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                catch(...)
+                {
+                    // skip the payload to receive the next frame
+                    status = skip(payloadSize);
+                    if (status != RECEIVED)
+                        return status;
+                    
+                    throw;
+                }
+                
+                if (matrix)
+                {
+                    status = receiveRows(*matrix);
+                    if (status != RECEIVED)
+                        return status;
+                    
+                    data = container;
+                    return RECEIVED;
+                }
+                
+                if (header.payload == SerializationHeader::SHARED_IMAGE || header.payload == SerializationHeader::SHARED_MATRIX)
+                {
+                    data = readSharedMemory(header, factory);
+                    return RECEIVED;
+                }
+                
+                m_textData.resize(preamble.textSize);
+                m_fileData.resize(preamble.fileSize);
                 
                 std::vector<mutable_buffer> dataBuffers;
-                dataBuffers.push_back(buffer(m_headerData));
                 dataBuffers.push_back(buffer(m_textData));
                 dataBuffers.push_back(buffer(m_fileData));
                 
-                async_read(m_socket, dataBuffers, boost::bind(&Client::handleDataRead, this,
-                                                              placeholders::error, placeholders::bytes_transferred)); 
+                status = read(dataBuffers);
+                if (status != RECEIVED)
+                    return status;
+                
+                data = deserializeData(header, factory);
+                return RECEIVED;
             }
             
-            void Client::handleDataRead(const boost::system::error_code& error, size_t /*bytes_transferred*/)
+            Client::Status Client::receiveRows(Matrix & matrix)
             {
-                if (error)
-                    m_error = error;
+                // read the rows directly to the data
+                const std::size_t rowSize = matrix.cols() * matrix.valueSize();
+                std::vector<mutable_buffer> rows;
+                if(matrix.stride() == rowSize)
+                {
+                    rows.push_back(buffer(matrix.data(), rowSize * matrix.rows()));
+                }
+                else
+                {
+                    for(unsigned int i = 0; i < matrix.rows(); ++i)
+                        rows.push_back(buffer(matrix.data() + i * matrix.stride(), rowSize));
+                }
+                
+                return read(rows);
             }
             
-            const DataContainer Client::deserializeData(const AbstractFactory& factory)
+            Client::Status Client::skip(uint64_t size)
             {
-                SerializationHeader header;
-                std::istringstream headerStream(std::string(m_headerData.data(), m_headerData.size()));
-                boost::archive::text_iarchive headerArchive(headerStream);
-                headerArchive >> header;
+                boost::array<char, 65536> discarded;
+                while (size > 0)
+                {
+                    const std::size_t chunk = std::size_t(std::min(size, uint64_t(discarded.size())));
+                    const Status status = read(std::vector<mutable_buffer>(1, buffer(discarded.data(), chunk)));
+                    if (status != RECEIVED)
+                        return status;
+                    
+                    size -= chunk;
+                }
                 
+                return RECEIVED;
+            }
+            
+            void Client::disconnect()
+            {
+                // the next read fails and the client reports that it is not connected
+                boost::system::error_code error;
+                m_socket.close(error);
+            }
+            
+            const DataContainer Client::deserializeData(const SerializationHeader & header, const AbstractFactory& factory)
+            {
                 // create the data object and store in a container
                 Data* data = factory.newData(header.package, header.type);
                 DataContainer container(data);
                 
-                std::string textString(m_textData.data(), m_textData.size());
-                std::string fileString(m_fileData.data(), m_fileData.size());
-                
-                StreamInput input(textString, fileString);
+                StreamInput input(m_textData, m_fileData);
                 data->deserialize(input, header.version);
                 
                 return container;
             }
+            
+            Matrix* Client::newMatrix(const SerializationHeader & header, const AbstractFactory& factory, 
+                                      DataContainer & container) const
+            {
+                Data* data = factory.newData(header.package, header.type);
+                container = DataContainer(data);
+                
+                if(header.payload == SerializationHeader::SHARED_IMAGE || header.payload == SerializationHeader::RAW_IMAGE)
+                {
+                    ImageWrapper* image = dynamic_cast<ImageWrapper*>(data);
+                    if(image)
+                    {
+                        image->resize(header.cols, header.rows, Image::PixelType(header.elementType));
+                        return image;
+                    }
+                }
+                else
+                {
+                    MatrixWrapper* matrix = dynamic_cast<MatrixWrapper*>(data);
+                    if(matrix)
+                    {
+                        matrix->resize(header.rows, header.cols, Matrix::ValueType(header.elementType));
+                        return matrix;
+                    }
+                }
+                
+                throw DeserializationError(header.package, header.type, 
+                                           "Only image and matrix wrappers can be received without serialization.");
+            }
+            
+            const DataContainer Client::readSharedMemory(const SerializationHeader & header, const AbstractFactory& factory)
+            {
+                // the ring is opened upon the first payload it contains
+                if(! m_sharedMemory || m_sharedMemory->name() != header.sharedMemory)
+                {
+                    delete m_sharedMemory;
+                    m_sharedMemory = 0;
+                    
+                    try
+                    {
+                        m_sharedMemory = new SharedMemoryRing(header.sharedMemory);
+                    }
+                    catch(Exception &)
+                    {
+                        // the server sends the following payloads over the socket
+                        releaseSlot(header.slot, 0);
+                        throw;
+                    }
+                }
+                
+                DataContainer container;
+                try
+                {
+                    Matrix* matrix = newMatrix(header, factory, container);
+                    
+                    const std::size_t rowSize = matrix->cols() * matrix->valueSize();
+                    if(rowSize * matrix->rows() > m_sharedMemory->slotSize())
+                        throw DeserializationError(header.package, header.type, "Payload exceeds the shared memory slot.");
+                    
+                    const uint8_t* slotData = m_sharedMemory->slot(header.slot);
+                    for(unsigned int i = 0; i < matrix->rows(); ++i)
+                        std::memcpy(matrix->data() + i * matrix->stride(), slotData + i * rowSize, rowSize);
+                }
+                catch(...)
+                {
+                    releaseSlot(header.slot, WireFormat::SLOT_READ);
+                    throw;
+                }
+                
+                releaseSlot(header.slot, WireFormat::SLOT_READ);
+                
+                return container;
+            }
+            
+            void Client::releaseSlot(const uint32_t slot, const uint32_t flags)
+            {
+                // the server releases the slot, this way it can release the
+                // slots of clients which disconnect before they read their data
+                boost::array<char, WireFormat::HELLO_SIZE> release;
+                WireFormat::writeRelease(release.data(), slot, flags);
+                boost::system::error_code error;
+                boost::asio::write(m_socket, buffer(release), error);
+            }
         }
     }
 }
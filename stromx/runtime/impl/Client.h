@@ -14,8 +14,8 @@
  *  limitations under the License.
  */
 
-#ifndef STROMX_RUNTIME_IMPL_SERVER_H
-#define STROMX_RUNTIME_IMPL_SERVER_H
+#ifndef STROMX_RUNTIME_IMPL_CLIENT_H
+#define STROMX_RUNTIME_IMPL_CLIENT_H
 
 #include <deque>
 #include <boost/array.hpp>
@@ -23,6 +23,7 @@
 #include <boost/thread.hpp>
 
 #include "stromx/runtime/impl/SerializationHeader.h"
+#include "stromx/runtime/impl/WireFormat.h"
 #include "stromx/runtime/DataContainer.h"
 
 namespace stromx
@@ -30,29 +31,52 @@ namespace stromx
     namespace runtime
     {
         class AbstractFactory;
+        class Data;
+        class Matrix;
         
         namespace impl
         {
+            class SharedMemoryRing;
+            
             class Client
             {
         public:
                 class NoConnection : public std::exception {};
                 class Stopped : public std::exception {};
                 
+                enum Status
+                {
+                    RECEIVED,
+                    STOPPED,
+                    NO_CONNECTION
+                };
+                
                 Client(const std::string & url, const std::string & port);
                 ~Client();
                 
                 const DataContainer receive(const AbstractFactory & factory);
+                Status tryReceive(const AbstractFactory & factory, DataContainer & data);
                 void stop();
                 
             private:
                 typedef boost::lock_guard<boost::mutex> lock_t;
                 
-                void run();
-                void asyncReceive();
-                void handleHeaderRead(const boost::system::error_code& error, size_t bytes_transferred);
-                void handleDataRead(const boost::system::error_code& error, size_t bytes_transferred);
-                const DataContainer deserializeData(const AbstractFactory& factory);
+                // frames which exceed these sizes are rejected
+                static const uint32_t MAX_HEADER_SIZE = 1 << 20;
+                static const uint64_t MAX_PAYLOAD_SIZE = uint64_t(1) << 30;
+                
+                Status read(const std::vector<boost::asio::mutable_buffer> & buffers);
+                void handleRead(const boost::system::error_code& error, size_t bytes_transferred);
+                Status receiveText(const AbstractFactory& factory, DataContainer & data);
+                Status receiveBinary(const AbstractFactory& factory, DataContainer & data);
+                Status receiveRows(Matrix & matrix);
+                Status skip(uint64_t size);
+                void disconnect();
+                const DataContainer deserializeData(const SerializationHeader & header, const AbstractFactory& factory);
+                const DataContainer readSharedMemory(const SerializationHeader & header, const AbstractFactory& factory);
+                void releaseSlot(const uint32_t slot, const uint32_t flags);
+                Matrix* newMatrix(const SerializationHeader & header, const AbstractFactory& factory, 
+                                  DataContainer & container) const;
                 
                 boost::asio::io_service m_ioService;
                 boost::asio::ip::tcp::socket m_socket;
@@ -60,16 +84,17 @@ namespace stromx
                 boost::mutex m_mutex;
                 bool m_stopped;
                 
-                boost::array<char, impl::SerializationHeader::NUM_SIZE_DIGITS> m_headerSizeBuffer;
-                boost::array<char, impl::SerializationHeader::NUM_SIZE_DIGITS> m_textSizeBuffer;
-                boost::array<char, impl::SerializationHeader::NUM_SIZE_DIGITS> m_fileSizeBuffer;
+                // the preambles of the text and the binary format have the same size
+                boost::array<char, WireFormat::PREAMBLE_SIZE> m_preamble;
                 
                 std::vector<char> m_headerData;
                 std::vector<char> m_textData;
                 std::vector<char> m_fileData;
+                
+                SharedMemoryRing* m_sharedMemory;
             };
         }
     }
 }
 
-#endif // STROMX_RUNTIME_IMPL_SERVER_H
+#endif // STROMX_RUNTIME_IMPL_CLIENT_H
@@ -19,6 +19,7 @@
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Recycler.h"
 #include "stromx/runtime/impl/DataContainerImpl.h"
+#include "stromx/runtime/impl/Tracer.h"
 
 namespace stromx
 {
@@ -26,12 +27,37 @@ namespace stromx
     {
         namespace impl
         {
+            namespace
+            {
+                // counts the threads which wait for access to a container
+                class WaiterGuard
+                {
+                public:
+                    explicit WaiterGuard(boost::atomic<unsigned int> & numWaiters)
+                      : m_numWaiters(numWaiters)
+                    {
+                        m_numWaiters++;
+                    }
+                    
+                    ~WaiterGuard()
+                    {
+                        m_numWaiters--;
+                    }
+                    
+                private:
+                    boost::atomic<unsigned int> & m_numWaiters;
+                };
+            }
+            
+            const unsigned int DataContainerImpl::WRITE_ACCESS;
+            
             DataContainerImpl::DataContainerImpl(Data* data, const bool isReadOnly)
-            : m_readAccessCounter(0),
-                m_writeAccess(false),
+            : m_accessState(0),
+                m_numWaiters(0),
                 m_recycleAccess(0),
                 m_data(data),
-                m_isReadOnly(isReadOnly)
+                m_isReadOnly(isReadOnly),
+                m_isCopyOnWrite(false)
             {
                 if(! data)
                     throw WrongArgument();
@@ -39,33 +65,11 @@ namespace stromx
             
             void DataContainerImpl::getReadAccess(const bool waitWithTimeout, const unsigned int timeout)
             {
-                unique_lock_t lock(m_mutex);
-                
-                try
-                {
-                    if(waitWithTimeout)
-                    {
-                        while(m_writeAccess)
-                        {
-                            if(m_cond.wait_for(lock, boost::chrono::milliseconds(timeout))
-                                == boost::cv_status::timeout)
-                            {
-                                throw Timeout();
-                            }
-                        }
-                    }
-                    else
-                    {
-                        while(m_writeAccess)
-                            m_cond.wait(lock);
-                    }
-                }
-                catch(boost::thread_interrupted&)
-                {
-                    throw Interrupt();
-                } 
+                if(tryAcquireReadAccess())
+                    return;
                 
-                m_readAccessCounter++;
+                waitForAccess(&DataContainerImpl::tryAcquireReadAccess, "waitForReadAccess",
+                              waitWithTimeout, timeout);
             }
             
             DataContainerImpl::~DataContainerImpl()
@@ -77,26 +81,70 @@ namespace stromx
 
             void DataContainerImpl::returnReadAccess()
             {
-                lock_t lock(m_mutex);
-                
-                BOOST_ASSERT(m_readAccessCounter);
-                m_readAccessCounter--;
+                BOOST_ASSERT(m_accessState & ~WRITE_ACCESS);
+                m_accessState--;
                 
-                m_cond.notify_all();
+                notifyWaiters();
             }
                 
             void DataContainerImpl::getWriteAccess(const bool waitWithTimeout, const unsigned int timeout)
             {
                 if (m_isReadOnly)
                     throw WrongArgument("Failed to obtain write access for read-only data container.");
-                    
+                
+                if(tryAcquireWriteAccess())
+                    return;
+                
+                waitForAccess(&DataContainerImpl::tryAcquireWriteAccess, "waitForWriteAccess",
+                              waitWithTimeout, timeout);
+            }
+
+            void DataContainerImpl::returnWriteAccess()
+            {
+                BOOST_ASSERT(m_accessState == WRITE_ACCESS);
+                m_accessState = 0;
+                
+                notifyWaiters();
+            }
+            
+            bool DataContainerImpl::tryAcquireReadAccess()
+            {
+                unsigned int state = m_accessState.load();
+                while(! (state & WRITE_ACCESS))
+                {
+                    if(m_accessState.compare_exchange_weak(state, state + 1))
+                        return true;
+                }
+                
+                return false;
+            }
+            
+            bool DataContainerImpl::tryAcquireWriteAccess()
+            {
+                unsigned int state = 0;
+                return m_accessState.compare_exchange_strong(state, WRITE_ACCESS);
+            }
+            
+            void DataContainerImpl::waitForAccess(const TryAcquireFunction tryAcquire, const char* const spanName,
+                                                  const bool waitWithTimeout, const unsigned int timeout)
+            {
                 unique_lock_t lock(m_mutex);
                 
+                // the waiter must be registered before the access state is
+                // checked again, otherwise a concurrent release could miss it
+                WaiterGuard guard(m_numWaiters);
+                
+                if((this->*tryAcquire)())
+                    return;
+                
+                Tracer::Span span;
+                span.begin("data", spanName);
+                
                 try
                 {
                     if(waitWithTimeout)
                     {
-                        while(m_readAccessCounter || m_writeAccess)
+                        while(! (this->*tryAcquire)())
                         {
                             if(m_cond.wait_for(lock, boost::chrono::milliseconds(timeout))
                                 == boost::cv_status::timeout)
@@ -107,7 +155,7 @@ namespace stromx
                     }
                     else
                     {
-                        while(m_readAccessCounter || m_writeAccess)
+                        while(! (this->*tryAcquire)())
                             m_cond.wait(lock);
                     }
                 }
@@ -115,17 +163,17 @@ namespace stromx
                 {
                     throw Interrupt();
                 } 
-                    
-                m_writeAccess = true;
             }
-
-            void DataContainerImpl::returnWriteAccess()
+            
+            void DataContainerImpl::notifyWaiters()
             {
-                lock_t lock(m_mutex);
-                
-                BOOST_ASSERT(m_writeAccess);
-                m_writeAccess = false;
+                // the access state has been changed before the waiters are
+                // counted, i.e. a thread which is not counted yet will find
+                // the new state when it checks the state after registering
+                if(m_numWaiters == 0)
+                    return;
                 
+                lock_t lock(m_mutex);
                 m_cond.notify_all();
             }
 
@@ -159,6 +207,18 @@ namespace stromx
                 m_cond.notify_all();
             }
             
+            Metadata DataContainerImpl::metadata()
+            {
+                lock_t lock(m_mutex);
+                return m_metadata;
+            }
+            
+            void DataContainerImpl::setMetadata(const Metadata& metadata)
+            {
+                lock_t lock(m_mutex);
+                m_metadata = metadata;
+            }
+            
             void DataContainerImpl::recycle()
             {
                 lock_t lock(m_mutex);
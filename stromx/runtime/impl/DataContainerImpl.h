@@ -17,10 +17,12 @@
 #ifndef STROMX_RUNTIME_IMPL_DATACONTAINERIMPL_H
 #define STROMX_RUNTIME_IMPL_DATACONTAINERIMPL_H
 
+#include <boost/atomic.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include "stromx/runtime/Config.h"
+#include "stromx/runtime/Metadata.h"
 
 namespace stromx
 {
@@ -49,20 +51,38 @@ namespace stromx
                 Data* data() const { return m_data; }
                 bool isReadOnly() const { return m_isReadOnly; }
                 
+                bool isCopyOnWrite() const { return m_isCopyOnWrite; }
+                void setCopyOnWrite(const bool copyOnWrite) { m_isCopyOnWrite = copyOnWrite; }
+                
+                Metadata metadata();
+                void setMetadata(const Metadata & metadata);
+                
             private:
                 typedef boost::lock_guard<boost::mutex> lock_t;
                 typedef boost::unique_lock<boost::mutex> unique_lock_t;
+                typedef bool (DataContainerImpl::*TryAcquireFunction)();
+                
+                // the highest bit of the access state is set if there is a writer,
+                // the remaining bits count the readers
+                static const unsigned int WRITE_ACCESS = 1u << 31;
                 
                 boost::mutex m_mutex;
                 boost::condition_variable_any m_cond;
                 
                 void recycle();
+                bool tryAcquireReadAccess();
+                bool tryAcquireWriteAccess();
+                void waitForAccess(const TryAcquireFunction tryAcquire, const char* const spanName,
+                                   const bool waitWithTimeout, const unsigned int timeout);
+                void notifyWaiters();
                 
-                unsigned int m_readAccessCounter;
-                bool m_writeAccess;
+                boost::atomic<unsigned int> m_accessState;
+                boost::atomic<unsigned int> m_numWaiters;
                 Recycler* m_recycleAccess;
                 Data* m_data;
                 const bool m_isReadOnly;
+                boost::atomic<bool> m_isCopyOnWrite;
+                Metadata m_metadata;
             };
         }
     }
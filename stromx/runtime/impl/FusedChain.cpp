@@ -0,0 +1,111 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Operator.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/impl/FusedChain.h"
+#include "stromx/runtime/impl/InputNode.h"
+#include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/impl/Tracer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            std::vector<FusedChain> FusedChain::create(const std::vector<InputNode*>& sequence, 
+                                                       const bool fuse)
+            {
+                std::vector<FusedChain> chains;
+                
+                for(std::vector<InputNode*>::const_iterator node = sequence.begin();
+                    node != sequence.end();
+                    ++node)
+                {
+                    if(fuse && ! chains.empty() && canFuse(chains.back().m_nodes.back(), *node))
+                        chains.back().m_nodes.push_back(*node);
+                    else
+                        chains.push_back(FusedChain(*node));
+                }
+                
+                return chains;
+            }
+            
+            FusedChain::FusedChain(InputNode*const node)
+            {
+                m_nodes.push_back(node);
+            }
+            
+            bool FusedChain::canFuse(const InputNode*const previous, const InputNode*const next)
+            {
+                if(! previous->isConnected() || ! next->isConnected())
+                    return false;
+                
+                // the next node must be served by the operator of the previous node...
+                const OutputNode & source = next->source();
+                Operator* const op = previous->op();
+                if(source.op() != op)
+                    return false;
+                
+                // ...which must have no other connectors...
+                if(op->info().inputs().size() != 1 || op->info().outputs().size() != 1)
+                    return false;
+                
+                // ...and no other consumers
+                return source.connectedInputs().size() == 1;
+            }
+            
+            void FusedChain::setInputData()
+            {
+                InputNode* const head = m_nodes.front();
+                
+                if(m_nodes.size() == 1)
+                {
+                    head->setInputData();
+                    return;
+                }
+                
+                Tracer::Span span("input", "fused", &head->op()->name());
+                
+                DataContainer data = head->getSourceData();
+                
+                for(unsigned int i = 0; i < m_nodes.size() - 1; ++i)
+                {
+                    Operator* const op = m_nodes[i]->op();
+                    
+                    try
+                    {
+                        data = op->process(m_nodes[i]->inputId(), data,
+                                           m_nodes[i + 1]->source().outputId());
+                    }
+                    catch(OperatorError & ex)
+                    {
+                        ex.setName(op->name());
+                        throw;
+                    }
+                    
+                    // the data was consumed without producing any output
+                    if(data.empty())
+                        return;
+                }
+                
+                m_nodes.back()->setInputData(data);
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_FUSEDCHAIN_H
+#define STROMX_RUNTIME_IMPL_FUSEDCHAIN_H
+
+#include <vector>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Operator;
+        
+        namespace impl
+        {
+            class InputNode;
+            
+            /** 
+             * A sequence of input nodes of a thread which is processed as a single
+             * step. Each node after the first one is connected to the only output of 
+             * the operator of the previous node. The data is passed directly from 
+             * one operator to the next instead of going through the connected input
+             * and output nodes.
+             */
+            class FusedChain
+            {
+        public:
+                /** 
+                 * Splits the input sequence of a thread into chains. If \c fuse is 
+                 * false each chain consists of a single node.
+                 */
+                static std::vector<FusedChain> create(const std::vector<InputNode*> & sequence,
+                                                      const bool fuse);
+                
+                explicit FusedChain(InputNode* const node);
+                
+                const std::vector<InputNode*> & nodes() const { return m_nodes; }
+                
+                /**
+                 * Sets the input data of all nodes of the chain. The function
+                 * returns early if an operator of the chain did not produce any output.
+                 */
+                void setInputData();
+                
+            private:
+                static bool canFuse(const InputNode* const previous, const InputNode* const next);
+                
+                std::vector<InputNode*> m_nodes;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_FUSEDCHAIN_H
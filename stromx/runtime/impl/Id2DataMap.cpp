@@ -14,6 +14,8 @@
  *  limitations under the License.
  */
 
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Input.h"
@@ -40,25 +42,43 @@ namespace stromx
             bool isConnector<Output>(const Parameter* parameter)
             {
                 return parameter->originalType() == Description::OUTPUT;
-            }            
+            }
+        }
+
+        namespace impl
+        {
+            const unsigned int Id2DataMap::MAX_TABLE_SIZE;
+            const int Id2DataMap::NO_SLOT;
+            
+            Id2DataMap::Id2DataMap()
+              : m_observer(0)
+            {
+            }
+            
+            void Id2DataMap::initialize(const std::vector<const Input*> & descriptions, const std::vector<const Parameter*> & parameters)
+            {
+                populate(descriptions, parameters);
+            }
+            
+            void Id2DataMap::initialize(const std::vector<const Output*> & descriptions, const std::vector<const Parameter*> & parameters)
+            {
+                populate(descriptions, parameters);
+            }
             
             template <class description_t>
-            void populateId2DataMap(const std::vector<const description_t*> & descriptions,
-                                    const std::vector<const Parameter*> & parameters, 
-                                    std::map<unsigned int, DataContainer> & map,
-                                    std::set<unsigned int> & persistentParameters)
+            void Id2DataMap::populate(const std::vector<const description_t*> & descriptions,
+                                      const std::vector<const Parameter*> & parameters)
             {
-                map.clear();
-                persistentParameters.clear();
+                m_slots.clear();
+                m_table.clear();
                 
+                // collect the IDs of all connectors and whether they are persistent
+                std::vector<std::pair<unsigned int, bool> > ids;
                 for(typename std::vector<const description_t*>::const_iterator iter = descriptions.begin();
                     iter != descriptions.end();
                     ++iter)
                 {
-                    if(map.count((*iter)->id()))
-                        throw WrongArgument("Two descriptors with the same ID");
-                    
-                    map[(*iter)->id()] = DataContainer();
+                    ids.push_back(std::make_pair((*iter)->id(), false));
                 }
                 
                 for(typename std::vector<const Parameter*>::const_iterator iter = parameters.begin();
@@ -67,57 +87,95 @@ namespace stromx
                 {
                     if (! isConnector<description_t>(*iter))
                         continue;
-                        
-                    if(map.count((*iter)->id()))
-                        throw WrongArgument("Two descriptors with the same ID");
                     
-                    map[(*iter)->id()] = DataContainer();
+                    const bool isPersistent = (*iter)->updateBehavior() == Description::PERSISTENT;
+                    ids.push_back(std::make_pair((*iter)->id(), isPersistent));
+                }
+                
+                // the slots are sorted by their IDs
+                std::sort(ids.begin(), ids.end());
+                for(unsigned int i = 0; i < ids.size(); ++i)
+                {
+                    if(i > 0 && ids[i].first == ids[i - 1].first)
+                    {
+                        m_slots.clear();
+                        throw WrongArgument("Two descriptors with the same ID");
+                    }
                     
-                    if ((*iter)->updateBehavior() == Description::PERSISTENT)
-                        persistentParameters.insert((*iter)->id());
+                    m_slots.push_back(Slot(ids[i].first, ids[i].second));
                 }
+                
+                if(m_slots.empty())
+                    return;
+                
+                // build the lookup table unless the IDs are very large
+                const unsigned int maxId = m_slots.back().id;
+                if(maxId >= MAX_TABLE_SIZE)
+                    return;
+                
+                m_table.resize(maxId + 1, NO_SLOT);
+                for(unsigned int i = 0; i < m_slots.size(); ++i)
+                    m_table[m_slots[i].id] = i;
             }
-        }
 
-        namespace impl
-        {
-            Id2DataMap::Id2DataMap()
-              : m_observer(0)
+            void Id2DataMap::setObserver(const Id2DataMapObserver* const observer)
             {
+                m_observer = observer;
             }
             
-            void Id2DataMap::initialize(const std::vector<const Input*> & descriptions, const std::vector<const Parameter*> & parameters)
+            int Id2DataMap::findSlot(const unsigned int id) const
             {
-                populateId2DataMap(descriptions, parameters, m_map, m_persistentParameters);
+                if(id < m_table.size())
+                    return m_table[id];
+                
+                if(! m_table.empty())
+                    return NO_SLOT;
+                
+                // there is no lookup table, i.e. search the sorted slots
+                std::size_t first = 0;
+                std::size_t last = m_slots.size();
+                while(first < last)
+                {
+                    const std::size_t middle = (first + last) / 2;
+                    if(m_slots[middle].id < id)
+                        first = middle + 1;
+                    else
+                        last = middle;
+                }
+                
+                if(first < m_slots.size() && m_slots[first].id == id)
+                    return int(first);
+                
+                return NO_SLOT;
             }
             
-            void Id2DataMap::initialize(const std::vector<const Output*> & descriptions, const std::vector<const Parameter*> & parameters)
+            unsigned int Id2DataMap::slotIndex(const unsigned int id) const
             {
-                populateId2DataMap(descriptions, parameters, m_map, m_persistentParameters);
-            }
-
-            void Id2DataMap::setObserver(const Id2DataMapObserver* const observer)
-            {
-                m_observer = observer;
+                const int index = findSlot(id);
+                if(index == NO_SLOT)
+                    throw WrongId("No data with ID " + boost::lexical_cast<std::string>(id));
+                
+                return index;
             }
             
             const DataContainer & Id2DataMap::get(const unsigned int id) const
             {
-                std::map<unsigned int, DataContainer>::const_iterator iter = m_map.find(id);
-                if(iter == m_map.end())
-                    throw WrongId("No data with ID " + id);
-                
-                return iter->second;
+                return slot(id).data;
             }
             
             void Id2DataMap::set(const unsigned int id, const DataContainer & data)
             {
-                std::map<unsigned int, DataContainer>::iterator iter = m_map.find(id);
-                if(iter == m_map.end())
-                    throw WrongId("No data with ID " + id);
+                Slot & target = slot(id);
                 
-                DataContainer oldData = iter->second;
-                iter->second = data;
+                // without observer there is no need to keep the old data alive
+                if(! m_observer)
+                {
+                    target.data = data;
+                    return;
+                }
+                
+                DataContainer oldData = target.data;
+                target.data = data;
                 
                 if(m_observer)
                     m_observer->observe(id, oldData, data);
@@ -125,46 +183,40 @@ namespace stromx
             
             void Id2DataMap::clear()
             {
-                for(std::map<unsigned int, DataContainer>::iterator iter = m_map.begin();
-                    iter != m_map.end();
+                for(std::vector<Slot>::iterator iter = m_slots.begin();
+                    iter != m_slots.end();
                     ++iter)
                 {
-                    if (mustBeReset(iter->first))
-                        iter->second = DataContainer();
+                    if (! iter->isPersistent)
+                        iter->data = DataContainer();
                 }       
             }
             
             bool Id2DataMap::empty() const
             {
-                bool value = true;
-                for(std::map<unsigned int, DataContainer>::const_iterator iter = m_map.begin();
-                    iter != m_map.end();
+                for(std::vector<Slot>::const_iterator iter = m_slots.begin();
+                    iter != m_slots.end();
                     ++iter)
                 {
-                    if(! iter->second.empty())
-                    {
-                        value = false;
-                        break;
-                    }
+                    if(! iter->data.empty())
+                        return false;
                 }   
                 
-                return value;
+                return true;
             }
             
             bool Id2DataMap::canBeSet(const unsigned int id) const
             {
-                if (m_persistentParameters.count(id))
-                    return true;
-                    
-                return get(id).empty();
+                const Slot & target = slot(id);
+                
+                return target.isPersistent || target.data.empty();
             }
             
             bool Id2DataMap::mustBeReset(const unsigned int id) const
             {
-                if (m_persistentParameters.count(id))
-                    return false;
-                    
-                return true;
+                const int index = findSlot(id);
+                
+                return ! (index != NO_SLOT && m_slots[index].isPersistent);
             }
         }
     }
@@ -17,15 +17,13 @@
 #ifndef STROMX_RUNTIME_IMPL_ID2DATAMAP_H
 #define STROMX_RUNTIME_IMPL_ID2DATAMAP_H
 
-#include <map>
-#include <set>
 #include <vector>
+#include "stromx/runtime/DataContainer.h"
 
 namespace stromx
 {
     namespace runtime
     {
-        class DataContainer;
         class Input;
         class Output;
         class Parameter;
@@ -38,6 +36,14 @@ namespace stromx
                 virtual void observe(const unsigned int id, const DataContainer & oldData, const DataContainer & newData) const = 0;
             };
            
+            /** 
+             * Stores the data of the connectors of an operator. The data is kept in a 
+             * contiguous array of slots which is built upon initialization. Connector
+             * IDs are mapped to slots by a lookup table indexed by the ID, i.e. the
+             * slots are found in constant time regardless of how sparse the IDs are.
+             * Only if the largest ID exceeds MAX_TABLE_SIZE the slots are found by 
+             * binary search.
+             */
             class Id2DataMap
             {
             public:
@@ -56,8 +62,31 @@ namespace stromx
                 bool mustBeReset(const unsigned int id) const;
                 
             private:
-                std::map<unsigned int, DataContainer> m_map;
-                std::set<unsigned int> m_persistentParameters;
+                struct Slot
+                {
+                    Slot(const unsigned int id, const bool isPersistent)
+                      : id(id), isPersistent(isPersistent)
+                    {}
+                    
+                    unsigned int id;
+                    bool isPersistent;
+                    DataContainer data;
+                };
+                
+                // the lookup table is not used if it would have more entries
+                static const unsigned int MAX_TABLE_SIZE = 4096;
+                static const int NO_SLOT = -1;
+                
+                template <class description_t>
+                void populate(const std::vector<const description_t*> & descriptions,
+                              const std::vector<const Parameter*> & parameters);
+                int findSlot(const unsigned int id) const;
+                unsigned int slotIndex(const unsigned int id) const;
+                const Slot & slot(const unsigned int id) const { return m_slots[slotIndex(id)]; }
+                Slot & slot(const unsigned int id) { return m_slots[slotIndex(id)]; }
+                
+                std::vector<Slot> m_slots;
+                std::vector<int> m_table;
                 const Id2DataMapObserver* m_observer;
             };
         }
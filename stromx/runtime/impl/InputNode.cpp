@@ -19,6 +19,7 @@
 #include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/impl/InputNode.h"
 #include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/impl/Tracer.h"
 
 namespace stromx
 {
@@ -52,12 +53,22 @@ namespace stromx
             }
             
             void InputNode::setInputData()
+            {
+                Tracer::Span span("input", "setInputData", &m_operator->name());
+                
+                setInputData(getSourceData());
+            }
+            
+            DataContainer InputNode::getSourceData()
             {
                 if(! m_source)
                     throw WrongOperatorState(m_operator->info(), "Input node has not been connected.");
                 
-                DataContainer inputData = m_source->getOutputData();
-                
+                return m_source->getOutputData();
+            }
+            
+            void InputNode::setInputData(const DataContainer & inputData)
+            {
                 try
                 {
                     m_operator->setInputData(m_inputId, inputData);
@@ -69,6 +80,36 @@ namespace stromx
                 }
             }
             
+            InputNode::Readiness InputNode::readiness() const
+            {
+                if(! m_source)
+                    return BLOCKED;
+                
+                const Operator* source = m_source->op();
+                const bool hasOutput = source->hasOutputData(m_source->outputId());
+                
+                // without data the state of the target operator does not matter
+                // if the source is busy
+                if(! hasOutput && source->status() == Operator::EXECUTING)
+                    return BLOCKED;
+                
+                const bool canSetInput = m_operator->canSetInputData(m_inputId);
+                
+                if(hasOutput && canSetInput)
+                    return READY;
+                
+                // if the data is missing or the input is still occupied setInputData() 
+                // tries to execute the respective operator which blocks if the operator 
+                // is already executing in another thread
+                if((hasOutput || source->status() != Operator::EXECUTING)
+                    && (canSetInput || m_operator->status() != Operator::EXECUTING))
+                {
+                    return PENDING;
+                }
+                
+                return BLOCKED;
+            }
+            
             void InputNode::disconnect()
             {
                 if(m_source)
@@ -31,6 +31,16 @@ namespace stromx
             class InputNode
             {
         public:
+                enum Readiness
+                {
+                    /** Setting the input data would block until another thread proceeds. */
+                    BLOCKED,
+                    /** Setting the input data executes the source or the target operator. */
+                    PENDING,
+                    /** The source data is available and can be passed to the target. */
+                    READY
+                };
+                
                 InputNode(Operator* const op, const unsigned int inputId);
                 
                 unsigned int inputId() const { return m_inputId; }
@@ -40,6 +50,9 @@ namespace stromx
                 void connect(OutputNode* const output);
                 void disconnect();
                 void setInputData();
+                void setInputData(const DataContainer & data);
+                DataContainer getSourceData();
+                Readiness readiness() const;
                 
             private:
                 OutputNode *m_source;
@@ -0,0 +1,231 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/impl/LzCodec.h"
+
+#include <cstring>
+#include <vector>
+#include "stromx/runtime/Exception.h"
+
+namespace
+{
+    const std::size_t MIN_MATCH = 4;
+    const std::size_t MAX_OFFSET = 0xffff;
+    
+    // the last bytes of the input are always encoded as literals
+    const std::size_t LAST_LITERALS = 5;
+    const std::size_t MATCH_LIMIT = 12;
+    
+    const unsigned int HASH_BITS = 14;
+    
+    uint32_t read32(const uint8_t* const data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    
+    uint32_t hash(const uint32_t value)
+    {
+        return (value * 2654435761U) >> (32 - HASH_BITS);
+    }
+    
+    uint8_t* writeLength(uint8_t* out, std::size_t length)
+    {
+        while(length >= 255)
+        {
+            *out++ = 255;
+            length -= 255;
+        }
+        *out++ = uint8_t(length);
+        return out;
+    }
+    
+    uint8_t* writeSequence(uint8_t* out, const uint8_t* const literals, const std::size_t numLiterals,
+                           const std::size_t offset, const std::size_t matchLength)
+    {
+        uint8_t* token = out++;
+        
+        *token = uint8_t((numLiterals < 15 ? numLiterals : 15) << 4);
+        if(numLiterals >= 15)
+            out = writeLength(out, numLiterals - 15);
+        
+        std::memcpy(out, literals, numLiterals);
+        out += numLiterals;
+        
+        if(matchLength == 0)
+            return out;
+        
+        *out++ = uint8_t(offset & 0xff);
+        *out++ = uint8_t(offset >> 8);
+        
+        const std::size_t length = matchLength - MIN_MATCH;
+        *token |= uint8_t(length < 15 ? length : 15);
+        if(length >= 15)
+            out = writeLength(out, length - 15);
+        
+        return out;
+    }
+    
+    std::size_t readLength(const uint8_t* & in, const uint8_t* const end, std::size_t length)
+    {
+        if(length != 15)
+            return length;
+        
+        uint8_t value = 255;
+        while(value == 255)
+        {
+            if(in >= end)
+                throw stromx::runtime::Exception("Corrupt compressed data.");
+            
+            value = *in++;
+            length += value;
+        }
+        
+        return length;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            std::size_t LzCodec::maxCompressedSize(const std::size_t size)
+            {
+                return size + size / 255 + 16;
+            }
+            
+            std::size_t LzCodec::minCompressedSize(const std::size_t size)
+            {
+                // each byte of a length encodes at most 255 bytes of output
+                return size / 255;
+            }
+            
+            std::size_t LzCodec::compress(const uint8_t*const source, const std::size_t size,
+                                          uint8_t*const destination)
+            {
+                uint8_t* out = destination;
+                const uint8_t* anchor = source;
+                
+                if(size > MATCH_LIMIT)
+                {
+                    // positions of the last occurrences of 4-byte sequences
+                    std::vector<uint32_t> table(std::size_t(1) << HASH_BITS, 0);
+                    
+                    const uint8_t* in = source + 1;
+                    const uint8_t* const matchLimit = source + size - MATCH_LIMIT;
+                    const uint8_t* const end = source + size - LAST_LITERALS;
+                    
+                    // skip faster over data which does not compress
+                    unsigned int numMisses = 0;
+                    
+                    while(in < matchLimit)
+                    {
+                        const uint32_t sequence = read32(in);
+                        uint32_t & entry = table[hash(sequence)];
+                        const uint8_t* candidate = source + entry;
+                        entry = uint32_t(in - source);
+                        
+                        if(candidate >= in || std::size_t(in - candidate) > MAX_OFFSET
+                           || read32(candidate) != sequence)
+                        {
+                            in += 1 + (numMisses++ >> 6);
+                            continue;
+                        }
+                        
+                        numMisses = 0;
+                        
+                        // extend the match backwards over the pending literals
+                        while(in > anchor && candidate > source && in[-1] == candidate[-1])
+                        {
+                            --in;
+                            --candidate;
+                        }
+                        
+                        // and forwards
+                        std::size_t matchLength = MIN_MATCH;
+                        while(in + matchLength < end && in[matchLength] == candidate[matchLength])
+                            ++matchLength;
+                        
+                        out = writeSequence(out, anchor, in - anchor, in - candidate, matchLength);
+                        in += matchLength;
+                        anchor = in;
+                    }
+                }
+                
+                out = writeSequence(out, anchor, source + size - anchor, 0, 0);
+                return out - destination;
+            }
+            
+            void LzCodec::decompress(const uint8_t*const source, const std::size_t sourceSize,
+                                     uint8_t*const destination, const std::size_t size)
+            {
+                const uint8_t* in = source;
+                const uint8_t* const inEnd = source + sourceSize;
+                uint8_t* out = destination;
+                uint8_t* const outEnd = destination + size;
+                
+                while(in < inEnd)
+                {
+                    const uint8_t token = *in++;
+                    
+                    const std::size_t numLiterals = readLength(in, inEnd, token >> 4);
+                    if(numLiterals > std::size_t(inEnd - in) || numLiterals > std::size_t(outEnd - out))
+                        throw Exception("Corrupt compressed data.");
+                    
+                    std::memcpy(out, in, numLiterals);
+                    in += numLiterals;
+                    out += numLiterals;
+                    
+                    // the last sequence consists of literals only
+                    if(in == inEnd)
+                        break;
+                    
+                    if(inEnd - in < 2)
+                        throw Exception("Corrupt compressed data.");
+                    
+                    const std::size_t offset = in[0] | (std::size_t(in[1]) << 8);
+                    in += 2;
+                    
+                    const std::size_t matchLength = readLength(in, inEnd, token & 0x0f) + MIN_MATCH;
+                    if(offset == 0 || offset > std::size_t(out - destination) 
+                       || matchLength > std::size_t(outEnd - out))
+                    {
+                        throw Exception("Corrupt compressed data.");
+                    }
+                    
+                    // the source and destination of the copy overlap for short offsets
+                    const uint8_t* match = out - offset;
+                    if(offset >= matchLength)
+                    {
+                        std::memcpy(out, match, matchLength);
+                    }
+                    else
+                    {
+                        for(std::size_t i = 0; i < matchLength; ++i)
+                            out[i] = match[i];
+                    }
+                    out += matchLength;
+                }
+                
+                if(out != outEnd)
+                    throw Exception("Corrupt compressed data.");
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_LZCODEC_H
+#define STROMX_RUNTIME_IMPL_LZCODEC_H
+
+#include <cstddef>
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Fast LZ77 compression in the style of LZ4. The compressed data is a
+             * sequence of tokens. Each token describes a number of literal bytes
+             * which are copied verbatim and a match which repeats previous output 
+             * at an offset of up to 64 KiB. The codec favors speed over
+             * compression ratio.
+             */
+            class LzCodec
+            {
+            public:
+                /** Returns the maximal size of the compressed representation of \c size bytes. */
+                static std::size_t maxCompressedSize(const std::size_t size);
+                
+                /** 
+                 * Returns a lower bound of the size of the compressed representation of
+                 * \c size bytes, i.e. the data expands at most by this ratio when it is
+                 * decompressed.
+                 */
+                static std::size_t minCompressedSize(const std::size_t size);
+                
+                /** 
+                 * Compresses \c size bytes from \c source to \c destination and returns 
+                 * the compressed size. The destination must provide at least 
+                 * maxCompressedSize() bytes.
+                 */
+                static std::size_t compress(const uint8_t* const source, const std::size_t size,
+                                            uint8_t* const destination);
+                
+                /** 
+                 * Decompresses \c sourceSize bytes from \c source to exactly \c size
+                 * bytes in \c destination.
+                 * 
+                 * \throws Exception If the compressed data is corrupt.
+                 */
+                static void decompress(const uint8_t* const source, const std::size_t sourceSize,
+                                       uint8_t* const destination, const std::size_t size);
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_LZCODEC_H
@@ -0,0 +1,67 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/impl/MappedFile.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include "stromx/runtime/Exception.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            using namespace boost::interprocess;
+            
+            MappedFile::MappedFile(const std::string & path)
+            {
+                try
+                {
+                    // empty files can not be mapped
+                    if(boost::filesystem::file_size(path) == 0)
+                        return;
+                    
+                    // the mapping remains valid if the file is closed
+                    file_mapping file(path.c_str(), read_only);
+                    mapped_region region(file, read_only);
+                    m_region.swap(region);
+                }
+                catch(interprocess_exception &)
+                {
+                    throw FileAccessFailed(path, "", "Failed to map file.");
+                }
+                catch(boost::filesystem::filesystem_error &)
+                {
+                    throw FileAccessFailed(path, "", "Failed to map file.");
+                }
+            }
+            
+            const char* MappedFile::data() const
+            {
+                return static_cast<const char*>(m_region.get_address());
+            }
+            
+            std::size_t MappedFile::size() const
+            {
+                return m_region.get_size();
+            }
+        }
+    }
+}
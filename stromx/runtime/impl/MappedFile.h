@@ -0,0 +1,54 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_IMPL_MAPPEDFILE_H
+#define STROMX_RUNTIME_IMPL_MAPPEDFILE_H
+
+#include <string>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Read-only memory mapping of a complete file. The pages of the file
+             * are only loaded when they are accessed.
+             */
+            class MappedFile
+            {
+            public:
+                /** 
+                 * Maps the file \c path. 
+                 * 
+                 * \throws FileAccessFailed If the file can not be mapped.
+                 */
+                explicit MappedFile(const std::string & path);
+                
+                const char* data() const;
+                std::size_t size() const;
+                
+            private:
+                boost::interprocess::mapped_region m_region;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_MAPPEDFILE_H
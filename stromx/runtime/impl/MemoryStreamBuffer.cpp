@@ -0,0 +1,105 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            VectorOutputBuffer::VectorOutputBuffer(std::vector<char>& data)
+              : m_data(data)
+            {}
+            
+            VectorOutputBuffer::int_type VectorOutputBuffer::overflow(int_type c)
+            {
+                if(! traits_type::eq_int_type(c, traits_type::eof()))
+                    m_data.push_back(traits_type::to_char_type(c));
+                
+                return traits_type::not_eof(c);
+            }
+            
+            std::streamsize VectorOutputBuffer::xsputn(const char* s, std::streamsize n)
+            {
+                m_data.insert(m_data.end(), s, s + n);
+                return n;
+            }
+            
+            MemoryInputBuffer::MemoryInputBuffer(const char*const data, const std::size_t size)
+            {
+                // the buffer is never written, i.e. it is safe to cast away the constness
+                char* begin = const_cast<char*>(data);
+                setg(begin, begin, begin + size);
+            }
+            
+            MemoryInputBuffer::pos_type MemoryInputBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                                   std::ios_base::openmode which)
+            {
+                if(! (which & std::ios_base::in))
+                    return pos_type(off_type(-1));
+                
+                off_type base = 0;
+                if(dir == std::ios_base::cur)
+                    base = gptr() - eback();
+                else if(dir == std::ios_base::end)
+                    base = egptr() - eback();
+                
+                const off_type pos = base + off;
+                if(pos < 0 || pos > egptr() - eback())
+                    return pos_type(off_type(-1));
+                
+                setg(eback(), eback() + pos, egptr());
+                return pos_type(pos);
+            }
+            
+            MemoryInputBuffer::pos_type MemoryInputBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+            {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
+            }
+            
+            VectorOutput::VectorOutput(std::vector<char> & textData, std::vector<char> & fileData, 
+                                       const Encoding encoding)
+              : m_textBuffer(textData),
+                m_fileBuffer(fileData),
+                m_textStream(&m_textBuffer),
+                m_fileStream(&m_fileBuffer),
+                m_encoding(encoding)
+            {}
+            
+            std::ostream & VectorOutput::text()
+            {
+                return m_textStream;
+            }
+            
+            std::ostream & VectorOutput::openFile(const std::string & /*ext*/, const OpenMode /*mode*/)
+            {
+                return m_fileStream;
+            }
+            
+            std::ostream & VectorOutput::file()
+            {
+                return m_fileStream;
+            }
+            
+            OutputProvider::Encoding VectorOutput::encoding() const
+            {
+                return m_encoding;
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_MEMORYSTREAMBUFFER_H
+#define STROMX_RUNTIME_IMPL_MEMORYSTREAMBUFFER_H
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+#include "stromx/runtime/OutputProvider.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Stream buffer which appends the written characters to a vector. In 
+             * contrast to \c std::stringbuf the data can be accessed without copying it. 
+             */
+            class VectorOutputBuffer : public std::streambuf
+            {
+            public:
+                explicit VectorOutputBuffer(std::vector<char> & data);
+                
+            protected:
+                int_type overflow(int_type c);
+                std::streamsize xsputn(const char* s, std::streamsize n);
+                
+            private:
+                std::vector<char> & m_data;
+            };
+            
+            /** 
+             * Stream buffer which reads from a memory region without copying it. 
+             * The memory must remain valid as long as the buffer is in use.
+             */
+            class MemoryInputBuffer : public std::streambuf
+            {
+            public:
+                MemoryInputBuffer(const char* const data, const std::size_t size);
+                
+            protected:
+                pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                                 std::ios_base::openmode which = std::ios_base::in);
+                pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+            };
+            
+            /** 
+             * Output provider which appends the text and file representation of
+             * data to vectors. 
+             */
+            class VectorOutput : public OutputProvider
+            {
+            public:
+                VectorOutput(std::vector<char> & textData, std::vector<char> & fileData, const Encoding encoding);
+                
+                std::ostream & text();
+                std::ostream & openFile(const std::string & ext, const OpenMode mode);
+                std::ostream & file();
+                Encoding encoding() const;
+                
+            private:
+                VectorOutputBuffer m_textBuffer;
+                VectorOutputBuffer m_fileBuffer;
+                std::ostream m_textStream;
+                std::ostream m_fileStream;
+                Encoding m_encoding;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_MEMORYSTREAMBUFFER_H
@@ -21,6 +21,7 @@
 #include "stromx/runtime/impl/InputNode.h"
 #include "stromx/runtime/impl/Network.h"
 #include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/impl/SynchronizedOperatorKernel.h"
 
 namespace stromx
 {
@@ -63,6 +64,26 @@ namespace stromx
             
             void Network::activate()
             {
+                // data channels are passed from exactly one thread to another, 
+                // this is checked before any operator is activated
+                for(std::vector<Operator*>::iterator iter = m_operators.begin();
+                    iter != m_operators.end();
+                    ++iter)
+                {
+                    const Operator* op = *iter;
+                    for(std::vector<const Output*>::const_iterator output = op->info().outputs().begin();
+                        output != op->info().outputs().end();
+                        ++output)
+                    {
+                        const unsigned int id = (*output)->id();
+                        if(op->m_kernel->usesChannel(id) && op->getOutputNode(id)->connectedInputs().size() > 1)
+                        {
+                            throw OperatorError(op->info(), "An output with a data channel can not be connected to several inputs.",
+                                                op->name());
+                        }
+                    }
+                }
+                
                 for(std::vector<Operator*>::iterator iter = m_operators.begin();
                     iter != m_operators.end();
                     ++iter)
@@ -0,0 +1,254 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/impl/RecordLog.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/WireFormat.h"
+
+namespace
+{
+    const char MAGIC[] = { 'S', 'X', 'R', 'L' };
+    const unsigned int MAGIC_SIZE = 4;
+    
+    void write32(char* const data, const uint32_t value)
+    {
+        for(unsigned int i = 0; i < 4; ++i)
+            data[i] = char((value >> (8 * i)) & 0xff);
+    }
+    
+    void write64(char* const data, const uint64_t value)
+    {
+        for(unsigned int i = 0; i < 8; ++i)
+            data[i] = char((value >> (8 * i)) & 0xff);
+    }
+    
+    uint32_t read32(const char* const data)
+    {
+        uint32_t value = 0;
+        for(unsigned int i = 0; i < 4; ++i)
+            value |= uint32_t(uint8_t(data[i])) << (8 * i);
+        return value;
+    }
+    
+    uint64_t read64(const char* const data)
+    {
+        uint64_t value = 0;
+        for(unsigned int i = 0; i < 8; ++i)
+            value |= uint64_t(uint8_t(data[i])) << (8 * i);
+        return value;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            using namespace boost::interprocess;
+            
+            const uint32_t RecordLog::VERSION;
+            const unsigned int RecordLog::SEGMENT_HEADER_SIZE;
+            const unsigned int RecordLog::TIMESTAMP_SIZE;
+            
+            RecordLog::RecordLog(const std::string & path, const std::size_t segmentSize)
+              : m_path(path),
+                m_segmentSize(segmentSize),
+                m_numSegments(0),
+                m_used(0)
+            {
+                removeSegments();
+                openSegment(m_segmentSize);
+            }
+            
+            RecordLog::~RecordLog()
+            {
+                try
+                {
+                    closeSegment();
+                }
+                catch(FileAccessFailed &)
+                {
+                    // ignore exceptions in destructor
+                }
+            }
+            
+            const std::string RecordLog::segmentPath(const std::string & path, const unsigned int index)
+            {
+                std::ostringstream segment;
+                segment << path << "." << std::setw(6) << std::setfill('0') << index;
+                return segment.str();
+            }
+            
+            void RecordLog::writeTimestamp(const uint64_t timestamp, char* const data)
+            {
+                write64(data, timestamp);
+            }
+            
+            char* RecordLog::append(const std::size_t size)
+            {
+                if(m_used + size > m_region.get_size())
+                {
+                    closeSegment();
+                    openSegment(std::max(m_segmentSize, SEGMENT_HEADER_SIZE + size));
+                }
+                
+                char* entry = static_cast<char*>(m_region.get_address()) + m_used;
+                m_used += size;
+                
+                return entry;
+            }
+            
+            void RecordLog::removeSegments()
+            {
+                // the segments of a log are numbered without gaps, i.e. the
+                // first missing segment ends the previous log
+                for(unsigned int i = 0; ; ++i)
+                {
+                    const std::string path = segmentPath(m_path, i);
+                    try
+                    {
+                        if(! boost::filesystem::remove(path))
+                            break;
+                    }
+                    catch(boost::filesystem::filesystem_error &)
+                    {
+                        throw FileAccessFailed(path, m_path, "Failed to remove log segment.");
+                    }
+                }
+            }
+            
+            void RecordLog::openSegment(const std::size_t size)
+            {
+                m_currentPath = segmentPath(m_path, m_numSegments);
+                
+                try
+                {
+                    // allocate the segment with its full size
+                    {
+                        std::ofstream file(m_currentPath.c_str(), std::ios_base::out | std::ios_base::trunc 
+                                                                  | std::ios_base::binary);
+                        if(file.fail())
+                            throw FileAccessFailed(m_currentPath, m_path, "Failed to create log segment.");
+                    }
+                    boost::filesystem::resize_file(m_currentPath, size);
+                    
+                    file_mapping file(m_currentPath.c_str(), read_write);
+                    mapped_region region(file, read_write);
+                    m_region.swap(region);
+                }
+                catch(interprocess_exception &)
+                {
+                    throw FileAccessFailed(m_currentPath, m_path, "Failed to map log segment.");
+                }
+                catch(boost::filesystem::filesystem_error &)
+                {
+                    throw FileAccessFailed(m_currentPath, m_path, "Failed to allocate log segment.");
+                }
+                
+                char* header = static_cast<char*>(m_region.get_address());
+                std::memcpy(header, MAGIC, MAGIC_SIZE);
+                write32(header + MAGIC_SIZE, VERSION);
+                m_used = SEGMENT_HEADER_SIZE;
+                m_numSegments++;
+            }
+            
+            void RecordLog::closeSegment()
+            {
+                if(! m_region.get_address())
+                    return;
+                
+                // unmap the segment before it is truncated to its entries
+                {
+                    mapped_region region;
+                    m_region.swap(region);
+                    region.flush();
+                }
+                
+                try
+                {
+                    boost::filesystem::resize_file(m_currentPath, m_used);
+                }
+                catch(boost::filesystem::filesystem_error &)
+                {
+                    throw FileAccessFailed(m_currentPath, m_path, "Failed to truncate log segment.");
+                }
+            }
+            
+            RecordLogReader::RecordLogReader(const std::string & path)
+              : m_path(path),
+                m_file(path),
+                m_position(RecordLog::SEGMENT_HEADER_SIZE)
+            {
+                if(m_file.size() < RecordLog::SEGMENT_HEADER_SIZE 
+                   || std::memcmp(m_file.data(), MAGIC, MAGIC_SIZE) != 0)
+                {
+                    throw InvalidFileFormat(path, "Not a record log segment.");
+                }
+                
+                if(read32(m_file.data() + MAGIC_SIZE) > RecordLog::VERSION)
+                    throw InvalidFileFormat(path, "Unsupported record log version.");
+            }
+            
+            bool RecordLogReader::next(Entry & entry)
+            {
+                const std::size_t entryStart = RecordLog::TIMESTAMP_SIZE + WireFormat::PREAMBLE_SIZE;
+                if(m_file.size() - m_position < entryStart)
+                    return false;
+                
+                // the remainder of segments which have not been closed is zero
+                const char* data = m_file.data() + m_position;
+                if(! WireFormat::hasMagic(data + RecordLog::TIMESTAMP_SIZE))
+                    return false;
+                
+                try
+                {
+                    const WireFormat::Preamble preamble = WireFormat::readPreamble(data + RecordLog::TIMESTAMP_SIZE);
+                    const uint64_t payloadSize = uint64_t(preamble.headerSize) + preamble.textSize + preamble.fileSize;
+                    if(payloadSize > m_file.size() - m_position - entryStart)
+                        throw InvalidFileFormat(m_path, "Truncated record log entry.");
+                    
+                    const char* header = data + entryStart;
+                    WireFormat::readHeader(header, preamble.headerSize, entry.header);
+                    
+                    entry.timestamp = read64(data);
+                    entry.text = header + preamble.headerSize;
+                    entry.textSize = preamble.textSize;
+                    entry.file = entry.text + entry.textSize;
+                    entry.fileSize = std::size_t(preamble.fileSize);
+                    
+                    m_position += entryStart + std::size_t(payloadSize);
+                }
+                catch(DeserializationError &)
+                {
+                    throw InvalidFileFormat(m_path, "Invalid record log entry.");
+                }
+                
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_IMPL_RECORDLOG_H
+#define STROMX_RUNTIME_IMPL_RECORDLOG_H
+
+#include <string>
+#include <boost/interprocess/mapped_region.hpp>
+#include "stromx/runtime/impl/MappedFile.h"
+#include "stromx/runtime/impl/SerializationHeader.h"
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Append-only log which is split into memory-mapped segment files. The 
+             * segments of the log \c path are named <tt>path.000000</tt>, 
+             * <tt>path.000001</tt> and so on. Each segment starts with the header
+             * <tt>"SXRL" | version (4)</tt> and is followed by the entries. An entry
+             * consists of a timestamp in microseconds (8) and a frame of the binary
+             * wire format, i.e. the preamble, the binary header and the payloads. 
+             * All integers are encoded little-endian.
+             * 
+             * A segment is allocated with its full size and truncated to its 
+             * entries when it is closed. If the log is not closed properly the
+             * remainder of the last segment contains zeros.
+             * 
+             * \sa WireFormat
+             */
+            class RecordLog
+            {
+            public:
+                /** The current version of the log format. */
+                static const uint32_t VERSION = 1;
+                
+                /** The size of the header at the start of each segment. */
+                static const unsigned int SEGMENT_HEADER_SIZE = 8;
+                
+                /** The size of the timestamp at the start of each entry. */
+                static const unsigned int TIMESTAMP_SIZE = 8;
+                
+                /** 
+                 * Creates the first segment of the log \c path. Existing segments of the 
+                 * same log are removed before, i.e. a reader never sees segments of
+                 * a previous recording.
+                 * 
+                 * \throws FileAccessFailed If an existing segment can not be removed
+                 *                          or the segment can not be created.
+                 */
+                RecordLog(const std::string & path, const std::size_t segmentSize);
+                
+                /** Closes the current segment. */
+                ~RecordLog();
+                
+                /** Returns the path of the segment \c index of the log \c path. */
+                static const std::string segmentPath(const std::string & path, const unsigned int index);
+                
+                /** Writes the timestamp at the start of an entry to \c data. */
+                static void writeTimestamp(const uint64_t timestamp, char* const data);
+                
+                /** 
+                 * Reserves \c size bytes for a new entry and returns their address. 
+                 * A new segment is started if the entry does not fit into the current 
+                 * one. Entries which are larger than the segment size are stored in 
+                 * a segment of their own. The memory is valid until the next call
+                 * to append().
+                 * 
+                 * \throws FileAccessFailed If a new segment can not be created.
+                 */
+                char* append(const std::size_t size);
+                
+                /** Returns the number of segments which have been started. */
+                unsigned int numSegments() const { return m_numSegments; }
+                
+            private:
+                void removeSegments();
+                void openSegment(const std::size_t size);
+                void closeSegment();
+                
+                std::string m_path;
+                std::size_t m_segmentSize;
+                unsigned int m_numSegments;
+                std::string m_currentPath;
+                boost::interprocess::mapped_region m_region;
+                std::size_t m_used;
+            };
+            
+            /** Reads the entries of a segment of a record log. */
+            class RecordLogReader
+            {
+            public:
+                /** An entry of the log. The payloads point into the mapped segment. */
+                struct Entry
+                {
+                    Entry() : timestamp(0), text(0), textSize(0), file(0), fileSize(0) {}
+                    
+                    uint64_t timestamp;
+                    SerializationHeader header;
+                    const char* text;
+                    std::size_t textSize;
+                    const char* file;
+                    std::size_t fileSize;
+                };
+                
+                /** 
+                 * Maps the segment \c path.
+                 * 
+                 * \throws FileAccessFailed If the segment can not be mapped.
+                 * \throws InvalidFileFormat If the file is not a segment of a record log.
+                 */
+                explicit RecordLogReader(const std::string & path);
+                
+                /** 
+                 * Reads the next entry of the segment. Returns false if the end of the 
+                 * entries has been reached.
+                 * 
+                 * \throws InvalidFileFormat If the entry is truncated.
+                 */
+                bool next(Entry & entry);
+                
+            private:
+                std::string m_path;
+                MappedFile m_file;
+                std::size_t m_position;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_RECORDLOG_H
@@ -0,0 +1,195 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/impl/RecordWriter.h"
+
+#include <cstring>
+#include <boost/bind.hpp>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Matrix.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
+#include "stromx/runtime/impl/SerializationHeader.h"
+#include "stromx/runtime/impl/Server.h"
+#include "stromx/runtime/impl/WireFormat.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            RecordWriter::RecordWriter(const std::string & path, const std::size_t segmentSize,
+                                       const unsigned int queueSize, const OutputProvider::Encoding encoding)
+              : m_log(path, segmentSize),
+                m_queueSize(queueSize),
+                m_encoding(encoding),
+                m_stopped(false)
+            {
+                m_thread = boost::thread(boost::bind(&RecordWriter::run, this));
+            }
+            
+            RecordWriter::~RecordWriter()
+            {
+                stop();
+            }
+            
+            bool RecordWriter::write(const DataContainer & data, const uint64_t timestamp)
+            {
+                {
+                    lock_t lock(m_mutex);
+                    
+                    if(m_stopped || m_queue.size() >= m_queueSize)
+                    {
+                        m_statistics.droppedFrames++;
+                        return false;
+                    }
+                    
+                    m_queue.push_back(Item(data, timestamp));
+                }
+                
+                m_cond.notify_one();
+                return true;
+            }
+            
+            void RecordWriter::stop()
+            {
+                {
+                    lock_t lock(m_mutex);
+                    m_stopped = true;
+                }
+                
+                m_cond.notify_one();
+                
+                if(m_thread.joinable())
+                    m_thread.join();
+            }
+            
+            const RecordStatistics RecordWriter::statistics() const
+            {
+                lock_t lock(m_mutex);
+                return m_statistics;
+            }
+            
+            void RecordWriter::run()
+            {
+                while(true)
+                {
+                    unique_lock_t lock(m_mutex);
+                    while(m_queue.empty() && ! m_stopped)
+                        m_cond.wait(lock);
+                    
+                    // the queued data is written before the thread stops
+                    if(m_queue.empty())
+                        return;
+                    
+                    const Item item = m_queue.front();
+                    lock.unlock();
+                    
+                    std::size_t size = 0;
+                    try
+                    {
+                        size = record(item);
+                    }
+                    catch(std::exception &)
+                    {
+                        // data which can not be serialized or written is dropped
+                    }
+                    
+                    lock.lock();
+                    m_queue.pop_front();
+                    if(size)
+                    {
+                        m_statistics.recordedFrames++;
+                        m_statistics.recordedBytes += size;
+                    }
+                    else
+                    {
+                        m_statistics.droppedFrames++;
+                    }
+                }
+            }
+            
+            std::size_t RecordWriter::record(const Item & item)
+            {
+                ReadAccess access(item.data);
+                const Data & value = access.get();
+                
+                SerializationHeader header;
+                header.serverVersion = Server::VERSION;
+                header.package = value.package();
+                header.type = value.type();
+                header.version = value.version();
+                
+                m_textData.clear();
+                m_fileData.clear();
+                
+                // the rows of images and matrices are copied directly to the log
+                const Matrix* matrix = 0;
+                std::size_t rowSize = 0;
+                if(value.isVariant(Variant::MATRIX) && 
+                   (m_encoding == OutputProvider::DEFAULT || m_encoding == OutputProvider::RAW))
+                {
+                    matrix = &data_cast<Matrix>(value);
+                    rowSize = matrix->cols() * matrix->valueSize();
+                    WireFormat::describeMatrix(value, header);
+                    header.payload = value.isVariant(Variant::IMAGE) ? SerializationHeader::RAW_IMAGE
+                                                                     : SerializationHeader::RAW_MATRIX;
+                }
+                else
+                {
+                    VectorOutput output(m_textData, m_fileData, m_encoding);
+                    value.serialize(output);
+                }
+                
+                WireFormat::writeHeader(header, m_header);
+                
+                WireFormat::Preamble preamble;
+                preamble.headerSize = m_header.size();
+                preamble.textSize = m_textData.size();
+                preamble.fileSize = matrix ? rowSize * matrix->rows() : m_fileData.size();
+                
+                const std::size_t size = RecordLog::TIMESTAMP_SIZE + WireFormat::PREAMBLE_SIZE 
+                                         + preamble.headerSize + preamble.textSize + std::size_t(preamble.fileSize);
+                char* entry = m_log.append(size);
+                
+                RecordLog::writeTimestamp(item.timestamp, entry);
+                entry += RecordLog::TIMESTAMP_SIZE;
+                WireFormat::writePreamble(preamble, entry);
+                entry += WireFormat::PREAMBLE_SIZE;
+                std::memcpy(entry, &m_header[0], m_header.size());
+                entry += m_header.size();
+                if(! m_textData.empty())
+                    std::memcpy(entry, &m_textData[0], m_textData.size());
+                entry += m_textData.size();
+                
+                if(matrix)
+                {
+                    for(unsigned int i = 0; i < matrix->rows(); ++i)
+                        std::memcpy(entry + i * rowSize, matrix->data() + i * matrix->stride(), rowSize);
+                }
+                else if(! m_fileData.empty())
+                {
+                    std::memcpy(entry, &m_fileData[0], m_fileData.size());
+                }
+                
+                return size;
+            }
+        }
+    }
+}
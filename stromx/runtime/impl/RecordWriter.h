@@ -0,0 +1,117 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_IMPL_RECORDWRITER_H
+#define STROMX_RUNTIME_IMPL_RECORDWRITER_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/OutputProvider.h"
+#include "stromx/runtime/impl/RecordLog.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            struct RecordStatistics
+            {
+                RecordStatistics()
+                  : recordedFrames(0),
+                    recordedBytes(0),
+                    droppedFrames(0)
+                {}
+                
+                uint64_t recordedFrames;
+                uint64_t recordedBytes;
+                uint64_t droppedFrames;
+            };
+            
+            /** 
+             * Appends data to a record log on a background thread. The data is 
+             * queued up to the queue size. New data is dropped if the queue is full.
+             * Images and matrices are stored as raw rows unless a compressing 
+             * encoding is selected. All other data is serialized.
+             */
+            class RecordWriter
+            {
+            public:
+                /** 
+                 * Creates the log \c path and starts the writer thread.
+                 * 
+                 * \throws FileAccessFailed If the log can not be created.
+                 */
+                RecordWriter(const std::string & path, const std::size_t segmentSize,
+                             const unsigned int queueSize, const OutputProvider::Encoding encoding);
+                
+                /** Stops the writer. */
+                ~RecordWriter();
+                
+                /** 
+                 * Queues \c data which has been received at \c timestamp. Does not block.
+                 * Returns false if the data has been dropped.
+                 */
+                bool write(const DataContainer & data, const uint64_t timestamp);
+                
+                /** Writes the queued data to the log and stops the writer thread. */
+                void stop();
+                
+                const RecordStatistics statistics() const;
+                
+            private:
+                typedef boost::unique_lock<boost::mutex> unique_lock_t;
+                typedef boost::lock_guard<boost::mutex> lock_t;
+                
+                struct Item
+                {
+                    Item(const DataContainer & data, const uint64_t timestamp)
+                      : data(data), timestamp(timestamp)
+                    {}
+                    
+                    DataContainer data;
+                    uint64_t timestamp;
+                };
+                
+                void run();
+                std::size_t record(const Item & item);
+                
+                RecordLog m_log;
+                unsigned int m_queueSize;
+                OutputProvider::Encoding m_encoding;
+                std::deque<Item> m_queue;
+                bool m_stopped;
+                RecordStatistics m_statistics;
+                mutable boost::mutex m_mutex;
+                boost::condition_variable m_cond;
+                boost::thread m_thread;
+                
+                // reused by the writer thread for each entry
+                std::vector<char> m_header;
+                std::vector<char> m_textData;
+                std::vector<char> m_fileData;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_RECORDWRITER_H
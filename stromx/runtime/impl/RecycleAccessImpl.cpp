@@ -19,6 +19,7 @@
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/impl/DataContainerImpl.h"
 #include "stromx/runtime/impl/RecycleAccessImpl.h"
+#include "stromx/runtime/impl/WorkerPool.h"
 
 namespace stromx
 {
@@ -84,6 +85,8 @@ namespace stromx
                 
                 try
                 {
+                    WorkerPool::BlockingScope scope(m_data.empty());
+                    
                     if(waitWithTimeout)
                     {
                         while(m_data.empty())
@@ -110,6 +113,18 @@ namespace stromx
                 m_data.pop_front();
                 return value;
             }
+            
+            Data* RecycleAccessImpl::tryGet()
+            {
+                lock_t lock(m_mutex);
+                
+                if(m_data.empty())
+                    return 0;
+                
+                Data* value = m_data.front();
+                m_data.pop_front();
+                return value;
+            }
         }
     } 
 }
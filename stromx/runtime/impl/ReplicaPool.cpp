@@ -0,0 +1,441 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <set>
+#include "stromx/runtime/Data.h"
+#include "stromx/runtime/DataProvider.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Id2DataMapper.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/impl/Id2DataMap.h"
+#include "stromx/runtime/impl/ReplicaPool.h"
+#include "stromx/runtime/impl/Tracer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            // copies the values of the parameters in the list from source to target
+            // and records their IDs in copied
+            void copyParameters(const OperatorKernel & source, OperatorKernel & target,
+                                const std::vector<const Parameter*> & parameters,
+                                std::set<unsigned int> & copied)
+            {
+                for(std::vector<const Parameter*>::const_iterator iter = parameters.begin();
+                    iter != parameters.end();
+                    ++iter)
+                {
+                    const unsigned int id = (*iter)->id();
+                    
+                    // connectors which have been converted to parameters carry data
+                    if((*iter)->originalType() != Description::PARAMETER || copied.count(id))
+                        continue;
+                    
+                    // skip parameters which can not be read, e.g. triggers
+                    DataRef value;
+                    try
+                    {
+                        value = source.getParameter(id);
+                    }
+                    catch(std::exception &)
+                    {
+                        continue;
+                    }
+                    
+                    target.setParameter(id, value);
+                    copied.insert(id);
+                }
+            }
+            
+            std::vector<unsigned int> outputIds(const OperatorKernel & kernel)
+            {
+                std::vector<unsigned int> ids;
+                
+                for(std::vector<const Output*>::const_iterator iter = kernel.outputs().begin();
+                    iter != kernel.outputs().end();
+                    ++iter)
+                {
+                    ids.push_back((*iter)->id());
+                }
+                
+                for(std::vector<const Parameter*>::const_iterator iter = kernel.parameters().begin();
+                    iter != kernel.parameters().end();
+                    ++iter)
+                {
+                    if((*iter)->originalType() == Description::OUTPUT)
+                        ids.push_back((*iter)->id());
+                }
+                
+                return ids;
+            }
+        }
+        
+        namespace impl
+        {
+            class ReplicaPool::Provider : public DataProvider
+            {
+            public:
+                Provider(const OperatorKernel & kernel, const AbstractFactory & factory)
+                  : m_factory(factory)
+                {
+                    m_inputs.initialize(kernel.inputs(), kernel.parameters());
+                    m_outputs.initialize(kernel.outputs(), kernel.parameters());
+                }
+                
+                Id2DataMap & inputs() { return m_inputs; }
+                Id2DataMap & outputs() { return m_outputs; }
+                
+                void receiveInputData(const Id2DataMapper& mapper)
+                {
+                    // nobody else sets the inputs during the execution
+                    if(! mapper.tryGet(m_inputs))
+                        throw WrongState("A replicated operator must receive each input once per execution.");
+                    
+                    mapper.get(m_inputs);
+                }
+                
+                void sendOutputData(const Id2DataMapper& mapper)
+                {
+                    // nobody else clears the outputs during the execution
+                    if(! mapper.trySet(m_outputs))
+                        throw WrongState("A replicated operator must send each output once per execution.");
+                    
+                    mapper.set(m_outputs);
+                }
+                
+                void testForInterrupt()
+                {
+                    try
+                    {
+                        boost::this_thread::interruption_point();
+                    }
+                    catch(boost::thread_interrupted&)
+                    {
+                        throw Interrupt();
+                    }
+                }
+                
+                void sleep(const unsigned int microseconds)
+                {
+                    try
+                    {
+                        boost::this_thread::sleep_for(boost::chrono::microseconds(microseconds));
+                    }
+                    catch(boost::thread_interrupted&)
+                    {
+                        throw Interrupt();
+                    }
+                }
+                
+                // parameters are only set between the executions of a replica
+                void unlockParameters() {}
+                void lockParameters() {}
+                
+                const AbstractFactory & factory() const { return m_factory; }
+                
+            private:
+                const AbstractFactory & m_factory;
+                Id2DataMap m_inputs;
+                Id2DataMap m_outputs;
+            };
+            
+            ReplicaPool::ReplicaPool(OperatorKernel & prototype, const unsigned int numReplicas,
+                                     const Dispatch dispatch, const AbstractFactory & factory,
+                                     const boost::function<void ()> & onFinished)
+              : m_dispatch(dispatch),
+                m_factory(factory),
+                m_type(prototype.type()),
+                m_onFinished(onFinished),
+                m_nextJob(0),
+                m_nextResult(0)
+            {
+                if(numReplicas == 0)
+                    throw WrongArgument("At least one replica is required.");
+                
+                try
+                {
+                    for(unsigned int i = 0; i < numReplicas; ++i)
+                    {
+                        m_replicas.push_back(new Replica);
+                        m_replicas.back()->kernel = createClone(prototype);
+                    }
+                    
+                    for(unsigned int i = 0; i < numReplicas; ++i)
+                        m_replicas[i]->thread = new boost::thread(boost::bind(&ReplicaPool::loop, this, i));
+                }
+                catch(...)
+                {
+                    clear();
+                    throw;
+                }
+            }
+            
+            ReplicaPool::~ReplicaPool()
+            {
+                clear();
+            }
+            
+            void ReplicaPool::clear()
+            {
+                for(std::vector<Replica*>::iterator iter = m_replicas.begin();
+                    iter != m_replicas.end();
+                    ++iter)
+                {
+                    if((*iter)->thread)
+                        (*iter)->thread->interrupt();
+                }
+                
+                for(std::vector<Replica*>::iterator iter = m_replicas.begin();
+                    iter != m_replicas.end();
+                    ++iter)
+                {
+                    if((*iter)->thread)
+                    {
+                        (*iter)->thread->join();
+                        delete (*iter)->thread;
+                    }
+                    
+                    if((*iter)->kernel)
+                    {
+                        try
+                        {
+                            (*iter)->kernel->deactivate();
+                            (*iter)->kernel->deinitialize();
+                        }
+                        catch(std::exception &)
+                        {
+                        }
+                        
+                        delete (*iter)->kernel;
+                    }
+                    
+                    delete *iter;
+                }
+                
+                m_replicas.clear();
+            }
+            
+            unsigned int ReplicaPool::numPending()
+            {
+                lock_t lock(m_mutex);
+                return m_nextJob - m_nextResult;
+            }
+            
+            void ReplicaPool::submit(const DataMap & inputs)
+            {
+                lock_t lock(m_mutex);
+                
+                Job job;
+                job.index = m_nextJob;
+                job.inputs = inputs;
+                
+                unsigned int target = 0;
+                switch(m_dispatch)
+                {
+                case ROUND_ROBIN:
+                    target = job.index % m_replicas.size();
+                    break;
+                case LEAST_LOADED:
+                    for(unsigned int i = 1; i < m_replicas.size(); ++i)
+                    {
+                        if(m_replicas[i]->load < m_replicas[target]->load)
+                            target = i;
+                    }
+                    break;
+                default:
+                    BOOST_ASSERT(false);
+                }
+                
+                m_replicas[target]->jobs.push_back(job);
+                ++m_replicas[target]->load;
+                ++m_nextJob;
+                
+                m_cond.notify_all();
+            }
+            
+            bool ReplicaPool::tryTakeResult(Result & result)
+            {
+                lock_t lock(m_mutex);
+                
+                // results of later inputs are held back until the oldest one arrived
+                std::map<uint64_t, Result>::iterator iter = m_results.find(m_nextResult);
+                if(iter == m_results.end())
+                    return false;
+                
+                result = iter->second;
+                m_results.erase(iter);
+                ++m_nextResult;
+                
+                return true;
+            }
+            
+            void ReplicaPool::setParameter(const unsigned int id, const Data & value)
+            {
+                lock_t lock(m_mutex);
+                
+                for(std::vector<Replica*>::iterator iter = m_replicas.begin();
+                    iter != m_replicas.end();
+                    ++iter)
+                {
+                    (*iter)->parameters.push_back(std::make_pair(id, DataRef(value.clone())));
+                }
+            }
+            
+            OperatorKernel* ReplicaPool::createClone(OperatorKernel & prototype)
+            {
+                OperatorKernel* clone = prototype.clone();
+                
+                try
+                {
+                    // parameters which must be set before the initialization, e.g. the
+                    // number of connectors
+                    std::set<unsigned int> copied;
+                    copyParameters(prototype, *clone, clone->parameters(), copied);
+                    
+                    clone->initialize();
+                    
+                    for(std::vector<const Parameter*>::const_iterator iter = prototype.parameters().begin();
+                        iter != prototype.parameters().end();
+                        ++iter)
+                    {
+                        if((*iter)->originalType() != Description::PARAMETER)
+                            clone->setConnectorType((*iter)->id(), Description::PARAMETER, (*iter)->updateBehavior());
+                    }
+                    
+                    copyParameters(prototype, *clone, prototype.parameters(), copied);
+                    
+                    clone->activate();
+                }
+                catch(...)
+                {
+                    delete clone;
+                    throw;
+                }
+                
+                return clone;
+            }
+            
+            void ReplicaPool::loop(const unsigned int index)
+            {
+                Replica & replica = *m_replicas[index];
+                Provider provider(*replica.kernel, m_factory);
+                const std::vector<unsigned int> outputs = outputIds(*replica.kernel);
+                
+                try
+                {
+                    while(true)
+                    {
+                        Job job;
+                        std::vector<std::pair<unsigned int, DataRef> > parameters;
+                        
+                        {
+                            unique_lock_t lock(m_mutex);
+                            
+                            while(replica.jobs.empty())
+                                m_cond.wait(lock);
+                            
+                            job = replica.jobs.front();
+                            replica.jobs.pop_front();
+                            parameters.swap(replica.parameters);
+                        }
+                        
+                        for(std::vector<std::pair<unsigned int, DataRef> >::iterator iter = parameters.begin();
+                            iter != parameters.end();
+                            ++iter)
+                        {
+                            // errors have already been reported by the original kernel
+                            try
+                            {
+                                replica.kernel->setParameter(iter->first, iter->second);
+                            }
+                            catch(std::exception &)
+                            {
+                            }
+                        }
+                        
+                        Result result;
+                        execute(replica, provider, job, result);
+                        
+                        for(std::vector<unsigned int>::const_iterator iter = outputs.begin();
+                            iter != outputs.end();
+                            ++iter)
+                        {
+                            const DataContainer & data = provider.outputs().get(*iter);
+                            if(! data.empty())
+                                result.outputs[*iter] = data;
+                        }
+                        provider.outputs().clear();
+                        
+                        {
+                            lock_t lock(m_mutex);
+                            --replica.load;
+                            m_results[job.index] = result;
+                        }
+                        
+                        m_onFinished();
+                    }
+                }
+                catch(boost::thread_interrupted &)
+                {
+                }
+                catch(Interrupt &)
+                {
+                }
+            }
+            
+            void ReplicaPool::execute(Replica & replica, Provider & provider, Job & job, Result & result)
+            {
+                provider.inputs().clear();
+                for(DataMap::const_iterator iter = job.inputs.begin(); iter != job.inputs.end(); ++iter)
+                    provider.inputs().set(iter->first, iter->second);
+                
+                const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+                
+                try
+                {
+                    Tracer::Span span("operator", "execute", &m_type);
+                    replica.kernel->execute(provider);
+                }
+                catch(Interrupt &)
+                {
+                    throw;
+                }
+                catch(std::exception & e)
+                {
+                    result.failed = true;
+                    result.message = e.what();
+                }
+                catch(boost::thread_interrupted &)
+                {
+                    throw;
+                }
+                catch(...)
+                {
+                    result.failed = true;
+                    result.message = "Unknown error.";
+                }
+                
+                using namespace boost::chrono;
+                result.executionTime = duration_cast<microseconds>(steady_clock::now() - start).count();
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_REPLICAPOOL_H
+#define STROMX_RUNTIME_IMPL_REPLICAPOOL_H
+
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <deque>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/DataRef.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class AbstractFactory;
+        class OperatorKernel;
+        
+        namespace impl
+        {
+            /**
+             * Executes the input data of an operator on several clones of its kernel.
+             * Each clone is executed by a dedicated thread. The results are returned
+             * in the order the inputs have been submitted.
+             *
+             * The kernel must receive all its inputs and send all its outputs exactly
+             * once per execution.
+             */
+            class ReplicaPool
+            {
+            public:
+                enum Dispatch
+                {
+                    ROUND_ROBIN,
+                    LEAST_LOADED
+                };
+                
+                typedef std::map<unsigned int, DataContainer> DataMap;
+                
+                struct Result
+                {
+                    Result() : failed(false), executionTime(0) {}
+                    
+                    DataMap outputs;
+                    bool failed;
+                    std::string message;
+                    uint64_t executionTime;
+                };
+                
+                /**
+                 * Clones, initializes and activates \c numReplicas copies of \c prototype
+                 * which must be active. The connector types and the parameter values of 
+                 * \c prototype are copied to the clones. The function \c onFinished is 
+                 * called by the replica threads whenever a result becomes available.
+                 */
+                ReplicaPool(OperatorKernel & prototype, const unsigned int numReplicas,
+                            const Dispatch dispatch, const AbstractFactory & factory,
+                            const boost::function<void ()> & onFinished);
+                
+                /** Interrupts and joins the replica threads and deletes the clones. */
+                ~ReplicaPool();
+                
+                unsigned int size() const { return m_replicas.size(); }
+                
+                /** Returns the number of submitted inputs whose results have not been taken yet. */
+                unsigned int numPending();
+                
+                /** Queues \c inputs for the execution by one of the replicas. */
+                void submit(const DataMap & inputs);
+                
+                /** 
+                 * Moves the result of the oldest pending input to \c result if it
+                 * is available. Returns false otherwise.
+                 */
+                bool tryTakeResult(Result & result);
+                
+                /** Sets the parameter \c id of all clones before their next execution. */
+                void setParameter(const unsigned int id, const Data & value);
+                
+            private:
+                typedef boost::lock_guard<boost::mutex> lock_t;
+                typedef boost::unique_lock<boost::mutex> unique_lock_t;
+                
+                struct Job
+                {
+                    uint64_t index;
+                    DataMap inputs;
+                };
+                
+                struct Replica
+                {
+                    Replica() : kernel(0), thread(0), load(0) {}
+                    
+                    OperatorKernel* kernel;
+                    boost::thread* thread;
+                    std::deque<Job> jobs;
+                    std::vector<std::pair<unsigned int, DataRef> > parameters;
+                    
+                    // the number of queued and running jobs
+                    unsigned int load;
+                };
+                
+                class Provider;
+                
+                OperatorKernel* createClone(OperatorKernel & prototype);
+                void clear();
+                void loop(const unsigned int index);
+                void execute(Replica & replica, Provider & provider, Job & job, Result & result);
+                
+                Dispatch m_dispatch;
+                const AbstractFactory & m_factory;
+                const std::string & m_type;
+                boost::function<void ()> m_onFinished;
+                std::vector<Replica*> m_replicas;
+                std::map<uint64_t, Result> m_results;
+                uint64_t m_nextJob;
+                uint64_t m_nextResult;
+                boost::mutex m_mutex;
+                boost::condition_variable m_cond;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_REPLICAPOOL_H
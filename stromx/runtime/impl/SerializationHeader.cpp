@@ -27,7 +27,13 @@ namespace stromx
                 return (lhs.serverVersion == rhs.serverVersion) &&
                        (lhs.package == rhs.package) &&
                        (lhs.type == rhs.type) &&
-                       (lhs.version == rhs.version);
+                       (lhs.version == rhs.version) &&
+                       (lhs.payload == rhs.payload) &&
+                       (lhs.sharedMemory == rhs.sharedMemory) &&
+                       (lhs.slot == rhs.slot) &&
+                       (lhs.rows == rhs.rows) &&
+                       (lhs.cols == rhs.cols) &&
+                       (lhs.elementType == rhs.elementType);
             }
             
             std::ostream & operator<<(std::ostream & out, const SerializationHeader & header)
@@ -37,6 +43,12 @@ namespace stromx
                 out << header.type << " ";
                 out << header.version;
                 
+                if(header.payload != SerializationHeader::SERIALIZED)
+                {
+                    out << " " << header.sharedMemory << ":" << header.slot << " ";
+                    out << header.rows << "x" << header.cols;
+                }
+                
                 return out;
             }
         }
@@ -21,6 +21,7 @@
 
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/version.hpp>
 
 namespace boost {
     namespace serialization {
@@ -43,18 +44,65 @@ namespace stromx
         {
             struct SerializationHeader
             {
+                // describes where the payload of the data is stored
+                enum Payload
+                {
+                    // the payload is serialized to the text and file buffers
+                    SERIALIZED,
+                    // the image payload is stored in a slot of a shared memory ring
+                    SHARED_IMAGE,
+                    // the matrix payload is stored in a slot of a shared memory ring
+                    SHARED_MATRIX,
+                    // the rows of the image follow the header in the file buffer
+                    // (binary wire format only)
+                    RAW_IMAGE,
+                    // the rows of the matrix follow the header in the file buffer
+                    // (binary wire format only)
+                    RAW_MATRIX
+                };
+                
+                SerializationHeader()
+                  : payload(SERIALIZED),
+                    slot(0),
+                    rows(0),
+                    cols(0),
+                    elementType(0)
+                {}
+                
                 Version serverVersion;
                 std::string package;
                 std::string type;
                 Version version;
+                
+                // the members below are transmitted from class version 1 on
+                unsigned int payload;
+                std::string sharedMemory;
+                unsigned int slot;
+                unsigned int rows;
+                unsigned int cols;
+                unsigned int elementType;
 
                 template <typename Archive>
-                void serialize(Archive& ar, const unsigned int /*classVersion*/)
+                void serialize(Archive& ar, const unsigned int classVersion)
                 {
                     ar & serverVersion;
                     ar & package;
                     ar & type;
                     ar & version;
+                    
+                    if(classVersion < 1)
+                        return;
+                    
+                    ar & payload;
+                    
+                    if(payload == SERIALIZED)
+                        return;
+                    
+                    ar & sharedMemory;
+                    ar & slot;
+                    ar & rows;
+                    ar & cols;
+                    ar & elementType;
                 }
                 
                 const static unsigned int NUM_SIZE_DIGITS = 8;
@@ -67,4 +115,6 @@ namespace stromx
     }
 }
 
+BOOST_CLASS_VERSION(stromx::runtime::impl::SerializationHeader, 1)
+
 #endif // STROMX_RUNTIME_IMPL_SERIALIZATIONHEADER_H
@@ -16,44 +16,97 @@
 
 #include "Server.h"
 
+#include <cstring>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/bind.hpp>
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
 #include "stromx/runtime/impl/SerializationHeader.h"
+#include "stromx/runtime/impl/SharedMemoryRing.h"
+#include "stromx/runtime/Image.h"
 #include "stromx/runtime/OutputProvider.h"
 #include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/Variant.h"
 
 using namespace boost::asio;
 
 namespace
 {
-    class StreamOutput : public stromx::runtime::OutputProvider
+    using stromx::runtime::impl::Frame;
+    using stromx::runtime::impl::SerializationHeader;
+    
+    void referenceRows(const stromx::runtime::Matrix & matrix, std::vector<const_buffer> & rows)
     {
-    public:
-        StreamOutput()
-        {}
+        const std::size_t rowSize = matrix.cols() * matrix.valueSize();
         
-        std::ostream & text ()
+        // reference the matrix as a single buffer if its rows are not padded
+        if(matrix.stride() == rowSize)
         {
-            return m_textStream;
+            rows.push_back(buffer(matrix.data(), rowSize * matrix.rows()));
         }
-        
-        std::ostream & openFile (const std::string &/*ext*/, const OpenMode /*mode*/)
+        else
         {
-            return m_fileStream;
+            for(unsigned int i = 0; i < matrix.rows(); ++i)
+                rows.push_back(buffer(matrix.data() + i * matrix.stride(), rowSize));
         }
+    }
+    
+    void encodeText(const SerializationHeader & header, Frame & frame)
+    {
+        stromx::runtime::impl::VectorOutputBuffer headerBuffer(frame.textHeader);
+        std::ostream headerStream(&headerBuffer);
+        boost::archive::text_oarchive headerArchive(headerStream);
+        headerArchive << header;
         
-        std::ostream & file ()
-        {
-            return m_fileStream;
-        }
+        // output the sizes of the buffers
+        std::ostringstream sizesStream;
+        sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << frame.textHeader.size();
+        sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << frame.textData.size();
+        sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << frame.fileData.size();
+        
+        const std::string sizes = sizesStream.str();
+        std::copy(sizes.begin(), sizes.end(), frame.textPreamble.begin());
         
-        std::string textData() const { return m_textStream.str(); }
-        std::string fileData() const { return m_fileStream.str(); }
+        frame.textBuffers.push_back(buffer(frame.textPreamble));
+        frame.textBuffers.push_back(buffer(frame.textHeader));
+        frame.textBuffers.push_back(buffer(frame.textData));
+        frame.textBuffers.push_back(buffer(frame.fileData));
+        frame.hasText = true;
+    }
+    
+    void encodeBinary(const SerializationHeader & header, const std::vector<const_buffer> & rows, Frame & frame)
+    {
+        using stromx::runtime::impl::WireFormat;
+        
+        WireFormat::writeHeader(header, frame.binaryHeader);
+        
+        WireFormat::Preamble preamble;
+        preamble.headerSize = frame.binaryHeader.size();
+        preamble.textSize = frame.textData.size();
+        preamble.fileSize = frame.fileData.size() + buffer_size(rows);
+        WireFormat::writePreamble(preamble, frame.binaryPreamble.data());
+        
+        frame.binaryBuffers.push_back(buffer(frame.binaryPreamble));
+        frame.binaryBuffers.push_back(buffer(frame.binaryHeader));
+        frame.binaryBuffers.push_back(buffer(frame.textData));
+        frame.binaryBuffers.push_back(buffer(frame.fileData));
+        frame.binaryBuffers.insert(frame.binaryBuffers.end(), rows.begin(), rows.end());
+        frame.hasBinary = true;
+    }
+    
+    void encodeShared(const SerializationHeader & header, Frame & frame)
+    {
+        using stromx::runtime::impl::WireFormat;
         
-    private:
-        std::ostringstream m_textStream;
-        std::ostringstream m_fileStream;
-    };
+        WireFormat::writeHeader(header, frame.sharedHeader);
+        
+        // the payload is in the shared memory slot
+        WireFormat::Preamble preamble;
+        preamble.headerSize = frame.sharedHeader.size();
+        WireFormat::writePreamble(preamble, frame.sharedPreamble.data());
+        
+        frame.sharedBuffers.push_back(buffer(frame.sharedPreamble));
+        frame.sharedBuffers.push_back(buffer(frame.sharedHeader));
+    }
 }
 
 namespace stromx
@@ -63,64 +116,268 @@ namespace stromx
         namespace impl
         {            
             const Version Server::VERSION(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
+            
+            ConnectionStatistics & ConnectionStatistics::operator+=(const ConnectionStatistics & rhs)
+            {
+                sentFrames += rhs.sentFrames;
+                droppedFrames += rhs.droppedFrames;
+                sentBytes += rhs.sentBytes;
+                droppedBytes += rhs.droppedBytes;
+                return *this;
+            }
 
             Connection::Connection(Server* server, boost::asio::io_service& ioService)
               : m_server(server),
                 m_socket(ioService),
-                m_active(false)
-            {}
+                m_handshake(new Handshake(server)),
+                m_disconnect(false)
+            {
+                m_handshake->connection = this;
+            }
+            
+            Connection::~Connection()
+            {
+                m_handshake->connection = 0;
+            }
             
-            void Connection::send(const DataContainer & data)
+            void Connection::startHandshake()
             {
-                ReadAccess access(data);
+                // only clients on the same host can read from shared memory
+                boost::system::error_code error;
+                const ip::tcp::endpoint endpoint = m_socket.remote_endpoint(error);
+                m_handshake->isLoopback = ! error && endpoint.address().is_loopback();
                 
-                // serialize the header
-                SerializationHeader header;
-                header.serverVersion = Server::VERSION;
-                header.package = access.get().package();
-                header.type = access.get().type();
-                header.version = access.get().version();
-                std::ostringstream headerStream;
-                boost::archive::text_oarchive headerArchive(headerStream);
-                headerArchive << header;
-                
-                // serialize the data
-                StreamOutput output;
-                access.get().serialize(output);
-                
-                m_headerData = headerStream.str();
-                m_textData = output.textData();
-                m_fileData = output.fileData();
-                
-                // output the sizes of the buffers
-                std::ostringstream sizesStream;
-                sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << m_headerData.size();
-                sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << m_textData.size();
-                sizesStream << std::setw(SerializationHeader::NUM_SIZE_DIGITS) << std::hex << m_fileData.size();
-                m_sizesData = sizesStream.str();
-                
-                // construct a buffer sequence
-                std::vector<const_buffer> buffers;
-                buffers.push_back(buffer(m_sizesData));
-                buffers.push_back(buffer(m_headerData));
-                buffers.push_back(buffer(m_textData));
-                buffers.push_back(buffer(m_fileData));
-                
-                boost::asio::async_write(m_socket, buffers, boost::bind(&Connection::handleWrite, this, 
-                                                                        placeholders::error, placeholders::bytes_transferred));
-                
-            } 
+                startRead();
+            }
+            
+            void Connection::startRead()
+            {
+                // clients which do not send a hello message receive the data in 
+                // the text format, i.e. this read might never complete
+                boost::asio::async_read(m_socket, buffer(m_handshake->message), 
+                                        boost::bind(&Connection::handleMessage, m_handshake,
+                                                    placeholders::error, placeholders::bytes_transferred));
+            }
+            
+            void Connection::handleMessage(boost::shared_ptr<Handshake> handshake,
+                                           const boost::system::error_code& error, size_t /*bytes_transferred*/)
+            {
+                if (error)
+                    return;
+                
+                const char* message = handshake->message.data();
+                bool isRelease = false;
+                uint32_t slot = 0;
+                if (! handshake->hasHello)
+                {
+                    // the server sends frames of its own version to clients which
+                    // support this or a newer version of the binary format
+                    handshake->hasHello = true;
+                    if (WireFormat::readHello(message) < WireFormat::VERSION)
+                        return;
+                    
+                    handshake->binary = true;
+                    if (handshake->isLoopback && (WireFormat::readHelloFlags(message) & WireFormat::SHARED_MEMORY))
+                        handshake->local = true;
+                }
+                else
+                {
+                    if (! WireFormat::readRelease(message, slot))
+                        return;
+                    
+                    // unless the client read the slot it could not open the shared 
+                    // memory, i.e. it receives the following frames over the socket
+                    isRelease = true;
+                    if (! (WireFormat::readReleaseFlags(message) & WireFormat::SLOT_READ))
+                        handshake->local = false;
+                }
+                
+                // the slots of a deleted connection have already been released
+                boost::lock_guard<boost::mutex> l(handshake->server->m_mutex);
+                if (handshake->connection)
+                {
+                    if (isRelease)
+                        handshake->connection->releaseSlot(slot);
+                    
+                    handshake->connection->startRead();
+                }
+            }
+            
+            void Connection::enqueue(const FramePtr & frame)
+            {
+                // a shared entry holds a reference to the slot until it is sent 
+                // or dropped, afterwards the client releases the slot
+                const bool shared = local() && frame->sharedSlot != SharedMemoryRing::NO_SLOT;
+                const Entry entry(frame, shared);
+                if (shared)
+                    m_server->m_sharedMemory->retainSlot(frame->sharedSlot);
+                
+                if (m_disconnect || ! canSend(entry))
+                {
+                    drop(entry);
+                    return;
+                }
+                
+                if (! m_current.frame)
+                {
+                    m_current = entry;
+                    startWrite();
+                    return;
+                }
+                
+                switch (m_server->m_policy)
+                {
+                case Server::LATEST_ONLY:
+                    while (! m_queue.empty())
+                    {
+                        drop(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    m_queue.push_back(entry);
+                    break;
+                case Server::BLOCKING:
+                    // the server waited until the queue had room for the frame
+                    m_queue.push_back(entry);
+                    break;
+                case Server::BOUNDED_FIFO:
+                    if (m_queue.size() < m_server->m_queueSize)
+                        m_queue.push_back(entry);
+                    else
+                        drop(entry);
+                    break;
+                case Server::DISCONNECT_SLOW_CLIENT:
+                    if (m_queue.size() < m_server->m_queueSize)
+                    {
+                        m_queue.push_back(entry);
+                    }
+                    else
+                    {
+                        // the socket is closed by the server thread
+                        m_disconnect = true;
+                        drop(entry);
+                        while (! m_queue.empty())
+                        {
+                            drop(m_queue.front());
+                            m_queue.pop_front();
+                        }
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+            
+            bool Connection::isFull() const
+            {
+                return m_current.frame && m_queue.size() >= m_server->m_queueSize;
+            }
+            
+            void Connection::releaseSlot(const unsigned int slot)
+            {
+                // the client can only release the slots it holds
+                if (m_slots.erase(slot))
+                    m_server->m_sharedMemory->releaseSlot(slot);
+            }
+            
+            void Connection::releaseSlots()
+            {
+                for (std::set<unsigned int>::const_iterator iter = m_slots.begin();
+                    iter != m_slots.end(); ++iter)
+                {
+                    m_server->m_sharedMemory->releaseSlot(*iter);
+                }
+                
+                m_slots.clear();
+            }
+            
+            const std::vector<const_buffer> & Connection::buffers(const Entry & entry) const
+            {
+                if (entry.shared)
+                    return entry.frame->sharedBuffers;
+                
+                return binary() ? entry.frame->binaryBuffers : entry.frame->textBuffers;
+            }
+            
+            bool Connection::canSend(const Entry & entry) const
+            {
+                // a client which connected after the frame was encoded might
+                // require a format which was not encoded
+                if (entry.shared)
+                    return true;
+                
+                return binary() ? entry.frame->hasBinary : entry.frame->hasText;
+            }
+            
+            void Connection::startWrite()
+            {
+                boost::asio::async_write(m_socket, buffers(m_current), 
+                                         boost::bind(&Connection::handleWrite, this, 
+                                                     placeholders::error, placeholders::bytes_transferred));
+            }
+            
+            void Connection::drop(const Entry & entry)
+            {
+                m_statistics.droppedFrames++;
+                m_statistics.droppedBytes += buffer_size(buffers(entry));
+                
+                // the client will not release the slot of the dropped frame
+                if (entry.shared)
+                    m_server->releaseSlot(*entry.frame);
+            }
             
             void Connection::handleWrite(const boost::system::error_code& error, size_t /*bytes_transferred*/)
             {
+                boost::lock_guard<boost::mutex> l(m_server->m_mutex);
+                
                 if (error)
-                    m_server->removeConnection(this);
+                {
+                    drop(m_current);
+                }
                 else
-                    m_server->setConnectionActive(this, false);
+                {
+                    m_statistics.sentFrames++;
+                    m_statistics.sentBytes += buffer_size(buffers(m_current));
+                    
+                    // the reference of the entry is passed to the client, the client 
+                    // reads the frame after it has been written and can not release 
+                    // the slot before it is stored here
+                    if (m_current.shared)
+                        m_slots.insert(m_current.frame->sharedSlot);
+                }
+                
+                m_current = Entry();
+                
+                if (error || m_disconnect)
+                {
+                    while (! m_queue.empty())
+                    {
+                        drop(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    
+                    m_server->removeConnection(this);
+                    return;
+                }
+                
+                if (! m_queue.empty())
+                {
+                    m_current = m_queue.front();
+                    m_queue.pop_front();
+                    startWrite();
+                }
+                
+                // wake up the server if it waits for room in the queue
+                m_server->m_cond.notify_all();
             }
 
-            Server::Server(unsigned int port)
-              : m_acceptor(m_ioService, ip::tcp::endpoint(ip::tcp::v4(), port))
+            Server::Server(unsigned int port, SharedMemoryRing* const sharedMemory,
+                           const QueuePolicy policy, const unsigned int queueSize,
+                           const OutputProvider::Encoding encoding)
+              : m_acceptor(m_ioService, ip::tcp::endpoint(ip::tcp::v4(), port)),
+                m_sharedMemory(sharedMemory),
+                m_policy(policy),
+                m_queueSize(queueSize),
+                m_encoding(encoding)
             {
                 m_thread = boost::thread(boost::bind(&Server::run, this));
             }
@@ -129,6 +386,8 @@ namespace stromx
             {
                 stop();
                 
+                delete m_sharedMemory;
+                
                 for (std::set<Connection*>::const_iterator iter = m_connections.begin();
                     iter != m_connections.end(); ++iter)
                 {
@@ -138,33 +397,149 @@ namespace stromx
             
             void Server::send(const DataContainer& data)
             {
-                Connection* connection = 0;
+                bool textClients = false;
+                bool localClients = false;
+                bool otherClients = false;
                 
                 {
                     boost::unique_lock<boost::mutex> l(m_mutex);
                     
-                    while (true)
+                    while (m_connections.empty() || (m_policy == BLOCKING && hasFullConnection()))
+                        m_cond.wait(l);
+                    
+                    for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                        iter != m_connections.end(); ++iter)
                     {
-                        for (std::set<Connection*>::const_iterator iter = m_connections.begin();
-                            iter != m_connections.end(); ++iter)
-                        {
-                            if ((*iter)->active() == false)
-                            {
-                                // in case an inactive connection was found return
-                                connection = *iter;
-                                connection->setActive(true);
-                                break;
-                            }
-                        }
+                        if (! (*iter)->binary())
+                            textClients = true;
                         
-                        if (! connection)
-                            m_cond.wait(l);
+                        if ((*iter)->local())
+                            localClients = true;
                         else
-                            break;
+                            otherClients = true;
+                    }
+                }
+                
+                // encode the data once for all clients
+                const FramePtr frame = encode(data, textClients, localClients, otherClients);
+                bool disconnect = false;
+                
+                {
+                    boost::lock_guard<boost::mutex> l(m_mutex);
+                    
+                    for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                        iter != m_connections.end(); ++iter)
+                    {
+                        (*iter)->enqueue(frame);
+                        disconnect = disconnect || (*iter)->disconnecting();
+                    }
+                }
+                
+                // release the reference which was acquired when encoding the frame
+                releaseSlot(*frame);
+                
+                if (disconnect)
+                    m_ioService.post(boost::bind(&Server::disconnectSlowClients, this));
+            }
+            
+            FramePtr Server::encode(const DataContainer & data, const bool textClients,
+                                    const bool localClients, const bool otherClients)
+            {
+                boost::shared_ptr<Frame> frame(new Frame);
+                frame->access = ReadAccess(data);
+                const Data & value = frame->access.get();
+                
+                SerializationHeader header;
+                header.serverVersion = VERSION;
+                header.package = value.package();
+                header.type = value.type();
+                header.version = value.version();
+                
+                SerializationHeader sharedHeader = header;
+                if (localClients && storeInSharedMemory(value, sharedHeader))
+                {
+                    // only the header is sent to the local clients
+                    frame->sharedSlot = sharedHeader.slot;
+                    encodeShared(sharedHeader, *frame);
+                    
+                    // the payload must not be encoded if all clients read it from 
+                    // shared memory
+                    if (! otherClients)
+                    {
+                        frame->access.release();
+                        return frame;
                     }
                 }
                 
-                connection->send(data);
+                std::vector<const_buffer> rows;
+                if (value.isVariant(Variant::MATRIX) && 
+                         (m_encoding == OutputProvider::DEFAULT || m_encoding == OutputProvider::RAW))
+                {
+                    // binary clients receive the rows directly from the data and
+                    // only text clients require the serialized data
+                    SerializationHeader rowsHeader = header;
+                    WireFormat::describeMatrix(value, rowsHeader);
+                    rowsHeader.payload = value.isVariant(Variant::IMAGE) ? SerializationHeader::RAW_IMAGE
+                                                                         : SerializationHeader::RAW_MATRIX;
+                    referenceRows(data_cast<Matrix>(value), rows);
+                    encodeBinary(rowsHeader, rows, *frame);
+                    
+                    if (textClients)
+                    {
+                        VectorOutput output(frame->textData, frame->fileData, m_encoding);
+                        value.serialize(output);
+                        encodeText(header, *frame);
+                    }
+                }
+                else
+                {
+                    VectorOutput output(frame->textData, frame->fileData, m_encoding);
+                    value.serialize(output);
+                    encodeBinary(header, rows, *frame);
+                    encodeText(header, *frame);
+                }
+                
+                // other threads can write to the data unless its rows are sent
+                if (rows.empty())
+                    frame->access.release();
+                
+                return frame;
+            }
+            
+            bool Server::storeInSharedMemory(const Data & data, SerializationHeader & header)
+            {
+                if(! m_sharedMemory || ! data.isVariant(Variant::MATRIX))
+                    return false;
+                
+                const Matrix & matrix = data_cast<Matrix>(data);
+                const std::size_t rowSize = matrix.cols() * matrix.valueSize();
+                if(rowSize * matrix.rows() > m_sharedMemory->slotSize())
+                    return false;
+                
+                // send the data serialized if the receivers do not release the slots
+                // fast enough
+                const int slot = m_sharedMemory->acquireSlot();
+                if(slot == SharedMemoryRing::NO_SLOT)
+                    return false;
+                
+                // copy the rows without padding to the slot
+                uint8_t* slotData = m_sharedMemory->slot(slot);
+                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                    std::memcpy(slotData + i * rowSize, matrix.data() + i * matrix.stride(), rowSize);
+                
+                WireFormat::describeMatrix(data, header);
+                header.payload = data.isVariant(Variant::IMAGE) ? SerializationHeader::SHARED_IMAGE
+                                                                : SerializationHeader::SHARED_MATRIX;
+                header.sharedMemory = m_sharedMemory->name();
+                header.slot = slot;
+                
+                return true;
+            }
+            
+            void Server::releaseSlot(const Frame & frame)
+            {
+                if (frame.sharedSlot != SharedMemoryRing::NO_SLOT)
+                    m_sharedMemory->releaseSlot(frame.sharedSlot);
             }
             
             void Server::stop()
@@ -192,8 +567,11 @@ namespace stromx
                                                     connection, boost::asio::placeholders::error));
             }
             
-            void Server::handleAccept(Connection* connection, const boost::system::error_code& /*error*/)
+            void Server::handleAccept(Connection* connection, const boost::system::error_code& error)
             {
+                if (! error)
+                    connection->startHandshake();
+                
                 {
                     boost::lock_guard<boost::mutex> l(m_mutex);
                     m_connections.insert(connection);
@@ -203,26 +581,83 @@ namespace stromx
                 startAccept();
             }
             
-            void Server::removeConnection(Connection* connection)
+            void Server::disconnectSlowClients()
             {
                 boost::lock_guard<boost::mutex> l(m_mutex);
+                
+                // the pending writes of the closed sockets fail and the
+                // connections are removed
+                for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                    iter != m_connections.end(); ++iter)
+                {
+                    if ((*iter)->disconnecting())
+                    {
+                        boost::system::error_code error;
+                        (*iter)->socket().close(error);
+                    }
+                }
+            }
+            
+            bool Server::hasFullConnection() const
+            {
+                for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                    iter != m_connections.end(); ++iter)
+                {
+                    if ((*iter)->isFull())
+                        return true;
+                }
+                
+                return false;
+            }
+            
+            void Server::removeConnection(Connection* connection)
+            {
+                // the client does not release its slots after it disconnected
+                connection->releaseSlots();
+                m_removedStatistics += connection->statistics();
                 m_connections.erase(connection);
                 delete connection;
                 
                 m_cond.notify_all();
             }
             
+            unsigned int Server::port() const
+            {
+                return m_acceptor.local_endpoint().port();
+            }
+            
             unsigned int Server::numConnections() const
             {
                 boost::lock_guard<boost::mutex> l(m_mutex);
                 return m_connections.size();
             }
             
-            void Server::setConnectionActive(Connection* connection, const bool isActive)
+            const std::vector<ConnectionStatistics> Server::statistics() const
             {
                 boost::lock_guard<boost::mutex> l(m_mutex);
-                connection->setActive(isActive);
-                m_cond.notify_all();
+                
+                std::vector<ConnectionStatistics> statistics;
+                for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                    iter != m_connections.end(); ++iter)
+                {
+                    statistics.push_back((*iter)->statistics());
+                }
+                
+                return statistics;
+            }
+            
+            const ConnectionStatistics Server::totalStatistics() const
+            {
+                boost::lock_guard<boost::mutex> l(m_mutex);
+                
+                ConnectionStatistics statistics = m_removedStatistics;
+                for (std::set<Connection*>::const_iterator iter = m_connections.begin();
+                    iter != m_connections.end(); ++iter)
+                {
+                    statistics += (*iter)->statistics();
+                }
+                
+                return statistics;
             }
             
             void Server::waitForNumConnections(const unsigned int numConnections)
@@ -235,4 +670,3 @@ namespace stromx
         }
     }
 }
-
@@ -19,45 +19,184 @@
 
 #include <deque>
 #include <set>
+#include <vector>
+#include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/OutputProvider.h"
+#include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/Version.h"
+#include "stromx/runtime/impl/WireFormat.h"
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
 
 namespace stromx
 {
     namespace runtime
     {
+        class Data;
         class ServerTest; 
         
         namespace impl
         {
             class Server;
+            class SharedMemoryRing;
+            struct SerializationHeader;
+            
+            /** 
+             * A data object encoded for the transmission to the clients. The frame 
+             * is encoded once and shared by all connections. Depending on the
+             * capabilities of a client it is either sent in the binary or in the
+             * text format. Clients on the same host receive only the header if 
+             * the payload was stored in shared memory.
+             */
+            struct Frame
+            {
+                Frame()
+                  : hasBinary(false),
+                    hasText(false),
+                    sharedSlot(-1)
+                {}
+                
+                // holds the data as long as its rows are referenced by the binary buffers
+                ReadAccess access;
+                
+                bool hasBinary;
+                std::vector<boost::asio::const_buffer> binaryBuffers;
+                boost::array<char, WireFormat::PREAMBLE_SIZE> binaryPreamble;
+                std::vector<char> binaryHeader;
+                
+                bool hasText;
+                std::vector<boost::asio::const_buffer> textBuffers;
+                boost::array<char, WireFormat::PREAMBLE_SIZE> textPreamble;
+                std::vector<char> textHeader;
+                
+                // the serialized payload is shared by both formats
+                std::vector<char> textData;
+                std::vector<char> fileData;
+                
+                // SharedMemoryRing::NO_SLOT if the payload is not stored in shared memory
+                int sharedSlot;
+                std::vector<boost::asio::const_buffer> sharedBuffers;
+                boost::array<char, WireFormat::PREAMBLE_SIZE> sharedPreamble;
+                std::vector<char> sharedHeader;
+            };
+            
+            typedef boost::shared_ptr<const Frame> FramePtr;
+            
+            /** Counts the frames and bytes which were sent to or dropped for a client. */
+            struct ConnectionStatistics
+            {
+                ConnectionStatistics()
+                  : sentFrames(0),
+                    droppedFrames(0),
+                    sentBytes(0),
+                    droppedBytes(0)
+                {}
+                
+                ConnectionStatistics & operator+=(const ConnectionStatistics & rhs);
+                
+                uint64_t sentFrames;
+                uint64_t droppedFrames;
+                uint64_t sentBytes;
+                uint64_t droppedBytes;
+            };
 
             class Connection
             {
         public:
-                
                 Connection(Server* server, boost::asio::io_service& ioService);
+                ~Connection();
 
-                bool active() const { return m_active; }
-                void setActive(const bool isActive) { m_active = isActive; }
                 boost::asio::ip::tcp::socket& socket() { return m_socket; }
-                void send(const DataContainer & data);
+                const ConnectionStatistics & statistics() const { return m_statistics; }
+                bool binary() const { return m_handshake->binary; }
+                bool local() const { return m_handshake->local; }
+                bool disconnecting() const { return m_disconnect; }
+                void startHandshake();
+                
+                // must be called while holding the mutex of the server
+                void enqueue(const FramePtr & frame);
+                bool isFull() const;
+                void releaseSlot(const unsigned int slot);
+                void releaseSlots();
 
-            private:                
+            private:
+                // the state of the handshake outlives the connection if the
+                // connection is deleted while a read from the client is pending
+                struct Handshake
+                {
+                    explicit Handshake(Server* server) 
+                      : server(server),
+                        connection(0),
+                        isLoopback(false),
+                        hasHello(false),
+                        binary(false),
+                        local(false)
+                    {}
+                    
+                    Server* server;
+                    
+                    // reset when the connection is deleted, guarded by the mutex of the server
+                    Connection* connection;
+                    
+                    bool isLoopback;
+                    bool hasHello;
+                    boost::array<char, WireFormat::HELLO_SIZE> message;
+                    boost::atomic<bool> binary;
+                    boost::atomic<bool> local;
+                };
+                
+                // a queued frame, if it is shared the connection holds a 
+                // reference to its shared memory slot
+                struct Entry
+                {
+                    Entry() : shared(false) {}
+                    Entry(const FramePtr & frame, const bool shared) : frame(frame), shared(shared) {}
+                    
+                    FramePtr frame;
+                    bool shared;
+                };
+                
+                static void handleMessage(boost::shared_ptr<Handshake> handshake, 
+                                          const boost::system::error_code& error, size_t bytes_transferred);
                 void handleWrite(const boost::system::error_code& error, size_t bytes_transferred);
+                const std::vector<boost::asio::const_buffer> & buffers(const Entry & entry) const;
+                bool canSend(const Entry & entry) const;
+                void startRead();
+                void startWrite();
+                void drop(const Entry & entry);
 
                 Server* m_server;
                 boost::asio::ip::tcp::socket m_socket;
-                bool m_active;
-                std::string m_sizesData;
-                std::string m_headerData;
-                std::string m_textData;
-                std::string m_fileData;
+                boost::shared_ptr<Handshake> m_handshake;
+                std::deque<Entry> m_queue;
+                Entry m_current;
+                bool m_disconnect;
+                ConnectionStatistics m_statistics;
+                
+                // the shared memory slots which have been sent to the client 
+                // and which the client has not released yet
+                std::set<unsigned int> m_slots;
             };
             
+            /** 
+             * Sends data to all connected clients. Each data object is serialized
+             * once and queued for each client. If a client can not keep up with the
+             * frame rate of the server its queue fills up and the queue policy
+             * decides whether the server waits for the client or which frames are 
+             * dropped. Images and matrices are passed in 
+             * shared memory only to clients which connected via the loopback interface
+             * and announced that they can read from shared memory.
+             */
             class Server
             {
                 friend class Connection;
@@ -66,11 +205,45 @@ namespace stromx
         public:
                 static const Version VERSION;
                 
-                Server(const unsigned int port);
+                enum QueuePolicy
+                {
+                    /** Only the latest frame is queued, older pending frames are dropped. */
+                    LATEST_ONLY,
+                    /** The frames are queued up to the queue size, new frames are dropped if the queue is full. */
+                    BOUNDED_FIFO,
+                    /** The frames are queued up to the queue size, a client with a full queue is disconnected. */
+                    DISCONNECT_SLOW_CLIENT,
+                    /** The frames are queued up to the queue size, send() blocks while the queue of a client is full. */
+                    BLOCKING
+                };
+                
+                /** 
+                 * Constructs a server which listens at \c port or at a free port if \c port
+                 * is 0. Images and matrices are serialized in \c encoding. Only if the 
+                 * encoding is OutputProvider::DEFAULT or OutputProvider::RAW clients which
+                 * understand the binary wire format receive their rows without serialization.
+                 */
+                explicit Server(const unsigned int port, SharedMemoryRing* const sharedMemory = 0,
+                                const QueuePolicy policy = BLOCKING, const unsigned int queueSize = 1,
+                                const OutputProvider::Encoding encoding = OutputProvider::DEFAULT);
                 ~Server();
                 
+                /** Returns the port the server listens at. */
+                unsigned int port() const;
+                
                 unsigned int numConnections() const;
                 
+                /** Returns the statistics of each connected client. */
+                const std::vector<ConnectionStatistics> statistics() const;
+                
+                /** Returns the sum of the statistics of all current and past clients. */
+                const ConnectionStatistics totalStatistics() const;
+                
+                /** 
+                 * Sends \c data to all connected clients. Blocks until at least one 
+                 * client is connected. If the queue policy is BLOCKING it also blocks
+                 * until each client has room for the data in its queue.
+                 */
                 void send(const DataContainer & data);
                 void stop();
                 void join();
@@ -79,9 +252,16 @@ namespace stromx
                 void run();
                 void startAccept();
                 void handleAccept(Connection* connection, const boost::system::error_code & error);
-                void setConnectionActive(Connection* connection, const bool isActive);
+                void disconnectSlowClients();
+                // must be called while holding the mutex
+                bool hasFullConnection() const;
+                // must be called while holding the mutex
                 void removeConnection(Connection* connection);
                 void waitForNumConnections(const unsigned int numConnections);
+                FramePtr encode(const DataContainer & data, const bool textClients,
+                                const bool localClients, const bool otherClients);
+                bool storeInSharedMemory(const Data & data, SerializationHeader & header);
+                void releaseSlot(const Frame & frame);
                 
                 std::set<Connection*> m_connections;
                 boost::asio::io_service m_ioService;
@@ -89,6 +269,11 @@ namespace stromx
                 boost::thread m_thread;
                 mutable boost::mutex m_mutex;
                 boost::condition_variable m_cond;
+                SharedMemoryRing* m_sharedMemory;
+                QueuePolicy m_policy;
+                unsigned int m_queueSize;
+                OutputProvider::Encoding m_encoding;
+                ConnectionStatistics m_removedStatistics;
             };
         }
     }
@@ -0,0 +1,193 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/impl/SharedMemoryRing.h"
+
+#include <new>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/static_assert.hpp>
+#include "stromx/runtime/Exception.h"
+
+// the slot states are accessed by several processes, i.e. they must not be
+// protected by a process-local lock
+BOOST_STATIC_ASSERT(BOOST_ATOMIC_INT32_LOCK_FREE == 2);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            using namespace boost::interprocess;
+            
+            const int SharedMemoryRing::NO_SLOT;
+            
+            SharedMemoryRing::SharedMemoryRing(const std::string & name, const unsigned int numSlots,
+                                               const unsigned int slotSize)
+              : m_name(name),
+                m_isOwner(true),
+                m_nextSlot(0)
+            {
+                if(numSlots == 0 || slotSize == 0)
+                    throw WrongArgument("Shared memory rings must have at least one slot of non-zero size.");
+                
+                try
+                {
+                    // remove the remains of a crashed process which used the same name
+                    shared_memory_object::remove(name.c_str());
+                    
+                    shared_memory_object memory(create_only, name.c_str(), read_write);
+                    m_memory.swap(memory);
+                    m_memory.truncate(dataOffset(numSlots) + std::size_t(numSlots) * slotSize);
+                    
+                    mapped_region region(m_memory, read_write);
+                    m_region.swap(region);
+                }
+                catch(interprocess_exception & e)
+                {
+                    shared_memory_object::remove(name.c_str());
+                    throw OutOfMemory(std::string("Failed to create shared memory: ") + e.what());
+                }
+                
+                Header* h = header();
+                h->numSlots = numSlots;
+                h->slotSize = slotSize;
+                
+                SlotState* slotStates = states();
+                for(unsigned int i = 0; i < numSlots; ++i)
+                    new(slotStates + i) SlotState(FREE);
+                
+                // publish the segment after it has been initialized
+                boost::atomic_thread_fence(boost::memory_order_release);
+                h->magic = MAGIC;
+            }
+            
+            SharedMemoryRing::SharedMemoryRing(const std::string & name)
+              : m_name(name),
+                m_isOwner(false),
+                m_nextSlot(0)
+            {
+                try
+                {
+                    shared_memory_object memory(open_only, name.c_str(), read_write);
+                    m_memory.swap(memory);
+                    
+                    mapped_region region(m_memory, read_write);
+                    m_region.swap(region);
+                }
+                catch(interprocess_exception & e)
+                {
+                    throw WrongArgument(std::string("Failed to open shared memory: ") + e.what());
+                }
+                
+                if(m_region.get_size() < sizeof(Header) || header()->magic != MAGIC)
+                    throw WrongArgument("Shared memory " + name + " does not contain a ring.");
+                
+                boost::atomic_thread_fence(boost::memory_order_acquire);
+                
+                if(m_region.get_size() < dataOffset(numSlots()) + std::size_t(numSlots()) * slotSize())
+                    throw WrongArgument("Shared memory " + name + " is too small.");
+            }
+            
+            SharedMemoryRing::~SharedMemoryRing()
+            {
+                if(m_isOwner)
+                    shared_memory_object::remove(m_name.c_str());
+            }
+            
+            unsigned int SharedMemoryRing::numSlots() const
+            {
+                return header()->numSlots;
+            }
+            
+            unsigned int SharedMemoryRing::slotSize() const
+            {
+                return header()->slotSize;
+            }
+            
+            int SharedMemoryRing::acquireSlot()
+            {
+                const unsigned int n = numSlots();
+                SlotState* slotStates = states();
+                const unsigned int start = m_nextSlot.load(boost::memory_order_relaxed);
+                
+                // visit the slots in ring order starting after the last acquired slot
+                for(unsigned int i = 0; i < n; ++i)
+                {
+                    const unsigned int index = (start + i) % n;
+                    uint32_t expected = FREE;
+                    if(slotStates[index].compare_exchange_strong(expected, USED, boost::memory_order_acquire))
+                    {
+                        m_nextSlot.store((index + 1) % n, boost::memory_order_relaxed);
+                        return int(index);
+                    }
+                }
+                
+                return NO_SLOT;
+            }
+            
+            void SharedMemoryRing::retainSlot(const unsigned int index)
+            {
+                validateIndex(index);
+                states()[index].fetch_add(1, boost::memory_order_relaxed);
+            }
+            
+            void SharedMemoryRing::releaseSlot(const unsigned int index)
+            {
+                validateIndex(index);
+                
+                // do not decrement the count of free slots
+                SlotState & state = states()[index];
+                uint32_t count = state.load(boost::memory_order_relaxed);
+                while(count != FREE && ! state.compare_exchange_weak(count, count - 1, boost::memory_order_release))
+                {}
+            }
+            
+            uint8_t* SharedMemoryRing::slot(const unsigned int index)
+            {
+                validateIndex(index);
+                
+                uint8_t* base = static_cast<uint8_t*>(m_region.get_address());
+                return base + dataOffset(numSlots()) + std::size_t(index) * slotSize();
+            }
+            
+            std::size_t SharedMemoryRing::dataOffset(const unsigned int numSlots)
+            {
+                // align the slots to cache lines
+                const std::size_t ALIGNMENT = 64;
+                const std::size_t size = sizeof(Header) + numSlots * sizeof(SlotState);
+                return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            }
+            
+            SharedMemoryRing::Header* SharedMemoryRing::header() const
+            {
+                return static_cast<Header*>(m_region.get_address());
+            }
+            
+            SharedMemoryRing::SlotState* SharedMemoryRing::states() const
+            {
+                uint8_t* base = static_cast<uint8_t*>(m_region.get_address());
+                return reinterpret_cast<SlotState*>(base + sizeof(Header));
+            }
+            
+            void SharedMemoryRing::validateIndex(const unsigned int index) const
+            {
+                if(index >= numSlots())
+                    throw WrongId("Slot index is out of range.");
+            }
+        }
+    }
+}
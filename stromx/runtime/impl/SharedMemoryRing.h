@@ -0,0 +1,116 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_SHAREDMEMORYRING_H
+#define STROMX_RUNTIME_IMPL_SHAREDMEMORYRING_H
+
+#include <string>
+#include <boost/atomic.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Ring of fixed-size slots in a named shared memory segment. The
+             * segment is created by the sending process, which writes payloads
+             * into free slots and passes the slot indices to the receiving process.
+             * The receiving process opens the segment by its name, reads the slots
+             * and releases them afterwards, i.e. the slots are recycled. Each slot
+             * counts its references such that the same payload can be passed to
+             * several receivers.
+             */
+            class SharedMemoryRing
+            {
+            public:
+                static const int NO_SLOT = -1;
+                
+                /** Creates the segment \c name and removes it upon destruction. */
+                SharedMemoryRing(const std::string & name, const unsigned int numSlots,
+                                 const unsigned int slotSize);
+                
+                /** Opens the existing segment \c name. */
+                explicit SharedMemoryRing(const std::string & name);
+                
+                ~SharedMemoryRing();
+                
+                const std::string & name() const { return m_name; }
+                unsigned int numSlots() const;
+                unsigned int slotSize() const;
+                
+                /** 
+                 * Returns the index of a free slot and sets its reference count to 1. 
+                 * Returns NO_SLOT if all slots are in use.
+                 */
+                int acquireSlot();
+                
+                /** Increments the reference count of the used slot \c index. */
+                void retainSlot(const unsigned int index);
+                
+                /** 
+                 * Decrements the reference count of the slot \c index. The slot is 
+                 * free if the count drops to 0.
+                 */
+                void releaseSlot(const unsigned int index);
+                
+                uint8_t* slot(const unsigned int index);
+                
+            private:
+                typedef boost::atomic<uint32_t> SlotState;
+                
+                struct Header
+                {
+                    uint32_t magic;
+                    uint32_t numSlots;
+                    uint32_t slotSize;
+                };
+                
+                // the state of a used slot is its reference count
+                enum State
+                {
+                    FREE,
+                    USED
+                };
+                
+                static const uint32_t MAGIC = 0x53545258;
+                
+                static std::size_t dataOffset(const unsigned int numSlots);
+                
+                Header* header() const;
+                SlotState* states() const;
+                void validateIndex(const unsigned int index) const;
+                
+                std::string m_name;
+                bool m_isOwner;
+                boost::interprocess::shared_memory_object m_memory;
+                boost::interprocess::mapped_region m_region;
+                boost::atomic<unsigned int> m_nextSlot;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_SHAREDMEMORYRING_H
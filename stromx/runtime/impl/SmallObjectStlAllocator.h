@@ -0,0 +1,87 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_SMALLOBJECTSTLALLOCATOR_H
+#define STROMX_RUNTIME_IMPL_SMALLOBJECTSTLALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include "stromx/runtime/SmallObjectAllocator.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** Adapts the small object allocator to the interface of standard allocators. */
+            template <class T>
+            class SmallObjectStlAllocator
+            {
+            public:
+                typedef T value_type;
+                typedef T* pointer;
+                typedef const T* const_pointer;
+                typedef T& reference;
+                typedef const T& const_reference;
+                typedef std::size_t size_type;
+                typedef std::ptrdiff_t difference_type;
+                
+                template <class U>
+                struct rebind
+                {
+                    typedef SmallObjectStlAllocator<U> other;
+                };
+                
+                SmallObjectStlAllocator() {}
+                
+                template <class U>
+                SmallObjectStlAllocator(const SmallObjectStlAllocator<U> &) {}
+                
+                pointer address(reference x) const { return &x; }
+                const_pointer address(const_reference x) const { return &x; }
+                size_type max_size() const { return std::size_t(-1) / sizeof(T); }
+                
+                pointer allocate(const size_type n, const void* = 0)
+                {
+                    return static_cast<pointer>(SmallObjectAllocator::allocate(n * sizeof(T)));
+                }
+                
+                void deallocate(const pointer p, const size_type n)
+                {
+                    SmallObjectAllocator::deallocate(p, n * sizeof(T));
+                }
+                
+                void construct(const pointer p, const T & value) { new(p) T(value); }
+                void destroy(const pointer p) { p->~T(); }
+            };
+            
+            template <class T, class U>
+            bool operator==(const SmallObjectStlAllocator<T> &, const SmallObjectStlAllocator<U> &)
+            {
+                return true;
+            }
+            
+            template <class T, class U>
+            bool operator!=(const SmallObjectStlAllocator<T> &, const SmallObjectStlAllocator<U> &)
+            {
+                return false;
+            }
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_SMALLOBJECTSTLALLOCATOR_H
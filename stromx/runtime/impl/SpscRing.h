@@ -0,0 +1,158 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_SPSCRING_H
+#define STROMX_RUNTIME_IMPL_SPSCRING_H
+
+#include <boost/atomic.hpp>
+#include <cstddef>
+#include <vector>
+#include "stromx/runtime/Exception.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /**
+             * Bounded single-producer/single-consumer ring buffer. Pushing and 
+             * popping does not lock and never blocks. The producer and the consumer
+             * only share the two position counters which are placed on different
+             * cache lines. Each side caches the last counter value it has read of the
+             * other side and only reloads it if the ring appears to be full or empty.
+             */
+            template <class T>
+            class SpscRing
+            {
+            public:
+                explicit SpscRing(const std::size_t capacity)
+                  : m_capacity(capacity),
+                    m_mask(0),
+                    m_head(0),
+                    m_tailCache(0),
+                    m_tail(0),
+                    m_headCache(0)
+                {
+                    if(capacity == 0)
+                        throw WrongArgument("Capacity of a ring must be positive.");
+                    
+                    // the size of the buffer is rounded up to a power of 2 to replace
+                    // the modulo operation by a mask
+                    std::size_t size = 1;
+                    while(size < capacity)
+                        size <<= 1;
+                    
+                    m_buffer.resize(size);
+                    m_mask = size - 1;
+                }
+                
+                std::size_t capacity() const { return m_capacity; }
+                
+                /** Must only be called by the producer. */
+                bool tryPush(const T & value)
+                {
+                    const std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+                    
+                    if(tail - m_headCache == m_capacity)
+                    {
+                        m_headCache = m_head.load(boost::memory_order_acquire);
+                        if(tail - m_headCache == m_capacity)
+                            return false;
+                    }
+                    
+                    m_buffer[tail & m_mask] = value;
+                    m_tail.store(tail + 1, boost::memory_order_release);
+                    return true;
+                }
+                
+                /** 
+                 * Returns a pointer to the oldest element or null if the ring is empty.
+                 * Must only be called by the consumer.
+                 */
+                T* front()
+                {
+                    const std::size_t head = m_head.load(boost::memory_order_relaxed);
+                    
+                    if(head == m_tailCache)
+                    {
+                        m_tailCache = m_tail.load(boost::memory_order_acquire);
+                        if(head == m_tailCache)
+                            return 0;
+                    }
+                    
+                    return &m_buffer[head & m_mask];
+                }
+                
+                /** Must only be called by the consumer. */
+                bool pop()
+                {
+                    T* value = front();
+                    if(! value)
+                        return false;
+                    
+                    // release the element before the producer can overwrite it
+                    *value = T();
+                    
+                    const std::size_t head = m_head.load(boost::memory_order_relaxed);
+                    m_head.store(head + 1, boost::memory_order_release);
+                    return true;
+                }
+                
+                std::size_t size() const
+                {
+                    const std::size_t head = m_head.load(boost::memory_order_acquire);
+                    const std::size_t tail = m_tail.load(boost::memory_order_acquire);
+                    return tail - head;
+                }
+                
+                bool empty() const { return size() == 0; }
+                
+                bool full() const { return size() >= m_capacity; }
+                
+                /** Removes all elements. Must not be called concurrently with any other member. */
+                void clear()
+                {
+                    while(pop())
+                        ;
+                }
+                
+            private:
+                enum { CACHE_LINE_SIZE = 64 };
+                
+                SpscRing(const SpscRing&);
+                SpscRing & operator=(const SpscRing&);
+                
+                std::vector<T> m_buffer;
+                std::size_t m_capacity;
+                std::size_t m_mask;
+                char m_padding0[CACHE_LINE_SIZE];
+                
+                // written by the consumer
+                boost::atomic<std::size_t> m_head;
+                std::size_t m_tailCache;
+                char m_padding1[CACHE_LINE_SIZE];
+                
+                // written by the producer
+                boost::atomic<std::size_t> m_tail;
+                std::size_t m_headCache;
+                char m_padding2[CACHE_LINE_SIZE];
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_SPSCRING_H
@@ -14,8 +14,11 @@
  *  limitations under the License.
  */
 
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/thread/thread.hpp>
 #include "stromx/runtime/Data.h"
+#include "stromx/runtime/DataChannel.h"
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Factory.h"
@@ -24,6 +27,8 @@
 #include "stromx/runtime/OperatorKernel.h"
 #include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/impl/SynchronizedOperatorKernel.h"
+#include "stromx/runtime/impl/Tracer.h"
+#include "stromx/runtime/impl/WorkerPool.h"
 
 namespace
 {
@@ -40,7 +45,13 @@ namespace stromx
               : m_op(op),
                 m_status(NONE),
                 m_parametersAreLocked(false),
-                m_factory(0)
+                m_factory(0),
+                m_hasChannels(false),
+                m_numChannelWaiters(0),
+                m_statisticsEnabled(false),
+                m_numReplicas(1),
+                m_dispatch(ReplicaPool::ROUND_ROBIN),
+                m_replicaPool(0)
             {
                 if(!op)
                     throw WrongArgument("Passed null pointer as operator.");
@@ -48,6 +59,13 @@ namespace stromx
             
             SynchronizedOperatorKernel::~SynchronizedOperatorKernel()
             {
+                for(WaiterMap::iterator iter = m_inputWaiters.begin(); iter != m_inputWaiters.end(); ++iter)
+                    delete iter->second;
+                
+                for(WaiterMap::iterator iter = m_outputWaiters.begin(); iter != m_outputWaiters.end(); ++iter)
+                    delete iter->second;
+                
+                delete m_replicaPool;
                 delete m_op;
             }
             
@@ -73,6 +91,7 @@ namespace stromx
                 
                 try
                 {
+                    WorkerPool::BlockingScope scope;
                     boost::this_thread::sleep_for(boost::chrono::microseconds(microseconds));
                 }
                 catch(boost::thread_interrupted&)
@@ -137,12 +156,93 @@ namespace stromx
                 {
                     throw OperatorError(*info(), e.what());
                 }
-               
+                
+                // collect the connectors which bypass the execution of the operator
+                for(std::vector<const Input*>::const_iterator iter = info()->inputs().begin();
+                    iter != info()->inputs().end();
+                    ++iter)
+                {
+                    if(DataChannel* channel = m_op->channel((*iter)->id()))
+                    {
+                        // data channels never drop data
+                        if(findOverflowPolicy((*iter)->id()) != Input::BLOCK)
+                        {
+                            m_channels.clear();
+                            m_op->deactivate();
+                            throw WrongOperatorState(*info(), "Inputs with a data channel must block if they are occupied.");
+                        }
+                        
+                        m_channels[(*iter)->id()] = channel;
+                    }
+                }
+                
+                for(std::vector<const Output*>::const_iterator iter = info()->outputs().begin();
+                    iter != info()->outputs().end();
+                    ++iter)
+                {
+                    if(DataChannel* channel = m_op->channel((*iter)->id()))
+                        m_channels[(*iter)->id()] = channel;
+                }
+                
+                if(m_numReplicas > 1)
+                {
+                    try
+                    {
+                        if(! m_channels.empty())
+                            throw WrongOperatorState(*info(), "Operators with data channels can not be replicated.");
+                        
+                        m_inputIds.clear();
+                        for(std::vector<const Input*>::const_iterator iter = info()->inputs().begin();
+                            iter != info()->inputs().end();
+                            ++iter)
+                        {
+                            m_inputIds.push_back((*iter)->id());
+                        }
+                        
+                        m_outputIds.clear();
+                        for(std::vector<const Output*>::const_iterator iter = info()->outputs().begin();
+                            iter != info()->outputs().end();
+                            ++iter)
+                        {
+                            m_outputIds.push_back((*iter)->id());
+                        }
+                        
+                        for(std::vector<const Parameter*>::const_iterator iter = info()->parameters().begin();
+                            iter != info()->parameters().end();
+                            ++iter)
+                        {
+                            if((*iter)->originalType() == Description::INPUT)
+                                m_inputIds.push_back((*iter)->id());
+                            else if((*iter)->originalType() == Description::OUTPUT)
+                                m_outputIds.push_back((*iter)->id());
+                        }
+                        
+                        m_replicaPool = new ReplicaPool(*m_op, m_numReplicas, m_dispatch, factory(),
+                            boost::bind(&SynchronizedOperatorKernel::onReplicaFinished, this));
+                    }
+                    catch(OperatorError &)
+                    {
+                        m_channels.clear();
+                        m_op->deactivate();
+                        throw;
+                    }
+                    catch(std::exception & e)
+                    {
+                        m_channels.clear();
+                        m_op->deactivate();
+                        throw OperatorError(*info(), e.what());
+                    }
+                }
+                
+                m_hasChannels.store(! m_channels.empty(), boost::memory_order_release);
                 m_status = ACTIVE;
             }
             
             void SynchronizedOperatorKernel::deactivate()
             {
+                // the replica pool is deleted after the kernel has been unlocked
+                // because the replica threads might wait for the lock
+                boost::scoped_ptr<ReplicaPool> replicaPool;
                 lock_t lock(m_mutex);
                 
                 if(m_status == INITIALIZED || m_status == NONE)
@@ -153,7 +253,13 @@ namespace stromx
                 
                 m_inputMap.clear();
                 m_outputMap.clear();
+                m_hasChannels.store(false, boost::memory_order_release);
+                m_channels.clear();
+                replicaPool.reset(m_replicaPool);
+                m_replicaPool = 0;
                 m_status = INITIALIZED;
+                notifyAll();
+                m_channelCond.notify_all();
                 
                 try
                 {
@@ -228,7 +334,7 @@ namespace stromx
                     if (m_outputMap.mustBeReset(id))
                     {
                         m_outputMap.set(id, DataContainer());
-                        m_dataCond.notify_all();
+                        notify(m_sendWaiters);
                     }
                         
                     ReadAccess access(data, timeout);
@@ -263,11 +369,15 @@ namespace stromx
                 if (isInputParameter(id))
                 {
                     while (! m_inputMap.canBeSet(id))
-                        waitForSignal(m_dataCond, lock, waitWithTimeout, timeout);
+                        waitForData(waiters(m_inputWaiters, id), lock, waitWithTimeout, timeout);
                         
                     DataContainer data(value.clone(), true);
                     m_inputMap.set(id, data);
-                    m_dataCond.notify_all();
+                    notify(m_receiveWaiters);
+                    
+                    // the threads waiting for a replicated operator pass the inputs on
+                    if(m_replicaPool)
+                        notifyAll();
                     return;
                 }
                 
@@ -286,6 +396,9 @@ namespace stromx
                 {
                     throw OperatorError(*info(), e.what());
                 }
+                
+                if(m_replicaPool)
+                    m_replicaPool->setParameter(id, value);
             }
 
             void SynchronizedOperatorKernel::receiveInputData(const Id2DataMapper& mapper)
@@ -295,10 +408,17 @@ namespace stromx
                 
                 BOOST_ASSERT(m_status == EXECUTING); // this function can only be called from OperatorKernel::execute();
                 
+                const bool collectStatistics = m_statisticsEnabled;
+                const boost::chrono::steady_clock::time_point start = collectStatistics ?
+                    boost::chrono::steady_clock::now() : boost::chrono::steady_clock::time_point();
+                
                 try
                 {
                     while(! mapper.tryGet(m_inputMap))
-                        waitForSignal(m_dataCond, lock, false);
+                        waitForData(m_receiveWaiters, lock, false);
+                    
+                    if(collectStatistics)
+                        m_statistics.addReceiveTime(elapsedTime(start));
                     
                     mapper.get(m_inputMap);
                 }
@@ -309,7 +429,7 @@ namespace stromx
                 }   
                 
                 m_parametersAreLocked = true;
-                m_dataCond.notify_all();
+                notifyFreeInputs();
             }
 
             void SynchronizedOperatorKernel::sendOutputData(const runtime::Id2DataMapper& mapper)
@@ -319,10 +439,17 @@ namespace stromx
                 
                 BOOST_ASSERT(m_status == EXECUTING); // this function can only be called from OperatorKernel::execute()
                 
+                const bool collectStatistics = m_statisticsEnabled;
+                const boost::chrono::steady_clock::time_point start = collectStatistics ?
+                    boost::chrono::steady_clock::now() : boost::chrono::steady_clock::time_point();
+                
                 try
                 {
                     while(! mapper.trySet(m_outputMap))
-                        waitForSignal(m_dataCond, lock, false);
+                        waitForData(m_sendWaiters, lock, false);
+                    
+                    if(collectStatistics)
+                        m_statistics.addSendTime(elapsedTime(start));
                     
                     mapper.set(m_outputMap);
                 }
@@ -333,7 +460,7 @@ namespace stromx
                 }   
                 
                 m_parametersAreLocked = true;
-                m_dataCond.notify_all();  
+                notifyAvailableOutputs();
             }
             
             void SynchronizedOperatorKernel::validateDataAccess()
@@ -347,27 +474,47 @@ namespace stromx
             
             DataContainer SynchronizedOperatorKernel::getOutputData(const unsigned int id)
             {
+                if(DataChannel* channel = findChannel(id))
+                {
+                    DataContainer data = channel->front();
+                    while(data.empty())
+                    {
+                        waitForChannel(*channel, false);
+                        data = channel->front();
+                    }
+                    
+                    return data;
+                }
+                
                 unique_lock_t lock(m_mutex);
                 validateDataAccess();
                 validateOutputId(id);
                 
-                while(m_outputMap.get(id).empty())
+                if(m_replicaPool)
                 {
-                    bool success = false;
+                    while(m_outputMap.get(id).empty())
                     {
-                        lock.unlock();
-                        
-                        // this section might throw an InterruptionException which will fall
-                        // through to the calling function
-                        success = tryExecute();
-                        
-                        lock.lock();
+                        validateDataAccess();
+                        if(! pumpReplicas())
+                            waitForData(waiters(m_outputWaiters, id), lock, false);
                     }
                     
-                    if(! success)
-                        waitForSignal(m_dataCond, lock, false); // wait for the situation to change
+                    return m_outputMap.get(id);
+                }
+                
+                while(m_outputMap.get(id).empty())
+                {
+                    // this might throw an InterruptionException which will fall
+                    // through to the calling function
+                    if(! tryExecute(lock))
+                    {
+                        // wait for the output or the end of the current execution
+                        waitForData(waiters(m_outputWaiters, id), lock, false);
+                    }
                     else
+                    {
                         testForInterrupt(); // give us some chance to escape the while loop
+                    }
                 }
                 
                 return m_outputMap.get(id);
@@ -375,48 +522,118 @@ namespace stromx
 
             void SynchronizedOperatorKernel::setInputData(const unsigned int id, DataContainer data)
             {
+                if(DataChannel* channel = findChannel(id))
+                {
+                    while(! channel->tryPush(data))
+                        waitForChannel(*channel, true);
+                    
+                    notifyChannel();
+                    return;
+                }
+                
                 unique_lock_t lock(m_mutex);
                 validateDataAccess();
                 validateInputId(id);
                 
-                while(! m_inputMap.canBeSet(id))
+                // inputs which do not block drop the new or the current data
+                // if they are occupied
+                const Input::OverflowPolicy policy = m_inputMap.canBeSet(id) ?
+                    Input::BLOCK : findOverflowPolicy(id);
+                
+                if(policy == Input::DROP_NEWEST)
                 {
-                    bool success = false;
+                    m_statistics.addDroppedData(id);
+                    return;
+                }
+                
+                if(policy == Input::DROP_OLDEST)
+                {
+                    m_statistics.addDroppedData(id);
+                    m_inputMap.set(id, DataContainer());
+                }
+                
+                if(m_replicaPool)
+                {
+                    while(! m_inputMap.canBeSet(id))
                     {
-                        lock.unlock();
-                        
-                        // this section might throw an Interrupt exception which will fall
-                        // through to the calling function
-                        success = tryExecute();
-                        
-                        lock.lock();
+                        validateDataAccess();
+                        if(! pumpReplicas())
+                            waitForData(waiters(m_inputWaiters, id), lock, false);
                     }
                     
-                    if(! success)
-                        waitForSignal(m_dataCond, lock, false); // wait for the situation to change
+                    m_inputMap.set(id, data);
+                    pumpReplicas();
+                    return;
+                }
+                
+                while(! m_inputMap.canBeSet(id))
+                {
+                    // this might throw an Interrupt exception which will fall
+                    // through to the calling function
+                    if(! tryExecute(lock))
+                    {
+                        // wait for the input to be freed or the end of the current execution
+                        waitForData(waiters(m_inputWaiters, id), lock, false);
+                    }
                     else
+                    {
                         testForInterrupt(); // give us some chance to escape the while loop
+                    }
                 }
                 
                 m_inputMap.set(id, data);
-                m_dataCond.notify_all();
+                notify(m_receiveWaiters);
                 
                 // if this is a greedy operator try to execute it immediately
                 if (m_op->properties().isGreedy)
-                {
-                   lock.unlock();
-                   tryExecute();
-                }
+                   tryExecute(lock);
             }
             
             void SynchronizedOperatorKernel::clearOutputData(unsigned int id)
             {
+                if(DataChannel* channel = findChannel(id))
+                {
+                    if(channel->pop())
+                        notifyChannel();
+                    return;
+                }
+                
                 lock_t lock(m_mutex);
                 validateDataAccess();
                 validateOutputId(id);
                 
                 m_outputMap.set(id, DataContainer());
-                m_dataCond.notify_all();
+                notify(m_sendWaiters);
+                
+                // the threads waiting for a replicated operator can pass on the next result
+                if(m_replicaPool)
+                    notifyAll();
+            }
+            
+            bool SynchronizedOperatorKernel::hasOutputData(const unsigned int id)
+            {
+                if(DataChannel* channel = findChannel(id))
+                    return ! channel->isEmpty();
+                
+                lock_t lock(m_mutex);
+                
+                if(m_status != ACTIVE && m_status != EXECUTING)
+                    return false;
+                
+                return ! m_outputMap.get(id).empty();
+            }
+            
+            bool SynchronizedOperatorKernel::canSetInputData(const unsigned int id)
+            {
+                if(DataChannel* channel = findChannel(id))
+                    return ! channel->isFull();
+                
+                lock_t lock(m_mutex);
+                
+                if(m_status != ACTIVE && m_status != EXECUTING)
+                    return false;
+                
+                return m_inputMap.canBeSet(id) || findOverflowPolicy(id) != Input::BLOCK;
             }
             
             void SynchronizedOperatorKernel::lockParameters()
@@ -466,42 +683,264 @@ namespace stromx
                 m_outputMap.initialize(m_op->outputs(), m_op->parameters());
             }
             
-            bool SynchronizedOperatorKernel::tryExecute()
+            OperatorStatistics SynchronizedOperatorKernel::statistics()
+            {
+                lock_t lock(m_mutex);
+                return m_statistics;
+            }
+            
+            void SynchronizedOperatorKernel::resetStatistics()
+            {
+                lock_t lock(m_mutex);
+                m_statistics = OperatorStatistics();
+            }
+            
+            bool SynchronizedOperatorKernel::statisticsEnabled()
+            {
+                lock_t lock(m_mutex);
+                return m_statisticsEnabled;
+            }
+            
+            void SynchronizedOperatorKernel::setStatisticsEnabled(const bool enabled)
             {
+                lock_t lock(m_mutex);
+                m_statisticsEnabled = enabled;
+            }
+            
+            unsigned int SynchronizedOperatorKernel::numReplicas()
+            {
+                lock_t lock(m_mutex);
+                return m_numReplicas;
+            }
+            
+            ReplicaPool::Dispatch SynchronizedOperatorKernel::dispatch()
+            {
+                lock_t lock(m_mutex);
+                return m_dispatch;
+            }
+            
+            void SynchronizedOperatorKernel::setReplication(const unsigned int numReplicas,
+                                                            const ReplicaPool::Dispatch dispatch)
+            {
+                lock_t lock(m_mutex);
+                
+                if (m_status == EXECUTING || m_status == ACTIVE)
+                    throw WrongState("Replication can not be set if the operator is active or executing.");
+                
+                if (numReplicas == 0)
+                    throw WrongArgument("The number of replicas must be positive.");
+                
+                m_numReplicas = numReplicas;
+                m_dispatch = dispatch;
+            }
+            
+            Input::OverflowPolicy SynchronizedOperatorKernel::overflowPolicy(const unsigned int id)
+            {
+                lock_t lock(m_mutex);
+                validateInputId(id);
+                
+                return findOverflowPolicy(id);
+            }
+            
+            void SynchronizedOperatorKernel::setOverflowPolicy(const unsigned int id, const Input::OverflowPolicy policy)
+            {
+                lock_t lock(m_mutex);
+                validateInputId(id);
+                
+                if(policy != Input::BLOCK && m_op->usesChannel(id))
+                    throw WrongArgument("Inputs with a data channel must block if they are occupied.");
+                
+                m_overflowPolicies[id] = policy;
+            }
+            
+            Input::OverflowPolicy SynchronizedOperatorKernel::findOverflowPolicy(const unsigned int id) const
+            {
+                std::map<unsigned int, Input::OverflowPolicy>::const_iterator iter = m_overflowPolicies.find(id);
+                if(iter != m_overflowPolicies.end())
+                    return iter->second;
+                
+                return info()->input(id).overflowPolicy();
+            }
+            
+            bool SynchronizedOperatorKernel::pumpReplicas()
+            {
+                bool progress = false;
+                
+                // pass complete sets of inputs to the replicas but do not queue
+                // more than two sets per replica
+                bool inputsComplete = m_replicaPool->numPending() < 2 * m_replicaPool->size();
+                for(std::vector<unsigned int>::const_iterator iter = m_inputIds.begin();
+                    iter != m_inputIds.end() && inputsComplete;
+                    ++iter)
                 {
-                    lock_t lock(m_mutex);
+                    inputsComplete = ! m_inputMap.get(*iter).empty();
+                }
+                
+                if(inputsComplete)
+                {
+                    ReplicaPool::DataMap inputs;
+                    for(std::vector<unsigned int>::const_iterator iter = m_inputIds.begin();
+                        iter != m_inputIds.end();
+                        ++iter)
+                    {
+                        inputs[*iter] = m_inputMap.get(*iter);
+                        if(m_inputMap.mustBeReset(*iter))
+                            m_inputMap.set(*iter, DataContainer());
+                    }
                     
-                    if(m_status == EXECUTING)
+                    m_replicaPool->submit(inputs);
+                    notifyFreeInputs();
+                    progress = true;
+                }
+                
+                // results are taken in the order of the inputs once all outputs are free
+                bool outputsFree = true;
+                for(std::vector<unsigned int>::const_iterator iter = m_outputIds.begin();
+                    iter != m_outputIds.end() && outputsFree;
+                    ++iter)
+                {
+                    outputsFree = m_outputMap.canBeSet(*iter);
+                }
+                
+                ReplicaPool::Result result;
+                if(outputsFree && m_replicaPool->tryTakeResult(result))
+                {
+                    if(m_statisticsEnabled)
+                        m_statistics.addExecution(result.executionTime, result.failed);
+                    
+                    if(result.failed)
                     {
-                        return false;
+                        notifyAll();
+                        throw OperatorError(*info(), result.message);
                     }
-                    else
+                    
+                    for(ReplicaPool::DataMap::const_iterator iter = result.outputs.begin();
+                        iter != result.outputs.end();
+                        ++iter)
                     {
-                        try
-                        {
-                            boost::this_thread::interruption_point();
-                        }
-                        catch(boost::thread_interrupted&)
-                        {
-                            m_parameterCond.notify_all();
-                            throw Interrupt();
-                        }
-                        m_status = EXECUTING;
-                        m_parametersAreLocked = true;
+                        m_outputMap.set(iter->first, iter->second);
+                    }
+                    
+                    notifyAvailableOutputs();
+                    progress = true;
+                }
+                
+                return progress;
+            }
+            
+            void SynchronizedOperatorKernel::onReplicaFinished()
+            {
+                lock_t lock(m_mutex);
+                notifyAll();
+            }
+            
+            bool SynchronizedOperatorKernel::tryExecute(unique_lock_t & lock)
+            {
+                // the caller checked its input or output while holding the lock,
+                // releasing it before the execution starts would allow another execution 
+                // to occupy this connector in between and block the new execution forever
+                if(m_status == EXECUTING)
+                    return false;
+                
+                bool collectStatistics = false;
+                boost::chrono::steady_clock::time_point start;
+                beginExecution(collectStatistics, start);
+                
+                lock.unlock();
+                executeKernel(collectStatistics, start);
+                lock.lock();
+                
+                if(collectStatistics)
+                    m_statistics.addExecution(elapsedTime(start), false);
+                endExecution();
+        
+                return true;
+            }
+            
+            DataContainer SynchronizedOperatorKernel::process(const unsigned int inputId, DataContainer data,
+                                                              const unsigned int outputId)
+            {
+                bool collectStatistics = false;
+                boost::chrono::steady_clock::time_point start;
+                
+                {
+                    unique_lock_t lock(m_mutex);
+                    validateDataAccess();
+                    validateInputId(inputId);
+                    validateOutputId(outputId);
+                    
+                    // take the generic path unless the caller is the only client of the
+                    // operator and both connectors are served by the data maps
+                    const bool isExclusive = m_status == ACTIVE
+                        && ! m_replicaPool
+                        && ! findChannel(inputId)
+                        && ! findChannel(outputId)
+                        && m_inputMap.canBeSet(inputId)
+                        && m_outputMap.get(outputId).empty();
+                    
+                    if(! isExclusive)
+                    {
+                        lock.unlock();
+                        
+                        setInputData(inputId, data);
+                        DataContainer output = getOutputData(outputId);
+                        clearOutputData(outputId);
+                        return output;
                     }
+                    
+                    m_inputMap.set(inputId, data);
+                    beginExecution(collectStatistics, start);
                 }
                 
+                executeKernel(collectStatistics, start);
+                
+                lock_t lock(m_mutex);
+                if(collectStatistics)
+                    m_statistics.addExecution(elapsedTime(start), false);
+                
+                endExecution();
+                
+                // the output is handed to the caller and not kept by the operator
+                DataContainer output = m_outputMap.get(outputId);
+                if(! output.empty())
+                    m_outputMap.set(outputId, DataContainer());
+                
+                return output;
+            }
+            
+            void SynchronizedOperatorKernel::beginExecution(bool & collectStatistics,
+                                                            boost::chrono::steady_clock::time_point & start)
+            {
+                try
+                {
+                    boost::this_thread::interruption_point();
+                }
+                catch(boost::thread_interrupted&)
+                {
+                    m_parameterCond.notify_all();
+                    throw Interrupt();
+                }
+                m_status = EXECUTING;
+                m_parametersAreLocked = true;
+                
+                collectStatistics = m_statisticsEnabled;
+                if(collectStatistics)
+                    start = boost::chrono::steady_clock::now();
+            }
+            
+            void SynchronizedOperatorKernel::executeKernel(const bool collectStatistics,
+                                                           const boost::chrono::steady_clock::time_point & start)
+            {
                 try
                 {
+                    Tracer::Span span("operator", "execute", &m_op->type());
                     m_op->execute(*this);
                 }
                 catch(Interrupt &)
                 {
                     // pass interrupts to the caller
                     lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
+                    endExecution();
                     
                     throw;
                 }
@@ -509,9 +948,9 @@ namespace stromx
                 {
                     // pass all operator exceptions to the caller
                     lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
+                    if(collectStatistics)
+                        m_statistics.addExecution(elapsedTime(start), true);
+                    endExecution();
                     
                     throw;
                 }
@@ -519,9 +958,7 @@ namespace stromx
                 {
                     // pass interrupts to the caller
                     lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
+                    endExecution();
                     
                     throw Interrupt();
                 }
@@ -529,9 +966,9 @@ namespace stromx
                 {
                     // wrap other exceptions
                     lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
+                    if(collectStatistics)
+                        m_statistics.addExecution(elapsedTime(start), true);
+                    endExecution();
                     
                     throw OperatorError(*info(), e.what());
                 }
@@ -539,26 +976,34 @@ namespace stromx
                 {
                     // handle remaining exceptions
                     lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
+                    if(collectStatistics)
+                        m_statistics.addExecution(elapsedTime(start), true);
+                    endExecution();
                     
                     throw OperatorError(*info(), "Unknown error.");
                 }
+            }
+            
+            void SynchronizedOperatorKernel::endExecution()
+            {
+                m_status = ACTIVE;
+                m_parametersAreLocked = false;
+                m_parameterCond.notify_all();
                 
-                {
-                    lock_t lock(m_mutex);
-                    m_status = ACTIVE;
-                    m_parametersAreLocked = false;
-                    m_parameterCond.notify_all();
-                }
-        
-                return true;
+                // the executing thread was the only one which could wait in receiveInputData()
+                // or sendOutputData(), i.e. only the waiters for inputs and outputs are woken
+                notifyFreeInputs();
+                notifyAvailableOutputs();
+                notifyNextExecution();
             }
             
             void SynchronizedOperatorKernel::waitForSignal(boost::condition_variable & condition, unique_lock_t& lock,
                                                            const bool waitWithTimeout, const unsigned int timeout)
             {
+                // allow a worker pool to replace the blocked worker
+                WorkerPool::BlockingScope scope;
+                Tracer::Span span("wait", "waitForSignal");
+                
                 try
                 {
                     if(waitWithTimeout)
@@ -580,6 +1025,184 @@ namespace stromx
                 } 
             }
             
+            void SynchronizedOperatorKernel::waitForData(Waiters & waiters, unique_lock_t& lock,
+                                                         const bool waitWithTimeout, const unsigned int timeout)
+            {
+                // the count tells the notifying threads whether it is worth signalling
+                // the condition, it is only changed while the kernel is locked
+                ++waiters.count;
+                
+                try
+                {
+                    waitForSignal(waiters.cond, lock, waitWithTimeout, timeout);
+                }
+                catch(Interrupt &)
+                {
+                    --waiters.count;
+                    
+                    // pass the execution on if this thread was woken to execute the operator
+                    if(m_status == ACTIVE)
+                        notifyNextExecution();
+                    
+                    throw;
+                }
+                catch(Timeout &)
+                {
+                    --waiters.count;
+                    throw;
+                }
+                
+                --waiters.count;
+            }
+            
+            SynchronizedOperatorKernel::Waiters & SynchronizedOperatorKernel::waiters(WaiterMap & map, const unsigned int id)
+            {
+                WaiterMap::iterator iter = map.find(id);
+                if(iter != map.end())
+                    return *iter->second;
+                
+                Waiters* waiters = new Waiters;
+                map[id] = waiters;
+                return *waiters;
+            }
+            
+            void SynchronizedOperatorKernel::notify(Waiters & waiters)
+            {
+                if(waiters.count)
+                    waiters.cond.notify_all();
+            }
+            
+            void SynchronizedOperatorKernel::notifyFreeInputs()
+            {
+                // only wake the threads which wait for an input which can be set now
+                for(WaiterMap::iterator iter = m_inputWaiters.begin(); iter != m_inputWaiters.end(); ++iter)
+                {
+                    if(iter->second->count && m_inputMap.canBeSet(iter->first))
+                        iter->second->cond.notify_all();
+                }
+            }
+            
+            void SynchronizedOperatorKernel::notifyAvailableOutputs()
+            {
+                // only wake the threads which wait for an output which has been set
+                for(WaiterMap::iterator iter = m_outputWaiters.begin(); iter != m_outputWaiters.end(); ++iter)
+                {
+                    if(iter->second->count && ! m_outputMap.get(iter->first).empty())
+                        iter->second->cond.notify_all();
+                }
+            }
+            
+            void SynchronizedOperatorKernel::notifyNextExecution()
+            {
+                // a thread which waits for the end of the execution executes the operator 
+                // itself, waking the waiters of one connector is sufficient because the 
+                // end of the next execution wakes the next connector
+                for(WaiterMap::iterator iter = m_outputWaiters.begin(); iter != m_outputWaiters.end(); ++iter)
+                {
+                    if(iter->second->count && m_outputMap.get(iter->first).empty())
+                    {
+                        iter->second->cond.notify_all();
+                        return;
+                    }
+                }
+                
+                for(WaiterMap::iterator iter = m_inputWaiters.begin(); iter != m_inputWaiters.end(); ++iter)
+                {
+                    if(iter->second->count && ! m_inputMap.canBeSet(iter->first))
+                    {
+                        iter->second->cond.notify_all();
+                        return;
+                    }
+                }
+            }
+            
+            void SynchronizedOperatorKernel::notifyAll()
+            {
+                for(WaiterMap::iterator iter = m_inputWaiters.begin(); iter != m_inputWaiters.end(); ++iter)
+                    notify(*iter->second);
+                
+                for(WaiterMap::iterator iter = m_outputWaiters.begin(); iter != m_outputWaiters.end(); ++iter)
+                    notify(*iter->second);
+                
+                notify(m_receiveWaiters);
+                notify(m_sendWaiters);
+            }
+            
+            bool SynchronizedOperatorKernel::usesChannel(const unsigned int id)
+            {
+                lock_t lock(m_mutex);
+                return m_op->usesChannel(id);
+            }
+            
+            DataChannel* SynchronizedOperatorKernel::findChannel(const unsigned int id) const
+            {
+                // the channels are not read unless they have been published, i.e.
+                // they are only found while the operator is active
+                if(! m_hasChannels.load(boost::memory_order_acquire))
+                    return 0;
+                
+                std::map<unsigned int, DataChannel*>::const_iterator iter = m_channels.find(id);
+                return iter != m_channels.end() ? iter->second : 0;
+            }
+            
+            void SynchronizedOperatorKernel::waitForChannel(const DataChannel & channel, const bool waitForSpace)
+            {
+                unique_lock_t lock(m_mutex);
+                validateDataAccess();
+                
+                // announce the waiter before checking the channel again, notifyChannel()
+                // does the opposite which guarantees that no signal is lost
+                ++m_numChannelWaiters;
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                
+                try
+                {
+                    if(waitForSpace ? channel.isFull() : channel.isEmpty())
+                    {
+                        const bool collectStatistics = m_statisticsEnabled;
+                        const boost::chrono::steady_clock::time_point start = collectStatistics ?
+                            boost::chrono::steady_clock::now() : boost::chrono::steady_clock::time_point();
+                        
+                        waitForSignal(m_channelCond, lock, false);
+                        
+                        // a full channel delays the output of the data, an empty
+                        // one waits for input data
+                        if(collectStatistics && waitForSpace)
+                            m_statistics.addSendTime(elapsedTime(start));
+                        else if(collectStatistics)
+                            m_statistics.addReceiveTime(elapsedTime(start));
+                    }
+                }
+                catch(Interrupt &)
+                {
+                    --m_numChannelWaiters;
+                    throw;
+                }
+                
+                --m_numChannelWaiters;
+                
+                // the channel has been deleted if the operator was deactivated meanwhile
+                validateDataAccess();
+            }
+            
+            void SynchronizedOperatorKernel::notifyChannel()
+            {
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                
+                // only lock the kernel if somebody waits for the channel
+                if(m_numChannelWaiters.load(boost::memory_order_relaxed))
+                {
+                    lock_t lock(m_mutex);
+                    m_channelCond.notify_all();
+                }
+            }
+            
+            uint64_t SynchronizedOperatorKernel::elapsedTime(const boost::chrono::steady_clock::time_point & start) const
+            {
+                using namespace boost::chrono;
+                return duration_cast<microseconds>(steady_clock::now() - start).count();
+            }
+            
             void SynchronizedOperatorKernel::validateParameterId(const unsigned int id)
             {
                 bool isValid = false;
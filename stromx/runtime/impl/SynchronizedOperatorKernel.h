@@ -17,20 +17,27 @@
 #ifndef STROMX_RUNTIME_IMPL_SYNCHRONIZEDOPERATORKERNEL_H
 #define STROMX_RUNTIME_IMPL_SYNCHRONIZEDOPERATORKERNEL_H
 
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <map>
 #include "stromx/runtime/DataProvider.h"
 #include "stromx/runtime/DataRef.h"
+#include "stromx/runtime/Input.h"
 #include "stromx/runtime/OperatorKernel.h"
+#include "stromx/runtime/OperatorStatistics.h"
 #include "stromx/runtime/Parameter.h"
 #include "stromx/runtime/impl/Id2DataMap.h"
+#include "stromx/runtime/impl/ReplicaPool.h"
 
 namespace stromx
 {
     namespace runtime
     {
         class AbstractFactory;
+        class DataChannel;
         class Operator;
         class OperatorKernel;
         
@@ -65,10 +72,25 @@ namespace stromx
                 DataContainer getOutputData(const unsigned int id);
                 void setInputData(const unsigned int id, DataContainer data);
                 void clearOutputData(unsigned int id);
+                bool hasOutputData(const unsigned int id);
+                bool canSetInputData(const unsigned int id);
+                DataContainer process(const unsigned int inputId, DataContainer data, const unsigned int outputId);
                 const AbstractFactory* factoryPtr() const { return m_factory; }
                 void setFactory(const AbstractFactory* const factory);
                 void setConnectorType(const unsigned int id, const Description::Type type,
                                       const Parameter::UpdateBehavior updateBehavior = Parameter::PERSISTENT);
+                OperatorStatistics statistics();
+                void resetStatistics();
+                bool statisticsEnabled();
+                void setStatisticsEnabled(const bool enabled);
+                unsigned int numReplicas();
+                ReplicaPool::Dispatch dispatch();
+                void setReplication(const unsigned int numReplicas, const ReplicaPool::Dispatch dispatch);
+                Input::OverflowPolicy overflowPolicy(const unsigned int id);
+                void setOverflowPolicy(const unsigned int id, const Input::OverflowPolicy policy);
+                
+                // used by Network
+                bool usesChannel(const unsigned int id);
                 
                 // DataProvider implementation
                 void receiveInputData(const Id2DataMapper& mapper);
@@ -83,10 +105,32 @@ namespace stromx
                 typedef boost::lock_guard<boost::mutex> lock_t;
                 typedef boost::unique_lock<boost::mutex> unique_lock_t;
                 
+                // the threads waiting for a specific change of the data maps
+                struct Waiters
+                {
+                    Waiters() : count(0) {}
+                    
+                    boost::condition_variable cond;
+                    unsigned int count;
+                };
+                
+                typedef std::map<unsigned int, Waiters*> WaiterMap;
+                
                 // internally used members
-                bool tryExecute();
+                bool tryExecute(unique_lock_t & lock);
+                void beginExecution(bool & collectStatistics, boost::chrono::steady_clock::time_point & start);
+                void executeKernel(const bool collectStatistics, const boost::chrono::steady_clock::time_point & start);
+                void endExecution();
                 void waitForSignal(boost::condition_variable& condition, unique_lock_t& lock,
                                    const bool waitWithTimeout, const unsigned int timeout = 0);
+                void waitForData(Waiters & waiters, unique_lock_t& lock,
+                                 const bool waitWithTimeout, const unsigned int timeout = 0);
+                Waiters & waiters(WaiterMap & map, const unsigned int id);
+                void notify(Waiters & waiters);
+                void notifyFreeInputs();
+                void notifyAvailableOutputs();
+                void notifyNextExecution();
+                void notifyAll();
                 void validateParameterId(const unsigned int id);
                 void validateInputId(const unsigned int id);
                 void validateOutputId(const unsigned int id);
@@ -96,16 +140,40 @@ namespace stromx
                 void validateDataAccess();
                 bool isInputParameter(const unsigned int id) const;
                 bool isOutputParameter(const unsigned int id) const;
+                DataChannel* findChannel(const unsigned int id) const;
+                void waitForChannel(const DataChannel & channel, const bool waitForSpace);
+                void notifyChannel();
+                uint64_t elapsedTime(const boost::chrono::steady_clock::time_point & start) const;
+                bool pumpReplicas();
+                void onReplicaFinished();
+                Input::OverflowPolicy findOverflowPolicy(const unsigned int id) const;
                 
                 OperatorKernel* m_op;
                 Status m_status;
                 bool m_parametersAreLocked;
                 boost::condition_variable m_parameterCond;
-                boost::condition_variable m_dataCond;
+                WaiterMap m_inputWaiters;
+                WaiterMap m_outputWaiters;
+                Waiters m_receiveWaiters;
+                Waiters m_sendWaiters;
                 boost::mutex m_mutex;
                 impl::Id2DataMap m_inputMap;
                 impl::Id2DataMap m_outputMap;
                 const AbstractFactory* m_factory;
+                // the channels are only changed while m_hasChannels is false, i.e. they 
+                // are published to other threads when the operator is activated
+                std::map<unsigned int, DataChannel*> m_channels;
+                boost::atomic<bool> m_hasChannels;
+                boost::condition_variable m_channelCond;
+                boost::atomic<unsigned int> m_numChannelWaiters;
+                bool m_statisticsEnabled;
+                OperatorStatistics m_statistics;
+                unsigned int m_numReplicas;
+                ReplicaPool::Dispatch m_dispatch;
+                ReplicaPool* m_replicaPool;
+                std::vector<unsigned int> m_inputIds;
+                std::vector<unsigned int> m_outputIds;
+                std::map<unsigned int, Input::OverflowPolicy> m_overflowPolicies;
             };
         }
     }
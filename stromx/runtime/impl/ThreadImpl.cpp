@@ -18,6 +18,14 @@
 #include <boost/thread/tss.hpp>
 #include <set>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "ThreadImplObserver.h"
 #include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/OperatorInfo.h"
@@ -39,7 +47,12 @@ namespace stromx
                 m_thread(0),
                 m_observer(0),
                 m_delay(0),
-                m_parentThread(thread)
+                m_parentThread(thread),
+                m_affinity(0),
+                m_policy(OTHER),
+                m_priority(0),
+                m_isStarting(false),
+                m_fusionEnabled(false)
             {
             }
             
@@ -93,6 +106,56 @@ namespace stromx
                 m_delay = delay;
             }
 
+            void ThreadImpl::setAffinity(const uint64_t mask)
+            {
+                if(m_status != INACTIVE)
+                    throw WrongState("Thread must be inactive.");
+                
+#ifndef __linux__
+                if(mask)
+                    throw NotImplemented("CPU affinity is not supported on this platform.");
+#endif
+                
+                m_affinity = mask;
+            }
+            
+            void ThreadImpl::setScheduling(const SchedulingPolicy policy, const int priority)
+            {
+                if(m_status != INACTIVE)
+                    throw WrongState("Thread must be inactive.");
+                
+                switch(policy)
+                {
+                case OTHER:
+                    if(priority < -20 || priority > 19)
+                        throw WrongArgument("The nice level must be in the range [-20, 19].");
+                    break;
+                case FIFO:
+                case ROUND_ROBIN:
+                    if(priority < 1 || priority > 99)
+                        throw WrongArgument("The real-time priority must be in the range [1, 99].");
+                    break;
+                default:
+                    throw WrongArgument("Unknown scheduling policy.");
+                }
+                
+#ifndef __linux__
+                if(policy != OTHER || priority != 0)
+                    throw NotImplemented("Thread scheduling settings are not supported on this platform.");
+#endif
+                
+                m_policy = policy;
+                m_priority = priority;
+            }
+
+            void ThreadImpl::setFusionEnabled(const bool enabled)
+            {
+                if(m_status != INACTIVE)
+                    throw WrongState("Thread must be inactive.");
+                
+                m_fusionEnabled = enabled;
+            }
+
             void ThreadImpl::start()
             {
                 if(m_status != INACTIVE)
@@ -100,8 +163,32 @@ namespace stromx
                 
                 BOOST_ASSERT(! m_thread);
                 
+                m_chains = FusedChain::create(m_inputSequence, m_fusionEnabled);
+                
+                m_isStarting = true;
+                m_startError.clear();
+                
                 m_thread = new boost::thread(boost::bind(&ThreadImpl::loop, this));
                 
+                // wait until the new thread applied its settings
+                std::string error;
+                {
+                    unique_lock_t lock(m_mutex);
+                    while(m_isStarting)
+                        m_startCond.wait(lock);
+                    
+                    error = m_startError;
+                }
+                
+                if(! error.empty())
+                {
+                    m_thread->join();
+                    delete m_thread;
+                    m_thread = 0;
+                    
+                    throw WrongState(error);
+                }
+                
                 m_status = ACTIVE;
             }
 
@@ -165,8 +252,67 @@ namespace stromx
                 m_observer = observer;
             }
             
+            bool ThreadImpl::applySettings()
+            {
+#ifdef __linux__
+                if(m_affinity)
+                {
+                    cpu_set_t cpus;
+                    CPU_ZERO(&cpus);
+                    for(unsigned int i = 0; i < 64; ++i)
+                    {
+                        if(m_affinity & (uint64_t(1) << i))
+                            CPU_SET(i, &cpus);
+                    }
+                    
+                    if(pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus))
+                    {
+                        m_startError = "Failed to set the CPU affinity of the thread.";
+                        return false;
+                    }
+                }
+                
+                if(m_policy == OTHER)
+                {
+                    // a nice level of 0 keeps the nice level of the process
+                    if(m_priority && setpriority(PRIO_PROCESS, syscall(SYS_gettid), m_priority))
+                    {
+                        m_startError = "Failed to set the nice level of the thread.";
+                        return false;
+                    }
+                }
+                else
+                {
+                    sched_param param;
+                    param.sched_priority = m_priority;
+                    const int policy = m_policy == FIFO ? SCHED_FIFO : SCHED_RR;
+                    
+                    if(pthread_setschedparam(pthread_self(), policy, &param))
+                    {
+                        m_startError = "Failed to set the scheduling policy of the thread.";
+                        return false;
+                    }
+                }
+#endif
+                
+                return true;
+            }
+            
             void ThreadImpl::loop()
             {
+                // apply the settings before anything is executed and report
+                // the result to start()
+                {
+                    lock_t lock(m_mutex);
+                    
+                    const bool success = applySettings();
+                    m_isStarting = false;
+                    m_startCond.notify_all();
+                    
+                    if(! success)
+                        return;
+                }
+                
                 // return immediately if there are no inputs to process
                 if(m_inputSequence.empty())
                     return;
@@ -177,13 +323,13 @@ namespace stromx
                 {
                     while(true)
                     {                             
-                        for(std::vector<InputNode*>::iterator node = m_inputSequence.begin();
-                                node != m_inputSequence.end();
-                                ++node)
+                        for(std::vector<FusedChain>::iterator chain = m_chains.begin();
+                                chain != m_chains.end();
+                                ++chain)
                         {
                             try
                             {
-                                (*node)->setInputData();
+                                chain->setInputData();
                             }
                             catch(Interrupt &)
                             {
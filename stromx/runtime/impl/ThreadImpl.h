@@ -21,8 +21,10 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <stdint.h>
 #include <string>
 #include <vector>
+#include "stromx/runtime/impl/FusedChain.h"
 
 namespace stromx
 {
@@ -48,6 +50,13 @@ namespace stromx
                     PAUSED
                 };
                 
+                enum SchedulingPolicy
+                {
+                    OTHER,
+                    FIFO,
+                    ROUND_ROBIN
+                };
+                
                 ThreadImpl(Thread* thread = 0);
                 ~ThreadImpl();
                 
@@ -60,6 +69,14 @@ namespace stromx
                 
                 void setDelay(const unsigned int delay);
                 
+                uint64_t affinity() const { return m_affinity; }
+                void setAffinity(const uint64_t mask);
+                SchedulingPolicy schedulingPolicy() const { return m_policy; }
+                int priority() const { return m_priority; }
+                void setScheduling(const SchedulingPolicy policy, const int priority);
+                bool fusionEnabled() const { return m_fusionEnabled; }
+                void setFusionEnabled(const bool enabled);
+                
                 void start();
                 void stop();
                 void join();
@@ -73,15 +90,24 @@ namespace stromx
                 typedef boost::unique_lock<boost::mutex> unique_lock_t;
                 
                 void loop();
+                bool applySettings();
                 
                 Status m_status;
                 boost::thread* m_thread;
                 boost::mutex m_mutex;
                 boost::condition_variable m_pauseCond;
+                boost::condition_variable m_startCond;
                 std::vector<InputNode*> m_inputSequence;
                 const ThreadImplObserver* m_observer;
                 unsigned int m_delay;
                 Thread* m_parentThread;
+                uint64_t m_affinity;
+                SchedulingPolicy m_policy;
+                int m_priority;
+                bool m_isStarting;
+                std::string m_startError;
+                bool m_fusionEnabled;
+                std::vector<FusedChain> m_chains;
             };
         }
     }
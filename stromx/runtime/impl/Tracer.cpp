@@ -0,0 +1,314 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Thread.h"
+#include "stromx/runtime/impl/Tracer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        extern boost::thread_specific_ptr<Thread> gThread;
+    }
+}
+
+namespace
+{
+    typedef boost::lock_guard<boost::mutex> lock_t;
+    
+    const int NO_DETAIL = -1;
+    
+    struct Event
+    {
+        const char* category;
+        const char* name;
+        int detail;
+        uint64_t start;
+        uint64_t duration;
+    };
+    
+    struct Buffer
+    {
+        explicit Buffer(const unsigned int id)
+          : id(id),
+            events(stromx::runtime::impl::Tracer::BUFFER_SIZE),
+            size(0),
+            details(stromx::runtime::impl::Tracer::MAX_DETAILS),
+            numDetails(0),
+            generation(0)
+        {}
+        
+        unsigned int id;
+        std::string threadName;
+        std::vector<Event> events;
+        boost::atomic<unsigned int> size;
+        
+        // the details of the events are interned per buffer and only 
+        // looked up by the owning thread
+        std::vector<std::string> details;
+        boost::atomic<unsigned int> numDetails;
+        std::map<std::string, int> detailIds;
+        
+        // the trace which the events belong to
+        boost::atomic<unsigned int> generation;
+    };
+    
+    boost::mutex gMutex;
+    std::vector<Buffer*> gBuffers;
+    std::vector<Buffer*> gFreeBuffers;
+    boost::atomic<unsigned int> gGeneration(0);
+    boost::chrono::steady_clock::time_point gStartTime;
+    
+    void releaseBuffer(Buffer* buffer)
+    {
+        lock_t lock(gMutex);
+        gFreeBuffers.push_back(buffer);
+    }
+    
+    // the buffers are owned by gBuffers, a thread returns its buffer to
+    // gFreeBuffers when it exits
+    boost::thread_specific_ptr<Buffer> gBuffer(releaseBuffer);
+    
+    void writeString(std::ostream & out, const std::string & str)
+    {
+        out << '"';
+        for(std::string::const_iterator iter = str.begin(); iter != str.end(); ++iter)
+        {
+            switch(*iter)
+            {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if(static_cast<unsigned char>(*iter) >= 0x20)
+                    out << *iter;
+            }
+        }
+        out << '"';
+    }
+    
+    Buffer & threadBuffer()
+    {
+        Buffer* buffer = gBuffer.get();
+        if(buffer)
+            return *buffer;
+        
+        using stromx::runtime::gThread;
+        
+        lock_t lock(gMutex);
+        
+        // a buffer can be reused unless it holds events of the current trace
+        const unsigned int generation = gGeneration.load(boost::memory_order_acquire);
+        for(std::vector<Buffer*>::iterator iter = gFreeBuffers.begin();
+            iter != gFreeBuffers.end();
+            ++iter)
+        {
+            if((*iter)->generation.load(boost::memory_order_relaxed) != generation
+               || (*iter)->size.load(boost::memory_order_relaxed) == 0)
+            {
+                buffer = *iter;
+                gFreeBuffers.erase(iter);
+                break;
+            }
+        }
+        
+        if(! buffer)
+        {
+            buffer = new Buffer(gBuffers.size());
+            gBuffers.push_back(buffer);
+        }
+        
+        buffer->threadName = gThread.get() ? gThread->name() : std::string();
+        gBuffer.reset(buffer);
+        
+        return *buffer;
+    }
+    
+    // called by the owning thread only
+    void resetBuffer(Buffer & buffer, const unsigned int generation)
+    {
+        buffer.size.store(0, boost::memory_order_relaxed);
+        buffer.numDetails.store(0, boost::memory_order_relaxed);
+        buffer.detailIds.clear();
+        buffer.generation.store(generation, boost::memory_order_release);
+    }
+    
+    // called by the owning thread only
+    int internDetail(Buffer & buffer, const std::string & detail)
+    {
+        std::map<std::string, int>::const_iterator iter = buffer.detailIds.find(detail);
+        if(iter != buffer.detailIds.end())
+            return iter->second;
+        
+        const unsigned int index = buffer.numDetails.load(boost::memory_order_relaxed);
+        if(index >= stromx::runtime::impl::Tracer::MAX_DETAILS)
+            return NO_DETAIL;
+        
+        buffer.details[index] = detail;
+        buffer.detailIds[detail] = index;
+        buffer.numDetails.store(index + 1, boost::memory_order_release);
+        
+        return index;
+    }
+    
+    void writeEvents(std::ostream & out)
+    {
+        out << "{\"traceEvents\":[";
+        
+        const unsigned int generation = gGeneration.load(boost::memory_order_acquire);
+        
+        bool isFirst = true;
+        for(std::vector<Buffer*>::const_iterator iter = gBuffers.begin();
+            iter != gBuffers.end();
+            ++iter)
+        {
+            // skip the buffers which have not been used during this trace
+            const Buffer & buffer = **iter;
+            if(buffer.generation.load(boost::memory_order_acquire) != generation)
+                continue;
+            
+            const unsigned int size = buffer.size.load(boost::memory_order_acquire);
+            if(size == 0)
+                continue;
+            
+            if(! isFirst)
+                out << ",";
+            isFirst = false;
+            
+            // name the thread after the stromx thread which uses the buffer
+            out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.id
+                << ",\"args\":{\"name\":";
+            if(buffer.threadName.empty())
+                out << "\"Thread " << buffer.id << "\"";
+            else
+                writeString(out, buffer.threadName);
+            out << "}}";
+            
+            for(unsigned int i = 0; i < size; ++i)
+            {
+                const Event & event = buffer.events[i];
+                out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id
+                    << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+                
+                if(event.detail != NO_DETAIL)
+                {
+                    out << ",\"args\":{\"name\":";
+                    writeString(out, buffer.details[event.detail]);
+                    out << "}";
+                }
+                
+                out << "}";
+            }
+        }
+        
+        out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            const unsigned int Tracer::BUFFER_SIZE;
+            const unsigned int Tracer::MAX_DETAILS;
+            boost::atomic<bool> Tracer::traceIsActive(false);
+            
+            void Tracer::Span::start(const char* const category, const char* const name,
+                                     const std::string* const detail)
+            {
+                m_category = category;
+                m_name = name;
+                m_detail = detail;
+                m_generation = gGeneration.load(boost::memory_order_acquire);
+                m_start = boost::chrono::steady_clock::now();
+            }
+            
+            void Tracer::Span::end()
+            {
+                using namespace boost::chrono;
+                
+                const steady_clock::time_point end = steady_clock::now();
+                
+                // drop spans which began in a previous trace
+                if(! Tracer::isActive() || gGeneration.load(boost::memory_order_acquire) != m_generation)
+                    return;
+                
+                Buffer & buffer = threadBuffer();
+                
+                // the buffer is reset by its owner when it is first used in a trace
+                if(buffer.generation.load(boost::memory_order_relaxed) != m_generation)
+                    resetBuffer(buffer, m_generation);
+                
+                // only the owning thread writes to the buffer, the size is published
+                // to the thread which collects the events when the trace is stopped
+                const unsigned int index = buffer.size.load(boost::memory_order_relaxed);
+                if(index >= BUFFER_SIZE)
+                    return;
+                
+                Event & event = buffer.events[index];
+                event.category = m_category;
+                event.name = m_name;
+                event.detail = m_detail ? internDetail(buffer, *m_detail) : NO_DETAIL;
+                event.start = duration_cast<microseconds>(m_start - gStartTime).count();
+                event.duration = duration_cast<microseconds>(end - m_start).count();
+                
+                buffer.size.store(index + 1, boost::memory_order_release);
+            }
+            
+            void Tracer::start()
+            {
+                lock_t lock(gMutex);
+                
+                if(isActive())
+                    throw WrongState("A trace is already active.");
+                
+                // the buffers of the previous trace are reset by their owners
+                gStartTime = boost::chrono::steady_clock::now();
+                ++gGeneration;
+                traceIsActive.store(true, boost::memory_order_release);
+            }
+            
+            void Tracer::stop(std::ostream & out)
+            {
+                lock_t lock(gMutex);
+                
+                if(! isActive())
+                    throw WrongState("No trace is active.");
+                
+                traceIsActive.store(false, boost::memory_order_release);
+                
+                writeEvents(out);
+            }
+        }
+    }
+}
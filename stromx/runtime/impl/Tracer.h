@@ -0,0 +1,131 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_IMPL_TRACER_H
+#define STROMX_RUNTIME_IMPL_TRACER_H
+
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+#include <iosfwd>
+#include <stdint.h>
+#include <string>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /**
+             * Records spans of the execution of streams in the Chrome trace event 
+             * format which can be loaded in chrome://tracing or Perfetto. 
+             * 
+             * Each thread writes its events to its own buffer without any locking.
+             * The buffers are collected when the trace is stopped. If the buffer of 
+             * a thread is full further events of this thread are dropped. A thread
+             * returns its buffer when it exits and the buffer is reused by the next
+             * new thread. The details of the events are copied to the buffer, i.e.
+             * the trace does not refer to operators which might have been destroyed
+             * before it is stopped. The tracer is shared by all streams of a process,
+             * i.e. there can be at most one active trace at a time.
+             */
+            class Tracer
+            {
+            public:
+                /** The maximal number of events which are recorded per thread. */
+                static const unsigned int BUFFER_SIZE = 1 << 14;
+                
+                /** 
+                 * The maximal number of distinct details which are recorded per thread.
+                 * The details of further events are dropped.
+                 */
+                static const unsigned int MAX_DETAILS = 256;
+                
+                /**
+                 * Measures the time between its construction (or the call to begin())
+                 * and its destruction and records it as an event of the current thread.
+                 * Does nothing if no trace is active.
+                 */
+                class Span
+                {
+                public:
+                    /** Constructs an inactive span. */
+                    Span() : m_name(0) {}
+                    
+                    /** 
+                     * Constructs a span and begins it. The category and the name must be
+                     * string literals. The detail must remain valid until the span ends.
+                     */
+                    Span(const char* const category, const char* const name,
+                         const std::string* const detail = 0)
+                      : m_name(0)
+                    {
+                        begin(category, name, detail);
+                    }
+                    
+                    ~Span()
+                    {
+                        if(m_name)
+                            end();
+                    }
+                    
+                    /** Begins the span if a trace is active. */
+                    void begin(const char* const category, const char* const name,
+                               const std::string* const detail = 0)
+                    {
+                        if(Tracer::isActive())
+                            start(category, name, detail);
+                    }
+                    
+                private:
+                    Span(const Span&);
+                    Span & operator=(const Span&);
+                    
+                    void start(const char* const category, const char* const name,
+                               const std::string* const detail);
+                    void end();
+                    
+                    const char* m_category;
+                    const char* m_name;
+                    const std::string* m_detail;
+                    unsigned int m_generation;
+                    boost::chrono::steady_clock::time_point m_start;
+                };
+                
+                /** Returns true if a trace is being recorded. */
+                static bool isActive() { return traceIsActive.load(boost::memory_order_relaxed); }
+                
+                /**
+                 * Starts a new trace.
+                 * \throws WrongState If a trace is already active.
+                 */
+                static void start();
+                
+                /**
+                 * Stops the current trace and writes it to \c out.
+                 * \throws WrongState If no trace is active.
+                 */
+                static void stop(std::ostream & out);
+                
+            private:
+                static boost::atomic<bool> traceIsActive;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_TRACER_H
@@ -0,0 +1,280 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/impl/WireFormat.h"
+
+#include <cstring>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Image.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/SerializationHeader.h"
+
+namespace
+{
+    using stromx::runtime::DeserializationError;
+    
+    const char MAGIC[] = { 'S', 'T', 'R', 'X' };
+    const char RELEASE_MAGIC[] = { 'S', 'T', 'R', 'R' };
+    
+    void append32(std::vector<char> & data, const uint32_t value)
+    {
+        for(unsigned int i = 0; i < 4; ++i)
+            data.push_back(char((value >> (8 * i)) & 0xff));
+    }
+    
+    void append16(std::vector<char> & data, const uint16_t value)
+    {
+        data.push_back(char(value & 0xff));
+        data.push_back(char((value >> 8) & 0xff));
+    }
+    
+    void appendString(std::vector<char> & data, const std::string & value)
+    {
+        if(value.size() > 0xffff)
+            throw stromx::runtime::WrongArgument("String is too long for the wire format.");
+        
+        append16(data, uint16_t(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+    
+    void write32(char* const data, const uint32_t value)
+    {
+        for(unsigned int i = 0; i < 4; ++i)
+            data[i] = char((value >> (8 * i)) & 0xff);
+    }
+    
+    void write64(char* const data, const uint64_t value)
+    {
+        for(unsigned int i = 0; i < 8; ++i)
+            data[i] = char((value >> (8 * i)) & 0xff);
+    }
+    
+    uint32_t read32(const char* const data)
+    {
+        uint32_t value = 0;
+        for(unsigned int i = 0; i < 4; ++i)
+            value |= uint32_t(uint8_t(data[i])) << (8 * i);
+        return value;
+    }
+    
+    uint64_t read64(const char* const data)
+    {
+        uint64_t value = 0;
+        for(unsigned int i = 0; i < 8; ++i)
+            value |= uint64_t(uint8_t(data[i])) << (8 * i);
+        return value;
+    }
+    
+    // reads values from a header and checks that they are within its bounds
+    class HeaderReader
+    {
+    public:
+        HeaderReader(const char* const data, const std::size_t size)
+          : m_data(data), m_size(size), m_pos(0)
+        {}
+        
+        uint32_t read32()
+        {
+            require(4);
+            const uint32_t value = ::read32(m_data + m_pos);
+            m_pos += 4;
+            return value;
+        }
+        
+        std::string readString()
+        {
+            require(2);
+            const std::size_t length = uint8_t(m_data[m_pos]) | (uint8_t(m_data[m_pos + 1]) << 8);
+            m_pos += 2;
+            
+            require(length);
+            const std::string value(m_data + m_pos, length);
+            m_pos += length;
+            return value;
+        }
+        
+    private:
+        void require(const std::size_t numBytes) const
+        {
+            if(m_pos + numBytes > m_size)
+                throw DeserializationError("", "", "Truncated wire format header.");
+        }
+        
+        const char* m_data;
+        std::size_t m_size;
+        std::size_t m_pos;
+    };
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            const uint32_t WireFormat::VERSION;
+            const unsigned int WireFormat::PREAMBLE_SIZE;
+            const unsigned int WireFormat::HELLO_SIZE;
+            const unsigned int WireFormat::MAGIC_SIZE;
+            
+            bool WireFormat::hasMagic(const char*const data)
+            {
+                return std::memcmp(data, MAGIC, MAGIC_SIZE) == 0;
+            }
+            
+            void WireFormat::writeHello(char*const data, const uint32_t flags)
+            {
+                std::memcpy(data, MAGIC, MAGIC_SIZE);
+                write32(data + MAGIC_SIZE, VERSION);
+                write32(data + MAGIC_SIZE + 4, flags);
+            }
+            
+            uint32_t WireFormat::readHello(const char*const data)
+            {
+                if(! hasMagic(data))
+                    return 0;
+                
+                return read32(data + MAGIC_SIZE);
+            }
+            
+            uint32_t WireFormat::readHelloFlags(const char*const data)
+            {
+                if(! hasMagic(data))
+                    return 0;
+                
+                return read32(data + MAGIC_SIZE + 4);
+            }
+            
+            void WireFormat::writeRelease(char*const data, const uint32_t slot, const uint32_t flags)
+            {
+                std::memcpy(data, RELEASE_MAGIC, MAGIC_SIZE);
+                write32(data + MAGIC_SIZE, slot);
+                write32(data + MAGIC_SIZE + 4, flags);
+            }
+            
+            bool WireFormat::readRelease(const char*const data, uint32_t & slot)
+            {
+                if(std::memcmp(data, RELEASE_MAGIC, MAGIC_SIZE) != 0)
+                    return false;
+                
+                slot = read32(data + MAGIC_SIZE);
+                return true;
+            }
+            
+            uint32_t WireFormat::readReleaseFlags(const char*const data)
+            {
+                if(std::memcmp(data, RELEASE_MAGIC, MAGIC_SIZE) != 0)
+                    return 0;
+                
+                return read32(data + MAGIC_SIZE + 4);
+            }
+            
+            void WireFormat::writePreamble(const Preamble & preamble, char*const data)
+            {
+                std::memcpy(data, MAGIC, MAGIC_SIZE);
+                write32(data + 4, preamble.version);
+                write32(data + 8, preamble.headerSize);
+                write32(data + 12, preamble.textSize);
+                write64(data + 16, preamble.fileSize);
+            }
+            
+            const WireFormat::Preamble WireFormat::readPreamble(const char*const data)
+            {
+                if(! hasMagic(data))
+                    throw DeserializationError("", "", "Invalid wire format preamble.");
+                
+                Preamble preamble;
+                preamble.version = read32(data + 4);
+                preamble.headerSize = read32(data + 8);
+                preamble.textSize = read32(data + 12);
+                preamble.fileSize = read64(data + 16);
+                
+                if(preamble.version > VERSION)
+                    throw DeserializationError("", "", "Unsupported wire format version.");
+                
+                return preamble;
+            }
+            
+            void WireFormat::writeHeader(const SerializationHeader & header, std::vector<char> & data)
+            {
+                data.clear();
+                
+                append32(data, header.serverVersion.major());
+                append32(data, header.serverVersion.minor());
+                append32(data, header.serverVersion.revision());
+                appendString(data, header.package);
+                appendString(data, header.type);
+                append32(data, header.version.major());
+                append32(data, header.version.minor());
+                append32(data, header.version.revision());
+                append32(data, header.payload);
+                
+                if(header.payload == SerializationHeader::SERIALIZED)
+                    return;
+                
+                appendString(data, header.sharedMemory);
+                append32(data, header.slot);
+                append32(data, header.rows);
+                append32(data, header.cols);
+                append32(data, header.elementType);
+            }
+            
+            void WireFormat::readHeader(const char*const data, const std::size_t size, SerializationHeader & header)
+            {
+                HeaderReader reader(data, size);
+                
+                const unsigned int serverMajor = reader.read32();
+                const unsigned int serverMinor = reader.read32();
+                const unsigned int serverRevision = reader.read32();
+                header.serverVersion = Version(serverMajor, serverMinor, serverRevision);
+                header.package = reader.readString();
+                header.type = reader.readString();
+                const unsigned int major = reader.read32();
+                const unsigned int minor = reader.read32();
+                const unsigned int revision = reader.read32();
+                header.version = Version(major, minor, revision);
+                header.payload = reader.read32();
+                
+                if(header.payload == SerializationHeader::SERIALIZED)
+                    return;
+                
+                header.sharedMemory = reader.readString();
+                header.slot = reader.read32();
+                header.rows = reader.read32();
+                header.cols = reader.read32();
+                header.elementType = reader.read32();
+            }
+            
+            void WireFormat::describeMatrix(const Data & data, SerializationHeader & header)
+            {
+                if(data.isVariant(Variant::IMAGE))
+                {
+                    const Image & image = data_cast<Image>(data);
+                    header.rows = image.height();
+                    header.cols = image.width();
+                    header.elementType = image.pixelType();
+                }
+                else
+                {
+                    const Matrix & matrix = data_cast<Matrix>(data);
+                    header.rows = matrix.rows();
+                    header.cols = matrix.cols();
+                    header.elementType = matrix.valueType();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_WIREFORMAT_H
+#define STROMX_RUNTIME_IMPL_WIREFORMAT_H
+
+#include <string>
+#include <vector>
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+        
+        namespace impl
+        {
+            struct SerializationHeader;
+            
+            /** 
+             * Binary framing of data sent from a server to its clients. All integers
+             * are encoded little-endian. A frame starts with a preamble of fixed size
+             * which contains the sizes of the header and the payloads:
+             * 
+             * <tt>"STRX" | version (4) | header size (4) | text size (4) | file size (8)</tt>
+             * 
+             * It is followed by the binary header, the text payload and the file payload.
+             * Clients which understand this format announce it to the server by sending
+             * a hello message <tt>"STRX" | version (4) | flags (4)</tt> after connecting. 
+             * The server sends frames in the previous text format to all other clients.
+             * Clients which run on the host of the server can set the flag SHARED_MEMORY
+             * to receive payloads in shared memory. If such a client can not access the
+             * shared memory it returns the slot of the payload to the server by a release 
+             * message <tt>"STRR" | slot (4) | 0 (4)</tt>.
+             */
+            class WireFormat
+            {
+            public:
+                /** The current version of the binary format. */
+                static const uint32_t VERSION = 1;
+                
+                /** The size of the preamble of a frame. */
+                static const unsigned int PREAMBLE_SIZE = 24;
+                
+                /** The size of the hello and the release message of a client. */
+                static const unsigned int HELLO_SIZE = 12;
+                
+                /** The size of the magic bytes at the start of the preamble and the hello message. */
+                static const unsigned int MAGIC_SIZE = 4;
+                
+                struct Preamble
+                {
+                    Preamble() : version(VERSION), headerSize(0), textSize(0), fileSize(0) {}
+                    
+                    uint32_t version;
+                    uint32_t headerSize;
+                    uint32_t textSize;
+                    uint64_t fileSize;
+                };
+                
+                /** Returns true if \c data starts with the magic bytes of the binary format. */
+                static bool hasMagic(const char* const data);
+                
+                /** The flags of the hello message. */
+                enum HelloFlag
+                {
+                    /** The client can read payloads from the shared memory of the server. */
+                    SHARED_MEMORY = 1
+                };
+                
+                static void writeHello(char* const data, const uint32_t flags = 0);
+                
+                /** Returns the version in the hello message or 0 if \c data is not a hello message. */
+                static uint32_t readHello(const char* const data);
+                
+                /** Returns the flags in the hello message or 0 if \c data is not a hello message. */
+                static uint32_t readHelloFlags(const char* const data);
+                
+                /** The flags of the release message. */
+                enum ReleaseFlag
+                {
+                    /** 
+                     * The client read the slot and continues to read from shared memory.
+                     * Without this flag the client could not open the shared memory and
+                     * receives the following payloads over the socket.
+                     */
+                    SLOT_READ = 1
+                };
+                
+                static void writeRelease(char* const data, const uint32_t slot, const uint32_t flags = 0);
+                
+                /** 
+                 * Returns true and sets \c slot to the slot in the release message if 
+                 * \c data is a release message.
+                 */
+                static bool readRelease(const char* const data, uint32_t & slot);
+                
+                /** Returns the flags in the release message or 0 if \c data is not a release message. */
+                static uint32_t readReleaseFlags(const char* const data);
+                
+                static void writePreamble(const Preamble & preamble, char* const data);
+                
+                /** \throws DeserializationError If \c data is not a valid preamble. */
+                static const Preamble readPreamble(const char* const data);
+                
+                /** Replaces the content of \c data by the binary representation of \c header. */
+                static void writeHeader(const SerializationHeader & header, std::vector<char> & data);
+                
+                /** \throws DeserializationError If \c data is not a valid header. */
+                static void readHeader(const char* const data, const std::size_t size, SerializationHeader & header);
+                
+                /** 
+                 * Sets the rows, columns and element type of \c header to the 
+                 * dimensions of the image or matrix \c data. 
+                 */
+                static void describeMatrix(const Data & data, SerializationHeader & header);
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_WIREFORMAT_H
@@ -0,0 +1,484 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread/tss.hpp>
+
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Operator.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/impl/InputNode.h"
+#include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/impl/ThreadImplObserver.h"
+#include "stromx/runtime/impl/WorkerPool.h"
+
+namespace
+{
+    void do_release(stromx::runtime::impl::WorkerPool*) {}
+    
+    boost::thread_specific_ptr<stromx::runtime::impl::WorkerPool> gWorkerPool(do_release);
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        extern boost::thread_specific_ptr<Thread> gThread;
+        
+        namespace impl
+        {
+            WorkerPool::BlockingScope::BlockingScope(const bool isBlocking)
+              : m_pool(isBlocking ? gWorkerPool.release() : 0)
+            {
+                // the pool pointer is removed from the thread while the scope
+                // is alive which turns nested scopes into no-ops
+                if(m_pool)
+                    m_pool->enterBlocking();
+            }
+            
+            WorkerPool::BlockingScope::~BlockingScope()
+            {
+                if(m_pool)
+                {
+                    m_pool->leaveBlocking();
+                    gWorkerPool.reset(m_pool);
+                }
+            }
+            
+            WorkerPool::WorkerPool(const unsigned int size)
+              : m_status(INACTIVE),
+                m_size(size),
+                m_numTasks(0),
+                m_numRunning(0),
+                m_numIdle(0),
+                m_numEvents(0),
+                m_observer(this)
+            {
+                if(m_size == 0)
+                    m_size = boost::thread::hardware_concurrency();
+                
+                if(m_size == 0)
+                    m_size = 1;
+                
+                for(unsigned int i = 0; i < m_size; ++i)
+                    m_queues.push_back(new Queue);
+            }
+            
+            WorkerPool::~WorkerPool()
+            {
+                stop();
+                join();
+                
+                for(std::vector<Queue*>::iterator iter = m_queues.begin();
+                    iter != m_queues.end();
+                    ++iter)
+                {
+                    delete *iter;
+                }
+                
+                for(std::vector<const ThreadImplObserver*>::iterator iter = m_observers.begin();
+                    iter != m_observers.end();
+                    ++iter)
+                {
+                    delete *iter;
+                }
+            }
+            
+            void WorkerPool::addThread(Thread* const thread, const std::vector<InputNode*> & nodes,
+                                       const ThreadImplObserver* const observer)
+            {
+                if(m_status != INACTIVE)
+                    throw WrongState("Worker pool must be inactive.");
+                
+                if(observer)
+                    m_observers.push_back(observer);
+                
+                // distribute the tasks evenly among the workers
+                for(std::vector<InputNode*>::const_iterator iter = nodes.begin();
+                    iter != nodes.end();
+                    ++iter)
+                {
+                    if(! *iter)
+                        throw WrongArgument("Passed null as input node.");
+                    
+                    Queue & queue = *m_queues[m_numTasks % m_queues.size()];
+                    queue.tasks.push_back(Task(*iter, thread, observer));
+                    ++m_numTasks;
+                }
+            }
+            
+            void WorkerPool::setDelay(const Thread* const thread, const unsigned int delay)
+            {
+                lock_t lock(m_mutex);
+                m_delays[thread] = delay;
+            }
+            
+            void WorkerPool::start()
+            {
+                if(m_status != INACTIVE)
+                    throw WrongState("Worker pool must be inactive.");
+                
+                // the operators are observed before the pool lock is acquired because
+                // the observer is called while the operators are locked
+                observeOperators();
+                
+                lock_t lock(m_mutex);
+                
+                m_status = ACTIVE;
+                
+                // there is no use in more workers than tasks
+                const unsigned int numWorkers = std::min(m_size, m_numTasks);
+                for(unsigned int i = 0; i < numWorkers; ++i)
+                    spawnWorker();
+            }
+            
+            void WorkerPool::stop()
+            {
+                lock_t lock(m_mutex);
+                
+                if(m_status == INACTIVE || m_status == DEACTIVATING)
+                    return;
+                
+                // interrupt the workers while holding the lock to make sure
+                // no new worker is spawned afterwards
+                for(std::vector<boost::thread*>::iterator iter = m_workers.begin();
+                    iter != m_workers.end();
+                    ++iter)
+                {
+                    (*iter)->interrupt();
+                }
+                
+                m_status = DEACTIVATING;
+            }
+            
+            void WorkerPool::join()
+            {
+                if(m_status == INACTIVE)
+                    return;
+                
+                if(m_status != DEACTIVATING)
+                    throw WrongState("Worker pool must have been stopped.");
+                
+                // no workers are added after stop() has been called
+                for(std::vector<boost::thread*>::iterator iter = m_workers.begin();
+                    iter != m_workers.end();
+                    ++iter)
+                {
+                    (*iter)->join();
+                    delete *iter;
+                }
+                
+                m_workers.clear();
+                m_numRunning = 0;
+                m_numIdle = 0;
+                
+                unobserveOperators();
+                
+                m_status = INACTIVE;
+            }
+            
+            void WorkerPool::pause()
+            {
+                lock_t lock(m_mutex);
+                
+                if(m_status != ACTIVE)
+                    throw WrongState("Worker pool must be active.");
+                
+                m_status = PAUSED;
+            }
+            
+            void WorkerPool::resume()
+            {
+                lock_t lock(m_mutex);
+                
+                if(m_status != PAUSED)
+                    throw WrongState("Worker pool must have been paused.");
+                
+                m_status = ACTIVE;
+                
+                m_cond.notify_all();
+            }
+            
+            void WorkerPool::loop(const unsigned int index)
+            {
+                gWorkerPool.reset(this);
+                
+                try
+                {
+                    while(true)
+                    {
+                        const unsigned int numEvents = acquireSlot();
+                        
+                        Task task;
+                        const bool found = findTask(index, task);
+                        
+                        if(found)
+                            runTask(index, task);
+                        
+                        releaseSlot(found);
+                        
+                        // sleep unless something changed while the queues were searched
+                        if(! found)
+                        {
+                            unique_lock_t lock(m_mutex);
+                            if(m_numEvents == numEvents)
+                                wait(lock);
+                        }
+                    }
+                }
+                catch(Interrupt&)
+                {
+                }
+            }
+            
+            unsigned int WorkerPool::acquireSlot()
+            {
+                unique_lock_t lock(m_mutex);
+                
+                while(m_status == PAUSED || m_numRunning >= m_size)
+                    wait(lock);
+                
+                ++m_numRunning;
+                
+                return m_numEvents;
+            }
+            
+            void WorkerPool::releaseSlot(const bool hasRunTask)
+            {
+                lock_t lock(m_mutex);
+                
+                --m_numRunning;
+                
+                // the state of the operators changed if a task was executed
+                // which might allow idle workers to proceed
+                if(hasRunTask)
+                    ++m_numEvents;
+                
+                if(m_numIdle)
+                    m_cond.notify_all();
+            }
+            
+            void WorkerPool::signalEvent()
+            {
+                lock_t lock(m_mutex);
+                
+                ++m_numEvents;
+                
+                if(m_numIdle)
+                    m_cond.notify_all();
+            }
+            
+            void WorkerPool::DataObserver::observe(const Connector &, const DataContainer &, 
+                                                   const DataContainer &, const Thread* const) const
+            {
+                m_pool->signalEvent();
+            }
+            
+            void WorkerPool::observeOperators()
+            {
+                for(std::vector<Queue*>::iterator queue = m_queues.begin();
+                    queue != m_queues.end();
+                    ++queue)
+                {
+                    for(std::deque<Task>::iterator task = (*queue)->tasks.begin();
+                        task != (*queue)->tasks.end();
+                        ++task)
+                    {
+                        m_observedOperators.insert(task->node->op());
+                        if(task->node->isConnected())
+                            m_observedOperators.insert(task->node->source().op());
+                    }
+                }
+                
+                for(std::set<Operator*>::iterator iter = m_observedOperators.begin();
+                    iter != m_observedOperators.end();
+                    ++iter)
+                {
+                    (*iter)->addObserver(&m_observer);
+                }
+            }
+            
+            void WorkerPool::unobserveOperators()
+            {
+                for(std::set<Operator*>::iterator iter = m_observedOperators.begin();
+                    iter != m_observedOperators.end();
+                    ++iter)
+                {
+                    (*iter)->removeObserver(&m_observer);
+                }
+                
+                m_observedOperators.clear();
+            }
+            
+            bool WorkerPool::findTask(const unsigned int index, Task & task)
+            {
+                const unsigned int numQueues = m_queues.size();
+                
+                // first look for tasks which can be executed without waiting for
+                // another operator, then fall back to tasks which cause an operator
+                // to execute if there are any
+                bool hasPending = true;
+                for(unsigned int pass = 0; pass < 2 && hasPending; ++pass)
+                {
+                    const bool onlyReady = (pass == 0);
+                    hasPending = false;
+                    
+                    if(takeTask(*m_queues[index % numQueues], onlyReady, true, task, hasPending))
+                        return true;
+                    
+                    for(unsigned int i = 1; i < numQueues; ++i)
+                    {
+                        if(takeTask(*m_queues[(index + i) % numQueues], onlyReady, false, task, hasPending))
+                            return true;
+                    }
+                }
+                
+                return false;
+            }
+            
+            bool WorkerPool::takeTask(Queue & queue, const bool onlyReady, const bool fromBack, 
+                                      Task & task, bool & hasPending)
+            {
+                lock_t lock(queue.mutex);
+                
+                const unsigned int numTasks = queue.tasks.size();
+                for(unsigned int i = 0; i < numTasks; ++i)
+                {
+                    // the owner of the queue takes tasks from the back, other
+                    // workers steal from the front
+                    std::deque<Task>::iterator iter = fromBack ? queue.tasks.end() - 1 - i
+                                                               : queue.tasks.begin() + i;
+                    
+                    const InputNode::Readiness readiness = iter->node->readiness();
+                    if(readiness == InputNode::READY
+                       || (! onlyReady && readiness == InputNode::PENDING))
+                    {
+                        task = *iter;
+                        queue.tasks.erase(iter);
+                        return true;
+                    }
+                    
+                    if(readiness == InputNode::PENDING)
+                        hasPending = true;
+                }
+                
+                return false;
+            }
+            
+            void WorkerPool::runTask(const unsigned int index, const Task & task)
+            {
+                gThread.reset(task.thread);
+                
+                try
+                {
+                    task.node->setInputData();
+                }
+                catch(Interrupt &)
+                {
+                    // keep the task for the next start of the pool
+                    Queue & queue = *m_queues[index % m_queues.size()];
+                    lock_t lock(queue.mutex);
+                    queue.tasks.push_front(task);
+                    throw;
+                }
+                catch(OperatorError & ex)
+                {
+                    // send all operator errors to the observer-mechanism
+                    // but do not stop the worker
+                    if(task.observer)
+                        task.observer->observe(ex);
+                }
+                
+                // the task moves to the queue of the worker which executed it
+                {
+                    Queue & queue = *m_queues[index % m_queues.size()];
+                    lock_t lock(queue.mutex);
+                    queue.tasks.push_front(task);
+                }
+                
+                unsigned int delay = 0;
+                {
+                    lock_t lock(m_mutex);
+                    std::map<const Thread*, unsigned int>::const_iterator iter = m_delays.find(task.thread);
+                    if(iter != m_delays.end())
+                        delay = iter->second;
+                }
+                
+                try
+                {
+                    if(delay)
+                        boost::this_thread::sleep_for(boost::chrono::milliseconds(delay));
+                    else
+                        boost::this_thread::interruption_point();
+                }
+                catch(boost::thread_interrupted &)
+                {
+                    throw Interrupt();
+                }
+            }
+            
+            void WorkerPool::enterBlocking()
+            {
+                lock_t lock(m_mutex);
+                
+                --m_numRunning;
+                
+                if(m_status != ACTIVE)
+                    return;
+                
+                // hand the slot of the blocked worker to an idle worker or create
+                // a new one if all workers are busy
+                if(m_numIdle)
+                    m_cond.notify_all();
+                else if(m_workers.size() < m_size + m_numTasks)
+                    spawnWorker();
+            }
+            
+            void WorkerPool::leaveBlocking()
+            {
+                lock_t lock(m_mutex);
+                
+                // a worker which returns from blocking keeps running even if
+                // this exceeds the size of the pool for a short time
+                ++m_numRunning;
+            }
+            
+            void WorkerPool::spawnWorker()
+            {
+                const unsigned int index = m_workers.size();
+                m_workers.push_back(new boost::thread(boost::bind(&WorkerPool::loop, this, index)));
+            }
+            
+            void WorkerPool::wait(unique_lock_t & lock)
+            {
+                ++m_numIdle;
+                
+                try
+                {
+                    m_cond.wait(lock);
+                }
+                catch(boost::thread_interrupted &)
+                {
+                    --m_numIdle;
+                    throw Interrupt();
+                }
+                
+                --m_numIdle;
+            }
+        }
+    }
+}
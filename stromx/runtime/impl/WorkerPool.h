@@ -0,0 +1,181 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_IMPL_WORKERPOOL_H
+#define STROMX_RUNTIME_IMPL_WORKERPOOL_H
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+#include "stromx/runtime/ConnectorObserver.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Operator;
+        class Thread;
+        
+        namespace impl
+        {
+            class InputNode;
+            class ThreadImplObserver;
+            
+            /**
+             * Executes the input sequences of several threads on a fixed number of
+             * workers. Each input node is a task which is queued at one of the workers.
+             * A worker runs the ready tasks of its own queue and steals ready tasks
+             * from the queues of the other workers if its own queue runs dry.
+             *
+             * If a worker blocks inside an operator (see BlockingScope) it releases its
+             * slot and the pool wakes or spawns a spare worker. Thus at most size()
+             * workers are running tasks at a time and the pool never deadlocks if all
+             * slots are occupied by blocked workers.
+             *
+             * Idle workers do not poll. They sleep until the data of one of the 
+             * operators of the tasks changes or another worker finished a task.
+             */
+            class WorkerPool
+            {
+            public:
+                enum Status
+                {
+                    INACTIVE,
+                    ACTIVE,
+                    DEACTIVATING,
+                    PAUSED
+                };
+                
+                /**
+                 * Marks the current thread as blocked for the lifetime of the scope
+                 * if it is a worker of a pool and \c isBlocking is true. Does nothing 
+                 * for other threads.
+                 */
+                class BlockingScope
+                {
+                public:
+                    explicit BlockingScope(const bool isBlocking = true);
+                    ~BlockingScope();
+                
+                private:
+                    BlockingScope(const BlockingScope&);
+                    BlockingScope & operator=(const BlockingScope&);
+                    
+                    WorkerPool* m_pool;
+                };
+                
+                /**
+                 * Constructs a pool with \c size workers. If \c size is 0 the
+                 * number of hardware threads is used.
+                 */
+                explicit WorkerPool(const unsigned int size = 0);
+                ~WorkerPool();
+                
+                Status status() const { return m_status; }
+                unsigned int size() const { return m_size; }
+                
+                /**
+                 * Adds the input nodes of \c thread as tasks. The pool takes ownership
+                 * of \c observer which receives the operator errors of these tasks.
+                 */
+                void addThread(Thread* const thread, const std::vector<InputNode*> & nodes,
+                               const ThreadImplObserver* const observer);
+                
+                /** 
+                 * Sets the delay in milliseconds after each task of \c thread.
+                 * The delay of threads without tasks in the pool is ignored.
+                 */
+                void setDelay(const Thread* const thread, const unsigned int delay);
+                
+                void start();
+                void stop();
+                void join();
+                void pause();
+                void resume();
+            
+            private:
+                typedef boost::lock_guard<boost::mutex> lock_t;
+                typedef boost::unique_lock<boost::mutex> unique_lock_t;
+                
+                struct Task
+                {
+                    Task(InputNode* node = 0, Thread* thread = 0, const ThreadImplObserver* observer = 0)
+                      : node(node), thread(thread), observer(observer)
+                    {}
+                    
+                    InputNode* node;
+                    Thread* thread;
+                    const ThreadImplObserver* observer;
+                };
+                
+                struct Queue
+                {
+                    boost::mutex mutex;
+                    std::deque<Task> tasks;
+                };
+                
+                class DataObserver : public ConnectorObserver
+                {
+                public:
+                    explicit DataObserver(WorkerPool* const pool) : m_pool(pool) {}
+                    
+                    virtual void observe(const Connector & connector, const DataContainer & oldData, 
+                                         const DataContainer & newData, const Thread* const thread) const;
+                    
+                private:
+                    WorkerPool* m_pool;
+                };
+                
+                void loop(const unsigned int index);
+                unsigned int acquireSlot();
+                void releaseSlot(const bool hasRunTask);
+                void signalEvent();
+                void observeOperators();
+                void unobserveOperators();
+                bool findTask(const unsigned int index, Task & task);
+                bool takeTask(Queue & queue, const bool onlyReady, const bool fromBack, 
+                              Task & task, bool & hasPending);
+                void runTask(const unsigned int index, const Task & task);
+                void enterBlocking();
+                void leaveBlocking();
+                void spawnWorker();
+                void wait(unique_lock_t & lock);
+                
+                Status m_status;
+                unsigned int m_size;
+                unsigned int m_numTasks;
+                unsigned int m_numRunning;
+                unsigned int m_numIdle;
+                unsigned int m_numEvents;
+                std::map<const Thread*, unsigned int> m_delays;
+                DataObserver m_observer;
+                std::set<Operator*> m_observedOperators;
+                boost::mutex m_mutex;
+                boost::condition_variable m_cond;
+                std::vector<boost::thread*> m_workers;
+                std::vector<Queue*> m_queues;
+                std::vector<const ThreadImplObserver*> m_observers;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_WORKERPOOL_H
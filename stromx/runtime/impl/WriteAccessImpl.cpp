@@ -16,6 +16,7 @@
 
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/Exception.h"
+#include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/impl/DataContainerImpl.h"
 #include "stromx/runtime/impl/WriteAccessImpl.h"
 
@@ -23,6 +24,24 @@ namespace stromx
 {
     namespace runtime
     {   
+        namespace
+        {
+            DataContainer copyData(const DataContainer & data, const bool waitWithTimeout, const unsigned int timeout)
+            {
+                Data* copy = 0;
+                {
+                    ReadAccess access = waitWithTimeout ? ReadAccess(data, timeout) : ReadAccess(data);
+                    copy = access.get().clone();
+                }
+                
+                DataContainer container(copy);
+                container.setCopyOnWrite(true);
+                container.setMetadata(data.metadata());
+                
+                return container;
+            }
+        }
+        
         namespace impl
         {
             WriteAccessImpl::WriteAccessImpl(const DataContainer& data, const bool waitWithTimeout, const unsigned int timeout)
@@ -34,6 +53,27 @@ namespace stromx
                 m_data.m_impl->getWriteAccess(waitWithTimeout, timeout);
             }
 
+            WriteAccessImpl::WriteAccessImpl(DataContainer& data, const bool waitWithTimeout, const unsigned int timeout)
+              : m_data(data)
+            {
+                if(data.empty())
+                    throw WrongArgument("Data container is empty.");
+                
+                // the data is shared by data and m_data, any further owner (including 
+                // read and write accesses) keeps the original and the writer continues
+                // with a copy
+                if(m_data.m_impl->isCopyOnWrite() && m_data.m_impl.use_count() > 2)
+                {
+                    if(m_data.m_impl->isReadOnly())
+                        throw WrongArgument("Failed to obtain write access for read-only data container.");
+                    
+                    m_data = copyData(data, waitWithTimeout, timeout);
+                    data = m_data;
+                }
+                
+                m_data.m_impl->getWriteAccess(waitWithTimeout, timeout);
+            }
+
             Data& WriteAccessImpl::get() const
             {
                 return *m_data.m_impl->data();
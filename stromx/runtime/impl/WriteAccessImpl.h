@@ -32,6 +32,10 @@ namespace stromx
             {
         public:
                 WriteAccessImpl(const DataContainer & data, const bool waitWithTimeout, const unsigned int timeout = 0);
+                
+                // replaces data by a copy if it is in copy-on-write mode and
+                // another container (e.g. an ID-data pair) refers to the same data
+                WriteAccessImpl(DataContainer & data, const bool waitWithTimeout, const unsigned int timeout = 0);
                 ~WriteAccessImpl();
                 
                 Data& get() const;
@@ -24,6 +24,7 @@
 #include <xercesc/util/XMLString.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include "stromx/runtime/Data.h"
 #include "stromx/runtime/DirectoryFileInput.h"
 #include "stromx/runtime/Exception.h"
@@ -91,6 +92,23 @@ namespace stromx
           </xs:restriction> \
         </xs:simpleType> \
       </xs:attribute> \
+      <xs:attribute name=\"affinity\"> \
+        <xs:simpleType> \
+          <xs:restriction base=\"xs:string\"> \
+           <xs:pattern value=\"0x[0-9a-f]{1,16}\"/> \
+          </xs:restriction> \
+        </xs:simpleType> \
+      </xs:attribute> \
+      <xs:attribute name=\"policy\"> \
+        <xs:simpleType> \
+          <xs:restriction base=\"xs:string\"> \
+            <xs:enumeration value=\"other\"/> \
+            <xs:enumeration value=\"fifo\"/> \
+            <xs:enumeration value=\"rr\"/> \
+          </xs:restriction> \
+        </xs:simpleType> \
+      </xs:attribute> \
+      <xs:attribute name=\"priority\" type=\"xs:integer\"/> \
     </xs:complexType> \
   </xs:element> \
   <xs:element name=\"Operator\"> \
@@ -113,6 +131,15 @@ namespace stromx
       <xs:attribute name=\"isInitialized\" type=\"xs:boolean\"/> \
       <xs:attribute name=\"x\" type=\"xs:decimal\"/> \
       <xs:attribute name=\"y\" type=\"xs:decimal\"/> \
+      <xs:attribute name=\"replicas\" type=\"xs:positiveInteger\"/> \
+      <xs:attribute name=\"dispatch\"> \
+        <xs:simpleType> \
+          <xs:restriction base=\"xs:string\"> \
+            <xs:enumeration value=\"round-robin\"/> \
+            <xs:enumeration value=\"least-loaded\"/> \
+          </xs:restriction> \
+        </xs:simpleType> \
+      </xs:attribute> \
     </xs:complexType> \
   </xs:element> \
   <xs:element name=\"Parameter\"> \
@@ -154,6 +181,15 @@ namespace stromx
       <xs:attribute name=\"operator\" use=\"required\" type=\"xs:NMTOKEN\"/> \
       <xs:attribute name=\"output\" use=\"required\" type=\"xs:NMTOKEN\"/> \
       <xs:attribute name=\"outputTitle\"/> \
+      <xs:attribute name=\"overflow\"> \
+        <xs:simpleType> \
+          <xs:restriction base=\"xs:string\"> \
+            <xs:enumeration value=\"block\"/> \
+            <xs:enumeration value=\"drop-newest\"/> \
+            <xs:enumeration value=\"drop-oldest\"/> \
+          </xs:restriction> \
+        </xs:simpleType> \
+      </xs:attribute> \
     </xs:complexType> \
   </xs:element> \
   <xs:element name=\"InputConnector\"> \
@@ -546,6 +582,8 @@ namespace stromx
                 Xml2Str isInitialized(opElement->getAttribute(Str2Xml("isInitialized")));
                 Xml2Str x(opElement->getAttribute(Str2Xml("x")));
                 Xml2Str y(opElement->getAttribute(Str2Xml("y")));
+                Xml2Str replicas(opElement->getAttribute(Str2Xml("replicas")));
+                Xml2Str dispatch(opElement->getAttribute(Str2Xml("dispatch")));
                 
                 unsigned int id = boost::lexical_cast<unsigned int>((const char*)(idStr));
                 
@@ -567,6 +605,21 @@ namespace stromx
                                   boost::lexical_cast<float>(yStr));
                 op->setPosition(position);
                 
+                std::string replicasStr(replicas);
+                std::string dispatchStr(dispatch);
+                if (replicasStr != "" || dispatchStr != "")
+                {
+                    unsigned int numReplicas = 1;
+                    if (replicasStr != "")
+                        numReplicas = boost::lexical_cast<unsigned int>(replicasStr);
+                    
+                    Operator::Dispatch dispatchType = Operator::ROUND_ROBIN;
+                    if (dispatchStr == "least-loaded")
+                        dispatchType = Operator::LEAST_LOADED;
+                    
+                    op->setReplication(numReplicas, dispatchType);
+                }
+                
                 m_id2OperatorMap[id] = op;
                 m_id2DataMap.clear();
                 m_id2BehaviorMap.clear();
@@ -763,6 +816,32 @@ namespace stromx
                     thread->setColor(color);
                 }
                 
+                std::string affinityStr(Xml2Str(threadElement->getAttribute(Str2Xml("affinity"))));
+                if (affinityStr != "")
+                {
+                    uint64_t affinity = 0;
+                    std::istringstream in(affinityStr);
+                    in >> std::hex >> affinity;
+                    thread->setAffinity(affinity);
+                }
+                
+                std::string policyStr(Xml2Str(threadElement->getAttribute(Str2Xml("policy"))));
+                std::string priorityStr(Xml2Str(threadElement->getAttribute(Str2Xml("priority"))));
+                if (policyStr != "" || priorityStr != "")
+                {
+                    Thread::SchedulingPolicy policy = Thread::OTHER;
+                    if (policyStr == "fifo")
+                        policy = Thread::FIFO;
+                    else if (policyStr == "rr")
+                        policy = Thread::ROUND_ROBIN;
+                    
+                    int priority = 0;
+                    if (priorityStr != "")
+                        priority = boost::lexical_cast<int>(priorityStr);
+                    
+                    thread->setScheduling(policy, priority);
+                }
+                
                 DOMNodeList* inputs = threadElement->getElementsByTagName(Str2Xml("InputConnector"));
                 XMLSize_t numInputs = inputs->getLength();
                 
@@ -797,6 +876,7 @@ namespace stromx
                 Xml2Str opIdStr(inputElement->getAttribute(Str2Xml("operator")));
                 Xml2Str inputIdStr(inputElement->getAttribute(Str2Xml("id")));
                 Xml2Str outputIdStr(inputElement->getAttribute(Str2Xml("output")));
+                Xml2Str overflow(inputElement->getAttribute(Str2Xml("overflow")));
                 
                 unsigned int opId = boost::lexical_cast<unsigned int>(std::string(opIdStr));
                 unsigned int inputId = boost::lexical_cast<unsigned int>(std::string(inputIdStr));
@@ -810,6 +890,14 @@ namespace stromx
                 Operator* source = idOpPair->second;
                 
                 m_stream->connect(source, outputId, op, inputId);
+                
+                std::string overflowStr(overflow);
+                if (overflowStr == "block")
+                    op->setOverflowPolicy(inputId, Input::BLOCK);
+                else if (overflowStr == "drop-newest")
+                    op->setOverflowPolicy(inputId, Input::DROP_NEWEST);
+                else if (overflowStr == "drop-oldest")
+                    op->setOverflowPolicy(inputId, Input::DROP_OLDEST);
             }
         }
     }
@@ -17,6 +17,7 @@
 #include <boost/lexical_cast.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <xercesc/framework/MemBufFormatTarget.hpp>
 #include "stromx/runtime/Config.h"
 #include "stromx/runtime/Data.h"
@@ -178,6 +179,39 @@ namespace stromx
                     colorAttr->setValue(Str2Xml(colorStr.c_str()));
                     thrElement->setAttributeNode(colorAttr);
                     
+                    //Create attribute affinity of Thread if the thread is restricted to some CPUs
+                    if((*iter_thr)->affinity())
+                    {
+                        DOMAttr* affinityAttr = m_doc->createAttribute(Str2Xml("affinity"));
+                        std::ostringstream affinityStr;
+                        affinityStr << "0x" << std::hex << (*iter_thr)->affinity();
+                        affinityAttr->setValue(Str2Xml(affinityStr.str().c_str()));
+                        thrElement->setAttributeNode(affinityAttr);
+                    }
+                    
+                    //Create attributes policy and priority of Thread if they differ from the defaults
+                    if((*iter_thr)->schedulingPolicy() != Thread::OTHER || (*iter_thr)->priority() != 0)
+                    {
+                        DOMAttr* policyAttr = m_doc->createAttribute(Str2Xml("policy"));
+                        switch((*iter_thr)->schedulingPolicy())
+                        {
+                        case Thread::FIFO:
+                            policyAttr->setValue(Str2Xml("fifo"));
+                            break;
+                        case Thread::ROUND_ROBIN:
+                            policyAttr->setValue(Str2Xml("rr"));
+                            break;
+                        default:
+                            policyAttr->setValue(Str2Xml("other"));
+                        }
+                        thrElement->setAttributeNode(policyAttr);
+                        
+                        DOMAttr* priorityAttr = m_doc->createAttribute(Str2Xml("priority"));
+                        std::string priorityStr = boost::lexical_cast<std::string>((*iter_thr)->priority());
+                        priorityAttr->setValue(Str2Xml(priorityStr.c_str()));
+                        thrElement->setAttributeNode(priorityAttr);
+                    }
+                    
                     //Create InputNodes of Thread (multiple entries for each Thread possible)
                     createInputConnectors((*iter_thr), thrElement);
                 }
@@ -347,6 +381,25 @@ namespace stromx
                         const Output& outputDesc = node.op()->info().output(node.id());
                         outputTitleAttr->setValue(Str2Xml(outputDesc.title().c_str()));
                         inElement->setAttributeNode(outputTitleAttr);
+                        
+                        //Write the overflow policy if it differs from the default of the input
+                        const Input::OverflowPolicy policy = currOp->overflowPolicy((*iter_in)->id());
+                        if (policy != inputDesc.overflowPolicy())
+                        {
+                            DOMAttr* overflowAttr = m_doc->createAttribute(Str2Xml("overflow"));
+                            switch (policy)
+                            {
+                            case Input::DROP_NEWEST:
+                                overflowAttr->setValue(Str2Xml("drop-newest"));
+                                break;
+                            case Input::DROP_OLDEST:
+                                overflowAttr->setValue(Str2Xml("drop-oldest"));
+                                break;
+                            default:
+                                overflowAttr->setValue(Str2Xml("block"));
+                            }
+                            inElement->setAttributeNode(overflowAttr);
+                        }
                     }
                 }
             }
@@ -403,6 +456,18 @@ namespace stromx
                     yAttr->setValue(Str2Xml(boost::lexical_cast<std::string>(op->position().y()).c_str()));
                     opElement->setAttributeNode(yAttr);
                     
+                    //Create attributes replicas and dispatch of current operator op if it is replicated
+                    if (op->numReplicas() > 1)
+                    {
+                        DOMAttr* replicasAttr = m_doc->createAttribute(Str2Xml("replicas"));
+                        replicasAttr->setValue(Str2Xml(boost::lexical_cast<std::string>(op->numReplicas()).c_str()));
+                        opElement->setAttributeNode(replicasAttr);
+                        
+                        DOMAttr* dispatchAttr = m_doc->createAttribute(Str2Xml("dispatch"));
+                        dispatchAttr->setValue(Str2Xml(op->dispatch() == Operator::LEAST_LOADED ? "least-loaded" : "round-robin"));
+                        opElement->setAttributeNode(dispatchAttr);
+                    }
+                    
                     createParameters(op, opElement);
                     
                     if (m_stream != 0 && op->status() != Operator::NONE)
@@ -0,0 +1,148 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/impl/ZipIndex.h"
+
+#ifdef __GNUG__
+    #include <tr1/cstdint>
+#else
+    #include <cstdint>
+#endif
+
+namespace
+{
+    const uint32_t END_OF_DIRECTORY_SIGNATURE = 0x06054b50;
+    const uint32_t DIRECTORY_ENTRY_SIGNATURE = 0x02014b50;
+    const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    
+    const std::size_t END_OF_DIRECTORY_SIZE = 22;
+    const std::size_t DIRECTORY_ENTRY_SIZE = 46;
+    const std::size_t LOCAL_HEADER_SIZE = 30;
+    const std::size_t MAX_COMMENT_SIZE = 0xffff;
+    
+    const uint16_t METHOD_STORE = 0;
+    const uint16_t FLAG_ENCRYPTED = 0x0001;
+    const uint32_t ZIP64_MARKER = 0xffffffff;
+    
+    uint16_t read16(const unsigned char* const data)
+    {
+        return uint16_t(data[0] | (data[1] << 8));
+    }
+    
+    uint32_t read32(const unsigned char* const data)
+    {
+        return uint32_t(data[0]) | (uint32_t(data[1]) << 8) 
+               | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            ZipIndex::ZipIndex(const char* const archive, const std::size_t size)
+            {
+                if(archive)
+                    read(reinterpret_cast<const unsigned char*>(archive), size);
+            }
+            
+            const ZipIndex::Entry* ZipIndex::find(const std::string & name) const
+            {
+                std::map<std::string, Entry>::const_iterator iter = m_entries.find(name);
+                return iter == m_entries.end() ? 0 : &iter->second;
+            }
+            
+            void ZipIndex::read(const unsigned char* const archive, const std::size_t size)
+            {
+                if(size < END_OF_DIRECTORY_SIZE)
+                    return;
+                
+                // the end of the central directory is followed by a comment of
+                // variable length, i.e. search it from the end of the archive
+                const unsigned char* end = 0;
+                const std::size_t last = size - END_OF_DIRECTORY_SIZE;
+                const std::size_t first = last > MAX_COMMENT_SIZE ? last - MAX_COMMENT_SIZE : 0;
+                for(std::size_t i = last + 1; i > first; --i)
+                {
+                    if(read32(archive + i - 1) == END_OF_DIRECTORY_SIGNATURE)
+                    {
+                        end = archive + i - 1;
+                        break;
+                    }
+                }
+                
+                if(! end)
+                    return;
+                
+                const std::size_t numEntries = read16(end + 10);
+                std::size_t position = read32(end + 16);
+                
+                for(std::size_t i = 0; i < numEntries; ++i)
+                {
+                    if(position + DIRECTORY_ENTRY_SIZE > size)
+                        return;
+                    
+                    const unsigned char* entry = archive + position;
+                    if(read32(entry) != DIRECTORY_ENTRY_SIGNATURE)
+                        return;
+                    
+                    const uint16_t flags = read16(entry + 8);
+                    const uint16_t method = read16(entry + 10);
+                    const uint32_t compressedSize = read32(entry + 20);
+                    const uint32_t uncompressedSize = read32(entry + 24);
+                    const std::size_t nameLength = read16(entry + 28);
+                    const std::size_t extraLength = read16(entry + 30);
+                    const std::size_t commentLength = read16(entry + 32);
+                    const std::size_t localOffset = read32(entry + 42);
+                    
+                    if(position + DIRECTORY_ENTRY_SIZE + nameLength > size)
+                        return;
+                    
+                    const std::string name(reinterpret_cast<const char*>(entry + DIRECTORY_ENTRY_SIZE), nameLength);
+                    position += DIRECTORY_ENTRY_SIZE + nameLength + extraLength + commentLength;
+                    
+                    if(method != METHOD_STORE || (flags & FLAG_ENCRYPTED) 
+                       || compressedSize != uncompressedSize || compressedSize == ZIP64_MARKER 
+                       || localOffset == ZIP64_MARKER)
+                    {
+                        continue;
+                    }
+                    
+                    // the lengths of the name and the extra field in the local
+                    // header can differ from the central directory
+                    if(localOffset + LOCAL_HEADER_SIZE > size)
+                        continue;
+                    
+                    const unsigned char* local = archive + localOffset;
+                    if(read32(local) != LOCAL_HEADER_SIGNATURE)
+                        continue;
+                    
+                    Entry value;
+                    value.offset = localOffset + LOCAL_HEADER_SIZE + read16(local + 26) + read16(local + 28);
+                    value.size = compressedSize;
+                    
+                    if(value.offset > size || value.size > size - value.offset)
+                        continue;
+                    
+                    m_entries[name] = value;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_IMPL_ZIPINDEX_H
+#define STROMX_RUNTIME_IMPL_ZIPINDEX_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            /** 
+             * Locates the uncompressed (stored) entries in the memory image of 
+             * a zip archive by reading its central directory. libzip does not
+             * expose the position of the data of an entry in the archive, which
+             * is required to access the entry without copying it.
+             * 
+             * Compressed, encrypted and ZIP64 entries are not indexed. If the 
+             * archive is invalid the index is empty.
+             */
+            class ZipIndex
+            {
+            public:
+                /** The position of the data of an entry in the archive. */
+                struct Entry
+                {
+                    Entry() : offset(0), size(0) {}
+                    
+                    std::size_t offset;
+                    std::size_t size;
+                };
+                
+                ZipIndex(const char* const archive, const std::size_t size);
+                
+                /** Returns the entry \c name or 0 if the entry is not indexed. */
+                const Entry* find(const std::string & name) const;
+                
+                std::size_t numEntries() const { return m_entries.size(); }
+                
+            private:
+                void read(const unsigned char* const archive, const std::size_t size);
+                
+                std::map<std::string, Entry> m_entries;
+            };
+        }
+    }
+}
+
+#endif // STROMX_RUNTIME_IMPL_ZIPINDEX_H
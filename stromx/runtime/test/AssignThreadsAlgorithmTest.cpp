@@ -20,6 +20,7 @@
 #include "stromx/runtime/AssignThreadsAlgorithm.h"
 #include "stromx/runtime/Counter.h"
 #include "stromx/runtime/Dump.h"
+#include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Fork.h"
 #include "stromx/runtime/Split.h"
 #include "stromx/runtime/Join.h"
@@ -42,6 +43,26 @@ namespace stromx
         void AssignThreadsAlgorithmTest::tearDown()
         {
             delete m_stream;
+            m_chain.clear();
+        }
+        
+        void AssignThreadsAlgorithmTest::buildChain()
+        {
+            // counter -> delay -> delay -> delay -> dump
+            m_stream = new Stream;
+            
+            m_chain.push_back(m_stream->addOperator(new Counter));
+            for (unsigned int i = 0; i < 3; ++i)
+                m_chain.push_back(m_stream->addOperator(new PeriodicDelay));
+            m_chain.push_back(m_stream->addOperator(new Dump));
+            
+            for (std::vector<Operator*>::iterator iter = m_chain.begin(); iter != m_chain.end(); ++iter)
+                m_stream->initializeOperator(*iter);
+            
+            m_stream->connect(m_chain[0], Counter::OUTPUT, m_chain[1], PeriodicDelay::INPUT);
+            m_stream->connect(m_chain[1], PeriodicDelay::OUTPUT, m_chain[2], PeriodicDelay::INPUT);
+            m_stream->connect(m_chain[2], PeriodicDelay::OUTPUT, m_chain[3], PeriodicDelay::INPUT);
+            m_stream->connect(m_chain[3], PeriodicDelay::OUTPUT, m_chain[4], Dump::INPUT);
         }
         
         void AssignThreadsAlgorithmTest::testApplyForkJoin()
@@ -335,5 +356,127 @@ namespace stromx
             
             CPPUNIT_ASSERT_EQUAL(std::size_t(2), thread->inputSequence().size());
         }
+        
+        int AssignThreadsAlgorithmTest::threadOf(const Operator* const op) const
+        {
+            for (unsigned int i = 0; i < m_stream->threads().size(); ++i)
+            {
+                const std::vector<InputConnector> & inputs = m_stream->threads()[i]->inputSequence();
+                for (std::vector<InputConnector>::const_iterator iter = inputs.begin(); iter != inputs.end(); ++iter)
+                {
+                    if (iter->op() == op)
+                        return i;
+                }
+            }
+            
+            return -1;
+        }
+        
+        void AssignThreadsAlgorithmTest::testApplyBalancedChain()
+        {
+            buildChain();
+            
+            AssignThreadsAlgorithm algorithm;
+            algorithm.setMode(AssignThreadsAlgorithm::BALANCED);
+            algorithm.setNumCores(3);
+            algorithm.setCost(m_chain[0], 0.0);
+            algorithm.setCost(m_chain[1], 10.0);
+            algorithm.setCost(m_chain[2], 10.0);
+            algorithm.setCost(m_chain[3], 10.0);
+            algorithm.setCost(m_chain[4], 0.0);
+            algorithm.apply(*m_stream);
+            
+            // each delay is executed by its own thread, the cheap dump is
+            // executed by the thread of the last delay
+            CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_stream->threads().size());
+            
+            Thread* thread0 = m_stream->threads()[0];
+            Thread* thread1 = m_stream->threads()[1];
+            Thread* thread2 = m_stream->threads()[2];
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(1), thread0->inputSequence().size());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(1), thread1->inputSequence().size());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), thread2->inputSequence().size());
+            
+            CPPUNIT_ASSERT_EQUAL(static_cast<const Operator*>(m_chain[1]),
+                                 thread0->inputSequence()[0].op());
+            CPPUNIT_ASSERT_EQUAL(static_cast<const Operator*>(m_chain[2]),
+                                 thread1->inputSequence()[0].op());
+            CPPUNIT_ASSERT_EQUAL(static_cast<const Operator*>(m_chain[3]),
+                                 thread2->inputSequence()[0].op());
+            CPPUNIT_ASSERT_EQUAL(static_cast<const Operator*>(m_chain[4]),
+                                 thread2->inputSequence()[1].op());
+        }
+        
+        void AssignThreadsAlgorithmTest::testApplyBalancedOneCore()
+        {
+            buildChain();
+            
+            AssignThreadsAlgorithm algorithm;
+            algorithm.setMode(AssignThreadsAlgorithm::BALANCED);
+            algorithm.setNumCores(1);
+            algorithm.apply(*m_stream);
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_stream->threads().size());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_stream->threads()[0]->inputSequence().size());
+        }
+        
+        void AssignThreadsAlgorithmTest::testApplyBalancedHeavyOperators()
+        {
+            buildChain();
+            
+            AssignThreadsAlgorithm algorithm;
+            algorithm.setMode(AssignThreadsAlgorithm::BALANCED);
+            algorithm.setNumCores(2);
+            algorithm.setCost(m_chain[0], 1.0);
+            algorithm.setCost(m_chain[1], 100.0);
+            algorithm.setCost(m_chain[2], 1.0);
+            algorithm.setCost(m_chain[3], 100.0);
+            algorithm.setCost(m_chain[4], 1.0);
+            algorithm.apply(*m_stream);
+            
+            // the two heavy operators are executed by different threads
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_stream->threads().size());
+            CPPUNIT_ASSERT(threadOf(m_chain[1]) != threadOf(m_chain[3]));
+        }
+        
+        void AssignThreadsAlgorithmTest::testApplyBalancedForkJoin()
+        {
+            m_stream = new Stream;
+            
+            Operator* counter = m_stream->addOperator(new Counter);
+            Operator* fork = m_stream->addOperator(new Fork);
+            Operator* join = m_stream->addOperator(new Join);
+            Operator* dump = m_stream->addOperator(new Dump);
+            
+            m_stream->initializeOperator(counter);
+            m_stream->initializeOperator(fork);
+            m_stream->initializeOperator(join);
+            m_stream->initializeOperator(dump);
+            
+            m_stream->connect(counter, Counter::OUTPUT, fork, Fork::INPUT);
+            m_stream->connect(fork, 2, join, 2);
+            m_stream->connect(fork, 3, join, 3);
+            m_stream->connect(join, Join::OUTPUT, dump, Dump::INPUT);
+            
+            AssignThreadsAlgorithm algorithm;
+            algorithm.setMode(AssignThreadsAlgorithm::BALANCED);
+            algorithm.setNumCores(1);
+            algorithm.apply(*m_stream);
+            
+            // connectors with different operator threads are never merged
+            CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_stream->threads().size());
+        }
+        
+        void AssignThreadsAlgorithmTest::testSetCost()
+        {
+            m_stream = new Stream;
+            Operator* counter = m_stream->addOperator(new Counter);
+            
+            AssignThreadsAlgorithm algorithm;
+            CPPUNIT_ASSERT_NO_THROW(algorithm.setCost(counter, 2.0));
+            CPPUNIT_ASSERT_THROW(algorithm.setCost(0, 2.0), WrongArgument);
+            CPPUNIT_ASSERT_THROW(algorithm.setCost(counter, -1.0), WrongArgument);
+        }
     }
 }
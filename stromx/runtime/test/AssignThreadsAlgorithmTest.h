@@ -19,6 +19,7 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/TestFixture.h>
+#include <vector>
 
 namespace stromx
 {
@@ -38,6 +39,11 @@ namespace stromx
             CPPUNIT_TEST (testApplyTwoComponents);
             CPPUNIT_TEST (testApplyParallel);
             CPPUNIT_TEST (testTwoOutputsAtOneInput);
+            CPPUNIT_TEST (testApplyBalancedChain);
+            CPPUNIT_TEST (testApplyBalancedOneCore);
+            CPPUNIT_TEST (testApplyBalancedHeavyOperators);
+            CPPUNIT_TEST (testApplyBalancedForkJoin);
+            CPPUNIT_TEST (testSetCost);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -55,9 +61,19 @@ namespace stromx
                 void testApplyTwoComponents();
                 void testApplyParallel();
                 void testTwoOutputsAtOneInput();
+                void testApplyBalancedChain();
+                void testApplyBalancedOneCore();
+                void testApplyBalancedHeavyOperators();
+                void testApplyBalancedForkJoin();
+                void testSetCost();
+                
                 
             private:
+                void buildChain();
+                int threadOf(const Operator* const op) const;
+                
                 Stream* m_stream;
+                std::vector<Operator*> m_chain;
             
         };
     }
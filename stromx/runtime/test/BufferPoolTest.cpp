@@ -0,0 +1,187 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/BufferPool.h"
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Factory.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/test/BufferPoolTest.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::BufferPoolTest);
+
+namespace
+{
+    void releaseDelayed(stromx::runtime::DataContainer & container)
+    {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+        container = stromx::runtime::DataContainer();
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void BufferPoolTest::testAllocate()
+        {
+            BufferPool pool;
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), pool.numBuffers());
+            
+            pool.allocate(UInt32(5), 3);
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), pool.numBuffers());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), pool.numFreeBuffers());
+        }
+        
+        void BufferPoolTest::testAllocateMatrix()
+        {
+            BufferPool pool;
+            pool.allocate(MatrixImpl(), 2, BufferShape::matrix(3, 4, Matrix::FLOAT_32));
+            
+            DataContainer container = pool.get();
+            ReadAccess access(container);
+            const Matrix & matrix = access.get<Matrix>();
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), matrix.rows());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(4), matrix.cols());
+            CPPUNIT_ASSERT_EQUAL(Matrix::FLOAT_32, matrix.valueType());
+        }
+        
+        void BufferPoolTest::testAllocateFactory()
+        {
+            Factory factory;
+            factory.registerData(new MatrixImpl());
+            BufferPool pool;
+            
+            pool.allocate(factory, "Test", "MatrixImpl", 2, BufferShape::matrix(3, 4, Matrix::UINT_8));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), pool.numBuffers());
+            
+            // the pool keeps its buffers if the allocation fails
+            CPPUNIT_ASSERT_THROW(pool.allocate(factory, "Test", "Unknown", 3), DataAllocationFailed);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), pool.numBuffers());
+        }
+        
+        void BufferPoolTest::testAllocateWrongShape()
+        {
+            BufferPool pool;
+            
+            CPPUNIT_ASSERT_THROW(pool.allocate(UInt32(), 2, BufferShape::matrix(3, 4, Matrix::UINT_8)),
+                                 WrongArgument);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), pool.numBuffers());
+        }
+        
+        void BufferPoolTest::testGetNoBuffers()
+        {
+            BufferPool pool;
+            
+            CPPUNIT_ASSERT_THROW(pool.get(), WrongState);
+        }
+        
+        void BufferPoolTest::testRecycle()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 2);
+            
+            DataContainer container = pool.get();
+            const Data* buffer = &ReadAccess(container).get();
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), pool.numFreeBuffers());
+            
+            container = DataContainer();
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), pool.numFreeBuffers());
+            
+            // the last returned buffer is handed out first
+            container = pool.get();
+            CPPUNIT_ASSERT_EQUAL(buffer, &ReadAccess(container).get());
+        }
+        
+        void BufferPoolTest::testTryGet()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 1);
+            
+            DataContainer container = pool.tryGet();
+            CPPUNIT_ASSERT(! container.empty());
+            CPPUNIT_ASSERT(pool.tryGet().empty());
+        }
+        
+        void BufferPoolTest::testGetTimeout()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 1);
+            
+            DataContainer container = pool.get();
+            CPPUNIT_ASSERT_THROW(pool.get(100), Timeout);
+            
+            container = DataContainer();
+            CPPUNIT_ASSERT_NO_THROW(pool.get(100));
+        }
+        
+        void BufferPoolTest::testGetBlocking()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 1);
+            
+            DataContainer container = pool.get();
+            boost::thread t(releaseDelayed, boost::ref(container));
+            
+            DataContainer other = pool.get();
+            CPPUNIT_ASSERT(! other.empty());
+            t.join();
+            
+            CPPUNIT_ASSERT(pool.statistics().waitTime() > 0);
+        }
+        
+        void BufferPoolTest::testStatistics()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 2);
+            
+            DataContainer first = pool.get();
+            DataContainer second = pool.get();
+            pool.tryGet();
+            
+            BufferPoolStatistics statistics = pool.statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistics.numHits());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numMisses());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), statistics.highWaterMark());
+            
+            pool.resetStatistics();
+            statistics = pool.statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numHits());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numMisses());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), statistics.highWaterMark());
+        }
+        
+        void BufferPoolTest::testDeallocateUsedBuffers()
+        {
+            BufferPool pool;
+            pool.allocate(UInt32(5), 2);
+            
+            DataContainer container = pool.get();
+            pool.deallocate();
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), pool.numBuffers());
+            
+            // the buffer in use remains valid until its container is released
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(5), (unsigned int)(ReadAccess(container).get<UInt32>()));
+            container = DataContainer();
+        }
+    }
+}
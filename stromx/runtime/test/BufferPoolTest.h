@@ -0,0 +1,63 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_BUFFERPOOLTEST_H
+#define STROMX_RUNTIME_BUFFERPOOLTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class BufferPoolTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (BufferPoolTest);
+            CPPUNIT_TEST(testAllocate);
+            CPPUNIT_TEST(testAllocateMatrix);
+            CPPUNIT_TEST(testAllocateFactory);
+            CPPUNIT_TEST(testAllocateWrongShape);
+            CPPUNIT_TEST(testGetNoBuffers);
+            CPPUNIT_TEST(testRecycle);
+            CPPUNIT_TEST(testTryGet);
+            CPPUNIT_TEST(testGetTimeout);
+            CPPUNIT_TEST(testGetBlocking);
+            CPPUNIT_TEST(testStatistics);
+            CPPUNIT_TEST(testDeallocateUsedBuffers);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            void setUp() {}
+            void tearDown() {}
+            
+        protected:
+            void testAllocate();
+            void testAllocateMatrix();
+            void testAllocateFactory();
+            void testAllocateWrongShape();
+            void testGetNoBuffers();
+            void testRecycle();
+            void testTryGet();
+            void testGetTimeout();
+            void testGetBlocking();
+            void testStatistics();
+            void testDeallocateUsedBuffers();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_BUFFERPOOLTEST_H
@@ -25,6 +25,9 @@
 #include "stromx/runtime/Primitive.h"
 #include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/impl/Client.h"
+#include "stromx/runtime/impl/Server.h"
+#include "stromx/runtime/impl/WireFormat.h"
+#include "stromx/runtime/test/MatrixImpl.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::ClientTest);
 
@@ -36,12 +39,10 @@ namespace stromx
         {
             using namespace boost::asio;
 
-            void startConnection()
+            void startConnection(ip::tcp::acceptor* acceptor)
             {
-                io_service ioService;
-                ip::tcp::acceptor acceptor(ioService, ip::tcp::endpoint(ip::tcp::v4(), 49152));
-                ip::tcp::socket socket(ioService);
-                acceptor.accept(socket);
+                ip::tcp::socket socket(acceptor->get_executor());
+                acceptor->accept(socket);
             }
 
             void acceptConnections(ip::tcp::acceptor* acceptor, ip::tcp::socket* socket)
@@ -55,14 +56,20 @@ namespace stromx
                 CPPUNIT_ASSERT_THROW(client->receive(factory), impl::Client::Stopped);
             } 
             
-            void sendValue(ip::tcp::socket & socket, unsigned int value)
+            const impl::SerializationHeader uintHeader()
             {
-                // serialize the header
                 impl::SerializationHeader header;
                 header.serverVersion = Version(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
                 header.package = "runtime";
                 header.type = "UInt32";
                 header.version = Version(STROMX_RUNTIME_VERSION_MAJOR, STROMX_RUNTIME_VERSION_MINOR, STROMX_RUNTIME_VERSION_PATCH);
+                return header;
+            }
+            
+            void sendValue(ip::tcp::socket & socket, unsigned int value)
+            {
+                // serialize the header
+                impl::SerializationHeader header = uintHeader();
                 std::ostringstream headerStream;
                 boost::archive::text_oarchive headerArchive(headerStream);
                 headerArchive << header;
@@ -78,32 +85,73 @@ namespace stromx
                 sizesStream << std::setw(impl::SerializationHeader::NUM_SIZE_DIGITS) << std::hex << textData.size();
                 sizesStream << std::setw(impl::SerializationHeader::NUM_SIZE_DIGITS) << std::hex << fileData.size();
                 
+                std::string sizesData = sizesStream.str();
+                
                 // construct a buffer sequence
                 std::vector<const_buffer> buffers;
-                buffers.push_back(buffer(sizesStream.str()));
+                buffers.push_back(buffer(sizesData));
                 buffers.push_back(buffer(headerData));
                 buffers.push_back(buffer(textData));
                 buffers.push_back(buffer(fileData));
                 
                 boost::asio::write(socket, buffers);
             }
+            
+            void sendBinary(ip::tcp::socket & socket, const std::vector<char> & headerData,
+                            const std::string & textData, const std::string & fileData)
+            {
+                impl::WireFormat::Preamble preamble;
+                preamble.headerSize = headerData.size();
+                preamble.textSize = textData.size();
+                preamble.fileSize = fileData.size();
+                boost::array<char, impl::WireFormat::PREAMBLE_SIZE> preambleData;
+                impl::WireFormat::writePreamble(preamble, preambleData.data());
+                
+                std::vector<const_buffer> buffers;
+                buffers.push_back(buffer(preambleData));
+                buffers.push_back(buffer(headerData));
+                buffers.push_back(buffer(textData));
+                buffers.push_back(buffer(fileData));
+                
+                boost::asio::write(socket, buffers);
+            }
+            
+            void sendBinaryValue(ip::tcp::socket & socket, unsigned int value)
+            {
+                std::vector<char> headerData;
+                impl::WireFormat::writeHeader(uintHeader(), headerData);
+                sendBinary(socket, headerData, boost::lexical_cast<std::string>(value), "");
+            }
+            
+            void sendRows(ip::tcp::socket & socket, const std::string & type, const unsigned int rows, 
+                          const unsigned int cols, const std::string & fileData)
+            {
+                impl::SerializationHeader header;
+                header.serverVersion = impl::Server::VERSION;
+                header.package = "Test";
+                header.type = type;
+                header.payload = impl::SerializationHeader::RAW_MATRIX;
+                header.rows = rows;
+                header.cols = cols;
+                header.elementType = Matrix::UINT_8;
+                
+                std::vector<char> headerData;
+                impl::WireFormat::writeHeader(header, headerData);
+                sendBinary(socket, headerData, "", fileData);
+            }
 
-            void sendData(const unsigned int value)
+            void sendData(ip::tcp::acceptor* acceptor, const unsigned int value)
             {
-                io_service ioService;
-                ip::tcp::acceptor acceptor(ioService, ip::tcp::endpoint(ip::tcp::v4(), 49152));
-                ip::tcp::socket socket(ioService);
-                acceptor.accept(socket);
+                ip::tcp::socket socket(acceptor->get_executor());
+                acceptor->accept(socket);
                 
                 sendValue(socket, value);
             }
 
-            void sendMultipleData()
+            void sendMultipleData(ip::tcp::acceptor* acceptor)
             {
-                io_service ioService;
-                ip::tcp::acceptor acceptor(ioService, ip::tcp::endpoint(ip::tcp::v4(), 49152));
-                ip::tcp::socket socket(ioService);
-                acceptor.accept(socket);
+                ip::tcp::socket socket(acceptor->get_executor());
+                acceptor->accept(socket);
                 
                 sendValue(socket, 2);
                 sendValue(socket, 3);
@@ -114,78 +162,148 @@ namespace stromx
         {
             m_client = 0;
             
-            // wait a bit to increase the chance that the requested socket is available
-            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            // the server side of the tests listens at a free port
+            m_acceptor = new ip::tcp::acceptor(m_ioService, ip::tcp::endpoint(ip::tcp::v4(), 0));
+            m_port = boost::lexical_cast<std::string>(m_acceptor->local_endpoint().port());
         }
 
         void ClientTest::testNoConnection()
         {
-            CPPUNIT_ASSERT_THROW(impl::Client("localhost", "49152"), 
+            m_acceptor->close();
+            
+            CPPUNIT_ASSERT_THROW(impl::Client("localhost", m_port), 
                                  impl::Client::NoConnection);
         }
 
         void ClientTest::testConnection()
         {
-            boost::thread t(startConnection);
+            boost::thread t(startConnection, m_acceptor);
             
-            CPPUNIT_ASSERT_NO_THROW(m_client = new impl::Client("localhost", "49152"));
+            CPPUNIT_ASSERT_NO_THROW(m_client = new impl::Client("localhost", m_port));
             t.join();
         }
 
         void ClientTest::testReceive()
         {
-            boost::thread t(sendData, 2);
+            boost::thread t(sendData, m_acceptor, 2);
             
-            m_client = new impl::Client("localhost", "49152");
+            m_client = new impl::Client("localhost", m_port);
             Factory factory;
             factory.registerData(new UInt32);
             DataContainer data = m_client->receive(factory);
-            ReadAccess<UInt32> access(data);
+            ReadAccess access(data);
             
-            CPPUNIT_ASSERT_EQUAL(UInt32(2), access());
+            CPPUNIT_ASSERT_EQUAL(UInt32(2), access.get<UInt32>());
             t.join();
         }
 
         void ClientTest::testReceiveMultipleData()
         {
-            boost::thread t(sendMultipleData);
-            m_client = new impl::Client("localhost", "49152");
+            boost::thread t(sendMultipleData, m_acceptor);
+            m_client = new impl::Client("localhost", m_port);
             Factory factory;
             factory.registerData(new UInt32);
             DataContainer data;
             
             data = m_client->receive(factory);
-            ReadAccess<UInt32> access1(data);
-            CPPUNIT_ASSERT_EQUAL(UInt32(2), access1());
+            ReadAccess access1(data);
+            CPPUNIT_ASSERT_EQUAL(UInt32(2), access1.get<UInt32>());
             
             data = m_client->receive(factory);
-            ReadAccess<UInt32> access2(data);
-            CPPUNIT_ASSERT_EQUAL(UInt32(3), access2());
+            ReadAccess access2(data);
+            CPPUNIT_ASSERT_EQUAL(UInt32(3), access2.get<UInt32>());
             t.join();
         }
 
         void ClientTest::testReceiveClosedConnection()
         {
-            boost::thread t(startConnection);
+            boost::thread t(startConnection, m_acceptor);
             
-            m_client = new impl::Client("localhost", "49152");
+            m_client = new impl::Client("localhost", m_port);
             Factory factory;
             CPPUNIT_ASSERT_THROW(m_client->receive(factory), impl::Client::NoConnection);
             
             t.join();
         }
+        
+        void ClientTest::testReceiveInvalidHeader()
+        {
+            ip::tcp::socket socket(m_ioService);
+            m_client = new impl::Client("localhost", m_port);
+            m_acceptor->accept(socket);
+            
+            sendBinary(socket, std::vector<char>(4, 'x'), "text", "file");
+            sendBinaryValue(socket, 3);
+            
+            Factory factory;
+            factory.registerData(new UInt32);
+            CPPUNIT_ASSERT_THROW(m_client->receive(factory), DeserializationError);
+            
+            DataContainer data = m_client->receive(factory);
+            CPPUNIT_ASSERT_EQUAL(UInt32(3), ReadAccess(data).get<UInt32>());
+        }
+        
+        void ClientTest::testReceiveRowsWrongSize()
+        {
+            ip::tcp::socket socket(m_ioService);
+            m_client = new impl::Client("localhost", m_port);
+            m_acceptor->accept(socket);
+            
+            sendRows(socket, "MatrixImpl", 2, 3, "12345");
+            sendBinaryValue(socket, 3);
+            
+            Factory factory;
+            factory.registerData(new UInt32);
+            factory.registerData(new MatrixImpl);
+            CPPUNIT_ASSERT_THROW(m_client->receive(factory), DeserializationError);
+            
+            DataContainer data = m_client->receive(factory);
+            CPPUNIT_ASSERT_EQUAL(UInt32(3), ReadAccess(data).get<UInt32>());
+        }
+        
+        void ClientTest::testReceiveRowsUnknownType()
+        {
+            ip::tcp::socket socket(m_ioService);
+            m_client = new impl::Client("localhost", m_port);
+            m_acceptor->accept(socket);
+            
+            sendRows(socket, "Unknown", 2, 3, "123456");
+            sendBinaryValue(socket, 3);
+            
+            Factory factory;
+            factory.registerData(new UInt32);
+            CPPUNIT_ASSERT_THROW(m_client->receive(factory), DataAllocationFailed);
+            
+            DataContainer data = m_client->receive(factory);
+            CPPUNIT_ASSERT_EQUAL(UInt32(3), ReadAccess(data).get<UInt32>());
+        }
+        
+        void ClientTest::testReceiveTooLarge()
+        {
+            ip::tcp::socket socket(m_ioService);
+            m_client = new impl::Client("localhost", m_port);
+            m_acceptor->accept(socket);
+            
+            impl::WireFormat::Preamble preamble;
+            preamble.fileSize = uint64_t(1) << 40;
+            boost::array<char, impl::WireFormat::PREAMBLE_SIZE> preambleData;
+            impl::WireFormat::writePreamble(preamble, preambleData.data());
+            boost::asio::write(socket, buffer(preambleData));
+            
+            Factory factory;
+            CPPUNIT_ASSERT_THROW(m_client->receive(factory), DeserializationError);
+            CPPUNIT_ASSERT_THROW(m_client->receive(factory), impl::Client::NoConnection);
+        }
 
         void ClientTest::testStop()
         {
-            io_service ioService;
-            ip::tcp::acceptor acceptor(ioService, ip::tcp::endpoint(ip::tcp::v4(), 49152));
-            ip::tcp::socket socket(ioService);
+            ip::tcp::socket socket(m_ioService);
             
             // wait for incoming connections
-            boost::thread server(boost::bind(&acceptConnections, &acceptor, &socket));
+            boost::thread server(boost::bind(&acceptConnections, m_acceptor, &socket));
             
             // connect to server
-            m_client = new impl::Client("localhost", "49152");
+            m_client = new impl::Client("localhost", m_port);
             
             // request data from server a separate thread
             boost::thread client(boost::bind(&receiveData, m_client));
@@ -202,15 +320,13 @@ namespace stromx
 
         void ClientTest::testStopWithWait()
         {
-            io_service ioService;
-            ip::tcp::acceptor acceptor(ioService, ip::tcp::endpoint(ip::tcp::v4(), 49152));
-            ip::tcp::socket socket(ioService);
+            ip::tcp::socket socket(m_ioService);
             
             // wait for incoming connections
-            boost::thread server(boost::bind(&acceptConnections, &acceptor, &socket));
+            boost::thread server(boost::bind(&acceptConnections, m_acceptor, &socket));
             
             // connect to server
-            m_client = new impl::Client("localhost", "49152");
+            m_client = new impl::Client("localhost", m_port);
             
             // request data from server a separate thread
             boost::thread client(boost::bind(&receiveData, m_client));
@@ -229,6 +345,7 @@ namespace stromx
         void ClientTest::tearDown()
         {            
             delete m_client;
+            delete m_acceptor;
         }
     }
 }
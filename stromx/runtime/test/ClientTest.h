@@ -39,12 +39,16 @@ namespace stromx
             CPPUNIT_TEST (testReceive);
             CPPUNIT_TEST (testReceiveMultipleData);
             CPPUNIT_TEST (testReceiveClosedConnection);
+            CPPUNIT_TEST (testReceiveInvalidHeader);
+            CPPUNIT_TEST (testReceiveRowsWrongSize);
+            CPPUNIT_TEST (testReceiveRowsUnknownType);
+            CPPUNIT_TEST (testReceiveTooLarge);
             CPPUNIT_TEST (testStop);
             CPPUNIT_TEST (testStopWithWait);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
-            ClientTest() : m_client(0) {}
+            ClientTest() : m_client(0), m_acceptor(0) {}
             
             void setUp();
             void tearDown();
@@ -55,11 +59,18 @@ namespace stromx
             void testReceive();
             void testReceiveMultipleData();
             void testReceiveClosedConnection();
+            void testReceiveInvalidHeader();
+            void testReceiveRowsWrongSize();
+            void testReceiveRowsUnknownType();
+            void testReceiveTooLarge();
             void testStop();
             void testStopWithWait();
                 
         private:            
             impl::Client* m_client;
+            boost::asio::io_service m_ioService;
+            boost::asio::ip::tcp::acceptor* m_acceptor;
+            std::string m_port;
         };
     }
 }
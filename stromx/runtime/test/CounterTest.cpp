@@ -45,6 +45,8 @@ namespace stromx
             
             data = m_operator->getOutputData(Counter::OUTPUT);
             CPPUNIT_ASSERT_EQUAL(UInt32(1), ReadAccess(data).get<UInt32>());
+            CPPUNIT_ASSERT(data.metadata().isValid());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), data.metadata().sequenceNumber());
             
             m_operator->deactivate();
             m_operator->activate();
@@ -0,0 +1,133 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/DataBuffer.h"
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Factory.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/OperatorTester.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/test/DataBufferTest.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::DataBufferTest);
+
+namespace stromx
+{
+    using namespace runtime;
+    
+    namespace runtime
+    {
+        void DataBufferTest::setUp()
+        {
+            m_factory = new Factory;
+            m_factory->registerData(new UInt32);
+            m_factory->registerData(new MatrixImpl);
+            
+            m_operator = new OperatorTester(new DataBuffer());
+            m_operator->setFactory(m_factory);
+            m_operator->initialize();
+            m_operator->setParameter(DataBuffer::DATA_TYPE, String("UInt32"));
+            m_operator->setParameter(DataBuffer::NUM_BUFFERS, UInt32(2));
+        }
+        
+        void DataBufferTest::testExecute()
+        {
+            m_operator->activate();
+            
+            DataContainer first = m_operator->getOutputData(DataBuffer::OUTPUT);
+            m_operator->clearOutputData(DataBuffer::OUTPUT);
+            DataContainer second = m_operator->getOutputData(DataBuffer::OUTPUT);
+            m_operator->clearOutputData(DataBuffer::OUTPUT);
+            
+            CPPUNIT_ASSERT(first != second);
+            CPPUNIT_ASSERT_NO_THROW(ReadAccess(first).get<UInt32>());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistic(DataBuffer::NUM_HITS));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(DataBuffer::NUM_MISSES));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistic(DataBuffer::HIGH_WATER_MARK));
+            
+            // the released buffer is sent again
+            const Data* buffer = &ReadAccess(first).get();
+            first = DataContainer();
+            DataContainer third = m_operator->getOutputData(DataBuffer::OUTPUT);
+            CPPUNIT_ASSERT_EQUAL(buffer, &ReadAccess(third).get());
+        }
+        
+        void DataBufferTest::testExecuteMatrix()
+        {
+            m_operator->setParameter(DataBuffer::DATA_PACKAGE, String("Test"));
+            m_operator->setParameter(DataBuffer::DATA_TYPE, String("MatrixImpl"));
+            m_operator->setParameter(DataBuffer::SHAPE, Enum(BufferShape::MATRIX));
+            m_operator->setParameter(DataBuffer::ROWS, UInt32(3));
+            m_operator->setParameter(DataBuffer::COLS, UInt32(4));
+            m_operator->setParameter(DataBuffer::VALUE_TYPE, Enum(Matrix::INT_16));
+            m_operator->activate();
+            
+            DataContainer output = m_operator->getOutputData(DataBuffer::OUTPUT);
+            ReadAccess access(output);
+            const Matrix & matrix = access.get<Matrix>();
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), matrix.rows());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(4), matrix.cols());
+            CPPUNIT_ASSERT_EQUAL(Matrix::INT_16, matrix.valueType());
+        }
+        
+        void DataBufferTest::testExecuteWrongType()
+        {
+            m_operator->setParameter(DataBuffer::DATA_TYPE, String("Unknown"));
+            m_operator->activate();
+            
+            CPPUNIT_ASSERT_THROW(m_operator->getOutputData(DataBuffer::OUTPUT), OperatorError);
+        }
+        
+        void DataBufferTest::testExecuteWrongShape()
+        {
+            m_operator->setParameter(DataBuffer::SHAPE, Enum(BufferShape::IMAGE));
+            m_operator->activate();
+            
+            CPPUNIT_ASSERT_THROW(m_operator->getOutputData(DataBuffer::OUTPUT), OperatorError);
+        }
+        
+        void DataBufferTest::testActivate()
+        {
+            m_operator->activate();
+            DataContainer output = m_operator->getOutputData(DataBuffer::OUTPUT);
+            m_operator->clearOutputData(DataBuffer::OUTPUT);
+            m_operator->deactivate();
+            
+            m_operator->setParameter(DataBuffer::NUM_BUFFERS, UInt32(3));
+            m_operator->activate();
+            for(unsigned int i = 0; i < 3; ++i)
+            {
+                m_operator->getOutputData(DataBuffer::OUTPUT);
+                m_operator->clearOutputData(DataBuffer::OUTPUT);
+            }
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(DataBuffer::NUM_MISSES));
+        }
+        
+        uint64_t DataBufferTest::statistic(const unsigned int id)
+        {
+            return data_cast<UInt64>(m_operator->getParameter(id));
+        }
+        
+        void DataBufferTest::tearDown()
+        {
+            delete m_operator;
+            delete m_factory;
+        }
+    }
+}
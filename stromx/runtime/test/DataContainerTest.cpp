@@ -97,5 +97,38 @@ namespace stromx
             container = DataContainer();
             CPPUNIT_ASSERT(container.empty());
         }
+        
+        void DataContainerTest::testMetadata()
+        {
+            DataContainer container(new TestData());
+            CPPUNIT_ASSERT(! container.metadata().isValid());
+            
+            DataContainer copy = container;
+            container.setMetadata(Metadata(10, 2));
+            CPPUNIT_ASSERT(copy.metadata().isValid());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(10), copy.metadata().timestamp());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), copy.metadata().sequenceNumber());
+        }
+        
+        void DataContainerTest::testMetadataEmpty()
+        {
+            DataContainer container;
+            CPPUNIT_ASSERT(! container.metadata().isValid());
+            CPPUNIT_ASSERT_THROW(container.setMetadata(Metadata(10, 2)), WrongState);
+        }
+        
+        void DataContainerTest::testCopyOnWrite()
+        {
+            DataContainer container(new TestData());
+            CPPUNIT_ASSERT(! container.isCopyOnWrite());
+            
+            DataContainer copy = container;
+            container.setCopyOnWrite(true);
+            CPPUNIT_ASSERT(copy.isCopyOnWrite());
+            
+            DataContainer empty;
+            CPPUNIT_ASSERT(! empty.isCopyOnWrite());
+            CPPUNIT_ASSERT_THROW(empty.setCopyOnWrite(true), WrongState);
+        }
     }
 }
\ No newline at end of file
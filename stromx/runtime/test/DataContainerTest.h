@@ -34,6 +34,9 @@ namespace stromx
             CPPUNIT_TEST (testCompare);
             CPPUNIT_TEST (testEmpty);
             CPPUNIT_TEST (testRelease);
+            CPPUNIT_TEST (testMetadata);
+            CPPUNIT_TEST (testMetadataEmpty);
+            CPPUNIT_TEST (testCopyOnWrite);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -48,6 +51,9 @@ namespace stromx
                 void testCompare();
                 void testEmpty();
                 void testRelease();
+                void testMetadata();
+                void testMetadataEmpty();
+                void testCopyOnWrite();
             private:
                 void destroyDelayed(DataContainer & container);
         };
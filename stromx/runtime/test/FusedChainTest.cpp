@@ -0,0 +1,134 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Counter.h"
+#include "stromx/runtime/Dump.h"
+#include "stromx/runtime/LatencyProbe.h"
+#include "stromx/runtime/Operator.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/impl/FusedChain.h"
+#include "stromx/runtime/impl/InputNode.h"
+#include "stromx/runtime/impl/OutputNode.h"
+#include "stromx/runtime/test/FusedChainTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::FusedChainTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using namespace impl;
+        
+        void FusedChainTest::setUp()
+        {
+            // counter -> probe -> probe -> dump
+            m_operators.push_back(new Operator(new Counter));
+            m_operators.push_back(new Operator(new LatencyProbe));
+            m_operators.push_back(new Operator(new LatencyProbe));
+            m_operators.push_back(new Operator(new Dump));
+            
+            for(std::vector<Operator*>::iterator iter = m_operators.begin();
+                iter != m_operators.end();
+                ++iter)
+            {
+                (*iter)->initialize();
+                (*iter)->activate();
+            }
+            
+            input(1)->connect(m_operators[0]->getOutputNode(Counter::OUTPUT));
+            input(2)->connect(m_operators[1]->getOutputNode(LatencyProbe::OUTPUT));
+            input(3)->connect(m_operators[2]->getOutputNode(LatencyProbe::OUTPUT));
+            
+            m_sequence.push_back(input(1));
+            m_sequence.push_back(input(2));
+            m_sequence.push_back(input(3));
+        }
+        
+        void FusedChainTest::testCreate()
+        {
+            std::vector<FusedChain> chains = FusedChain::create(m_sequence, true);
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(1), chains.size());
+            CPPUNIT_ASSERT(m_sequence == chains[0].nodes());
+        }
+        
+        void FusedChainTest::testCreateNotFused()
+        {
+            std::vector<FusedChain> chains = FusedChain::create(m_sequence, false);
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(3), chains.size());
+            for(unsigned int i = 0; i < 3; ++i)
+            {
+                CPPUNIT_ASSERT_EQUAL(std::size_t(1), chains[i].nodes().size());
+                CPPUNIT_ASSERT_EQUAL(m_sequence[i], chains[i].nodes()[0]);
+            }
+        }
+        
+        void FusedChainTest::testCreateMultipleConsumers()
+        {
+            // the first probe serves a second dump, i.e. its output can 
+            // not be passed on directly
+            Operator* dump = new Operator(new Dump);
+            dump->initialize();
+            dump->activate();
+            m_operators.push_back(dump);
+            input(4)->connect(m_operators[1]->getOutputNode(LatencyProbe::OUTPUT));
+            
+            std::vector<FusedChain> chains = FusedChain::create(m_sequence, true);
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), chains.size());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(1), chains[0].nodes().size());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), chains[1].nodes().size());
+            CPPUNIT_ASSERT_EQUAL(input(2), chains[1].nodes()[0]);
+        }
+        
+        void FusedChainTest::testSetInputData()
+        {
+            std::vector<FusedChain> chains = FusedChain::create(m_sequence, true);
+            
+            for(unsigned int i = 0; i < 3; ++i)
+                chains[0].setInputData();
+            
+            // the data passed both probes and the probes kept no data
+            for(unsigned int i = 1; i < 3; ++i)
+            {
+                DataRef numMeasurements = m_operators[i]->getParameter(LatencyProbe::NUM_MEASUREMENTS);
+                CPPUNIT_ASSERT_EQUAL(UInt64(3), data_cast<UInt64>(numMeasurements));
+                CPPUNIT_ASSERT(! m_operators[i]->hasOutputData(LatencyProbe::OUTPUT));
+            }
+        }
+        
+        InputNode* FusedChainTest::input(const unsigned int op) const
+        {
+            return m_operators[op]->getInputNode(0);
+        }
+        
+        void FusedChainTest::tearDown()
+        {
+            for(std::vector<Operator*>::iterator iter = m_operators.begin();
+                iter != m_operators.end();
+                ++iter)
+            {
+                (*iter)->deactivate();
+                delete *iter;
+            }
+            
+            m_operators.clear();
+            m_sequence.clear();
+        }
+    }
+}
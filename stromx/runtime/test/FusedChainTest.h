@@ -0,0 +1,63 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_FUSEDCHAINTEST_H
+#define STROMX_RUNTIME_FUSEDCHAINTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <vector>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Operator;
+        
+        namespace impl
+        {
+            class InputNode;
+        }
+        
+        class FusedChainTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (FusedChainTest);
+            CPPUNIT_TEST(testCreate);
+            CPPUNIT_TEST(testCreateNotFused);
+            CPPUNIT_TEST(testCreateMultipleConsumers);
+            CPPUNIT_TEST(testSetInputData);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+            void setUp();
+            void tearDown();
+        
+        protected:
+            void testCreate();
+            void testCreateNotFused();
+            void testCreateMultipleConsumers();
+            void testSetInputData();
+                
+        private:
+            impl::InputNode* input(const unsigned int op) const;
+            
+            std::vector<Operator*> m_operators;
+            std::vector<impl::InputNode*> m_sequence;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_FUSEDCHAINTEST_H
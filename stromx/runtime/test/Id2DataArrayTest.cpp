@@ -0,0 +1,185 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Id2DataArray.h"
+#include "stromx/runtime/Input.h"
+#include "stromx/runtime/None.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/Id2DataMap.h"
+#include "stromx/runtime/test/Id2DataArrayTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::Id2DataArrayTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void Id2DataArrayTest::setUp ( void )
+        {
+            std::vector<const Input*> descriptions;
+            descriptions.push_back(new Input(0, Variant::NONE));
+            descriptions.push_back(new Input(1, Variant::NONE));
+            descriptions.push_back(new Input(2, Variant::NONE));
+            m_map = new impl::Id2DataMap;
+            m_map->initialize(descriptions);
+            m_dataContainer = DataContainer(new None());
+            
+            m_ids.clear();
+            m_ids.push_back(0);
+            m_ids.push_back(1);
+            m_ids.push_back(2);
+        }
+        
+        void Id2DataArrayTest::testTrySet()
+        {
+            Id2DataArray andArray(m_ids, Id2DataComposite::AND);
+            Id2DataArray orArray(m_ids, Id2DataComposite::OR);
+            andArray.setAllData(m_dataContainer);
+            orArray.setAllData(m_dataContainer);
+            
+            CPPUNIT_ASSERT_EQUAL(true, andArray.trySet(*m_map));
+            CPPUNIT_ASSERT_EQUAL(true, orArray.trySet(*m_map));
+            
+            m_map->set(0, m_dataContainer);
+            CPPUNIT_ASSERT_EQUAL(false, andArray.trySet(*m_map));
+            CPPUNIT_ASSERT_EQUAL(true, orArray.trySet(*m_map));
+            
+            m_map->set(1, m_dataContainer);
+            m_map->set(2, m_dataContainer);
+            CPPUNIT_ASSERT_EQUAL(false, orArray.trySet(*m_map));
+        }
+        
+        void Id2DataArrayTest::testTryGet()
+        {
+            Id2DataArray andArray(m_ids, Id2DataComposite::AND);
+            Id2DataArray orArray(m_ids, Id2DataComposite::OR);
+            
+            CPPUNIT_ASSERT_EQUAL(false, andArray.tryGet(*m_map));
+            CPPUNIT_ASSERT_EQUAL(false, orArray.tryGet(*m_map));
+            
+            m_map->set(2, m_dataContainer);
+            CPPUNIT_ASSERT_EQUAL(false, andArray.tryGet(*m_map));
+            CPPUNIT_ASSERT_EQUAL(true, orArray.tryGet(*m_map));
+            
+            m_map->set(0, m_dataContainer);
+            m_map->set(1, m_dataContainer);
+            CPPUNIT_ASSERT_EQUAL(true, andArray.tryGet(*m_map));
+        }
+        
+        void Id2DataArrayTest::testSetAnd()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::AND);
+            array.setAllData(m_dataContainer);
+            
+            CPPUNIT_ASSERT_NO_THROW(array.set(*m_map));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, m_map->get(0));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, m_map->get(1));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, m_map->get(2));
+            CPPUNIT_ASSERT(array.data(0).empty());
+            CPPUNIT_ASSERT(array.data(1).empty());
+            CPPUNIT_ASSERT(array.data(2).empty());
+            
+            array.setAllData(m_dataContainer);
+            CPPUNIT_ASSERT_THROW(array.set(*m_map), WrongState);
+        }
+        
+        void Id2DataArrayTest::testSetOr()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::OR);
+            m_map->set(0, m_dataContainer);
+            array.setAllData(m_dataContainer);
+            
+            CPPUNIT_ASSERT_NO_THROW(array.set(*m_map));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, m_map->get(1));
+            CPPUNIT_ASSERT(m_map->get(2).empty());
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(0));
+            CPPUNIT_ASSERT(array.data(1).empty());
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(2));
+            
+            m_map->set(2, m_dataContainer);
+            CPPUNIT_ASSERT_THROW(array.set(*m_map), WrongState);
+        }
+        
+        void Id2DataArrayTest::testGetAnd()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::AND);
+            m_map->set(0, m_dataContainer);
+            m_map->set(1, m_dataContainer);
+            m_map->set(2, m_dataContainer);
+            
+            CPPUNIT_ASSERT_NO_THROW(array.get(*m_map));
+            CPPUNIT_ASSERT(m_map->get(0).empty());
+            CPPUNIT_ASSERT(m_map->get(1).empty());
+            CPPUNIT_ASSERT(m_map->get(2).empty());
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(0));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(1));
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(2));
+            
+            m_map->set(0, m_dataContainer);
+            CPPUNIT_ASSERT_THROW(array.get(*m_map), WrongState);
+        }
+        
+        void Id2DataArrayTest::testGetOr()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::OR);
+            m_map->set(1, m_dataContainer);
+            m_map->set(2, m_dataContainer);
+            
+            CPPUNIT_ASSERT_NO_THROW(array.get(*m_map));
+            CPPUNIT_ASSERT(m_map->get(1).empty());
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, m_map->get(2));
+            CPPUNIT_ASSERT(array.data(0).empty());
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.data(1));
+            CPPUNIT_ASSERT(array.data(2).empty());
+            
+            array.clear();
+            m_map->set(2, DataContainer());
+            CPPUNIT_ASSERT_THROW(array.get(*m_map), WrongState);
+        }
+        
+        void Id2DataArrayTest::testFirstData()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::OR);
+            CPPUNIT_ASSERT(array.firstData().empty());
+            
+            array.setData(2, m_dataContainer);
+            CPPUNIT_ASSERT_EQUAL(m_dataContainer, array.firstData());
+            
+            CPPUNIT_ASSERT_THROW(array.setData(3, m_dataContainer), WrongArgument);
+        }
+        
+        void Id2DataArrayTest::testClear()
+        {
+            Id2DataArray array(m_ids, Id2DataComposite::AND);
+            array.setAllData(m_dataContainer);
+            
+            array.clear();
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), array.size());
+            CPPUNIT_ASSERT(array.data(0).empty());
+            CPPUNIT_ASSERT(array.data(1).empty());
+            CPPUNIT_ASSERT(array.data(2).empty());
+        }
+        
+        void Id2DataArrayTest::tearDown ( void )
+        {
+            delete m_map;
+        }
+    }
+}
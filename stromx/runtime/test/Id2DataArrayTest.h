@@ -0,0 +1,70 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_ID2DATAARRAYTEST_H
+#define STROMX_RUNTIME_ID2DATAARRAYTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <vector>
+#include "stromx/runtime/DataContainer.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            class Id2DataMap;
+        }
+        
+        class Id2DataArrayTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (Id2DataArrayTest);
+            CPPUNIT_TEST (testTrySet);
+            CPPUNIT_TEST (testTryGet);
+            CPPUNIT_TEST (testSetAnd);
+            CPPUNIT_TEST (testSetOr);
+            CPPUNIT_TEST (testGetAnd);
+            CPPUNIT_TEST (testGetOr);
+            CPPUNIT_TEST (testFirstData);
+            CPPUNIT_TEST (testClear);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+                Id2DataArrayTest() : m_map(0) {}
+                void setUp();
+                void tearDown();
+            
+            protected:
+                void testTrySet();
+                void testTryGet();
+                void testSetAnd();
+                void testSetOr();
+                void testGetAnd();
+                void testGetOr();
+                void testFirstData();
+                void testClear();
+                
+            private:
+                impl::Id2DataMap* m_map;
+                DataContainer m_dataContainer; 
+                std::vector<unsigned int> m_ids;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_ID2DATAARRAYTEST_H
@@ -0,0 +1,163 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/chrono.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <fstream>
+#include <map>
+#include <set>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Input.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/Id2DataMap.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            // the data map as it was implemented before the flat layout
+            class MapReference
+            {
+            public:
+                explicit MapReference(const std::vector<const Input*> & inputs)
+                {
+                    for(std::vector<const Input*>::const_iterator iter = inputs.begin();
+                        iter != inputs.end();
+                        ++iter)
+                    {
+                        m_map[(*iter)->id()] = DataContainer();
+                    }
+                }
+                
+                const DataContainer & get(const unsigned int id) const
+                {
+                    return m_map.find(id)->second;
+                }
+                
+                void set(const unsigned int id, const DataContainer & data)
+                {
+                    std::map<unsigned int, DataContainer>::iterator iter = m_map.find(id);
+                    DataContainer oldData = iter->second;
+                    iter->second = data;
+                }
+                
+                bool canBeSet(const unsigned int id) const
+                {
+                    if (m_persistentParameters.count(id))
+                        return true;
+                    
+                    return get(id).empty();
+                }
+                
+            private:
+                std::map<unsigned int, DataContainer> m_map;
+                std::set<unsigned int> m_persistentParameters;
+            };
+            
+            const unsigned int NUM_ROUNDS = 100000;
+            
+            // looks up each connector as an operator does when checking 
+            // whether it can accept or send data, the connector IDs are
+            // multiples of stride
+            template <class map_t>
+            double measure(map_t & map, const unsigned int numConnectors, 
+                           const unsigned int stride, unsigned int & checksum)
+            {
+                using namespace boost::chrono;
+                
+                for(unsigned int i = 0; i < numConnectors; i += 2)
+                    map.set(i * stride, DataContainer(new UInt8()));
+                
+                const steady_clock::time_point start = steady_clock::now();
+                
+                for(unsigned int round = 0; round < NUM_ROUNDS; ++round)
+                {
+                    for(unsigned int i = 0; i < numConnectors; ++i)
+                    {
+                        const unsigned int id = i * stride;
+                        if(map.canBeSet(id))
+                            checksum++;
+                        
+                        if(! map.get(id).empty())
+                            checksum++;
+                    }
+                }
+                
+                const double elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+                return elapsed / (NUM_ROUNDS * numConnectors);
+            }
+        }
+        
+        class Id2DataMapBenchmark : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (Id2DataMapBenchmark);
+            CPPUNIT_TEST(testAccess);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        protected:
+            void testAccess()
+            {
+                const unsigned int sizes[] = { 2, 8, 32 };
+                
+                // dense IDs, sparse IDs within the lookup table and IDs beyond
+                // the lookup table
+                const unsigned int strides[] = { 1, 100, 1000 };
+                
+                // the timings are written to a file in the working directory
+                std::ofstream results("Id2DataMapBenchmark.txt");
+                for(unsigned int j = 0; j < sizeof(strides) / sizeof(strides[0]); ++j)
+                {
+                    for(unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+                    {
+                        const unsigned int numConnectors = sizes[i];
+                        const unsigned int stride = strides[j];
+                        
+                        std::vector<Input> descriptions;
+                        for(unsigned int k = 0; k < numConnectors; ++k)
+                            descriptions.push_back(Input(k * stride, Variant::DATA));
+                        
+                        std::vector<const Input*> inputs;
+                        for(unsigned int k = 0; k < numConnectors; ++k)
+                            inputs.push_back(&descriptions[k]);
+                        
+                        impl::Id2DataMap flat;
+                        flat.initialize(inputs);
+                        MapReference reference(inputs);
+                        
+                        unsigned int flatChecksum = 0;
+                        unsigned int referenceChecksum = 0;
+                        const double flatTime = measure(flat, numConnectors, stride, flatChecksum);
+                        const double referenceTime = measure(reference, numConnectors, stride, referenceChecksum);
+                        
+                        results << numConnectors << " connectors with ID stride " << stride 
+                                << ": std::map " << referenceTime << " ns, flat " << flatTime 
+                                << " ns per connector" << std::endl;
+                        
+                        CPPUNIT_ASSERT_EQUAL(referenceChecksum, flatChecksum);
+                        CPPUNIT_ASSERT_EQUAL(NUM_ROUNDS * numConnectors, flatChecksum);
+                    }
+                }
+            }
+        };
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::Id2DataMapBenchmark);
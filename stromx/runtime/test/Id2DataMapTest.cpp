@@ -153,6 +153,57 @@ namespace stromx
             CPPUNIT_ASSERT(m_inputMap->mustBeReset(3));
         }
         
+        void Id2DataMapTest::testClear()
+        {
+            DataContainer data(new UInt8());
+            m_inputMap->set(0, data);
+            m_inputMap->set(2, data);
+            CPPUNIT_ASSERT(! m_inputMap->empty());
+            
+            m_inputMap->clear();
+            
+            CPPUNIT_ASSERT(m_inputMap->get(0).empty());
+            CPPUNIT_ASSERT_EQUAL(data, m_inputMap->get(2));
+            
+            m_inputMap->set(2, DataContainer());
+            CPPUNIT_ASSERT(m_inputMap->empty());
+        }
+        
+        void Id2DataMapTest::testSparseIds()
+        {
+            Input input0(0, Variant::NONE);
+            Input input1(1000, Variant::NONE);
+            Input input2(5, Variant::NONE);
+            
+            std::vector<const Input*> inputs;
+            inputs.push_back(&input0);
+            inputs.push_back(&input1);
+            inputs.push_back(&input2);
+            
+            impl::Id2DataMap map;
+            map.initialize(inputs);
+            
+            DataContainer data(new UInt8());
+            map.set(1000, data);
+            
+            CPPUNIT_ASSERT_EQUAL(data, map.get(1000));
+            CPPUNIT_ASSERT(map.get(5).empty());
+            CPPUNIT_ASSERT(! map.canBeSet(1000));
+            CPPUNIT_ASSERT(map.canBeSet(0));
+            CPPUNIT_ASSERT_THROW(map.get(6), WrongId);
+            CPPUNIT_ASSERT_THROW(map.get(2000), WrongId);
+        }
+        
+        void Id2DataMapTest::testDuplicateIds()
+        {
+            std::vector<const Input*> inputs;
+            inputs.push_back(&m_input0);
+            inputs.push_back(&m_input0);
+            
+            impl::Id2DataMap map;
+            CPPUNIT_ASSERT_THROW(map.initialize(inputs), WrongArgument);
+        }
+        
         Id2DataMapTest::~Id2DataMapTest()
         {
             delete m_observer;
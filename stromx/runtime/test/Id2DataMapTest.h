@@ -40,6 +40,9 @@ namespace stromx
             CPPUNIT_TEST(testMustBeReset);
             CPPUNIT_TEST(testSetInputMap);
             CPPUNIT_TEST(testSetOutputMap);
+            CPPUNIT_TEST(testClear);
+            CPPUNIT_TEST(testSparseIds);
+            CPPUNIT_TEST(testDuplicateIds);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -57,6 +60,9 @@ namespace stromx
             void testMustBeReset();
             void testSetInputMap();
             void testSetOutputMap();
+            void testClear();
+            void testSparseIds();
+            void testDuplicateIds();
                 
         private:
             class Observer : public impl::Id2DataMapObserver
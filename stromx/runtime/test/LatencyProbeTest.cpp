@@ -0,0 +1,131 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/LatencyProbe.h"
+#include "stromx/runtime/Metadata.h"
+#include "stromx/runtime/OperatorTester.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/test/LatencyProbeTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::LatencyProbeTest);
+
+namespace
+{
+    // one second in microseconds
+    const uint64_t SECOND = 1000000;
+}
+
+namespace stromx
+{
+    using namespace runtime;
+    
+    namespace runtime
+    {
+        void LatencyProbeTest::setUp()
+        {
+            m_operator = new OperatorTester(new LatencyProbe());
+            m_operator->initialize();
+            m_operator->activate();
+        }
+        
+        void LatencyProbeTest::testExecute()
+        {
+            DataContainer input(new UInt32(1));
+            input.setMetadata(Metadata(Metadata::currentTime() - SECOND, 5));
+            
+            m_operator->setInputData(LatencyProbe::INPUT, input);
+            DataContainer output = m_operator->getOutputData(LatencyProbe::OUTPUT);
+            
+            CPPUNIT_ASSERT(input == output);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(5), output.metadata().sequenceNumber());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistic(LatencyProbe::NUM_MEASUREMENTS));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::NUM_MISSING_METADATA));
+            CPPUNIT_ASSERT(statistic(LatencyProbe::MEDIAN) >= SECOND);
+            CPPUNIT_ASSERT(statistic(LatencyProbe::MEDIAN) < 2 * SECOND);
+            CPPUNIT_ASSERT_EQUAL(statistic(LatencyProbe::MEDIAN), statistic(LatencyProbe::MAXIMUM));
+        }
+        
+        void LatencyProbeTest::testExecuteNoMetadata()
+        {
+            DataContainer input(new UInt32(1));
+            
+            m_operator->setInputData(LatencyProbe::INPUT, input);
+            DataContainer output = m_operator->getOutputData(LatencyProbe::OUTPUT);
+            
+            CPPUNIT_ASSERT(input == output);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::NUM_MEASUREMENTS));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistic(LatencyProbe::NUM_MISSING_METADATA));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::MEDIAN));
+        }
+        
+        void LatencyProbeTest::testPercentiles()
+        {
+            m_operator->setParameter(LatencyProbe::WINDOW_SIZE, UInt32(10));
+            
+            // only the latencies 11 to 20 seconds remain in the window
+            for(uint64_t i = 1; i <= 20; ++i)
+                pass(i * SECOND);
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(20), statistic(LatencyProbe::NUM_MEASUREMENTS));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(15), statistic(LatencyProbe::MEDIAN) / SECOND);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(19), statistic(LatencyProbe::PERCENTILE_90) / SECOND);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(20), statistic(LatencyProbe::PERCENTILE_99) / SECOND);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(20), statistic(LatencyProbe::MAXIMUM) / SECOND);
+            
+            // shrink the window to the last 2 measurements
+            m_operator->setParameter(LatencyProbe::WINDOW_SIZE, UInt32(2));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(19), statistic(LatencyProbe::MEDIAN) / SECOND);
+        }
+        
+        void LatencyProbeTest::testActivate()
+        {
+            pass(SECOND);
+            DataContainer input(new UInt32(1));
+            m_operator->setInputData(LatencyProbe::INPUT, input);
+            m_operator->getOutputData(LatencyProbe::OUTPUT);
+            m_operator->clearOutputData(LatencyProbe::OUTPUT);
+            
+            m_operator->deactivate();
+            m_operator->activate();
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::NUM_MEASUREMENTS));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::NUM_MISSING_METADATA));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(LatencyProbe::MAXIMUM));
+        }
+        
+        void LatencyProbeTest::pass(const uint64_t latency)
+        {
+            DataContainer input(new UInt32(1));
+            input.setMetadata(Metadata(Metadata::currentTime() - latency, 0));
+            
+            m_operator->setInputData(LatencyProbe::INPUT, input);
+            m_operator->getOutputData(LatencyProbe::OUTPUT);
+            m_operator->clearOutputData(LatencyProbe::OUTPUT);
+        }
+        
+        uint64_t LatencyProbeTest::statistic(const unsigned int id)
+        {
+            return data_cast<UInt64>(m_operator->getParameter(id));
+        }
+        
+        void LatencyProbeTest::tearDown()
+        {
+            delete m_operator;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/test/LzCodecTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <vector>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/LzCodec.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::LzCodecTest);
+
+namespace
+{
+    typedef std::vector<uint8_t> Buffer;
+    
+    const Buffer compress(const Buffer & data)
+    {
+        Buffer compressed(stromx::runtime::impl::LzCodec::maxCompressedSize(data.size()));
+        const uint8_t* source = data.empty() ? 0 : &data[0];
+        compressed.resize(stromx::runtime::impl::LzCodec::compress(source, data.size(), &compressed[0]));
+        return compressed;
+    }
+    
+    const Buffer decompress(const Buffer & compressed, const std::size_t size)
+    {
+        Buffer data(size);
+        const uint8_t* source = compressed.empty() ? 0 : &compressed[0];
+        stromx::runtime::impl::LzCodec::decompress(source, compressed.size(), 
+                                                   data.empty() ? 0 : &data[0], size);
+        return data;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using impl::LzCodec;
+        
+        void LzCodecTest::testEmpty()
+        {
+            const Buffer data;
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT(compressed.size() <= LzCodec::maxCompressedSize(0));
+            CPPUNIT_ASSERT(decompress(compressed, 0).empty());
+        }
+        
+        void LzCodecTest::testShort()
+        {
+            const uint8_t values[] = { 1, 2, 3 };
+            const Buffer data(values, values + 3);
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT(data == decompress(compressed, data.size()));
+        }
+        
+        void LzCodecTest::testRepetitive()
+        {
+            Buffer data(100000);
+            for(std::size_t i = 0; i < data.size(); ++i)
+                data[i] = uint8_t(i % 7);
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT(compressed.size() < data.size() / 10);
+            CPPUNIT_ASSERT(data == decompress(compressed, data.size()));
+        }
+        
+        void LzCodecTest::testOverlappingMatch()
+        {
+            Buffer data(1000, 42);
+            data[0] = 1;
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT(compressed.size() < 50);
+            CPPUNIT_ASSERT(data == decompress(compressed, data.size()));
+        }
+        
+        void LzCodecTest::testRandom()
+        {
+            Buffer data(70000);
+            uint32_t state = 12345;
+            for(std::size_t i = 0; i < data.size(); ++i)
+            {
+                state = state * 1103515245 + 12345;
+                data[i] = uint8_t(state >> 16);
+            }
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT(compressed.size() <= LzCodec::maxCompressedSize(data.size()));
+            CPPUNIT_ASSERT(data == decompress(compressed, data.size()));
+        }
+        
+        void LzCodecTest::testDecompressTruncated()
+        {
+            Buffer data(10000);
+            for(std::size_t i = 0; i < data.size(); ++i)
+                data[i] = uint8_t(i % 13);
+            
+            Buffer compressed = compress(data);
+            compressed.resize(compressed.size() / 2);
+            
+            CPPUNIT_ASSERT_THROW(decompress(compressed, data.size()), Exception);
+        }
+        
+        void LzCodecTest::testDecompressWrongSize()
+        {
+            Buffer data(10000);
+            for(std::size_t i = 0; i < data.size(); ++i)
+                data[i] = uint8_t(i % 13);
+            
+            const Buffer compressed = compress(data);
+            
+            CPPUNIT_ASSERT_THROW(decompress(compressed, data.size() - 1), Exception);
+            CPPUNIT_ASSERT_THROW(decompress(compressed, data.size() + 1), Exception);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/test/MappedFileTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <fstream>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/MappedFile.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::MappedFileTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using impl::MappedFile;
+        
+        void MappedFileTest::testMap()
+        {
+            MappedFile file("data.txt");
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(6), file.size());
+            CPPUNIT_ASSERT_EQUAL(std::string("191079"), std::string(file.data(), file.size()));
+        }
+        
+        void MappedFileTest::testMapEmpty()
+        {
+            {
+                std::ofstream out("MappedFileTest_testMapEmpty.txt");
+            }
+            
+            MappedFile file("MappedFileTest_testMapEmpty.txt");
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(0), file.size());
+        }
+        
+        void MappedFileTest::testMapMissing()
+        {
+            CPPUNIT_ASSERT_THROW(MappedFile("MappedFileTest_testMapMissing.txt"), FileAccessFailed);
+        }
+    }
+}
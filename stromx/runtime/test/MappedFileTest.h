@@ -0,0 +1,50 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_MAPPEDFILETEST_H
+#define STROMX_RUNTIME_MAPPEDFILETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class MappedFileTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (MappedFileTest);
+            CPPUNIT_TEST(testMap);
+            CPPUNIT_TEST(testMapEmpty);
+            CPPUNIT_TEST(testMapMissing);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            MappedFileTest() {}
+            
+            void setUp() {}
+            void tearDown() {}
+            
+        protected:
+            void testMap();
+            void testMapEmpty();
+            void testMapMissing();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_MAPPEDFILETEST_H
@@ -0,0 +1,304 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/test/MatrixCodecTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <cstring>
+#include <sstream>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/InputProvider.h"
+#include "stromx/runtime/MatrixCodec.h"
+#include "stromx/runtime/OutputProvider.h"
+#include "stromx/runtime/Version.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::MatrixCodecTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            class EncodingOutput : public OutputProvider
+            {
+            public:
+                explicit EncodingOutput(const Encoding encoding) : m_encoding(encoding) {}
+                
+                std::ostream & text() { return m_text; }
+                std::ostream & openFile(const std::string & ext, const OpenMode)
+                {
+                    m_extension = ext;
+                    return m_file;
+                }
+                std::ostream & file() { return m_file; }
+                Encoding encoding() const { return m_encoding; }
+                
+                const std::string extension() const { return m_extension; }
+                const std::string fileData() const { return m_file.str(); }
+                
+            private:
+                Encoding m_encoding;
+                std::string m_extension;
+                std::ostringstream m_text;
+                std::ostringstream m_file;
+            };
+            
+            class FileInput : public InputProvider
+            {
+            public:
+                explicit FileInput(const std::string & data) : m_file(data) {}
+                
+                std::istream & text() { return m_text; }
+                std::istream & openFile(const OpenMode) { return m_file; }
+                bool hasFile() const { return true; }
+                std::istream & file() { return m_file; }
+                
+            private:
+                std::istringstream m_text;
+                std::istringstream m_file;
+            };
+            
+            void fill(Matrix & matrix)
+            {
+                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                {
+                    uint16_t* row = reinterpret_cast<uint16_t*>(matrix.data() + i * matrix.stride());
+                    for(unsigned int j = 0; j < matrix.cols(); ++j)
+                        row[j] = uint16_t(i + j % 5);
+                }
+            }
+            
+            bool equal(const Matrix & lhs, const Matrix & rhs)
+            {
+                if(lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols() || lhs.valueType() != rhs.valueType())
+                    return false;
+                
+                const std::size_t rowSize = lhs.cols() * lhs.valueSize();
+                for(unsigned int i = 0; i < lhs.rows(); ++i)
+                {
+                    if(std::memcmp(lhs.data() + i * lhs.stride(), rhs.data() + i * rhs.stride(), rowSize))
+                        return false;
+                }
+                
+                return true;
+            }
+            
+            void roundTrip(const OutputProvider::Encoding encoding)
+            {
+                MatrixImpl matrix(30, 40, Matrix::UINT_16);
+                fill(matrix);
+                std::stringstream stream;
+                
+                MatrixCodec::encode(matrix, encoding, stream);
+                
+                const MatrixCodec::Header header = MatrixCodec::readHeader(stream);
+                CPPUNIT_ASSERT_EQUAL(encoding, header.encoding);
+                CPPUNIT_ASSERT_EQUAL(30u, header.rows);
+                CPPUNIT_ASSERT_EQUAL(40u, header.cols);
+                CPPUNIT_ASSERT_EQUAL(Matrix::UINT_16, header.valueType);
+                
+                MatrixImpl decoded(header.rows, header.cols, header.valueType);
+                MatrixCodec::decode(stream, header, decoded);
+                CPPUNIT_ASSERT(equal(matrix, decoded));
+            }
+        }
+        
+        void MatrixCodecTest::testRaw()
+        {
+            roundTrip(OutputProvider::RAW);
+        }
+        
+        void MatrixCodecTest::testFast()
+        {
+            roundTrip(OutputProvider::FAST);
+        }
+        
+        void MatrixCodecTest::testFastEmpty()
+        {
+            MatrixImpl matrix(0, 0, Matrix::UINT_8);
+            std::stringstream stream;
+            
+            MatrixCodec::encode(matrix, OutputProvider::FAST, stream);
+            
+            const MatrixCodec::Header header = MatrixCodec::readHeader(stream);
+            MatrixImpl decoded(0, 0, Matrix::UINT_8);
+            MatrixCodec::decode(stream, header, decoded);
+            CPPUNIT_ASSERT_EQUAL(0u, decoded.rows());
+        }
+        
+        void MatrixCodecTest::testEncodeUnsupported()
+        {
+            MatrixImpl matrix(2, 2, Matrix::UINT_8);
+            std::stringstream stream;
+            
+            CPPUNIT_ASSERT_THROW(MatrixCodec::encode(matrix, OutputProvider::PNG, stream), WrongArgument);
+        }
+        
+        void MatrixCodecTest::testIsEncoded()
+        {
+            MatrixImpl matrix(2, 2, Matrix::UINT_8);
+            std::stringstream encoded;
+            MatrixCodec::encode(matrix, OutputProvider::RAW, encoded);
+            
+            CPPUNIT_ASSERT(MatrixCodec::isEncoded(encoded));
+            CPPUNIT_ASSERT_EQUAL(std::streampos(0), encoded.tellg());
+            
+            std::istringstream numpy("\x93NUMPY");
+            CPPUNIT_ASSERT(! MatrixCodec::isEncoded(numpy));
+            CPPUNIT_ASSERT_EQUAL(std::streampos(0), numpy.tellg());
+            
+            std::istringstream empty("");
+            CPPUNIT_ASSERT(! MatrixCodec::isEncoded(empty));
+        }
+        
+        void MatrixCodecTest::testReadHeaderInvalid()
+        {
+            std::istringstream truncated("SXMC");
+            CPPUNIT_ASSERT_THROW(MatrixCodec::readHeader(truncated), Exception);
+            
+            MatrixImpl matrix(2, 2, Matrix::UINT_8);
+            std::ostringstream out;
+            MatrixCodec::encode(matrix, OutputProvider::RAW, out);
+            std::string data = out.str();
+            data[5] = char(OutputProvider::PNG);
+            std::istringstream wrongEncoding(data);
+            CPPUNIT_ASSERT_THROW(MatrixCodec::readHeader(wrongEncoding), Exception);
+        }
+        
+        void MatrixCodecTest::testDecodeWrongDimensions()
+        {
+            MatrixImpl matrix(2, 3, Matrix::UINT_8);
+            std::stringstream stream;
+            MatrixCodec::encode(matrix, OutputProvider::RAW, stream);
+            const MatrixCodec::Header header = MatrixCodec::readHeader(stream);
+            
+            MatrixImpl decoded(3, 2, Matrix::UINT_8);
+            CPPUNIT_ASSERT_THROW(MatrixCodec::decode(stream, header, decoded), Exception);
+        }
+        
+        void MatrixCodecTest::testDecodeTruncated()
+        {
+            MatrixImpl matrix(30, 40, Matrix::UINT_16);
+            fill(matrix);
+            
+            for(unsigned int i = 0; i < 2; ++i)
+            {
+                const OutputProvider::Encoding encoding = i ? OutputProvider::FAST : OutputProvider::RAW;
+                std::ostringstream out;
+                MatrixCodec::encode(matrix, encoding, out);
+                const std::string data = out.str();
+                std::istringstream in(data.substr(0, data.size() - 10));
+                
+                // the header of the truncated data is rejected
+                CPPUNIT_ASSERT_THROW(MatrixCodec::readHeader(in), Exception);
+                
+                // decoding detects the truncation as well
+                std::istringstream complete(data);
+                const MatrixCodec::Header header = MatrixCodec::readHeader(complete);
+                in.clear();
+                in.seekg(complete.tellg());
+                MatrixImpl decoded(header.rows, header.cols, header.valueType);
+                CPPUNIT_ASSERT_THROW(MatrixCodec::decode(in, header, decoded), Exception);
+            }
+        }
+        
+        void MatrixCodecTest::testReadHeaderWrongSize()
+        {
+            MatrixImpl matrix(2, 2, Matrix::UINT_8);
+            
+            for(unsigned int i = 0; i < 2; ++i)
+            {
+                const OutputProvider::Encoding encoding = i ? OutputProvider::FAST : OutputProvider::RAW;
+                std::ostringstream out;
+                MatrixCodec::encode(matrix, encoding, out);
+                
+                // the number of rows does not match the size of the payload
+                std::string data = out.str();
+                data[8] = data[9] = data[10] = data[11] = char(0xff);
+                std::istringstream in(data);
+                CPPUNIT_ASSERT_THROW(MatrixCodec::readHeader(in), Exception);
+            }
+        }
+        
+        void MatrixCodecTest::testSerializeRaw()
+        {
+            MatrixImpl matrix(30, 40, Matrix::UINT_16);
+            fill(matrix);
+            EncodingOutput output(OutputProvider::RAW);
+            
+            matrix.serialize(output);
+            
+            CPPUNIT_ASSERT_EQUAL(std::string(".sxm"), output.extension());
+            FileInput input(output.fileData());
+            MatrixImpl deserialized;
+            deserialized.deserialize(input, Version(0, 1, 0));
+            CPPUNIT_ASSERT(equal(matrix, deserialized));
+        }
+        
+        void MatrixCodecTest::testSerializeFast()
+        {
+            MatrixImpl matrix(30, 40, Matrix::UINT_16);
+            fill(matrix);
+            EncodingOutput output(OutputProvider::FAST);
+            
+            matrix.serialize(output);
+            
+            CPPUNIT_ASSERT_EQUAL(std::string(".sxz"), output.extension());
+            CPPUNIT_ASSERT(output.fileData().size() < 30 * 40 * 2);
+            FileInput input(output.fileData());
+            MatrixImpl deserialized;
+            deserialized.deserialize(input, Version(0, 1, 0));
+            CPPUNIT_ASSERT(equal(matrix, deserialized));
+        }
+        
+        void MatrixCodecTest::testSerializeDefault()
+        {
+            MatrixImpl matrix(30, 40, Matrix::UINT_16);
+            fill(matrix);
+            EncodingOutput output(OutputProvider::DEFAULT);
+            
+            matrix.serialize(output);
+            
+            CPPUNIT_ASSERT_EQUAL(std::string(".npy"), output.extension());
+            FileInput input(output.fileData());
+            MatrixImpl deserialized;
+            deserialized.deserialize(input, Version(0, 1, 0));
+            CPPUNIT_ASSERT(equal(matrix, deserialized));
+        }
+        
+        void MatrixCodecTest::testDeserializeTruncated()
+        {
+            MatrixImpl matrix(30, 40, Matrix::UINT_16);
+            fill(matrix);
+            
+            for(unsigned int i = 0; i < 2; ++i)
+            {
+                EncodingOutput output(i ? OutputProvider::FAST : OutputProvider::DEFAULT);
+                matrix.serialize(output);
+                const std::string data = output.fileData();
+                
+                // the truncated data is rejected before the matrix is allocated
+                FileInput input(data.substr(0, data.size() - 10));
+                MatrixImpl deserialized;
+                CPPUNIT_ASSERT_THROW(deserialized.deserialize(input, Version(0, 1, 0)), Exception);
+                CPPUNIT_ASSERT_EQUAL((unsigned int)(0), deserialized.rows());
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_MATRIXCODECTEST_H
+#define STROMX_RUNTIME_MATRIXCODECTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class MatrixCodecTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (MatrixCodecTest);
+            CPPUNIT_TEST(testRaw);
+            CPPUNIT_TEST(testFast);
+            CPPUNIT_TEST(testFastEmpty);
+            CPPUNIT_TEST(testEncodeUnsupported);
+            CPPUNIT_TEST(testIsEncoded);
+            CPPUNIT_TEST(testReadHeaderInvalid);
+            CPPUNIT_TEST(testDecodeWrongDimensions);
+            CPPUNIT_TEST(testDecodeTruncated);
+            CPPUNIT_TEST(testReadHeaderWrongSize);
+            CPPUNIT_TEST(testSerializeRaw);
+            CPPUNIT_TEST(testSerializeFast);
+            CPPUNIT_TEST(testSerializeDefault);
+            CPPUNIT_TEST(testDeserializeTruncated);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            MatrixCodecTest() {}
+            
+            void setUp() {}
+            void tearDown() {}
+            
+        protected:
+            void testRaw();
+            void testFast();
+            void testFastEmpty();
+            void testEncodeUnsupported();
+            void testIsEncoded();
+            void testReadHeaderInvalid();
+            void testDecodeWrongDimensions();
+            void testDecodeTruncated();
+            void testReadHeaderWrongSize();
+            void testSerializeRaw();
+            void testSerializeFast();
+            void testSerializeDefault();
+            void testDeserializeTruncated();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_MATRIXCODECTEST_H
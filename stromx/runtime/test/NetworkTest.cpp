@@ -19,7 +19,9 @@
 #include "stromx/runtime/Dump.h"
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Operator.h"
+#include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/OperatorTester.h"
+#include "stromx/runtime/Queue.h"
 #include "stromx/runtime/impl/Network.h"
 #include "stromx/runtime/impl/OutputNode.h"
 #include "stromx/runtime/test/NetworkTest.h"
@@ -118,6 +120,28 @@ namespace stromx
             CPPUNIT_ASSERT_EQUAL(Operator::ACTIVE,op2->status());
         }
 
+        void NetworkTest::testActivateSharedChannel()
+        {
+            Operator* queue = new Operator(new Queue());
+            queue->initialize();
+            queue->setParameter(Queue::MODE, Enum(Queue::RING));
+            m_network->addOperator(queue);
+            
+            for(unsigned int i = 0; i < 2; ++i)
+            {
+                Operator* op = new Operator(new TestOperator());
+                op->initialize();
+                m_network->addOperator(op);
+                m_network->connect(queue, Queue::OUTPUT, op, TestOperator::INPUT_1);
+            }
+            
+            // a ring channel has exactly one consumer
+            CPPUNIT_ASSERT_THROW(m_network->activate(), OperatorError);
+            CPPUNIT_ASSERT_EQUAL(Operator::INITIALIZED, queue->status());
+            
+            m_network->deactivate();
+        }
+        
         void NetworkTest::testDeactivate()
         {
             CPPUNIT_ASSERT_NO_THROW(m_network->deactivate());
@@ -38,6 +38,7 @@ namespace stromx
             CPPUNIT_TEST(testAddOperator);
             CPPUNIT_TEST(testRemoveOperator);
             CPPUNIT_TEST(testActivate);
+            CPPUNIT_TEST(testActivateSharedChannel);
             CPPUNIT_TEST(testDeactivate);
             CPPUNIT_TEST(testDeactivateFails);
             CPPUNIT_TEST(testConnectionSource);
@@ -54,6 +55,7 @@ namespace stromx
             void testRemoveOperator();
             void testRemoveConnectedOperator();
             void testActivate();
+            void testActivateSharedChannel();
             void testDeactivate();
             void testDeactivateFails();
             void testConnectionSource();
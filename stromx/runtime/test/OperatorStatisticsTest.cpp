@@ -0,0 +1,72 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/OperatorStatistics.h"
+#include "stromx/runtime/test/OperatorStatisticsTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::OperatorStatisticsTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void OperatorStatisticsTest::testConstructor()
+        {
+            OperatorStatistics statistics;
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numErrors());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.executionTime());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.receiveTime());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.sendTime());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numDroppedData());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numDroppedData(0));
+            CPPUNIT_ASSERT_EQUAL(std::size_t(OperatorStatistics::NUM_BUCKETS), 
+                                 statistics.histogram().size());
+        }
+        
+        void OperatorStatisticsTest::testBucket()
+        {
+            CPPUNIT_ASSERT_EQUAL(0u, OperatorStatistics::bucket(0));
+            CPPUNIT_ASSERT_EQUAL(0u, OperatorStatistics::bucket(1));
+            CPPUNIT_ASSERT_EQUAL(1u, OperatorStatistics::bucket(2));
+            CPPUNIT_ASSERT_EQUAL(1u, OperatorStatistics::bucket(3));
+            CPPUNIT_ASSERT_EQUAL(2u, OperatorStatistics::bucket(4));
+            CPPUNIT_ASSERT_EQUAL(9u, OperatorStatistics::bucket(1000));
+            CPPUNIT_ASSERT_EQUAL(OperatorStatistics::NUM_BUCKETS - 1, 
+                                 OperatorStatistics::bucket(uint64_t(-1)));
+        }
+        
+        void OperatorStatisticsTest::testBucketLowerBound()
+        {
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), OperatorStatistics::bucketLowerBound(0));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), OperatorStatistics::bucketLowerBound(1));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(512), OperatorStatistics::bucketLowerBound(9));
+            
+            for(unsigned int i = 0; i < OperatorStatistics::NUM_BUCKETS; ++i)
+                CPPUNIT_ASSERT_EQUAL(i, OperatorStatistics::bucket(OperatorStatistics::bucketLowerBound(i)));
+        }
+        
+        void OperatorStatisticsTest::testBucketLowerBoundOutOfRange()
+        {
+            CPPUNIT_ASSERT_THROW(OperatorStatistics::bucketLowerBound(OperatorStatistics::NUM_BUCKETS),
+                                 WrongArgument);
+        }
+    }
+}
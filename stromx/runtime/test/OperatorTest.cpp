@@ -23,6 +23,7 @@
 #include "stromx/runtime/None.h"
 #include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/OperatorTester.h"
+#include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/test/OperatorTest.h"
 #include "stromx/runtime/test/TestOperator.h"
 
@@ -487,5 +488,177 @@ namespace stromx
             CPPUNIT_ASSERT_THROW(op.getParameter(TestOperator::OUTPUT_1), WrongParameterId);
         }
         
+        void OperatorTest::testStatisticsDisabled()
+        {
+            CPPUNIT_ASSERT(! m_operator->statisticsEnabled());
+            
+            m_operator->setInputData(TestOperator::INPUT_1, m_container);
+            m_operator->setInputData(TestOperator::INPUT_2, m_container);
+            m_operator->getOutputData(TestOperator::OUTPUT_1);
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.executionTime());
+        }
+        
+        void OperatorTest::testStatistics()
+        {
+            m_operator->setStatisticsEnabled(true);
+            setWaitingTime(20);
+            m_operator->getOutputData(TestOperator::OUTPUT_1);
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numErrors());
+            CPPUNIT_ASSERT(statistics.executionTime() >= 20000);
+            CPPUNIT_ASSERT(statistics.executionTime() >= statistics.receiveTime() + statistics.sendTime());
+            
+            const unsigned int bucket = OperatorStatistics::bucket(statistics.executionTime());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.histogram()[bucket]);
+        }
+        
+        void OperatorTest::testStatisticsError()
+        {
+            m_operator->setStatisticsEnabled(true);
+            m_operator->setParameter(TestOperator::THROW_EXCEPTION, Bool(true));
+            
+            CPPUNIT_ASSERT_THROW(m_operator->getOutputData(TestOperator::OUTPUT_1), OperatorError);
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numErrors());
+        }
+        
+        void OperatorTest::testResetStatistics()
+        {
+            m_operator->setStatisticsEnabled(true);
+            m_operator->setInputData(TestOperator::INPUT_1, m_container);
+            m_operator->setInputData(TestOperator::INPUT_2, m_container);
+            m_operator->getOutputData(TestOperator::OUTPUT_1);
+            
+            m_operator->resetStatistics();
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.histogram()[0]);
+        }
+        
+        void OperatorTest::testSetReplication()
+        {
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), m_operator->numReplicas());
+            CPPUNIT_ASSERT_EQUAL(Operator::ROUND_ROBIN, m_operator->dispatch());
+            
+            m_operator->deactivate();
+            m_operator->setReplication(3, Operator::LEAST_LOADED);
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), m_operator->numReplicas());
+            CPPUNIT_ASSERT_EQUAL(Operator::LEAST_LOADED, m_operator->dispatch());
+            CPPUNIT_ASSERT_THROW(m_operator->setReplication(0), WrongArgument);
+        }
+        
+        void OperatorTest::testSetReplicationWrongState()
+        {
+            CPPUNIT_ASSERT_THROW(m_operator->setReplication(2), WrongState);
+        }
+        
+        void OperatorTest::testReplication()
+        {
+            m_operator->deactivate();
+            m_operator->setParameter(TestOperator::SLEEP_TIME, UInt32(50));
+            m_operator->setReplication(3);
+            m_operator->activate();
+            
+            // the input sets are processed in parallel
+            for(unsigned int i = 0; i < 6; ++i)
+            {
+                m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(i)));
+                m_operator->setInputData(TestOperator::INPUT_2, DataContainer(new UInt32(i)));
+            }
+            
+            // and their results are emitted in order
+            for(unsigned int i = 0; i < 6; ++i)
+            {
+                DataContainer data = m_operator->getOutputData(TestOperator::OUTPUT_1);
+                CPPUNIT_ASSERT_EQUAL(UInt32(i), ReadAccess(data).get<UInt32>());
+                m_operator->clearOutputData(TestOperator::OUTPUT_1);
+                m_operator->clearOutputData(TestOperator::OUTPUT_2);
+            }
+            
+            // the kernel of the operator is never executed itself
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), m_testOperator->numExecutes());
+        }
+        
+        void OperatorTest::testReplicationError()
+        {
+            m_operator->deactivate();
+            m_operator->setReplication(2);
+            m_operator->activate();
+            m_operator->setStatisticsEnabled(true);
+            m_operator->setParameter(TestOperator::THROW_EXCEPTION, Bool(true));
+            
+            m_operator->setInputData(TestOperator::INPUT_1, m_container);
+            m_operator->setInputData(TestOperator::INPUT_2, m_container);
+            CPPUNIT_ASSERT_THROW(m_operator->getOutputData(TestOperator::OUTPUT_1), OperatorError);
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numExecutions());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numErrors());
+        }
+        
+        void OperatorTest::testOverflowPolicy()
+        {
+            CPPUNIT_ASSERT_EQUAL(Input::BLOCK, m_operator->overflowPolicy(TestOperator::INPUT_1));
+            
+            m_operator->setOverflowPolicy(TestOperator::INPUT_1, Input::DROP_OLDEST);
+            
+            CPPUNIT_ASSERT_EQUAL(Input::DROP_OLDEST, m_operator->overflowPolicy(TestOperator::INPUT_1));
+            CPPUNIT_ASSERT_EQUAL(Input::BLOCK, m_operator->overflowPolicy(TestOperator::INPUT_2));
+        }
+        
+        void OperatorTest::testSetOverflowPolicyWrongId()
+        {
+            CPPUNIT_ASSERT_THROW(m_operator->setOverflowPolicy(TestOperator::OUTPUT_1, Input::DROP_NEWEST), WrongId);
+        }
+        
+        void OperatorTest::testDropNewest()
+        {
+            m_operator->setOverflowPolicy(TestOperator::INPUT_1, Input::DROP_NEWEST);
+            
+            m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(1)));
+            CPPUNIT_ASSERT(m_operator->canSetInputData(TestOperator::INPUT_1));
+            
+            // the second data is dropped without blocking
+            m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(2)));
+            m_operator->setInputData(TestOperator::INPUT_2, m_container);
+            
+            DataContainer data = m_operator->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(UInt32(1), ReadAccess(data).get<UInt32>());
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numDroppedData());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.numDroppedData(TestOperator::INPUT_1));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.numDroppedData(TestOperator::INPUT_2));
+        }
+        
+        void OperatorTest::testDropOldest()
+        {
+            m_operator->setOverflowPolicy(TestOperator::INPUT_1, Input::DROP_OLDEST);
+            
+            m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(1)));
+            
+            // the later data replaces the earlier one without blocking
+            m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(2)));
+            m_operator->setInputData(TestOperator::INPUT_1, DataContainer(new UInt32(3)));
+            m_operator->setInputData(TestOperator::INPUT_2, m_container);
+            
+            DataContainer data = m_operator->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(UInt32(3), ReadAccess(data).get<UInt32>());
+            
+            OperatorStatistics statistics = m_operator->statistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistics.numDroppedData(TestOperator::INPUT_1));
+            
+            m_operator->resetStatistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), m_operator->statistics().numDroppedData());
+        }
     }
 }
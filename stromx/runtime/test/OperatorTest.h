@@ -57,6 +57,18 @@ namespace stromx
             CPPUNIT_TEST (testSetConnectorTypeInput);
             CPPUNIT_TEST (testSetConnectorTypeOutput);
             CPPUNIT_TEST (testSetConnectorTypeParameter);
+            CPPUNIT_TEST (testStatisticsDisabled);
+            CPPUNIT_TEST (testStatistics);
+            CPPUNIT_TEST (testStatisticsError);
+            CPPUNIT_TEST (testResetStatistics);
+            CPPUNIT_TEST (testSetReplication);
+            CPPUNIT_TEST (testSetReplicationWrongState);
+            CPPUNIT_TEST (testReplication);
+            CPPUNIT_TEST (testReplicationError);
+            CPPUNIT_TEST (testOverflowPolicy);
+            CPPUNIT_TEST (testSetOverflowPolicyWrongId);
+            CPPUNIT_TEST (testDropNewest);
+            CPPUNIT_TEST (testDropOldest);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -90,6 +102,18 @@ namespace stromx
             void testSetConnectorTypeInput();
             void testSetConnectorTypeOutput();
             void testSetConnectorTypeParameter();
+            void testStatisticsDisabled();
+            void testStatistics();
+            void testStatisticsError();
+            void testResetStatistics();
+            void testSetReplication();
+            void testSetReplicationWrongState();
+            void testReplication();
+            void testReplicationError();
+            void testOverflowPolicy();
+            void testSetOverflowPolicyWrongId();
+            void testDropNewest();
+            void testDropOldest();
                 
         private:
             class TestObserver : public ConnectorObserver
@@ -14,8 +14,12 @@
 *  limitations under the License.
 */
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include <cppunit/TestAssert.h>
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/OperatorTester.h"
 #include "stromx/runtime/Primitive.h"
 #include "stromx/runtime/Queue.h"
@@ -55,6 +59,136 @@ namespace stromx
             CPPUNIT_ASSERT_EQUAL(&ReadAccess(input1).get(), &ReadAccess(output1).get());
         }    
 
+        void QueueTest::testExecuteRing()
+        {
+            OperatorTester op(new Queue());
+            op.initialize();
+            op.setParameter(Queue::SIZE, UInt32(2));
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            op.activate();
+            
+            DataContainer input1(new UInt8);
+            DataContainer input2(new UInt8);
+            
+            op.setInputData(Queue::INPUT, input1);
+            op.setInputData(Queue::INPUT, input2);
+            
+            DataContainer output1 = op.getOutputData(Queue::OUTPUT);
+            CPPUNIT_ASSERT_EQUAL(input1, output1);
+            op.clearOutputData(Queue::OUTPUT);
+            
+            DataContainer output2 = op.getOutputData(Queue::OUTPUT);
+            CPPUNIT_ASSERT_EQUAL(input2, output2);
+            op.clearOutputData(Queue::OUTPUT);
+            
+            DataRef mode = op.getParameter(Queue::MODE);
+            CPPUNIT_ASSERT_EQUAL(Enum(Queue::RING), data_cast<Enum>(mode));
+            
+            op.deactivate();
+        }
+        
+        namespace
+        {
+            void pushData(OperatorTester* op, const std::vector<DataContainer>* data)
+            {
+                for(std::vector<DataContainer>::const_iterator iter = data->begin();
+                    iter != data->end();
+                    ++iter)
+                {
+                    op->setInputData(Queue::INPUT, *iter);
+                }
+            }
+            
+            void waitForData(OperatorTester* op, bool* deactivated)
+            {
+                try
+                {
+                    op->getOutputData(Queue::OUTPUT);
+                }
+                catch(WrongOperatorState &)
+                {
+                    *deactivated = true;
+                }
+            }
+        }
+        
+        void QueueTest::testRingThreads()
+        {
+            OperatorTester op(new Queue());
+            op.initialize();
+            op.setParameter(Queue::SIZE, UInt32(4));
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            op.activate();
+            
+            std::vector<DataContainer> input;
+            for(unsigned int i = 0; i < 1000; ++i)
+                input.push_back(DataContainer(new UInt32(i)));
+            
+            // the producer blocks whenever the ring is full
+            boost::thread producer(boost::bind(&pushData, &op, &input));
+            
+            for(unsigned int i = 0; i < input.size(); ++i)
+            {
+                DataContainer output = op.getOutputData(Queue::OUTPUT);
+                CPPUNIT_ASSERT_EQUAL(input[i], output);
+                op.clearOutputData(Queue::OUTPUT);
+            }
+            
+            producer.join();
+            op.deactivate();
+        }
+
+        void QueueTest::testRingOverflowPolicy()
+        {
+            OperatorTester op(new Queue());
+            op.initialize();
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            CPPUNIT_ASSERT_THROW(op.setOverflowPolicy(Queue::INPUT, Input::DROP_NEWEST), WrongArgument);
+            
+            // the policy is checked again if the mode changes before the activation
+            op.setParameter(Queue::MODE, Enum(Queue::DEQUE));
+            op.setOverflowPolicy(Queue::INPUT, Input::DROP_OLDEST);
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            CPPUNIT_ASSERT_THROW(op.activate(), WrongOperatorState);
+            CPPUNIT_ASSERT_EQUAL(Operator::INITIALIZED, op.status());
+        }
+        
+        void QueueTest::testRingDeactivate()
+        {
+            OperatorTester op(new Queue());
+            op.initialize();
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            op.activate();
+            
+            bool deactivated = false;
+            boost::thread consumer(boost::bind(&waitForData, &op, &deactivated));
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            
+            // the waiting consumer must not access the deleted channel
+            op.deactivate();
+            consumer.join();
+            CPPUNIT_ASSERT(deactivated);
+        }
+        
+        void QueueTest::testRingStatistics()
+        {
+            OperatorTester op(new Queue());
+            op.initialize();
+            op.setParameter(Queue::MODE, Enum(Queue::RING));
+            op.setStatisticsEnabled(true);
+            op.activate();
+            
+            bool deactivated = false;
+            boost::thread consumer(boost::bind(&waitForData, &op, &deactivated));
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            op.setInputData(Queue::INPUT, DataContainer(new UInt32(0)));
+            consumer.join();
+            
+            CPPUNIT_ASSERT(! deactivated);
+            CPPUNIT_ASSERT(op.statistics().receiveTime() > 0);
+            op.deactivate();
+        }
+
         void QueueTest::tearDown ( void )
         {
             delete m_operator;
@@ -34,6 +34,11 @@ namespace stromx
         {
             CPPUNIT_TEST_SUITE (QueueTest);
             CPPUNIT_TEST (testExecute);
+            CPPUNIT_TEST (testExecuteRing);
+            CPPUNIT_TEST (testRingThreads);
+            CPPUNIT_TEST (testRingOverflowPolicy);
+            CPPUNIT_TEST (testRingDeactivate);
+            CPPUNIT_TEST (testRingStatistics);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -44,6 +49,11 @@ namespace stromx
 
             protected:
                 void testExecute();
+                void testExecuteRing();
+                void testRingThreads();
+                void testRingOverflowPolicy();
+                void testRingDeactivate();
+                void testRingStatistics();
                 
             private:
                 runtime::OperatorTester* m_operator;
@@ -0,0 +1,181 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/test/RecordLogTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/RecordLog.h"
+#include "stromx/runtime/impl/WireFormat.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::RecordLogTest);
+
+namespace
+{
+    using namespace stromx::runtime::impl;
+    
+    void appendEntry(RecordLog & log, const uint64_t timestamp, const std::string & text)
+    {
+        SerializationHeader header;
+        header.package = "runtime";
+        header.type = "String";
+        
+        std::vector<char> headerData;
+        WireFormat::writeHeader(header, headerData);
+        
+        WireFormat::Preamble preamble;
+        preamble.headerSize = headerData.size();
+        preamble.textSize = text.size();
+        preamble.fileSize = 0;
+        
+        char* entry = log.append(RecordLog::TIMESTAMP_SIZE + WireFormat::PREAMBLE_SIZE 
+                                 + headerData.size() + text.size());
+        RecordLog::writeTimestamp(timestamp, entry);
+        entry += RecordLog::TIMESTAMP_SIZE;
+        WireFormat::writePreamble(preamble, entry);
+        entry += WireFormat::PREAMBLE_SIZE;
+        std::memcpy(entry, &headerData[0], headerData.size());
+        entry += headerData.size();
+        std::memcpy(entry, text.c_str(), text.size());
+    }
+    
+    unsigned int numEntries(const std::string & path)
+    {
+        RecordLogReader reader(path);
+        RecordLogReader::Entry entry;
+        unsigned int num = 0;
+        while(reader.next(entry))
+            ++num;
+        
+        return num;
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using impl::RecordLog;
+        using impl::RecordLogReader;
+        
+        void RecordLogTest::testAppend()
+        {
+            const std::string path = "RecordLogTest_testAppend";
+            {
+                RecordLog log(path, 1024);
+                appendEntry(log, 10, "first");
+                appendEntry(log, 20, "second");
+            }
+            
+            RecordLogReader reader(RecordLog::segmentPath(path, 0));
+            RecordLogReader::Entry entry;
+            
+            CPPUNIT_ASSERT(reader.next(entry));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(10), entry.timestamp);
+            CPPUNIT_ASSERT_EQUAL(std::string("runtime"), entry.header.package);
+            CPPUNIT_ASSERT_EQUAL(std::string("String"), entry.header.type);
+            CPPUNIT_ASSERT_EQUAL(std::string("first"), std::string(entry.text, entry.textSize));
+            CPPUNIT_ASSERT_EQUAL(std::size_t(0), entry.fileSize);
+            
+            CPPUNIT_ASSERT(reader.next(entry));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(20), entry.timestamp);
+            CPPUNIT_ASSERT_EQUAL(std::string("second"), std::string(entry.text, entry.textSize));
+            
+            CPPUNIT_ASSERT(! reader.next(entry));
+        }
+        
+        void RecordLogTest::testAppendNewSegment()
+        {
+            const std::string path = "RecordLogTest_testAppendNewSegment";
+            const std::string text(300, 'x');
+            unsigned int numSegments = 0;
+            {
+                RecordLog log(path, 1024);
+                for(unsigned int i = 0; i < 5; ++i)
+                    appendEntry(log, i, text);
+                numSegments = log.numSegments();
+            }
+            
+            CPPUNIT_ASSERT(numSegments > 1);
+            unsigned int num = 0;
+            for(unsigned int i = 0; i < numSegments; ++i)
+                num += numEntries(RecordLog::segmentPath(path, i));
+            CPPUNIT_ASSERT_EQUAL(5u, num);
+            
+            // the segments are truncated to their entries
+            CPPUNIT_ASSERT(boost::filesystem::file_size(RecordLog::segmentPath(path, 0)) < 1024);
+        }
+        
+        void RecordLogTest::testRemoveSegments()
+        {
+            const std::string path = "RecordLogTest_testRemoveSegments";
+            const std::string text(300, 'x');
+            {
+                RecordLog log(path, 1024);
+                for(unsigned int i = 0; i < 5; ++i)
+                    appendEntry(log, i, text);
+                CPPUNIT_ASSERT(log.numSegments() > 1);
+            }
+            
+            // the segments of the previous log are removed
+            {
+                RecordLog log(path, 1024);
+                appendEntry(log, 10, "first");
+            }
+            
+            CPPUNIT_ASSERT_EQUAL(1u, numEntries(RecordLog::segmentPath(path, 0)));
+            CPPUNIT_ASSERT(! boost::filesystem::exists(RecordLog::segmentPath(path, 1)));
+        }
+        
+        void RecordLogTest::testAppendLargeEntry()
+        {
+            const std::string path = "RecordLogTest_testAppendLargeEntry";
+            const std::string text(4096, 'x');
+            {
+                RecordLog log(path, 1024);
+                appendEntry(log, 1, "small");
+                appendEntry(log, 2, text);
+                appendEntry(log, 3, "small");
+            }
+            
+            RecordLogReader reader(RecordLog::segmentPath(path, 1));
+            RecordLogReader::Entry entry;
+            
+            CPPUNIT_ASSERT(reader.next(entry));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), entry.timestamp);
+            CPPUNIT_ASSERT_EQUAL(text, std::string(entry.text, entry.textSize));
+            CPPUNIT_ASSERT(! reader.next(entry));
+            
+            CPPUNIT_ASSERT_EQUAL(1u, numEntries(RecordLog::segmentPath(path, 2)));
+        }
+        
+        void RecordLogTest::testReadInvalidFile()
+        {
+            const std::string path = "RecordLogTest_testReadInvalidFile";
+            {
+                std::ofstream out(path.c_str());
+                out << "no record log";
+            }
+            
+            CPPUNIT_ASSERT_THROW(RecordLogReader reader(path), InvalidFileFormat);
+        }
+    }
+}
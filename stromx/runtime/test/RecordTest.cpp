@@ -0,0 +1,159 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Metadata.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/OperatorTester.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/Record.h"
+#include "stromx/runtime/String.h"
+#include "stromx/runtime/WriteAccess.h"
+#include "stromx/runtime/impl/RecordLog.h"
+#include "stromx/runtime/impl/RecordWriter.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+#include "stromx/runtime/test/RecordTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::RecordTest);
+
+namespace stromx
+{
+    using namespace runtime;
+    
+    namespace runtime
+    {
+        using impl::RecordLog;
+        using impl::RecordLogReader;
+        
+        void RecordTest::setUp()
+        {
+            m_operator = new OperatorTester(new Record());
+            m_operator->initialize();
+            m_operator->setParameter(Record::PATH, String("RecordTest"));
+            m_operator->setParameter(Record::SEGMENT_SIZE, UInt32(4096));
+            m_operator->activate();
+        }
+        
+        void RecordTest::testExecute()
+        {
+            const uint64_t start = Metadata::currentTime();
+            for(unsigned int i = 0; i < 3; ++i)
+                m_operator->setInputData(Record::INPUT, DataContainer(new UInt32(i)));
+            m_operator->deactivate();
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(3), statistic(Record::RECORDED_FRAMES));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(Record::DROPPED_FRAMES));
+            
+            RecordLogReader reader(RecordLog::segmentPath("RecordTest", 0));
+            RecordLogReader::Entry entry;
+            for(unsigned int i = 0; i < 3; ++i)
+            {
+                CPPUNIT_ASSERT(reader.next(entry));
+                CPPUNIT_ASSERT(entry.timestamp >= start);
+                CPPUNIT_ASSERT_EQUAL(std::string("UInt32"), entry.header.type);
+                CPPUNIT_ASSERT_EQUAL(std::string(1, char('0' + i)), std::string(entry.text, entry.textSize));
+            }
+            CPPUNIT_ASSERT(! reader.next(entry));
+        }
+        
+        void RecordTest::testExecuteMatrix()
+        {
+            MatrixImpl* matrix = new MatrixImpl(2, 3, Matrix::UINT_8);
+            for(unsigned int i = 0; i < 6; ++i)
+                matrix->data()[i] = uint8_t(i);
+            
+            m_operator->setInputData(Record::INPUT, DataContainer(matrix));
+            m_operator->deactivate();
+            
+            RecordLogReader reader(RecordLog::segmentPath("RecordTest", 0));
+            RecordLogReader::Entry entry;
+            
+            CPPUNIT_ASSERT(reader.next(entry));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(impl::SerializationHeader::RAW_MATRIX), entry.header.payload);
+            CPPUNIT_ASSERT_EQUAL(2u, entry.header.rows);
+            CPPUNIT_ASSERT_EQUAL(3u, entry.header.cols);
+            CPPUNIT_ASSERT_EQUAL(std::size_t(6), entry.fileSize);
+            for(unsigned int i = 0; i < 6; ++i)
+                CPPUNIT_ASSERT_EQUAL(char(i), entry.file[i]);
+        }
+        
+        void RecordTest::testActivate()
+        {
+            m_operator->setInputData(Record::INPUT, DataContainer(new UInt32(1)));
+            m_operator->deactivate();
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistic(Record::RECORDED_FRAMES));
+            CPPUNIT_ASSERT(statistic(Record::RECORDED_BYTES) > 0);
+            
+            m_operator->activate();
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(Record::RECORDED_FRAMES));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistic(Record::RECORDED_BYTES));
+        }
+        
+        void RecordTest::testActivateFails()
+        {
+            m_operator->deactivate();
+            m_operator->setParameter(Record::PATH, String("RecordTest_missing/RecordTest"));
+            
+            CPPUNIT_ASSERT_THROW(m_operator->activate(), OperatorError);
+        }
+        
+        void RecordTest::testWriteStopped()
+        {
+            impl::RecordWriter writer("RecordTest_testWriteStopped", 4096, 1, OutputProvider::DEFAULT);
+            writer.stop();
+            
+            CPPUNIT_ASSERT(! writer.write(DataContainer(new UInt32(1)), 0));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), writer.statistics().droppedFrames);
+        }
+        
+        void RecordTest::testDropFrames()
+        {
+            m_operator->deactivate();
+            m_operator->setParameter(Record::QUEUE_SIZE, UInt32(1));
+            m_operator->activate();
+            
+            DataContainer blocked(new UInt32(0));
+            {
+                // the writer waits for a read access to the first input while
+                // it remains in the queue
+                WriteAccess access(blocked);
+                m_operator->setInputData(Record::INPUT, blocked);
+                m_operator->setInputData(Record::INPUT, DataContainer(new UInt32(1)));
+                m_operator->setInputData(Record::INPUT, DataContainer(new UInt32(2)));
+                
+                CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistic(Record::DROPPED_FRAMES));
+            }
+            m_operator->deactivate();
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistic(Record::RECORDED_FRAMES));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), statistic(Record::DROPPED_FRAMES));
+        }
+        
+        uint64_t RecordTest::statistic(const unsigned int id)
+        {
+            return data_cast<UInt64>(m_operator->getParameter(id));
+        }
+        
+        void RecordTest::tearDown()
+        {
+            delete m_operator;
+        }
+    }
+}
@@ -242,5 +242,26 @@ namespace stromx
             delete data1;
             delete data2;
         }
+        
+        void RecycleAccessTest::testTryGet()
+        {
+            Data* data = new TestData();
+            
+            RecycleAccess access;
+            CPPUNIT_ASSERT_EQUAL((Data*)(0), access.tryGet());
+            
+            DataContainer container = DataContainer(data);
+            access.add(container);
+            
+            // the data is still referenced by the container
+            CPPUNIT_ASSERT_EQUAL((Data*)(0), access.tryGet());
+            CPPUNIT_ASSERT(! access.empty());
+            
+            container = DataContainer();
+            CPPUNIT_ASSERT_EQUAL(data, access.tryGet());
+            CPPUNIT_ASSERT_EQUAL((Data*)(0), access.tryGet());
+            
+            delete data;
+        }
     }
 }
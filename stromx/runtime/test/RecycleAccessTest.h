@@ -44,6 +44,7 @@ namespace stromx
             CPPUNIT_TEST(testAdd);
             CPPUNIT_TEST(testRecycleMultiple);
             CPPUNIT_TEST(testEmpty);
+            CPPUNIT_TEST(testTryGet);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -66,6 +67,7 @@ namespace stromx
             void testAdd();
             void testRecycleMultiple();
             void testEmpty();
+            void testTryGet();
             
         private:
             void destroyDelayed(DataContainer & container);
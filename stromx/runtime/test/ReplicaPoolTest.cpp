@@ -0,0 +1,215 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/test/ReplicaPoolTest.h"
+#include "stromx/runtime/test/TestOperator.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::ReplicaPoolTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using namespace impl;
+        
+        void ReplicaPoolTest::setUp()
+        {
+            m_prototype = new TestOperator;
+            m_prototype->initialize();
+            m_prototype->activate();
+            m_numFinished = 0;
+        }
+        
+        void ReplicaPoolTest::tearDown()
+        {
+            delete m_prototype;
+        }
+        
+        void ReplicaPoolTest::testConstructor()
+        {
+            ReplicaPool pool(*m_prototype, 3, ReplicaPool::ROUND_ROBIN, m_factory,
+                             boost::bind(&ReplicaPoolTest::finished, this));
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), pool.size());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), pool.numPending());
+        }
+        
+        void ReplicaPoolTest::testConstructorZeroReplicas()
+        {
+            CPPUNIT_ASSERT_THROW(createPool(0, ReplicaPool::ROUND_ROBIN), WrongArgument);
+        }
+        
+        void ReplicaPoolTest::testSubmitRoundRobin()
+        {
+            submitAndTake(ReplicaPool::ROUND_ROBIN);
+        }
+        
+        void ReplicaPoolTest::testSubmitLeastLoaded()
+        {
+            submitAndTake(ReplicaPool::LEAST_LOADED);
+        }
+        
+        void ReplicaPoolTest::testResultOrder()
+        {
+            ReplicaPool* pool = createPool(2, ReplicaPool::ROUND_ROBIN);
+            
+            // the first replica executes slowly
+            pool->setParameter(TestOperator::SLEEP_TIME, UInt32(300));
+            submit(*pool, 0);
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+            
+            // the second one fast
+            pool->setParameter(TestOperator::SLEEP_TIME, UInt32(0));
+            submit(*pool, 1);
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            
+            // the second result is held back until the first one is available
+            ReplicaPool::Result result;
+            CPPUNIT_ASSERT(! pool->tryTakeResult(result));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), pool->numPending());
+            
+            result = takeResult(*pool);
+            CPPUNIT_ASSERT_EQUAL(UInt32(0), output(result, TestOperator::OUTPUT_1));
+            
+            result = takeResult(*pool);
+            CPPUNIT_ASSERT_EQUAL(UInt32(1), output(result, TestOperator::OUTPUT_1));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), pool->numPending());
+            
+            delete pool;
+        }
+        
+        void ReplicaPoolTest::testCopyParameters()
+        {
+            m_prototype->setParameter(TestOperator::THROW_EXCEPTION, Bool(true));
+            ReplicaPool* pool = createPool(2, ReplicaPool::ROUND_ROBIN);
+            
+            submit(*pool, 0);
+            ReplicaPool::Result result = takeResult(*pool);
+            
+            CPPUNIT_ASSERT(result.failed);
+            CPPUNIT_ASSERT_EQUAL(std::string("Funny exception."), result.message);
+            CPPUNIT_ASSERT(result.outputs.empty());
+            
+            delete pool;
+        }
+        
+        void ReplicaPoolTest::testSetParameter()
+        {
+            ReplicaPool* pool = createPool(2, ReplicaPool::ROUND_ROBIN);
+            
+            submit(*pool, 0);
+            CPPUNIT_ASSERT(! takeResult(*pool).failed);
+            
+            pool->setParameter(TestOperator::THROW_EXCEPTION, Bool(true));
+            submit(*pool, 1);
+            submit(*pool, 2);
+            CPPUNIT_ASSERT(takeResult(*pool).failed);
+            CPPUNIT_ASSERT(takeResult(*pool).failed);
+            
+            delete pool;
+        }
+        
+        void ReplicaPoolTest::testOnFinished()
+        {
+            ReplicaPool* pool = createPool(2, ReplicaPool::ROUND_ROBIN);
+            
+            for(unsigned int i = 0; i < 4; ++i)
+                submit(*pool, i);
+            
+            for(unsigned int i = 0; i < 4; ++i)
+                takeResult(*pool);
+            
+            // the callback is called after the result has been stored
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(4), m_numFinished);
+            
+            delete pool;
+        }
+        
+        ReplicaPool* ReplicaPoolTest::createPool(const unsigned int numReplicas,
+                                                 const impl::ReplicaPool::Dispatch dispatch)
+        {
+            return new ReplicaPool(*m_prototype, numReplicas, dispatch, m_factory,
+                                   boost::bind(&ReplicaPoolTest::finished, this));
+        }
+        
+        void ReplicaPoolTest::submit(ReplicaPool & pool, const unsigned int value)
+        {
+            const unsigned int ids[] = {TestOperator::INPUT_1, TestOperator::INPUT_2};
+            
+            ReplicaPool::DataMap inputs;
+            for(unsigned int i = 0; i < 2; ++i)
+                inputs[ids[i]] = DataContainer(new UInt32(value));
+            pool.submit(inputs);
+        }
+        
+        ReplicaPool::Result ReplicaPoolTest::takeResult(ReplicaPool & pool)
+        {
+            ReplicaPool::Result result;
+            
+            // give up after 2 seconds
+            bool available = false;
+            for(unsigned int i = 0; i < 200 && ! available; ++i)
+            {
+                available = pool.tryTakeResult(result);
+                if(! available)
+                    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+            }
+            
+            CPPUNIT_ASSERT(available);
+            return result;
+        }
+        
+        UInt32 ReplicaPoolTest::output(const ReplicaPool::Result & result, const unsigned int id)
+        {
+            ReplicaPool::DataMap::const_iterator iter = result.outputs.find(id);
+            CPPUNIT_ASSERT(iter != result.outputs.end());
+            
+            return ReadAccess(iter->second).get<UInt32>();
+        }
+        
+        void ReplicaPoolTest::submitAndTake(const impl::ReplicaPool::Dispatch dispatch)
+        {
+            ReplicaPool* pool = createPool(3, dispatch);
+            
+            for(unsigned int i = 0; i < 10; ++i)
+                submit(*pool, i);
+            
+            for(unsigned int i = 0; i < 10; ++i)
+            {
+                ReplicaPool::Result result = takeResult(*pool);
+                CPPUNIT_ASSERT(! result.failed);
+                CPPUNIT_ASSERT_EQUAL(UInt32(i), output(result, TestOperator::OUTPUT_1));
+                CPPUNIT_ASSERT_EQUAL(UInt32(i), output(result, TestOperator::OUTPUT_2));
+            }
+            
+            delete pool;
+        }
+        
+        void ReplicaPoolTest::finished()
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            ++m_numFinished;
+        }
+    }
+}
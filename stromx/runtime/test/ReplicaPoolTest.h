@@ -0,0 +1,79 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_REPLICAPOOLTEST_H
+#define STROMX_RUNTIME_REPLICAPOOLTEST_H
+
+#include <boost/thread/mutex.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include "stromx/runtime/Factory.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/impl/ReplicaPool.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class TestOperator;
+        
+        class ReplicaPoolTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (ReplicaPoolTest);
+            CPPUNIT_TEST(testConstructor);
+            CPPUNIT_TEST(testConstructorZeroReplicas);
+            CPPUNIT_TEST(testSubmitRoundRobin);
+            CPPUNIT_TEST(testSubmitLeastLoaded);
+            CPPUNIT_TEST(testResultOrder);
+            CPPUNIT_TEST(testCopyParameters);
+            CPPUNIT_TEST(testSetParameter);
+            CPPUNIT_TEST(testOnFinished);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+            ReplicaPoolTest() : m_prototype(0), m_numFinished(0) {}
+            
+            void setUp();
+            void tearDown();
+        
+        protected:
+            void testConstructor();
+            void testConstructorZeroReplicas();
+            void testSubmitRoundRobin();
+            void testSubmitLeastLoaded();
+            void testResultOrder();
+            void testCopyParameters();
+            void testSetParameter();
+            void testOnFinished();
+            
+        private:
+            impl::ReplicaPool* createPool(const unsigned int numReplicas,
+                                          const impl::ReplicaPool::Dispatch dispatch);
+            void submit(impl::ReplicaPool & pool, const unsigned int value);
+            impl::ReplicaPool::Result takeResult(impl::ReplicaPool & pool);
+            UInt32 output(const impl::ReplicaPool::Result & result, const unsigned int id);
+            void submitAndTake(const impl::ReplicaPool::Dispatch dispatch);
+            void finished();
+            
+            TestOperator* m_prototype;
+            Factory m_factory;
+            boost::mutex m_mutex;
+            unsigned int m_numFinished;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_REPLICAPOOLTEST_H
@@ -15,6 +15,7 @@
 */
 
 #include <cppunit/TestAssert.h>
+#include <boost/asio.hpp>
 #include <boost/thread.hpp>
 
 #include "stromx/runtime/Factory.h"
@@ -39,6 +40,27 @@ namespace stromx
             {
                 CPPUNIT_ASSERT_THROW(op->getOutputData(Receive::OUTPUT), Interrupt);
             }
+            
+            // returns the first port which is not in use starting from the 
+            // smallest port accepted by the send operator
+            unsigned int freePort()
+            {
+                using namespace boost::asio;
+                
+                io_service ioService;
+                for (unsigned int port = 49152; port < 65535; ++port)
+                {
+                    ip::tcp::acceptor acceptor(ioService);
+                    boost::system::error_code error;
+                    acceptor.open(ip::tcp::v4(), error);
+                    acceptor.set_option(ip::tcp::acceptor::reuse_address(true), error);
+                    acceptor.bind(ip::tcp::endpoint(ip::tcp::v4(), port), error);
+                    if (! error)
+                        return port;
+                }
+                
+                return 0;
+            }
         }
         
         void SendReceiveTest::setUp ( void )
@@ -51,9 +73,10 @@ namespace stromx
             m_send->initialize();
             m_receive->initialize();
             
-            m_send->setParameter(Send::PORT, UInt16(49152));
+            const UInt16 port(freePort());
+            m_send->setParameter(Send::PORT, port);
             m_receive->setParameter(Receive::URL, String("localhost"));
-            m_receive->setParameter(Receive::PORT, UInt16(49152));
+            m_receive->setParameter(Receive::PORT, port);
             
             m_send->activate();
             m_receive->activate();
@@ -66,11 +89,32 @@ namespace stromx
             
             m_factory->registerData(new UInt32);
             DataContainer out = m_receive->getOutputData(Receive::OUTPUT);
-            ReadAccess<UInt32> access(out);
+            ReadAccess access(out);
             
-            CPPUNIT_ASSERT_EQUAL(UInt32(2), access());
+            CPPUNIT_ASSERT_EQUAL(UInt32(2), access.get<UInt32>());
         }   
         
+        void SendReceiveTest::testSendMultipleData()
+        {
+            m_factory->registerData(new UInt32);
+            for (unsigned int i = 0; i < 5; ++i)
+                m_send->setInputData(Send::INPUT, DataContainer(new UInt32(i)));
+            
+            // the send operator blocks instead of dropping data by default
+            for (unsigned int i = 0; i < 5; ++i)
+            {
+                DataContainer out = m_receive->getOutputData(Receive::OUTPUT);
+                CPPUNIT_ASSERT_EQUAL(UInt32(i), ReadAccess(out).get<UInt32>());
+                m_receive->clearOutputData(Receive::OUTPUT);
+            }
+        }
+        
+        void SendReceiveTest::testQueuePolicyDefault()
+        {
+            CPPUNIT_ASSERT_EQUAL(Enum(Send::BLOCKING), 
+                                 data_cast<Enum>(m_send->getParameter(Send::QUEUE_POLICY)));
+        }
+        
         void SendReceiveTest::testInterrupt()
         {
             boost::thread receive(boost::bind(&getOutputData, m_receive));
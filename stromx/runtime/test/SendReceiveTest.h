@@ -31,6 +31,8 @@ namespace stromx
         {
             CPPUNIT_TEST_SUITE (SendReceiveTest);
             CPPUNIT_TEST (testSendUInt32);
+            CPPUNIT_TEST (testSendMultipleData);
+            CPPUNIT_TEST (testQueuePolicyDefault);
             CPPUNIT_TEST (testInterrupt);
             CPPUNIT_TEST_SUITE_END ();
 
@@ -42,6 +44,8 @@ namespace stromx
 
             protected:
                 void testSendUInt32();
+                void testSendMultipleData();
+                void testQueuePolicyDefault();
                 void testInterrupt();
                 
             private:
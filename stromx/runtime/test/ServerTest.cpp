@@ -21,13 +21,20 @@
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/thread.hpp>
 
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Factory.h"
 #include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/ReadAccess.h"
 #include <stromx/runtime/impl/SerializationHeader.h>
+#include "stromx/runtime/impl/Client.h"
 #include "stromx/runtime/impl/Server.h"
+#include "stromx/runtime/impl/SharedMemoryRing.h"
+#include "stromx/runtime/impl/WireFormat.h"
+#include "stromx/runtime/test/MatrixImpl.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::ServerTest);
 
@@ -39,10 +46,12 @@ namespace stromx
         {
             using namespace boost::asio;
             
-            void connectToServer(io_service & ioService, ip::tcp::socket & socket)
+            const std::string SHARED_MEMORY = "stromx_ServerTest";
+            
+            void connectToServer(io_service & ioService, ip::tcp::socket & socket, const unsigned int port)
             {
                 ip::tcp::resolver resolver(ioService);
-                ip::tcp::resolver::query query("localhost", "49152");
+                ip::tcp::resolver::query query("localhost", boost::lexical_cast<std::string>(port));
                 ip::tcp::resolver::iterator endpoint_iterator = resolver.resolve(query);
 
                 boost::asio::connect(socket, endpoint_iterator);
@@ -104,14 +113,67 @@ namespace stromx
                 
                 return header;
             }
+            
+            void sendHello(ip::tcp::socket& socket, const uint32_t flags)
+            {
+                boost::array<char, impl::WireFormat::HELLO_SIZE> hello;
+                impl::WireFormat::writeHello(hello.data(), flags);
+                write(socket, buffer(hello));
+            }
+            
+            const impl::SerializationHeader receiveBinary(ip::tcp::socket& socket)
+            {
+                boost::array<char, impl::WireFormat::PREAMBLE_SIZE> preambleData;
+                read(socket, buffer(preambleData));
+                const impl::WireFormat::Preamble preamble = impl::WireFormat::readPreamble(preambleData.data());
+                
+                std::vector<char> headerData(preamble.headerSize);
+                std::vector<char> payload(preamble.textSize + preamble.fileSize);
+                std::vector<mutable_buffer> dataBuffers;
+                dataBuffers.push_back(buffer(headerData));
+                dataBuffers.push_back(buffer(payload));
+                read(socket, dataBuffers);
+                
+                impl::SerializationHeader header;
+                impl::WireFormat::readHeader(headerData.data(), headerData.size(), header);
+                return header;
+            }
+            
+            const DataContainer matrix(const uint8_t value)
+            {
+                MatrixImpl* matrix = new MatrixImpl(2, 3, Matrix::UINT_8);
+                matrix->at<uint8_t>(1, 2) = value;
+                return DataContainer(matrix);
+            }
+            
+            // a frame which does not fit into the socket buffers, i.e. its write
+            // does not complete before the client reads it
+            const unsigned int LARGE_ROWS = 2048;
+            const unsigned int LARGE_COLS = 8192;
+            
+            const DataContainer largeMatrix(const uint8_t value)
+            {
+                MatrixImpl* matrix = new MatrixImpl(LARGE_ROWS, LARGE_COLS, Matrix::UINT_8);
+                matrix->at<uint8_t>(LARGE_ROWS - 1, LARGE_COLS - 1) = value;
+                return DataContainer(matrix);
+            }
+            
+            uint8_t receiveLargeMatrix(impl::Client & client, const Factory & factory)
+            {
+                DataContainer data = client.receive(factory);
+                return ReadAccess(data).get<Matrix>().at<uint8_t>(LARGE_ROWS - 1, LARGE_COLS - 1);
+            }
+            
+            void sendLargeMatrices(impl::Server* server, const unsigned int numFrames)
+            {
+                for (unsigned int i = 0; i < numFrames; ++i)
+                    server->send(largeMatrix(uint8_t(i)));
+            }
         }
     
         void ServerTest::setUp()
         {
-            m_server = new impl::Server(49152);
-            
-            // wait a bit to increase the chance that the requested socket is available
-            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            m_server = new impl::Server(0);
         }
 
         void ServerTest::tearDown()
@@ -152,7 +214,7 @@ namespace stromx
             ip::tcp::socket socket(ioService);
 
             ip::tcp::resolver resolver(ioService);
-            ip::tcp::resolver::query query("localhost", "49152");
+            ip::tcp::resolver::query query("localhost", boost::lexical_cast<std::string>(m_server->port()));
             ip::tcp::resolver::iterator endpoint_iterator = resolver.resolve(query);
 
             CPPUNIT_ASSERT_NO_THROW(boost::asio::connect(socket, endpoint_iterator));
@@ -163,7 +225,7 @@ namespace stromx
         
         void ServerTest::testConstructorFails()
         {
-            CPPUNIT_ASSERT_THROW(impl::Server(49152), boost::system::system_error);
+            CPPUNIT_ASSERT_THROW(impl::Server(m_server->port()), boost::system::system_error);
         }
         
         void ServerTest::testReceive()
@@ -172,7 +234,7 @@ namespace stromx
             
             io_service ioService;
             ip::tcp::socket socket(ioService);
-            connectToServer(ioService, socket);
+            connectToServer(ioService, socket, m_server->port());
             
             DataContainer data(new UInt32(2));
             m_server->send(data);
@@ -192,7 +254,7 @@ namespace stromx
             
             io_service ioService;
             ip::tcp::socket socket(ioService);
-            connectToServer(ioService, socket);
+            connectToServer(ioService, socket, m_server->port());
             
             DataContainer data2(new UInt32(2));
             DataContainer data10(new UInt32(10));
@@ -214,5 +276,289 @@ namespace stromx
             CPPUNIT_ASSERT_EQUAL(std::string("10"), text);
             CPPUNIT_ASSERT_EQUAL(std::string(), file);
         }
+        
+        void ServerTest::testReceiveMultipleClients()
+        {
+            using namespace boost::asio;
+            
+            io_service ioService;
+            ip::tcp::socket socket1(ioService);
+            ip::tcp::socket socket2(ioService);
+            connectToServer(ioService, socket1, m_server->port());
+            connectToServer(ioService, socket2, m_server->port());
+            m_server->waitForNumConnections(2);
+            
+            DataContainer data(new UInt32(2));
+            m_server->send(data);
+            
+            std::string text;
+            std::string file;
+            impl::SerializationHeader header;
+            
+            header = receive(socket1, text, file);
+            CPPUNIT_ASSERT_EQUAL(uintHeader(), header);
+            CPPUNIT_ASSERT_EQUAL(std::string("2"), text);
+            
+            header = receive(socket2, text, file);
+            CPPUNIT_ASSERT_EQUAL(uintHeader(), header);
+            CPPUNIT_ASSERT_EQUAL(std::string("2"), text);
+        }
+        
+        void ServerTest::testStatistics()
+        {
+            using namespace boost::asio;
+            
+            io_service ioService;
+            ip::tcp::socket socket(ioService);
+            connectToServer(ioService, socket, m_server->port());
+            
+            DataContainer data(new UInt32(2));
+            m_server->send(data);
+            
+            std::string text;
+            std::string file;
+            receive(socket, text, file);
+            
+            // the server counts the frame after the write completed
+            for (unsigned int i = 0; i < 100 && m_server->totalStatistics().sentFrames == 0; ++i)
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+            
+            const impl::ConnectionStatistics statistics = m_server->totalStatistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), statistics.sentFrames);
+            CPPUNIT_ASSERT(statistics.sentBytes > 0);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.droppedFrames);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.droppedBytes);
+        }
+        
+        void ServerTest::testSharedMemoryLocalClient()
+        {
+            startSharedMemoryServer();
+            
+            Factory factory;
+            factory.registerData(new MatrixImpl);
+            impl::Client client("localhost", boost::lexical_cast<std::string>(m_server->port()));
+            CPPUNIT_ASSERT(waitForHello());
+            
+            m_server->send(matrix(5));
+            DataContainer data = client.receive(factory);
+            
+            CPPUNIT_ASSERT_EQUAL(uint8_t(5), ReadAccess(data).get<Matrix>().at<uint8_t>(1, 2));
+            
+            // the client released the slot
+            CPPUNIT_ASSERT_EQUAL(0, waitForSlot());
+        }
+        
+        void ServerTest::testSharedMemoryOtherClient()
+        {
+            startSharedMemoryServer();
+            
+            io_service ioService;
+            ip::tcp::socket socket(ioService);
+            connectToServer(ioService, socket, m_server->port());
+            sendHello(socket, 0);
+            CPPUNIT_ASSERT(! waitForHello());
+            
+            m_server->send(matrix(5));
+            const impl::SerializationHeader header = receiveBinary(socket);
+            
+            CPPUNIT_ASSERT_EQUAL(impl::SerializationHeader::RAW_MATRIX, header.payload);
+            CPPUNIT_ASSERT_EQUAL(0, m_server->m_sharedMemory->acquireSlot());
+        }
+        
+        void ServerTest::testSharedMemoryReleaseByServer()
+        {
+            startSharedMemoryServer();
+            
+            io_service ioService;
+            ip::tcp::socket socket(ioService);
+            connectToServer(ioService, socket, m_server->port());
+            sendHello(socket, impl::WireFormat::SHARED_MEMORY);
+            CPPUNIT_ASSERT(waitForHello());
+            
+            m_server->send(matrix(5));
+            impl::SerializationHeader header = receiveBinary(socket);
+            CPPUNIT_ASSERT_EQUAL(impl::SerializationHeader::SHARED_MATRIX, header.payload);
+            
+            // return the slot as a client which can not open the shared memory
+            boost::array<char, impl::WireFormat::HELLO_SIZE> release;
+            impl::WireFormat::writeRelease(release.data(), header.slot);
+            write(socket, buffer(release));
+            for (unsigned int i = 0; i < 100 && isLocal(); ++i)
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+            
+            CPPUNIT_ASSERT(! isLocal());
+            
+            // the following frames are sent over the socket
+            m_server->send(matrix(6));
+            header = receiveBinary(socket);
+            CPPUNIT_ASSERT_EQUAL(impl::SerializationHeader::RAW_MATRIX, header.payload);
+            CPPUNIT_ASSERT_EQUAL(0, waitForSlot());
+        }
+        
+        void ServerTest::testSharedMemorySlotOwnership()
+        {
+            startSharedMemoryServer();
+            
+            io_service ioService;
+            ip::tcp::socket owner(ioService);
+            connectToServer(ioService, owner, m_server->port());
+            sendHello(owner, impl::WireFormat::SHARED_MEMORY);
+            CPPUNIT_ASSERT(waitForHello());
+            
+            m_server->send(matrix(5));
+            const impl::SerializationHeader header = receiveBinary(owner);
+            CPPUNIT_ASSERT_EQUAL(impl::SerializationHeader::SHARED_MATRIX, header.payload);
+            
+            // a client can not release the slot of another client
+            ip::tcp::socket other(ioService);
+            connectToServer(ioService, other, m_server->port());
+            sendHello(other, 0);
+            m_server->waitForNumConnections(2);
+            
+            boost::array<char, impl::WireFormat::HELLO_SIZE> release;
+            impl::WireFormat::writeRelease(release.data(), header.slot, impl::WireFormat::SLOT_READ);
+            write(other, buffer(release));
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            CPPUNIT_ASSERT_EQUAL(int(impl::SharedMemoryRing::NO_SLOT), m_server->m_sharedMemory->acquireSlot());
+            
+            // the writes to the closed socket fail and the server releases the
+            // slot of the removed connection
+            owner.close();
+            for (unsigned int i = 0; i < 100 && m_server->numConnections() > 1; ++i)
+            {
+                m_server->send(matrix(6));
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+            }
+            
+            CPPUNIT_ASSERT_EQUAL(1u, m_server->numConnections());
+            CPPUNIT_ASSERT_EQUAL(0, waitForSlot());
+        }
+        
+        void ServerTest::testQueuePolicyBlocking()
+        {
+            // blocking is the default policy
+            Factory factory;
+            factory.registerData(new MatrixImpl);
+            impl::Client client("localhost", boost::lexical_cast<std::string>(m_server->port()));
+            waitForHello();
+            
+            // the first frame is written and the second one is queued
+            boost::thread sender(boost::bind(sendLargeMatrices, m_server, 3));
+            CPPUNIT_ASSERT(! sender.try_join_for(boost::chrono::milliseconds(200)));
+            
+            for (unsigned int i = 0; i < 3; ++i)
+                CPPUNIT_ASSERT_EQUAL(uint8_t(i), receiveLargeMatrix(client, factory));
+            
+            sender.join();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), m_server->totalStatistics().droppedFrames);
+        }
+        
+        void ServerTest::testQueuePolicyLatestOnly()
+        {
+            startServer(impl::Server::LATEST_ONLY, 1);
+            
+            Factory factory;
+            factory.registerData(new MatrixImpl);
+            impl::Client client("localhost", boost::lexical_cast<std::string>(m_server->port()));
+            waitForHello();
+            
+            // the second and third frames are replaced by the fourth one
+            sendLargeMatrices(m_server, 4);
+            
+            CPPUNIT_ASSERT_EQUAL(uint8_t(0), receiveLargeMatrix(client, factory));
+            CPPUNIT_ASSERT_EQUAL(uint8_t(3), receiveLargeMatrix(client, factory));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), m_server->totalStatistics().droppedFrames);
+        }
+        
+        void ServerTest::testQueuePolicyBoundedFifo()
+        {
+            startServer(impl::Server::BOUNDED_FIFO, 2);
+            
+            Factory factory;
+            factory.registerData(new MatrixImpl);
+            impl::Client client("localhost", boost::lexical_cast<std::string>(m_server->port()));
+            waitForHello();
+            
+            // the fourth and fifth frames do not fit into the queue
+            sendLargeMatrices(m_server, 5);
+            
+            for (unsigned int i = 0; i < 3; ++i)
+                CPPUNIT_ASSERT_EQUAL(uint8_t(i), receiveLargeMatrix(client, factory));
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(2), m_server->totalStatistics().droppedFrames);
+        }
+        
+        void ServerTest::testQueuePolicyDisconnectSlowClient()
+        {
+            startServer(impl::Server::DISCONNECT_SLOW_CLIENT, 1);
+            
+            impl::Client client("localhost", boost::lexical_cast<std::string>(m_server->port()));
+            waitForHello();
+            
+            // the third frame does not fit into the queue
+            sendLargeMatrices(m_server, 3);
+            m_server->waitForNumConnections(0);
+            
+            const impl::ConnectionStatistics statistics = m_server->totalStatistics();
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.sentFrames);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(3), statistics.droppedFrames);
+        }
+        
+        void ServerTest::startSharedMemoryServer()
+        {
+            stopServer();
+            m_server = new impl::Server(0, new impl::SharedMemoryRing(SHARED_MEMORY, 1, 1024));
+        }
+        
+        void ServerTest::startServer(const impl::Server::QueuePolicy policy, const unsigned int queueSize)
+        {
+            stopServer();
+            m_server = new impl::Server(0, 0, policy, queueSize);
+        }
+        
+        void ServerTest::stopServer()
+        {
+            m_server->stop();
+            m_server->join();
+            delete m_server;
+            m_server = 0;
+        }
+        
+        bool ServerTest::waitForHello()
+        {
+            m_server->waitForNumConnections(1);
+            
+            for (unsigned int i = 0; i < 100; ++i)
+            {
+                {
+                    boost::lock_guard<boost::mutex> l(m_server->m_mutex);
+                    if ((*m_server->m_connections.begin())->binary())
+                        break;
+                }
+                
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+            }
+            
+            return isLocal();
+        }
+        
+        int ServerTest::waitForSlot()
+        {
+            // the clients release their slots asynchronously
+            int slot = m_server->m_sharedMemory->acquireSlot();
+            for (unsigned int i = 0; i < 100 && slot == impl::SharedMemoryRing::NO_SLOT; ++i)
+            {
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+                slot = m_server->m_sharedMemory->acquireSlot();
+            }
+            
+            return slot;
+        }
+        
+        bool ServerTest::isLocal()
+        {
+            boost::lock_guard<boost::mutex> l(m_server->m_mutex);
+            return (*m_server->m_connections.begin())->local();
+        }
     }
 }
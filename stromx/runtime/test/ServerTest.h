@@ -36,7 +36,17 @@ namespace stromx
             CPPUNIT_TEST (testConnectFails);
             CPPUNIT_TEST (testReceive);  
             CPPUNIT_TEST (testReceiveMultipleData);
+            CPPUNIT_TEST (testReceiveMultipleClients);
+            CPPUNIT_TEST (testStatistics);
             CPPUNIT_TEST (testConstructorFails);
+            CPPUNIT_TEST (testSharedMemoryLocalClient);
+            CPPUNIT_TEST (testSharedMemoryOtherClient);
+            CPPUNIT_TEST (testSharedMemoryReleaseByServer);
+            CPPUNIT_TEST (testSharedMemorySlotOwnership);
+            CPPUNIT_TEST (testQueuePolicyBlocking);
+            CPPUNIT_TEST (testQueuePolicyLatestOnly);
+            CPPUNIT_TEST (testQueuePolicyBoundedFifo);
+            CPPUNIT_TEST (testQueuePolicyDisconnectSlowClient);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -51,9 +61,26 @@ namespace stromx
             void testConnectFails();
             void testReceive();
             void testReceiveMultipleData();
+            void testReceiveMultipleClients();
+            void testStatistics();
             void testConstructorFails();
+            void testSharedMemoryLocalClient();
+            void testSharedMemoryOtherClient();
+            void testSharedMemoryReleaseByServer();
+            void testSharedMemorySlotOwnership();
+            void testQueuePolicyBlocking();
+            void testQueuePolicyLatestOnly();
+            void testQueuePolicyBoundedFifo();
+            void testQueuePolicyDisconnectSlowClient();
                 
         private:            
+            void startSharedMemoryServer();
+            void startServer(const impl::Server::QueuePolicy policy, const unsigned int queueSize);
+            void stopServer();
+            bool waitForHello();
+            int waitForSlot();
+            bool isLocal();
+            
             impl::Server* m_server;
         };
     }
@@ -0,0 +1,130 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cstring>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/SharedMemoryRing.h"
+#include "stromx/runtime/test/SharedMemoryRingTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::SharedMemoryRingTest);
+
+namespace
+{
+    const char* NAME = "stromx_SharedMemoryRingTest";
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void SharedMemoryRingTest::setUp()
+        {
+            m_ring = new impl::SharedMemoryRing(NAME, 3, 100);
+        }
+        
+        void SharedMemoryRingTest::testCreate()
+        {
+            CPPUNIT_ASSERT_EQUAL(std::string(NAME), m_ring->name());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), m_ring->numSlots());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(100), m_ring->slotSize());
+        }
+        
+        void SharedMemoryRingTest::testOpen()
+        {
+            impl::SharedMemoryRing ring(NAME);
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), ring.numSlots());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(100), ring.slotSize());
+        }
+        
+        void SharedMemoryRingTest::testOpenNonExisting()
+        {
+            CPPUNIT_ASSERT_THROW(impl::SharedMemoryRing("stromx_SharedMemoryRingTest_none"), WrongArgument);
+        }
+        
+        void SharedMemoryRingTest::testAcquireSlot()
+        {
+            CPPUNIT_ASSERT_EQUAL(0, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(1, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(2, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(int(impl::SharedMemoryRing::NO_SLOT), m_ring->acquireSlot());
+        }
+        
+        void SharedMemoryRingTest::testReleaseSlot()
+        {
+            impl::SharedMemoryRing ring(NAME);
+            
+            m_ring->acquireSlot();
+            m_ring->acquireSlot();
+            m_ring->acquireSlot();
+            
+            // slots are released by the process which opened the ring
+            ring.releaseSlot(1);
+            CPPUNIT_ASSERT_EQUAL(1, m_ring->acquireSlot());
+            
+            // slots are acquired in ring order
+            ring.releaseSlot(0);
+            ring.releaseSlot(2);
+            CPPUNIT_ASSERT_EQUAL(2, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(0, m_ring->acquireSlot());
+        }
+        
+        void SharedMemoryRingTest::testRetainSlot()
+        {
+            impl::SharedMemoryRing ring(NAME);
+            
+            m_ring->acquireSlot();
+            m_ring->retainSlot(0);
+            
+            // the slot is free after the second release
+            ring.releaseSlot(0);
+            CPPUNIT_ASSERT_EQUAL(1, m_ring->acquireSlot());
+            ring.releaseSlot(0);
+            CPPUNIT_ASSERT_EQUAL(2, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(0, m_ring->acquireSlot());
+            
+            // releasing a free slot has no effect
+            ring.releaseSlot(1);
+            ring.releaseSlot(1);
+            CPPUNIT_ASSERT_EQUAL(1, m_ring->acquireSlot());
+            CPPUNIT_ASSERT_EQUAL(impl::SharedMemoryRing::NO_SLOT, m_ring->acquireSlot());
+        }
+        
+        void SharedMemoryRingTest::testSlotData()
+        {
+            impl::SharedMemoryRing ring(NAME);
+            
+            const int slot = m_ring->acquireSlot();
+            std::memset(m_ring->slot(slot), 0xab, 100);
+            
+            CPPUNIT_ASSERT_EQUAL(0xab, int(ring.slot(slot)[0]));
+            CPPUNIT_ASSERT_EQUAL(0xab, int(ring.slot(slot)[99]));
+            CPPUNIT_ASSERT(m_ring->slot(1) >= m_ring->slot(0) + 100);
+        }
+        
+        void SharedMemoryRingTest::testWrongSlot()
+        {
+            CPPUNIT_ASSERT_THROW(m_ring->slot(3), WrongId);
+            CPPUNIT_ASSERT_THROW(m_ring->releaseSlot(3), WrongId);
+        }
+        
+        void SharedMemoryRingTest::tearDown()
+        {
+            delete m_ring;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_SHAREDMEMORYRINGTEST_H
+#define STROMX_RUNTIME_SHAREDMEMORYRINGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace impl
+        {
+            class SharedMemoryRing;
+        }
+        
+        class SharedMemoryRingTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (SharedMemoryRingTest);
+            CPPUNIT_TEST(testCreate);
+            CPPUNIT_TEST(testOpen);
+            CPPUNIT_TEST(testOpenNonExisting);
+            CPPUNIT_TEST(testAcquireSlot);
+            CPPUNIT_TEST(testReleaseSlot);
+            CPPUNIT_TEST(testRetainSlot);
+            CPPUNIT_TEST(testSlotData);
+            CPPUNIT_TEST(testWrongSlot);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            SharedMemoryRingTest() : m_ring(0) {}
+            
+            void setUp();
+            void tearDown();
+            
+        protected:
+            void testCreate();
+            void testOpen();
+            void testOpenNonExisting();
+            void testAcquireSlot();
+            void testReleaseSlot();
+            void testRetainSlot();
+            void testSlotData();
+            void testWrongSlot();
+            
+        private:
+            impl::SharedMemoryRing* m_ring;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_SHAREDMEMORYRINGTEST_H
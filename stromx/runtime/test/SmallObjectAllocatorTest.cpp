@@ -0,0 +1,149 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cstring>
+#include <set>
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/SmallObjectAllocator.h"
+#include "stromx/runtime/test/SmallObjectAllocatorTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::SmallObjectAllocatorTest);
+
+namespace
+{
+    const std::size_t NUM_OBJECTS = 1000;
+    
+    void allocateObjects(std::vector<void*> & objects)
+    {
+        for(std::size_t i = 0; i < NUM_OBJECTS; ++i)
+            objects.push_back(stromx::runtime::SmallObjectAllocator::allocate(32));
+    }
+}
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void SmallObjectAllocatorTest::testAllocate()
+        {
+            void* ptr = SmallObjectAllocator::allocate(24);
+            CPPUNIT_ASSERT(ptr);
+            std::memset(ptr, 0xff, 24);
+            SmallObjectAllocator::deallocate(ptr, 24);
+            
+            // allocating zero bytes returns a valid pointer
+            ptr = SmallObjectAllocator::allocate(0);
+            CPPUNIT_ASSERT(ptr);
+            SmallObjectAllocator::deallocate(ptr, 0);
+            
+            SmallObjectAllocator::deallocate(0, 24);
+        }
+        
+        void SmallObjectAllocatorTest::testReuse()
+        {
+            void* ptr = SmallObjectAllocator::allocate(40);
+            SmallObjectAllocator::deallocate(ptr, 40);
+            
+            // objects in the same size class reuse the released block
+            CPPUNIT_ASSERT_EQUAL(ptr, SmallObjectAllocator::allocate(48));
+            SmallObjectAllocator::deallocate(ptr, 48);
+        }
+        
+        void SmallObjectAllocatorTest::testLargeObject()
+        {
+            const std::size_t size = SmallObjectAllocator::MAX_OBJECT_SIZE + 1;
+            void* ptr = SmallObjectAllocator::allocate(size);
+            CPPUNIT_ASSERT(ptr);
+            std::memset(ptr, 0xff, size);
+            SmallObjectAllocator::deallocate(ptr, size);
+        }
+        
+        void SmallObjectAllocatorTest::testManyObjects()
+        {
+            std::vector<void*> objects;
+            allocateObjects(objects);
+            
+            std::set<void*> distinct(objects.begin(), objects.end());
+            CPPUNIT_ASSERT_EQUAL(NUM_OBJECTS, distinct.size());
+            
+            for(std::vector<void*>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+                SmallObjectAllocator::deallocate(*iter, 32);
+            
+            // the released blocks are reused 
+            std::vector<void*> otherObjects;
+            allocateObjects(otherObjects);
+            for(std::vector<void*>::iterator iter = otherObjects.begin(); iter != otherObjects.end(); ++iter)
+            {
+                CPPUNIT_ASSERT(distinct.count(*iter));
+                SmallObjectAllocator::deallocate(*iter, 32);
+            }
+        }
+        
+        void SmallObjectAllocatorTest::testOtherThread()
+        {
+            // allocate the objects in another thread and release them in this thread
+            std::vector<void*> objects;
+            boost::thread t(allocateObjects, boost::ref(objects));
+            t.join();
+            
+            std::set<void*> distinct(objects.begin(), objects.end());
+            for(std::vector<void*>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+                SmallObjectAllocator::deallocate(*iter, 32);
+            
+            // most of the released blocks are passed on to other threads
+            objects.clear();
+            boost::thread t2(allocateObjects, boost::ref(objects));
+            t2.join();
+            
+            unsigned int numReused = 0;
+            for(std::vector<void*>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+            {
+                if(distinct.count(*iter))
+                    ++numReused;
+                SmallObjectAllocator::deallocate(*iter, 32);
+            }
+            CPPUNIT_ASSERT(numReused > NUM_OBJECTS / 2);
+        }
+        
+        void SmallObjectAllocatorTest::testPrimitive()
+        {
+            UInt32* value = new UInt32(5);
+            delete value;
+            
+            Data* data = new Float64(2.0);
+            CPPUNIT_ASSERT_EQUAL((void*)(value), (void*)(data));
+            delete data;
+        }
+        
+        void SmallObjectAllocatorTest::testDataContainer()
+        {
+            const Data* first = 0;
+            {
+                DataContainer container(new UInt32(5));
+                first = &ReadAccess(container).get();
+                CPPUNIT_ASSERT_EQUAL((unsigned int)(5), (unsigned int)(ReadAccess(container).get<UInt32>()));
+            }
+            
+            DataContainer container(new UInt32(6));
+            CPPUNIT_ASSERT_EQUAL(first, &ReadAccess(container).get());
+        }
+    }
+}
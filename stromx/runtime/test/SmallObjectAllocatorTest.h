@@ -0,0 +1,55 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_SMALLOBJECTALLOCATORTEST_H
+#define STROMX_RUNTIME_SMALLOBJECTALLOCATORTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class SmallObjectAllocatorTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (SmallObjectAllocatorTest);
+            CPPUNIT_TEST(testAllocate);
+            CPPUNIT_TEST(testReuse);
+            CPPUNIT_TEST(testLargeObject);
+            CPPUNIT_TEST(testManyObjects);
+            CPPUNIT_TEST(testOtherThread);
+            CPPUNIT_TEST(testPrimitive);
+            CPPUNIT_TEST(testDataContainer);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            void setUp() {}
+            void tearDown() {}
+            
+        protected:
+            void testAllocate();
+            void testReuse();
+            void testLargeObject();
+            void testManyObjects();
+            void testOtherThread();
+            void testPrimitive();
+            void testDataContainer();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_SMALLOBJECTALLOCATORTEST_H
@@ -0,0 +1,146 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/SpscRing.h"
+#include "stromx/runtime/test/SpscRingTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::SpscRingTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using namespace impl;
+        
+        namespace
+        {
+            const unsigned int NUM_VALUES = 100000;
+            
+            void produce(SpscRing<unsigned int>* ring)
+            {
+                for(unsigned int i = 0; i < NUM_VALUES; ++i)
+                {
+                    while(! ring->tryPush(i))
+                        boost::this_thread::yield();
+                }
+            }
+        }
+        
+        void SpscRingTest::testConstructor()
+        {
+            CPPUNIT_ASSERT_THROW(SpscRing<unsigned int>(0), WrongArgument);
+            
+            SpscRing<unsigned int> ring(3);
+            CPPUNIT_ASSERT_EQUAL(std::size_t(3), ring.capacity());
+            CPPUNIT_ASSERT(ring.empty());
+            CPPUNIT_ASSERT(! ring.full());
+        }
+        
+        void SpscRingTest::testTryPush()
+        {
+            SpscRing<unsigned int> ring(3);
+            
+            CPPUNIT_ASSERT(ring.tryPush(0));
+            CPPUNIT_ASSERT(ring.tryPush(1));
+            CPPUNIT_ASSERT(ring.tryPush(2));
+            CPPUNIT_ASSERT(ring.full());
+            CPPUNIT_ASSERT(! ring.tryPush(3));
+            CPPUNIT_ASSERT_EQUAL(std::size_t(3), ring.size());
+        }
+        
+        void SpscRingTest::testFront()
+        {
+            SpscRing<unsigned int> ring(3);
+            CPPUNIT_ASSERT(ring.front() == 0);
+            
+            ring.tryPush(5);
+            ring.tryPush(6);
+            
+            CPPUNIT_ASSERT(ring.front());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(5), *ring.front());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), ring.size());
+        }
+        
+        void SpscRingTest::testPop()
+        {
+            SpscRing<unsigned int> ring(3);
+            CPPUNIT_ASSERT(! ring.pop());
+            
+            ring.tryPush(5);
+            ring.tryPush(6);
+            
+            CPPUNIT_ASSERT(ring.pop());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(6), *ring.front());
+            CPPUNIT_ASSERT(ring.pop());
+            CPPUNIT_ASSERT(ring.empty());
+            CPPUNIT_ASSERT(! ring.pop());
+        }
+        
+        void SpscRingTest::testWrapAround()
+        {
+            SpscRing<unsigned int> ring(3);
+            
+            for(unsigned int i = 0; i < 10; ++i)
+            {
+                CPPUNIT_ASSERT(ring.tryPush(2 * i));
+                CPPUNIT_ASSERT(ring.tryPush(2 * i + 1));
+                
+                CPPUNIT_ASSERT_EQUAL(2 * i, *ring.front());
+                ring.pop();
+                CPPUNIT_ASSERT_EQUAL(2 * i + 1, *ring.front());
+                ring.pop();
+            }
+            
+            CPPUNIT_ASSERT(ring.empty());
+        }
+        
+        void SpscRingTest::testClear()
+        {
+            SpscRing<unsigned int> ring(3);
+            ring.tryPush(0);
+            ring.tryPush(1);
+            
+            ring.clear();
+            
+            CPPUNIT_ASSERT(ring.empty());
+            CPPUNIT_ASSERT(ring.tryPush(2));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), *ring.front());
+        }
+        
+        void SpscRingTest::testThreads()
+        {
+            SpscRing<unsigned int> ring(16);
+            boost::thread producer(boost::bind(&produce, &ring));
+            
+            for(unsigned int i = 0; i < NUM_VALUES; ++i)
+            {
+                unsigned int* value = 0;
+                while(! (value = ring.front()))
+                    boost::this_thread::yield();
+                
+                CPPUNIT_ASSERT_EQUAL(i, *value);
+                ring.pop();
+            }
+            
+            producer.join();
+            CPPUNIT_ASSERT(ring.empty());
+        }
+    }
+}
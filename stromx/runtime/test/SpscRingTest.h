@@ -0,0 +1,55 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_SPSCRINGTEST_H
+#define STROMX_RUNTIME_SPSCRINGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class SpscRingTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (SpscRingTest);
+            CPPUNIT_TEST(testConstructor);
+            CPPUNIT_TEST(testTryPush);
+            CPPUNIT_TEST(testFront);
+            CPPUNIT_TEST(testPop);
+            CPPUNIT_TEST(testWrapAround);
+            CPPUNIT_TEST(testClear);
+            CPPUNIT_TEST(testThreads);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+            void setUp() {}
+            void tearDown() {}
+        
+        protected:
+            void testConstructor();
+            void testTryPush();
+            void testFront();
+            void testPop();
+            void testWrapAround();
+            void testClear();
+            void testThreads();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_SPSCRINGTEST_H
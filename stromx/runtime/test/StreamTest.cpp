@@ -16,6 +16,7 @@
 
 #include <boost/thread/thread.hpp>
 #include <cppunit/TestAssert.h> 
+#include <sstream>
 #include "stromx/runtime/Dump.h"
 #include "stromx/runtime/Exception.h"
 #include "stromx/runtime/Factory.h"
@@ -361,6 +362,87 @@ namespace stromx
             CPPUNIT_ASSERT_NO_THROW(m_stream->start());
         }     
 
+        void StreamTest::testSetExecutionMode()
+        {
+            CPPUNIT_ASSERT_EQUAL(Stream::THREADS, m_stream->executionMode());
+            CPPUNIT_ASSERT_NO_THROW(m_stream->setExecutionMode(Stream::WORKER_POOL));
+            CPPUNIT_ASSERT_EQUAL(Stream::WORKER_POOL, m_stream->executionMode());
+            CPPUNIT_ASSERT_NO_THROW(m_stream->setWorkerPoolSize(2));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), m_stream->workerPoolSize());
+            
+            m_stream->start();
+            CPPUNIT_ASSERT_THROW(m_stream->setExecutionMode(Stream::THREADS), WrongState);
+            CPPUNIT_ASSERT_THROW(m_stream->setWorkerPoolSize(4), WrongState);
+        }
+        
+        void StreamTest::testStartWorkerPool()
+        {
+            m_stream->setExecutionMode(Stream::WORKER_POOL);
+            m_stream->setWorkerPoolSize(1);
+            
+            CPPUNIT_ASSERT_NO_THROW(m_stream->start());
+            CPPUNIT_ASSERT_EQUAL(Stream::ACTIVE, m_stream->status());
+            
+            Operator* source = m_stream->operators()[0];
+            Operator* target = m_stream->operators()[2];
+            DataContainer data(new None);
+            source->setInputData(TestOperator::INPUT_1, data);
+            source->setInputData(TestOperator::INPUT_2, data);
+            
+            CPPUNIT_ASSERT_EQUAL(data, target->getOutputData(TestOperator::OUTPUT_1));
+            CPPUNIT_ASSERT_EQUAL(data, target->getOutputData(TestOperator::OUTPUT_2));
+            
+            m_stream->stop();
+            m_stream->join();
+            CPPUNIT_ASSERT_EQUAL(Stream::INACTIVE, m_stream->status());
+            
+            // the stream can be restarted
+            CPPUNIT_ASSERT_NO_THROW(m_stream->start());
+        }
+        
+        void StreamTest::testPauseWorkerPool()
+        {
+            m_stream->setExecutionMode(Stream::WORKER_POOL);
+            m_stream->start();
+            
+            CPPUNIT_ASSERT_NO_THROW(m_stream->pause());
+            CPPUNIT_ASSERT_EQUAL(Stream::PAUSED, m_stream->status());
+            CPPUNIT_ASSERT_NO_THROW(m_stream->resume());
+            CPPUNIT_ASSERT_EQUAL(Stream::ACTIVE, m_stream->status());
+        }
+
+        void StreamTest::testTrace()
+        {
+            CPPUNIT_ASSERT_NO_THROW(m_stream->startTrace());
+            CPPUNIT_ASSERT_THROW(m_stream->startTrace(), WrongState);
+            
+            m_stream->start();
+            
+            Operator* source = m_stream->operators()[0];
+            Operator* target = m_stream->operators()[2];
+            DataContainer data(new None);
+            source->setInputData(TestOperator::INPUT_1, data);
+            source->setInputData(TestOperator::INPUT_2, data);
+            target->getOutputData(TestOperator::OUTPUT_1);
+            
+            m_stream->stop();
+            m_stream->join();
+            
+            std::ostringstream trace;
+            CPPUNIT_ASSERT_NO_THROW(m_stream->stopTrace(trace));
+            
+            CPPUNIT_ASSERT(trace.str().find("\"traceEvents\"") != std::string::npos);
+            CPPUNIT_ASSERT(trace.str().find("\"execute\"") != std::string::npos);
+            CPPUNIT_ASSERT(trace.str().find("\"setInputData\"") != std::string::npos);
+            CPPUNIT_ASSERT(trace.str().find("\"thread_name\"") != std::string::npos);
+        }
+        
+        void StreamTest::testStopTraceNotStarted()
+        {
+            std::ostringstream trace;
+            CPPUNIT_ASSERT_THROW(m_stream->stopTrace(trace), WrongState);
+        }
+
         void StreamTest::testPause()
         {
             CPPUNIT_ASSERT_THROW(m_stream->pause(), WrongState);
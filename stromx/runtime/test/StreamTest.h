@@ -56,6 +56,11 @@ namespace stromx
             CPPUNIT_TEST(testRemoveThread);
             CPPUNIT_TEST(testStart);
             CPPUNIT_TEST(testStartOperatorError);
+            CPPUNIT_TEST(testSetExecutionMode);
+            CPPUNIT_TEST(testStartWorkerPool);
+            CPPUNIT_TEST(testPauseWorkerPool);
+            CPPUNIT_TEST(testTrace);
+            CPPUNIT_TEST(testStopTraceNotStarted);
             CPPUNIT_TEST(testPause);
             CPPUNIT_TEST(testResume);
             CPPUNIT_TEST(testAddObserver);
@@ -99,6 +104,11 @@ namespace stromx
             void testRemoveThread();
             void testStart();
             void testStartOperatorError();
+            void testSetExecutionMode();
+            void testStartWorkerPool();
+            void testPauseWorkerPool();
+            void testTrace();
+            void testStopTraceNotStarted();
             void testPause();
             void testResume();
             void testAddObserver();
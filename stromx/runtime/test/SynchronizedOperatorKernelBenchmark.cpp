@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <fstream>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Id2DataComposite.h"
+#include "stromx/runtime/Id2DataPair.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/Variant.h"
+#include "stromx/runtime/impl/SynchronizedOperatorKernel.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            const unsigned int NUM_PAIRS = 4;
+            const unsigned int NUM_ITEMS = 20000;
+
+            // forwards the data of input i to output NUM_PAIRS + i
+            class ForwardOperator : public OperatorKernel
+            {
+            public:
+                ForwardOperator()
+                  : OperatorKernel("", "", Version())
+                {}
+
+                void initialize()
+                {
+                    OperatorKernel::initialize(setupInputs(), setupOutputs(),
+                                               std::vector<const Parameter*>());
+                }
+
+                OperatorKernel* clone() const { return 0; }
+
+                void execute(DataProvider& provider)
+                {
+                    Id2DataPair in0(0), in1(1), in2(2), in3(3);
+                    provider.receiveInputData(in0 || in1 || in2 || in3);
+
+                    const Id2DataPair* inputs[] = { &in0, &in1, &in2, &in3 };
+                    for(unsigned int i = 0; i < NUM_PAIRS; ++i)
+                    {
+                        if(! inputs[i]->data().empty())
+                        {
+                            Id2DataPair out(NUM_PAIRS + i, inputs[i]->data());
+                            provider.sendOutputData(out);
+                        }
+                    }
+                }
+
+            private:
+                static const std::vector<const Input* > setupInputs()
+                {
+                    std::vector<const Input*> inputs;
+                    for(unsigned int i = 0; i < NUM_PAIRS; ++i)
+                        inputs.push_back(new Input(i, Variant::UINT_32));
+
+                    return inputs;
+                }
+
+                static const std::vector<const Output* > setupOutputs()
+                {
+                    std::vector<const Output*> outputs;
+                    for(unsigned int i = 0; i < NUM_PAIRS; ++i)
+                        outputs.push_back(new Output(NUM_PAIRS + i, Variant::UINT_32));
+
+                    return outputs;
+                }
+            };
+
+            void produce(impl::SynchronizedOperatorKernel* kernel, const unsigned int id)
+            {
+                for(unsigned int i = 0; i < NUM_ITEMS; ++i)
+                    kernel->setInputData(id, DataContainer(new UInt32(i)));
+            }
+
+            void consume(impl::SynchronizedOperatorKernel* kernel, const unsigned int id,
+                         unsigned int* checksum)
+            {
+                for(unsigned int i = 0; i < NUM_ITEMS; ++i)
+                {
+                    DataContainer data = kernel->getOutputData(id);
+                    if(ReadAccess(data).get<UInt32>() == i)
+                        (*checksum)++;
+                    kernel->clearOutputData(id);
+                }
+            }
+
+            // passes NUM_ITEMS through each of the first numPairs inputs and outputs
+            // of one kernel with a producer and a consumer thread per pair
+            double measure(const unsigned int numPairs, unsigned int & checksum)
+            {
+                using namespace boost::chrono;
+
+                impl::SynchronizedOperatorKernel kernel(new ForwardOperator);
+                kernel.initialize(0, 0);
+                kernel.activate();
+
+                std::vector<unsigned int> checksums(numPairs, 0);
+                const steady_clock::time_point start = steady_clock::now();
+
+                boost::thread_group threads;
+                for(unsigned int i = 0; i < numPairs; ++i)
+                {
+                    threads.create_thread(boost::bind(produce, &kernel, i));
+                    threads.create_thread(boost::bind(consume, &kernel, NUM_PAIRS + i, &checksums[i]));
+                }
+                threads.join_all();
+
+                const double elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+                kernel.deactivate();
+
+                for(unsigned int i = 0; i < numPairs; ++i)
+                    checksum += checksums[i];
+
+                return elapsed / (numPairs * NUM_ITEMS);
+            }
+        }
+
+        class SynchronizedOperatorKernelBenchmark : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (SynchronizedOperatorKernelBenchmark);
+            CPPUNIT_TEST(testContention);
+            CPPUNIT_TEST_SUITE_END ();
+
+        protected:
+            void testContention()
+            {
+                // the timings are written to a file in the working directory
+                std::ofstream results("SynchronizedOperatorKernelBenchmark.txt");
+                for(unsigned int numPairs = 1; numPairs <= NUM_PAIRS; numPairs *= 2)
+                {
+                    unsigned int checksum = 0;
+                    const double time = measure(numPairs, checksum);
+
+                    results << numPairs << " producers and " << numPairs << " consumers: "
+                            << time << " ns per item" << std::endl;
+
+                    CPPUNIT_ASSERT_EQUAL(numPairs * NUM_ITEMS, checksum);
+                }
+            }
+        };
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::SynchronizedOperatorKernelBenchmark);
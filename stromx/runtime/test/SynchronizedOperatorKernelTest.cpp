@@ -14,10 +14,14 @@
  *  limitations under the License.
  */
 
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/TestFixture.h>
 
 #include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/Id2DataComposite.h"
 #include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/OperatorException.h"
 #include "stromx/runtime/ReadAccess.h"
@@ -86,6 +90,59 @@ public:
         return properties;
     }
 };
+
+// forwards the data of any of its inputs to the output
+class ContentionOperator : public OperatorKernel
+{
+public:
+    static const unsigned int NUM_INPUTS = 8;
+    static const unsigned int OUTPUT = NUM_INPUTS;
+    
+    ContentionOperator()
+        : OperatorKernel("", "", Version())
+    {}
+            
+    void initialize()
+    {
+        OperatorKernel::initialize(setupInputs(), setupOutputs(), 
+            std::vector<const Parameter*>());
+    }
+    
+    OperatorKernel* clone() const { return 0; }
+    void execute(DataProvider& provider)
+    {
+        Id2DataPair in0(0), in1(1), in2(2), in3(3), in4(4), in5(5), in6(6), in7(7);
+        provider.receiveInputData(in0 || in1 || in2 || in3 || in4 || in5 || in6 || in7);
+        
+        const Id2DataPair* inputs[] = { &in0, &in1, &in2, &in3, &in4, &in5, &in6, &in7 };
+        for(unsigned int i = 0; i < NUM_INPUTS; ++i)
+        {
+            if(! inputs[i]->data().empty())
+            {
+                Id2DataPair out(OUTPUT, inputs[i]->data());
+                provider.sendOutputData(out);
+                break;
+            }
+        }
+    }
+    
+    static const std::vector<const Input* > setupInputs()
+    {
+        std::vector<const Input*> inputs;
+        for(unsigned int i = 0; i < NUM_INPUTS; ++i)
+            inputs.push_back(new Input(i, Variant::UINT_32));
+        
+        return inputs;
+    }
+    
+    static const std::vector<const Output* > setupOutputs()
+    {
+        std::vector<const Output*> outputs;
+        outputs.push_back(new Output(OUTPUT, Variant::UINT_32));
+        
+        return outputs;
+    }
+};
 }
 
 using namespace impl;
@@ -108,6 +165,10 @@ class SynchronizedOperatorKernelTest : public CPPUNIT_NS :: TestFixture
     CPPUNIT_TEST (testInputParameterPush);
     CPPUNIT_TEST (testOutputParameterPersistent);
     CPPUNIT_TEST (testOutputParameterPull);
+    CPPUNIT_TEST (testConcurrentProducers);
+    CPPUNIT_TEST (testProcess);
+    CPPUNIT_TEST (testProcessNotActive);
+    CPPUNIT_TEST (testProcessStatistics);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -125,6 +186,14 @@ public:
     }
     
 private:
+    static const unsigned int NUM_ITEMS = 200;
+    
+    void pushItems(SynchronizedOperatorKernel* kernel, const unsigned int id)
+    {
+        for(unsigned int i = 0; i < NUM_ITEMS; ++i)
+            kernel->setInputData(id, DataContainer(new UInt32(id * NUM_ITEMS + i)));
+    }
+    
     SynchronizedOperatorKernel* m_kernel;
 
 protected:
@@ -303,6 +372,76 @@ protected:
         CPPUNIT_ASSERT_NO_THROW(m_kernel->getParameter(1, true, 0));
         CPPUNIT_ASSERT_THROW(m_kernel->getParameter(1, true, 0), ParameterError);
     }
+    
+    void testConcurrentProducers()
+    {
+        // one producer per input competes for the single execution of the 
+        // operator while the test thread consumes the output
+        SynchronizedOperatorKernel kernel(new ContentionOperator);
+        kernel.initialize(0, 0);
+        kernel.activate();
+        
+        boost::thread_group producers;
+        for(unsigned int i = 0; i < ContentionOperator::NUM_INPUTS; ++i)
+        {
+            producers.create_thread(boost::bind(&SynchronizedOperatorKernelTest::pushItems,
+                                                this, &kernel, i));
+        }
+        
+        // the items of each producer must arrive completely and in order
+        std::vector<unsigned int> numReceived(ContentionOperator::NUM_INPUTS, 0);
+        const unsigned int numItems = NUM_ITEMS * ContentionOperator::NUM_INPUTS;
+        for(unsigned int i = 0; i < numItems; ++i)
+        {
+            DataContainer data = kernel.getOutputData(ContentionOperator::OUTPUT);
+            const unsigned int value = ReadAccess(data).get<UInt32>();
+            kernel.clearOutputData(ContentionOperator::OUTPUT);
+            
+            const unsigned int producer = value / NUM_ITEMS;
+            CPPUNIT_ASSERT(producer < ContentionOperator::NUM_INPUTS);
+            CPPUNIT_ASSERT_EQUAL(numReceived[producer], value % NUM_ITEMS);
+            numReceived[producer]++;
+        }
+        
+        producers.join_all();
+        
+        CPPUNIT_ASSERT(! kernel.hasOutputData(ContentionOperator::OUTPUT));
+        kernel.deactivate();
+    }
+    
+    void testProcess()
+    {
+        m_kernel->initialize(0, 0);
+        m_kernel->activate();
+        
+        DataContainer output = m_kernel->process(0, DataContainer(new UInt16(42)), 1);
+        
+        CPPUNIT_ASSERT_EQUAL(Int16(42), ReadAccess(output).get<Int16>());
+        CPPUNIT_ASSERT(! m_kernel->hasOutputData(1));
+        CPPUNIT_ASSERT(m_kernel->canSetInputData(0));
+        CPPUNIT_ASSERT_EQUAL(SynchronizedOperatorKernel::ACTIVE, m_kernel->status());
+    }
+    
+    void testProcessNotActive()
+    {
+        m_kernel->initialize(0, 0);
+        
+        CPPUNIT_ASSERT_THROW(m_kernel->process(0, DataContainer(new UInt16(42)), 1),
+                             WrongOperatorState);
+    }
+    
+    void testProcessStatistics()
+    {
+        m_kernel->initialize(0, 0);
+        m_kernel->setStatisticsEnabled(true);
+        m_kernel->activate();
+        
+        m_kernel->process(0, DataContainer(new UInt16(42)), 1);
+        m_kernel->process(0, DataContainer(new UInt16(43)), 1);
+        
+        CPPUNIT_ASSERT_EQUAL(uint64_t(2), m_kernel->statistics().numExecutions());
+        CPPUNIT_ASSERT_EQUAL(uint64_t(0), m_kernel->statistics().numErrors());
+    }
 };
 }
 }
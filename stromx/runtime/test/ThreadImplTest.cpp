@@ -134,6 +134,86 @@ namespace stromx
             }     
         }
 
+        void ThreadImplTest::testSetAffinity()
+        {
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), m_thread->affinity());
+            
+            CPPUNIT_ASSERT_NO_THROW(m_thread->setAffinity(0x3));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0x3), m_thread->affinity());
+            
+            m_thread->setAffinity(0);
+            m_thread->start();
+            CPPUNIT_ASSERT_THROW(m_thread->setAffinity(0x1), WrongState);
+        }
+        
+        void ThreadImplTest::testSetFusionEnabled()
+        {
+            CPPUNIT_ASSERT(! m_thread->fusionEnabled());
+            
+            CPPUNIT_ASSERT_NO_THROW(m_thread->setFusionEnabled(true));
+            CPPUNIT_ASSERT(m_thread->fusionEnabled());
+            
+            m_thread->start();
+            CPPUNIT_ASSERT_THROW(m_thread->setFusionEnabled(false), WrongState);
+            
+            // the operators of the test have two inputs and are processed as usual
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            
+            DataContainer data = m_operators[2]->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+        }
+        
+        void ThreadImplTest::testSetScheduling()
+        {
+            CPPUNIT_ASSERT_EQUAL(ThreadImpl::OTHER, m_thread->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(0, m_thread->priority());
+            
+            CPPUNIT_ASSERT_NO_THROW(m_thread->setScheduling(ThreadImpl::ROUND_ROBIN, 10));
+            CPPUNIT_ASSERT_EQUAL(ThreadImpl::ROUND_ROBIN, m_thread->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(10, m_thread->priority());
+            
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(ThreadImpl::OTHER, 20), WrongArgument);
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(ThreadImpl::OTHER, -21), WrongArgument);
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(ThreadImpl::FIFO, 0), WrongArgument);
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(ThreadImpl::FIFO, 100), WrongArgument);
+            CPPUNIT_ASSERT_EQUAL(ThreadImpl::ROUND_ROBIN, m_thread->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(10, m_thread->priority());
+            
+            m_thread->setScheduling(ThreadImpl::OTHER, 0);
+            m_thread->start();
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(ThreadImpl::OTHER, 5), WrongState);
+        }
+        
+        void ThreadImplTest::testStartSettings()
+        {
+            // restricting the thread to the first CPU and raising its nice
+            // level does not require any privileges
+            m_thread->setAffinity(0x1);
+            m_thread->setScheduling(ThreadImpl::OTHER, 5);
+            CPPUNIT_ASSERT_NO_THROW(m_thread->start());
+            
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            
+            DataContainer data = m_operators[2]->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+        }
+        
+        void ThreadImplTest::testStartSettingsRefused()
+        {
+            // the affinity mask contains only a CPU which does not exist
+            if(boost::thread::hardware_concurrency() >= 64)
+                return;
+            
+            m_thread->setAffinity(uint64_t(1) << 63);
+            CPPUNIT_ASSERT_THROW(m_thread->start(), WrongState);
+            CPPUNIT_ASSERT_EQUAL(ThreadImpl::INACTIVE, m_thread->status());
+            
+            m_thread->setAffinity(0);
+            CPPUNIT_ASSERT_NO_THROW(m_thread->start());
+        }
+
         void ThreadImplTest::testStop()
         {
             CPPUNIT_ASSERT_NO_THROW(m_thread->stop());
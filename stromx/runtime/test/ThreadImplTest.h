@@ -50,6 +50,11 @@ namespace stromx
             CPPUNIT_TEST(testInsertInput);
             CPPUNIT_TEST(testRemoveInput);
             CPPUNIT_TEST(testObserver);
+            CPPUNIT_TEST(testSetAffinity);
+            CPPUNIT_TEST(testSetFusionEnabled);
+            CPPUNIT_TEST(testSetScheduling);
+            CPPUNIT_TEST(testStartSettings);
+            CPPUNIT_TEST(testStartSettingsRefused);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -72,6 +77,12 @@ namespace stromx
             void testResume();
             
             void testObserver();
+            
+            void testSetAffinity();
+            void testSetFusionEnabled();
+            void testSetScheduling();
+            void testStartSettings();
+            void testStartSettingsRefused();
                 
         private: 
             class TestObserver : public impl::ThreadImplObserver
@@ -89,6 +89,25 @@ namespace stromx
             CPPUNIT_ASSERT_EQUAL(static_cast<const Operator*>(m_op2), m_thread->inputSequence()[0].op());
         }
 
+        void ThreadTest::testAffinity()
+        {
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), m_thread->affinity());
+            CPPUNIT_ASSERT_NO_THROW(m_thread->setAffinity(0x5));
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0x5), m_thread->affinity());
+        }
+        
+        void ThreadTest::testScheduling()
+        {
+            CPPUNIT_ASSERT_EQUAL(Thread::OTHER, m_thread->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(0, m_thread->priority());
+            
+            CPPUNIT_ASSERT_NO_THROW(m_thread->setScheduling(Thread::FIFO, 50));
+            CPPUNIT_ASSERT_EQUAL(Thread::FIFO, m_thread->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(50, m_thread->priority());
+            
+            CPPUNIT_ASSERT_THROW(m_thread->setScheduling(Thread::ROUND_ROBIN, 0), WrongArgument);
+        }
+
         void ThreadTest::tearDown()
         {
             delete m_thread;
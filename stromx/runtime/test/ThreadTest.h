@@ -38,6 +38,8 @@ namespace stromx
             CPPUNIT_TEST(testInsertInput);
             CPPUNIT_TEST(testRemoveInputPosition);
             CPPUNIT_TEST(testRemoveInputOpId);
+            CPPUNIT_TEST(testAffinity);
+            CPPUNIT_TEST(testScheduling);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -52,6 +54,8 @@ namespace stromx
             void testInsertInput();
             void testRemoveInputPosition();
             void testRemoveInputOpId();
+            void testAffinity();
+            void testScheduling();
             void testRemoveOperator();
                 
         private:
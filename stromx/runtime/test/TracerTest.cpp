@@ -0,0 +1,178 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include <sstream>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/Tracer.h"
+#include "stromx/runtime/test/TracerTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::TracerTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using namespace impl;
+        
+        void TracerTest::tearDown()
+        {
+            // make sure a failed test does not leave an active trace behind
+            if(Tracer::isActive())
+            {
+                std::ostringstream out;
+                Tracer::stop(out);
+            }
+        }
+        
+        void TracerTest::testSpan()
+        {
+            Tracer::start();
+            
+            {
+                Tracer::Span span("test", "span");
+            }
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            const std::string trace = out.str();
+            CPPUNIT_ASSERT(trace.find("{\"name\":\"span\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+        }
+        
+        void TracerTest::testSpanInactive()
+        {
+            {
+                Tracer::Span span("test", "inactiveSpan");
+            }
+            
+            Tracer::start();
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("inactiveSpan") == std::string::npos);
+        }
+        
+        void TracerTest::testSpanNotBegun()
+        {
+            Tracer::start();
+            
+            {
+                Tracer::Span span;
+            }
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("\"ph\":\"X\"") == std::string::npos);
+        }
+        
+        void TracerTest::testSpanOtherThread()
+        {
+            Tracer::start();
+            
+            boost::thread t(&TracerTest::traceSpan);
+            t.join();
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("threadSpan") != std::string::npos);
+        }
+        
+        void TracerTest::testSpanExitedThreads()
+        {
+            Tracer::start();
+            
+            boost::thread t1(&TracerTest::traceSpan);
+            t1.join();
+            boost::thread t2(&TracerTest::traceOtherSpan);
+            t2.join();
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("threadSpan") != std::string::npos);
+            CPPUNIT_ASSERT(out.str().find("otherThreadSpan") != std::string::npos);
+            
+            Tracer::start();
+            
+            boost::thread t3(&TracerTest::traceOtherSpan);
+            t3.join();
+            
+            out.str("");
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("\"threadSpan") == std::string::npos);
+            CPPUNIT_ASSERT(out.str().find("otherThreadSpan") != std::string::npos);
+        }
+        
+        void TracerTest::testDetail()
+        {
+            const std::string detail("\"quoted\"");
+            
+            Tracer::start();
+            
+            {
+                Tracer::Span span("test", "span", &detail);
+            }
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("\"args\":{\"name\":\"\\\"quoted\\\"\"}") != std::string::npos);
+        }
+        
+        void TracerTest::testDetailDestroyed()
+        {
+            Tracer::start();
+            
+            {
+                const std::string detail("destroyed");
+                Tracer::Span span("test", "span", &detail);
+            }
+            
+            std::ostringstream out;
+            Tracer::stop(out);
+            
+            CPPUNIT_ASSERT(out.str().find("\"args\":{\"name\":\"destroyed\"}") != std::string::npos);
+        }
+        
+        void TracerTest::testStartActive()
+        {
+            Tracer::start();
+            CPPUNIT_ASSERT_THROW(Tracer::start(), WrongState);
+        }
+        
+        void TracerTest::testStopInactive()
+        {
+            std::ostringstream out;
+            CPPUNIT_ASSERT_THROW(Tracer::stop(out), WrongState);
+        }
+        
+        void TracerTest::traceSpan()
+        {
+            Tracer::Span span("test", "threadSpan");
+        }
+        
+        void TracerTest::traceOtherSpan()
+        {
+            Tracer::Span span("test", "otherThreadSpan");
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#ifndef STROMX_RUNTIME_TRACERTEST_H
+#define STROMX_RUNTIME_TRACERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class TracerTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (TracerTest);
+            CPPUNIT_TEST(testSpan);
+            CPPUNIT_TEST(testSpanInactive);
+            CPPUNIT_TEST(testSpanNotBegun);
+            CPPUNIT_TEST(testSpanOtherThread);
+            CPPUNIT_TEST(testSpanExitedThreads);
+            CPPUNIT_TEST(testDetail);
+            CPPUNIT_TEST(testDetailDestroyed);
+            CPPUNIT_TEST(testStartActive);
+            CPPUNIT_TEST(testStopInactive);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+            TracerTest() {}
+            
+            void setUp() {}
+            void tearDown();
+        
+        protected:
+            void testSpan();
+            void testSpanInactive();
+            void testSpanNotBegun();
+            void testSpanOtherThread();
+            void testSpanExitedThreads();
+            void testDetail();
+            void testDetailDestroyed();
+            void testStartActive();
+            void testStopInactive();
+            
+        private:
+            static void traceSpan();
+            static void traceOtherSpan();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_TRACERTEST_H
@@ -0,0 +1,222 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "stromx/runtime/test/WireFormatTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <istream>
+#include <ostream>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/impl/MemoryStreamBuffer.h"
+#include "stromx/runtime/impl/SerializationHeader.h"
+#include "stromx/runtime/impl/WireFormat.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::WireFormatTest);
+
+namespace stromx
+{
+    using namespace runtime;
+    
+    namespace runtime
+    {
+        using impl::SerializationHeader;
+        using impl::WireFormat;
+        
+        void WireFormatTest::testHello()
+        {
+            char data[WireFormat::HELLO_SIZE];
+            WireFormat::writeHello(data);
+            
+            CPPUNIT_ASSERT(WireFormat::hasMagic(data));
+            CPPUNIT_ASSERT_EQUAL(WireFormat::VERSION, WireFormat::readHello(data));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(0), WireFormat::readHelloFlags(data));
+        }
+        
+        void WireFormatTest::testHelloFlags()
+        {
+            char data[WireFormat::HELLO_SIZE];
+            WireFormat::writeHello(data, WireFormat::SHARED_MEMORY);
+            
+            CPPUNIT_ASSERT_EQUAL(WireFormat::VERSION, WireFormat::readHello(data));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(WireFormat::SHARED_MEMORY), WireFormat::readHelloFlags(data));
+        }
+        
+        void WireFormatTest::testReadHelloWrongMagic()
+        {
+            const char data[WireFormat::HELLO_SIZE] = { 'S', 'T', 'R', 'Y', 1, 0, 0, 0, 1, 0, 0, 0 };
+            
+            CPPUNIT_ASSERT(! WireFormat::hasMagic(data));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(0), WireFormat::readHello(data));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(0), WireFormat::readHelloFlags(data));
+        }
+        
+        void WireFormatTest::testRelease()
+        {
+            char data[WireFormat::HELLO_SIZE];
+            WireFormat::writeRelease(data, 7);
+            
+            uint32_t slot = 0;
+            CPPUNIT_ASSERT(WireFormat::readRelease(data, slot));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(7), slot);
+            CPPUNIT_ASSERT_EQUAL(uint32_t(0), WireFormat::readReleaseFlags(data));
+            CPPUNIT_ASSERT_EQUAL(uint32_t(0), WireFormat::readHello(data));
+            
+            WireFormat::writeRelease(data, 7, WireFormat::SLOT_READ);
+            CPPUNIT_ASSERT_EQUAL(uint32_t(WireFormat::SLOT_READ), WireFormat::readReleaseFlags(data));
+        }
+        
+        void WireFormatTest::testReadReleaseHello()
+        {
+            char data[WireFormat::HELLO_SIZE];
+            WireFormat::writeHello(data);
+            
+            uint32_t slot = 0;
+            CPPUNIT_ASSERT(! WireFormat::readRelease(data, slot));
+        }
+        
+        void WireFormatTest::testPreamble()
+        {
+            WireFormat::Preamble preamble;
+            preamble.headerSize = 40;
+            preamble.textSize = 12;
+            preamble.fileSize = 0x123456789ULL;
+            
+            char data[WireFormat::PREAMBLE_SIZE];
+            WireFormat::writePreamble(preamble, data);
+            const WireFormat::Preamble result = WireFormat::readPreamble(data);
+            
+            CPPUNIT_ASSERT_EQUAL(WireFormat::VERSION, result.version);
+            CPPUNIT_ASSERT_EQUAL(uint32_t(40), result.headerSize);
+            CPPUNIT_ASSERT_EQUAL(uint32_t(12), result.textSize);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0x123456789ULL), result.fileSize);
+        }
+        
+        void WireFormatTest::testPreambleLittleEndian()
+        {
+            WireFormat::Preamble preamble;
+            preamble.headerSize = 0x0201;
+            
+            char data[WireFormat::PREAMBLE_SIZE];
+            WireFormat::writePreamble(preamble, data);
+            
+            CPPUNIT_ASSERT_EQUAL(char(1), data[8]);
+            CPPUNIT_ASSERT_EQUAL(char(2), data[9]);
+            CPPUNIT_ASSERT_EQUAL(char(0), data[10]);
+            CPPUNIT_ASSERT_EQUAL(char(0), data[11]);
+        }
+        
+        void WireFormatTest::testReadPreambleWrongMagic()
+        {
+            // the preamble of the text format consists of hexadecimal sizes
+            const std::string data = "      1a       0    1000";
+            
+            CPPUNIT_ASSERT_THROW(WireFormat::readPreamble(data.c_str()), DeserializationError);
+        }
+        
+        void WireFormatTest::testReadPreambleNewerVersion()
+        {
+            WireFormat::Preamble preamble;
+            preamble.version = WireFormat::VERSION + 1;
+            
+            char data[WireFormat::PREAMBLE_SIZE];
+            WireFormat::writePreamble(preamble, data);
+            
+            CPPUNIT_ASSERT_THROW(WireFormat::readPreamble(data), DeserializationError);
+        }
+        
+        void WireFormatTest::testHeader()
+        {
+            SerializationHeader header;
+            header.serverVersion = Version(1, 2, 3);
+            header.package = "runtime";
+            header.type = "UInt32";
+            header.version = Version(4, 5, 6);
+            
+            std::vector<char> data;
+            WireFormat::writeHeader(header, data);
+            
+            SerializationHeader result;
+            WireFormat::readHeader(data.data(), data.size(), result);
+            
+            CPPUNIT_ASSERT_EQUAL(header, result);
+        }
+        
+        void WireFormatTest::testHeaderSharedMemory()
+        {
+            SerializationHeader header;
+            header.package = "runtime";
+            header.type = "Image";
+            header.payload = SerializationHeader::SHARED_IMAGE;
+            header.sharedMemory = "stromx_send_49152";
+            header.slot = 3;
+            header.rows = 480;
+            header.cols = 640;
+            header.elementType = 2;
+            
+            std::vector<char> data;
+            WireFormat::writeHeader(header, data);
+            
+            SerializationHeader result;
+            WireFormat::readHeader(data.data(), data.size(), result);
+            
+            CPPUNIT_ASSERT_EQUAL(header, result);
+        }
+        
+        void WireFormatTest::testReadHeaderTruncated()
+        {
+            SerializationHeader header;
+            header.package = "runtime";
+            header.type = "UInt32";
+            
+            std::vector<char> data;
+            WireFormat::writeHeader(header, data);
+            
+            SerializationHeader result;
+            CPPUNIT_ASSERT_THROW(WireFormat::readHeader(data.data(), data.size() - 1, result), 
+                                 DeserializationError);
+        }
+        
+        void WireFormatTest::testVectorOutputBuffer()
+        {
+            std::vector<char> data;
+            impl::VectorOutputBuffer buffer(data);
+            std::ostream stream(&buffer);
+            
+            stream << "abc" << 12;
+            stream.put('d');
+            
+            CPPUNIT_ASSERT_EQUAL(std::string("abc12d"), std::string(data.begin(), data.end()));
+        }
+        
+        void WireFormatTest::testMemoryInputBufferSeek()
+        {
+            const std::string data = "abcdef";
+            impl::MemoryInputBuffer buffer(data.c_str(), data.size());
+            std::istream stream(&buffer);
+            
+            CPPUNIT_ASSERT_EQUAL('a', char(stream.get()));
+            
+            stream.seekg(4);
+            CPPUNIT_ASSERT_EQUAL('e', char(stream.get()));
+            
+            stream.seekg(-3, std::ios_base::end);
+            CPPUNIT_ASSERT_EQUAL('d', char(stream.get()));
+            
+            stream.seekg(7);
+            CPPUNIT_ASSERT(stream.fail());
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_WIREFORMATTEST_H
+#define STROMX_RUNTIME_WIREFORMATTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class WireFormatTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (WireFormatTest);
+            CPPUNIT_TEST(testHello);
+            CPPUNIT_TEST(testHelloFlags);
+            CPPUNIT_TEST(testReadHelloWrongMagic);
+            CPPUNIT_TEST(testRelease);
+            CPPUNIT_TEST(testReadReleaseHello);
+            CPPUNIT_TEST(testPreamble);
+            CPPUNIT_TEST(testPreambleLittleEndian);
+            CPPUNIT_TEST(testReadPreambleWrongMagic);
+            CPPUNIT_TEST(testReadPreambleNewerVersion);
+            CPPUNIT_TEST(testHeader);
+            CPPUNIT_TEST(testHeaderSharedMemory);
+            CPPUNIT_TEST(testReadHeaderTruncated);
+            CPPUNIT_TEST(testVectorOutputBuffer);
+            CPPUNIT_TEST(testMemoryInputBufferSeek);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        public:
+            WireFormatTest() {}
+            
+            void setUp() {}
+            void tearDown() {}
+            
+        protected:
+            void testHello();
+            void testHelloFlags();
+            void testReadHelloWrongMagic();
+            void testRelease();
+            void testReadReleaseHello();
+            void testPreamble();
+            void testPreambleLittleEndian();
+            void testReadPreambleWrongMagic();
+            void testReadPreambleNewerVersion();
+            void testHeader();
+            void testHeaderSharedMemory();
+            void testReadHeaderTruncated();
+            void testVectorOutputBuffer();
+            void testMemoryInputBufferSeek();
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_WIREFORMATTEST_H
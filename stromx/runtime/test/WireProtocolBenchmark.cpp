@@ -0,0 +1,186 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <sstream>
+#include "stromx/runtime/Factory.h"
+#include "stromx/runtime/ReadAccess.h"
+#include "stromx/runtime/impl/Client.h"
+#include "stromx/runtime/impl/SerializationHeader.h"
+#include "stromx/runtime/impl/Server.h"
+#include "stromx/runtime/impl/WireFormat.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            const unsigned int NUM_HEADERS = 10000;
+            const unsigned int NUM_FRAMES = 20;
+            const unsigned int ROWS = 1080;
+            const unsigned int COLS = 3 * 1920;
+            
+            impl::SerializationHeader imageHeader()
+            {
+                impl::SerializationHeader header;
+                header.serverVersion = impl::Server::VERSION;
+                header.package = "runtime";
+                header.type = "Image";
+                header.version = Version(0, 1, 0);
+                return header;
+            }
+            
+            // encodes and decodes the header as the server and client did 
+            // before the binary format
+            double measureTextHeader(unsigned int & checksum)
+            {
+                using namespace boost::chrono;
+                
+                const impl::SerializationHeader header = imageHeader();
+                const steady_clock::time_point start = steady_clock::now();
+                
+                for(unsigned int i = 0; i < NUM_HEADERS; ++i)
+                {
+                    std::ostringstream out;
+                    boost::archive::text_oarchive outArchive(out);
+                    outArchive << header;
+                    
+                    impl::SerializationHeader result;
+                    std::istringstream in(out.str());
+                    boost::archive::text_iarchive inArchive(in);
+                    inArchive >> result;
+                    
+                    if(result == header)
+                        checksum++;
+                }
+                
+                const double elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+                return elapsed / NUM_HEADERS;
+            }
+            
+            double measureBinaryHeader(unsigned int & checksum)
+            {
+                using namespace boost::chrono;
+                
+                const impl::SerializationHeader header = imageHeader();
+                std::vector<char> data;
+                const steady_clock::time_point start = steady_clock::now();
+                
+                for(unsigned int i = 0; i < NUM_HEADERS; ++i)
+                {
+                    impl::WireFormat::writeHeader(header, data);
+                    
+                    impl::SerializationHeader result;
+                    impl::WireFormat::readHeader(data.data(), data.size(), result);
+                    
+                    if(result == header)
+                        checksum++;
+                }
+                
+                const double elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+                return elapsed / NUM_HEADERS;
+            }
+            
+            void sendFrames(impl::Server* server)
+            {
+                for(unsigned int i = 0; i < NUM_FRAMES; ++i)
+                {
+                    MatrixImpl* matrix = new MatrixImpl(ROWS, COLS, Matrix::UINT_8);
+                    matrix->at<uint8_t>(ROWS - 1, COLS - 1) = uint8_t(i);
+                    server->send(DataContainer(matrix));
+                }
+            }
+        }
+        
+        class WireProtocolBenchmark : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (WireProtocolBenchmark);
+            CPPUNIT_TEST(testHeader);
+            CPPUNIT_TEST(testThroughput);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        protected:
+            void testHeader()
+            {
+                unsigned int textChecksum = 0;
+                unsigned int binaryChecksum = 0;
+                const double textTime = measureTextHeader(textChecksum);
+                const double binaryTime = measureBinaryHeader(binaryChecksum);
+                
+                // the timings are written to a file in the working directory
+                std::ofstream results("WireProtocolBenchmark_header.txt");
+                results << "text archive " << textTime << " ns, binary " 
+                        << binaryTime << " ns per frame" << std::endl;
+                
+                CPPUNIT_ASSERT_EQUAL(NUM_HEADERS, textChecksum);
+                CPPUNIT_ASSERT_EQUAL(NUM_HEADERS, binaryChecksum);
+            }
+            
+            // sends large images from a server to a client as the send and
+            // receive operators do
+            void testThroughput()
+            {
+                using namespace boost::chrono;
+                
+                Factory factory;
+                factory.registerData(new MatrixImpl);
+                
+                // listen at a free port
+                impl::Server server(0, 0, impl::Server::BOUNDED_FIFO, NUM_FRAMES);
+                impl::Client client("localhost", boost::lexical_cast<std::string>(server.port()));
+                
+                const steady_clock::time_point start = steady_clock::now();
+                boost::thread sender(boost::bind(sendFrames, &server));
+                
+                DataContainer data;
+                for(unsigned int i = 0; i < NUM_FRAMES; ++i)
+                    data = client.receive(factory);
+                
+                const double elapsed = duration_cast<microseconds>(steady_clock::now() - start).count();
+                sender.join();
+                
+                const impl::ConnectionStatistics statistics = server.totalStatistics();
+                server.stop();
+                server.join();
+                
+                const double numBytes = double(NUM_FRAMES) * ROWS * COLS;
+                std::ofstream results("WireProtocolBenchmark_throughput.txt");
+                results << numBytes / elapsed << " MB/s" << std::endl;
+                
+                ReadAccess access(data);
+                const Matrix & matrix = access.get<Matrix>();
+                CPPUNIT_ASSERT_EQUAL(ROWS, matrix.rows());
+                CPPUNIT_ASSERT_EQUAL(COLS, matrix.cols());
+                CPPUNIT_ASSERT_EQUAL(uint8_t(NUM_FRAMES - 1), matrix.at<uint8_t>(ROWS - 1, COLS - 1));
+                CPPUNIT_ASSERT_EQUAL(uint64_t(NUM_FRAMES), statistics.sentFrames);
+                CPPUNIT_ASSERT_EQUAL(uint64_t(0), statistics.droppedFrames);
+            }
+        };
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::WireProtocolBenchmark);
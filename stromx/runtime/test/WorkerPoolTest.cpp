@@ -0,0 +1,294 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/thread/thread.hpp>
+#include <cppunit/TestAssert.h>
+#include "stromx/runtime/Exception.h"
+#include "stromx/runtime/None.h"
+#include "stromx/runtime/Operator.h"
+#include "stromx/runtime/OperatorException.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/impl/InputNode.h"
+#include "stromx/runtime/impl/WorkerPool.h"
+#include "stromx/runtime/test/TestOperator.h"
+#include "stromx/runtime/test/WorkerPoolTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::WorkerPoolTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        void WorkerPoolTest::TestObserver::observe(const OperatorError& ex) const
+        {
+            m_message = std::string(ex.what());
+        }
+        
+        using namespace impl;
+        
+        void WorkerPoolTest::setUp()
+        {
+            for(unsigned int i = 0; i < 3; ++i)
+            {
+                TestOperator* kernel = new TestOperator();
+                m_kernels.push_back(kernel);
+                
+                Operator* op = new Operator(kernel);
+                op->initialize();
+                op->activate();
+                
+                m_operators.push_back(op);
+            }
+            
+            for(unsigned int i = 0; i < 2; ++i)
+            {
+                m_operators[i + 1]->getInputNode(TestOperator::INPUT_1)
+                    ->connect(m_operators[i]->getOutputNode(TestOperator::OUTPUT_1));
+                    
+                m_operators[i + 1]->getInputNode(TestOperator::INPUT_2)
+                    ->connect(m_operators[i]->getOutputNode(TestOperator::OUTPUT_2));
+            }
+            
+            for(unsigned int i = 1; i < 3; ++i)
+            {
+                for(std::vector<const Input*>::const_iterator input = m_operators[i]->info().inputs().begin();
+                    input != m_operators[i]->info().inputs().end();
+                    ++input)
+                {
+                    m_nodes.push_back(m_operators[i]->getInputNode((*input)->id()));
+                }
+            }
+            
+            m_container = DataContainer(new runtime::None);
+        }
+        
+        void WorkerPoolTest::setupPool(const unsigned int size, const ThreadImplObserver* const observer)
+        {
+            m_pool = new WorkerPool(size);
+            m_pool->addThread(0, m_nodes, observer);
+        }
+        
+        void WorkerPoolTest::processData()
+        {
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            
+            DataContainer data = m_operators[2]->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+            
+            data = m_operators[2]->getOutputData(TestOperator::OUTPUT_2);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+            
+            m_operators[2]->clearOutputData(TestOperator::OUTPUT_1);
+            m_operators[2]->clearOutputData(TestOperator::OUTPUT_2);
+        }
+        
+        void WorkerPoolTest::testStart()
+        {
+            setupPool(2);
+            
+            CPPUNIT_ASSERT_NO_THROW(m_pool->start());
+            CPPUNIT_ASSERT_THROW(m_pool->start(), WrongState);
+            
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            
+            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            
+            DataContainer data = m_operators[2]->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+            
+            data = m_operators[2]->getOutputData(TestOperator::OUTPUT_2);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+            
+            for(std::vector<TestOperator*>::const_iterator iter = m_kernels.begin();
+                iter != m_kernels.end();
+                ++iter)
+            {
+                CPPUNIT_ASSERT_EQUAL((unsigned int)(1), (*iter)->numExecutes());
+            }     
+        }
+        
+        void WorkerPoolTest::testStartSingleWorker()
+        {
+            setupPool(1);
+            m_pool->start();
+            
+            // the single worker blocks inside the operators and must be
+            // replaced by spare workers to process the data
+            for(unsigned int i = 0; i < 5; ++i)
+                processData();
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(5), m_kernels[2]->numExecutes());
+        }
+        
+        void WorkerPoolTest::testStop()
+        {
+            setupPool(2);
+            
+            CPPUNIT_ASSERT_NO_THROW(m_pool->stop());
+            
+            m_pool->start();
+            CPPUNIT_ASSERT_NO_THROW(m_pool->stop());
+            CPPUNIT_ASSERT_NO_THROW(m_pool->stop());
+            CPPUNIT_ASSERT_EQUAL(WorkerPool::DEACTIVATING, m_pool->status());
+        }
+        
+        void WorkerPoolTest::testStopEmpty()
+        {
+            m_pool = new WorkerPool(2);
+            
+            m_pool->start();
+            CPPUNIT_ASSERT_NO_THROW(m_pool->stop());
+            CPPUNIT_ASSERT_NO_THROW(m_pool->join());
+        }
+        
+        void WorkerPoolTest::testJoin()
+        {
+            setupPool(2);
+            
+            CPPUNIT_ASSERT_NO_THROW(m_pool->join());
+            
+            m_pool->start();
+            CPPUNIT_ASSERT_THROW(m_pool->join(), WrongState);
+            
+            m_pool->stop();
+            
+            CPPUNIT_ASSERT_NO_THROW(m_pool->join());
+            CPPUNIT_ASSERT_EQUAL(WorkerPool::INACTIVE, m_pool->status());
+        }
+        
+        void WorkerPoolTest::testPause()
+        {
+            setupPool(2);
+            
+            CPPUNIT_ASSERT_THROW(m_pool->pause(), WrongState);
+            
+            m_pool->start();
+            CPPUNIT_ASSERT_NO_THROW(m_pool->pause());
+            
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            
+            CPPUNIT_ASSERT_EQUAL(WorkerPool::PAUSED, m_pool->status());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(0), m_kernels[2]->numExecutes());
+        }
+        
+        void WorkerPoolTest::testResume()
+        {
+            setupPool(2);
+            
+            CPPUNIT_ASSERT_THROW(m_pool->resume(), WrongState);
+            
+            m_pool->start();
+            
+            CPPUNIT_ASSERT_THROW(m_pool->resume(), WrongState);
+            
+            m_pool->pause();
+            m_operators[0]->setInputData(TestOperator::INPUT_1, m_container);
+            m_operators[0]->setInputData(TestOperator::INPUT_2, m_container);
+            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            
+            CPPUNIT_ASSERT_NO_THROW(m_pool->resume());
+            CPPUNIT_ASSERT_EQUAL(WorkerPool::ACTIVE, m_pool->status());
+            
+            DataContainer data = m_operators[2]->getOutputData(TestOperator::OUTPUT_1);
+            CPPUNIT_ASSERT_EQUAL(m_container, data);
+        }
+        
+        void WorkerPoolTest::testRestart()
+        {
+            setupPool(2);
+            
+            m_pool->start();
+            processData();
+            m_pool->stop();
+            m_pool->join();
+            
+            m_pool->start();
+            processData();
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), m_kernels[2]->numExecutes());
+        }
+        
+        void WorkerPoolTest::testObserver()
+        {
+            TestObserver* observer = new TestObserver;
+            setupPool(2, observer);
+            
+            m_operators[0]->setParameter(TestOperator::THROW_EXCEPTION, Bool(true));
+            
+            // start the pool and run it for 1 second
+            m_pool->start();
+            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+            m_pool->stop();
+            m_pool->join();
+            
+            CPPUNIT_ASSERT_EQUAL(std::string("Funny exception."), observer->message());
+        }
+        
+        void WorkerPoolTest::testDelay()
+        {
+            setupPool(2);
+            m_pool->setDelay(0, 100);
+            m_pool->start();
+            
+            // each of the tasks is followed by a delay of its thread
+            const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+            processData();
+            const boost::chrono::steady_clock::duration elapsed = boost::chrono::steady_clock::now() - start;
+            
+            CPPUNIT_ASSERT(elapsed >= boost::chrono::milliseconds(100));
+        }
+        
+        void WorkerPoolTest::testWakeUpIdle()
+        {
+            setupPool(2);
+            m_pool->start();
+            
+            // the workers go to sleep because there is no data and must
+            // be woken up when the data arrives
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            
+            for(unsigned int i = 0; i < 3; ++i)
+            {
+                processData();
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+            }
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(3), m_kernels[2]->numExecutes());
+        }
+        
+        void WorkerPoolTest::tearDown()
+        {
+            if(m_pool)
+            {
+                m_pool->stop();
+                m_pool->join();
+            }
+            
+            delete m_pool;
+            
+            for(std::vector<Operator*>::iterator iter = m_operators.begin();
+                iter != m_operators.end();
+                ++iter)
+            {
+                delete *iter;
+            }
+        }
+    }
+}
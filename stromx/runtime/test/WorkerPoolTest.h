@@ -0,0 +1,98 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STROMX_RUNTIME_WORKERPOOLTEST_H
+#define STROMX_RUNTIME_WORKERPOOLTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include "stromx/runtime/DataContainer.h"
+#include "stromx/runtime/impl/ThreadImplObserver.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class TestOperator;
+        class Operator;
+        class DataContainer;
+        
+        namespace impl
+        {
+            class WorkerPool;
+            class InputNode;
+        }
+        
+        class WorkerPoolTest : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (WorkerPoolTest);
+            CPPUNIT_TEST(testStart);
+            CPPUNIT_TEST(testStartSingleWorker);
+            CPPUNIT_TEST(testStop);
+            CPPUNIT_TEST(testStopEmpty);
+            CPPUNIT_TEST(testJoin);
+            CPPUNIT_TEST(testPause);
+            CPPUNIT_TEST(testResume);
+            CPPUNIT_TEST(testRestart);
+            CPPUNIT_TEST(testObserver);
+            CPPUNIT_TEST(testDelay);
+            CPPUNIT_TEST(testWakeUpIdle);
+            CPPUNIT_TEST_SUITE_END ();
+        
+        public:
+            WorkerPoolTest() : m_pool(0) {}
+            
+            void setUp();
+            void tearDown();
+        
+        protected:
+            void testStart();
+            void testStartSingleWorker();
+            void testStop();
+            void testStopEmpty();
+            void testJoin();
+            void testPause();
+            void testResume();
+            void testRestart();
+            void testObserver();
+            void testDelay();
+            void testWakeUpIdle();
+                
+        private: 
+            class TestObserver : public impl::ThreadImplObserver
+            {
+        public:
+                void observe(const OperatorError & ex) const;
+                
+                const std::string message() const { return m_message; }
+                
+            private:
+                mutable std::string m_message;
+            };
+            
+            void setupPool(const unsigned int size, const impl::ThreadImplObserver* const observer = 0);
+            void processData();
+            
+            std::vector<TestOperator*> m_kernels;
+            std::vector<Operator*> m_operators;
+            std::vector<impl::InputNode*> m_nodes;
+            DataContainer m_container;
+            impl::WorkerPool* m_pool;
+        };
+    }
+}
+
+#endif // STROMX_RUNTIME_WORKERPOOLTEST_H
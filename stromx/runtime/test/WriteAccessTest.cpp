@@ -19,12 +19,21 @@
 #include <cppunit/TestAssert.h>
 #include "stromx/runtime/DataContainer.h"
 #include "stromx/runtime/Exception.h"
+#include "stromx/runtime/Id2DataPair.h"
 #include "stromx/runtime/None.h"
+#include "stromx/runtime/Primitive.h"
+#include "stromx/runtime/ReadAccess.h"
 #include "stromx/runtime/test/TestData.h"
 #include "stromx/runtime/test/WriteAccessTest.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::WriteAccessTest);
 
+namespace
+{
+    const unsigned int NUM_ITERATIONS = 10000;
+    const unsigned int NUM_THREADS = 4;
+}
+
 namespace stromx
 {
     namespace runtime
@@ -154,6 +163,126 @@ namespace stromx
             
             CPPUNIT_ASSERT_THROW(WriteAccess(container, 100), Timeout);
         }
+        
+        void WriteAccessTest::incrementConcurrently(DataContainer& container)
+        {
+            for(unsigned int i = 0; i < NUM_ITERATIONS; ++i)
+            {
+                WriteAccess access(container);
+                UInt32 & value = access.get<UInt32>();
+                value = value + 1;
+            }
+        }
+        
+        void WriteAccessTest::readConcurrently(DataContainer& container)
+        {
+            for(unsigned int i = 0; i < NUM_ITERATIONS; ++i)
+                ReadAccess access(container);
+        }
+        
+        void WriteAccessTest::testWriteAccessConcurrent()
+        {
+            DataContainer container(new UInt32(0));
+            
+            {
+                boost::thread_group threads;
+                for(unsigned int i = 0; i < NUM_THREADS; ++i)
+                {
+                    threads.create_thread(boost::bind(&WriteAccessTest::incrementConcurrently, this, container));
+                    threads.create_thread(boost::bind(&WriteAccessTest::readConcurrently, this, container));
+                }
+                threads.join_all();
+            }
+            
+            ReadAccess access(container);
+            CPPUNIT_ASSERT_EQUAL(NUM_THREADS * NUM_ITERATIONS, (unsigned int)(access.get<UInt32>()));
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWrite()
+        {
+            DataContainer original(new UInt32(1));
+            original.setCopyOnWrite(true);
+            original.setMetadata(Metadata(10, 20));
+            ReadAccess read(original);
+            
+            DataContainer container = original;
+            {
+                WriteAccess access(container, 100);
+                access.get<UInt32>() = 2;
+            }
+            
+            CPPUNIT_ASSERT(container != original);
+            CPPUNIT_ASSERT(container.isCopyOnWrite());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(10), container.metadata().timestamp());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), (unsigned int)(read.get<UInt32>()));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), (unsigned int)(ReadAccess(container).get<UInt32>()));
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWriteNotShared()
+        {
+            DataContainer original(new UInt32(1));
+            original.setCopyOnWrite(true);
+            
+            DataContainer container = original;
+            {
+                WriteAccess access(container);
+                access.get<UInt32>() = 2;
+            }
+            
+            CPPUNIT_ASSERT(container != original);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), (unsigned int)(ReadAccess(original).get<UInt32>()));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), (unsigned int)(ReadAccess(container).get<UInt32>()));
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWriteSingleOwner()
+        {
+            DataContainer container(new UInt32(1));
+            container.setCopyOnWrite(true);
+            const Data* data = &ReadAccess(container).get();
+            
+            {
+                WriteAccess access(container);
+                access.get<UInt32>() = 2;
+                CPPUNIT_ASSERT_EQUAL(data, (const Data*)(&access.get()));
+            }
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(2), (unsigned int)(ReadAccess(container).get<UInt32>()));
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWriteReleasedPair()
+        {
+            Id2DataPair pair(0, DataContainer(new UInt32(1)));
+            DataContainer container = pair.release();
+            container.setCopyOnWrite(true);
+            const Data* data = &ReadAccess(container).get();
+            
+            {
+                WriteAccess access(container);
+                access.get<UInt32>() = 2;
+                CPPUNIT_ASSERT_EQUAL(data, (const Data*)(&access.get()));
+            }
+            
+            CPPUNIT_ASSERT(pair.data().empty());
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWriteReadOnly()
+        {
+            DataContainer original(new UInt32(1), true);
+            original.setCopyOnWrite(true);
+            
+            DataContainer container = original;
+            CPPUNIT_ASSERT_THROW(WriteAccess access(container), WrongArgument);
+            CPPUNIT_ASSERT(container == original);
+        }
+        
+        void WriteAccessTest::testWriteAccessCopyOnWriteConst()
+        {
+            DataContainer container(new UInt32(1));
+            container.setCopyOnWrite(true);
+            const DataContainer & constContainer = container;
+            ReadAccess read(container);
+            
+            CPPUNIT_ASSERT_THROW(WriteAccess(constContainer, 100), Timeout);
+        }
     }
 }
-
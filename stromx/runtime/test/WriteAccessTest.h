@@ -42,6 +42,13 @@ namespace stromx
             CPPUNIT_TEST(testWriteAccessDelayed);
             CPPUNIT_TEST(testWriteAccessInterrupt);
             CPPUNIT_TEST(testWriteAccessTimeout);
+            CPPUNIT_TEST(testWriteAccessConcurrent);
+            CPPUNIT_TEST(testWriteAccessCopyOnWrite);
+            CPPUNIT_TEST(testWriteAccessCopyOnWriteNotShared);
+            CPPUNIT_TEST(testWriteAccessCopyOnWriteSingleOwner);
+            CPPUNIT_TEST(testWriteAccessCopyOnWriteReleasedPair);
+            CPPUNIT_TEST(testWriteAccessCopyOnWriteReadOnly);
+            CPPUNIT_TEST(testWriteAccessCopyOnWriteConst);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -62,10 +69,19 @@ namespace stromx
             void testWriteAccessDelayed();
             void testWriteAccessInterrupt();
             void testWriteAccessTimeout();
+            void testWriteAccessConcurrent();
+            void testWriteAccessCopyOnWrite();
+            void testWriteAccessCopyOnWriteNotShared();
+            void testWriteAccessCopyOnWriteSingleOwner();
+            void testWriteAccessCopyOnWriteReleasedPair();
+            void testWriteAccessCopyOnWriteReadOnly();
+            void testWriteAccessCopyOnWriteConst();
                 
         private:
             void releaseDelayed(WriteAccess& access);
             void writeAccessInterrupt(DataContainer & container);
+            void incrementConcurrently(DataContainer & container);
+            void readConcurrently(DataContainer & container);
             
             Data* m_data;
         };
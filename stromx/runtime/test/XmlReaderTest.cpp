@@ -18,6 +18,7 @@
 #include "stromx/runtime/Factory.h"
 #include "stromx/runtime/Operator.h"
 #include "stromx/runtime/Stream.h"
+#include "stromx/runtime/Thread.h"
 #include "stromx/runtime/XmlReader.h"
 #include "stromx/runtime/XmlWriter.h"
 #include "stromx/runtime/test/TestData.h"
@@ -54,6 +55,75 @@ namespace stromx
             delete stream;
         }
         
+        void XmlReaderTest::testReadStreamThreadSettings()
+        {
+            Stream* stream = XmlReader().readStream("thread_settings.xml", m_factory);
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), stream->threads()[0]->affinity());
+            CPPUNIT_ASSERT_EQUAL(Thread::OTHER, stream->threads()[0]->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(0, stream->threads()[0]->priority());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), stream->threads()[1]->affinity());
+            CPPUNIT_ASSERT_EQUAL(Thread::OTHER, stream->threads()[1]->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(5, stream->threads()[1]->priority());
+            
+            // write and read the settings again
+            stream->threads()[0]->setAffinity(0xf0);
+            stream->threads()[0]->setScheduling(Thread::FIFO, 20);
+            XmlWriter().writeStream("XmlReaderTest_testReadStreamThreadSettings.xml", *stream);
+            delete stream;
+            
+            stream = XmlReader().readStream("XmlReaderTest_testReadStreamThreadSettings.xml", m_factory);
+            
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0xf0), stream->threads()[0]->affinity());
+            CPPUNIT_ASSERT_EQUAL(Thread::FIFO, stream->threads()[0]->schedulingPolicy());
+            CPPUNIT_ASSERT_EQUAL(20, stream->threads()[0]->priority());
+            CPPUNIT_ASSERT_EQUAL(uint64_t(1), stream->threads()[1]->affinity());
+            CPPUNIT_ASSERT_EQUAL(5, stream->threads()[1]->priority());
+            
+            delete stream;
+        }
+        
+        void XmlReaderTest::testReadStreamReplication()
+        {
+            Stream* stream = XmlReader().readStream("stream.xml", m_factory);
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), stream->operators()[0]->numReplicas());
+            
+            // write and read the settings again
+            stream->operators()[0]->setReplication(4, Operator::LEAST_LOADED);
+            XmlWriter().writeStream("XmlReaderTest_testReadStreamReplication.xml", *stream);
+            delete stream;
+            
+            stream = XmlReader().readStream("XmlReaderTest_testReadStreamReplication.xml", m_factory);
+            
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(4), stream->operators()[0]->numReplicas());
+            CPPUNIT_ASSERT_EQUAL(Operator::LEAST_LOADED, stream->operators()[0]->dispatch());
+            CPPUNIT_ASSERT_EQUAL((unsigned int)(1), stream->operators()[1]->numReplicas());
+            
+            delete stream;
+        }
+        
+        void XmlReaderTest::testReadStreamOverflowPolicy()
+        {
+            Stream* stream = XmlReader().readStream("stream.xml", m_factory);
+            
+            Operator* op = stream->operators()[1];
+            CPPUNIT_ASSERT_EQUAL(Input::BLOCK, op->overflowPolicy(TestOperator::INPUT_1));
+            
+            // write and read the policy again
+            op->setOverflowPolicy(TestOperator::INPUT_1, Input::DROP_OLDEST);
+            XmlWriter().writeStream("XmlReaderTest_testReadStreamOverflowPolicy.xml", *stream);
+            delete stream;
+            
+            stream = XmlReader().readStream("XmlReaderTest_testReadStreamOverflowPolicy.xml", m_factory);
+            
+            op = stream->operators()[1];
+            CPPUNIT_ASSERT_EQUAL(Input::DROP_OLDEST, op->overflowPolicy(TestOperator::INPUT_1));
+            CPPUNIT_ASSERT_EQUAL(Input::BLOCK, op->overflowPolicy(TestOperator::INPUT_2));
+            
+            delete stream;
+        }
+        
         void XmlReaderTest::testReadStreamZip()
         {
             Stream* stream = 0;
@@ -31,6 +31,9 @@ namespace stromx
         {
             CPPUNIT_TEST_SUITE (XmlReaderTest);
             CPPUNIT_TEST(testReadStream);
+            CPPUNIT_TEST(testReadStreamThreadSettings);
+            CPPUNIT_TEST(testReadStreamReplication);
+            CPPUNIT_TEST(testReadStreamOverflowPolicy);
             CPPUNIT_TEST(testReadStreamEmpty);
             CPPUNIT_TEST(testReadStreamWrongFile);
             CPPUNIT_TEST(testReadStreamInvalidFile);
@@ -58,6 +61,9 @@ namespace stromx
 
         protected:
             void testReadStream();
+            void testReadStreamThreadSettings();
+            void testReadStreamReplication();
+            void testReadStreamOverflowPolicy();
             void testReadStreamEmpty();
             void testReadStreamWrongFile();
             void testReadStreamInvalidFile();
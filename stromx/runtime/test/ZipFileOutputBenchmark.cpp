@@ -0,0 +1,111 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <boost/chrono.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <cstdio>
+#include <fstream>
+#include "stromx/runtime/Version.h"
+#include "stromx/runtime/ZipFileInput.h"
+#include "stromx/runtime/ZipFileOutput.h"
+#include "stromx/runtime/test/MatrixImpl.h"
+
+#ifdef __linux__
+    #include <sys/resource.h>
+#endif
+
+namespace stromx
+{
+    namespace runtime
+    {
+        namespace
+        {
+            const unsigned int NUM_PARAMETERS = 32;
+            const unsigned int ROWS = 2048;
+            const unsigned int COLS = 4096;
+            
+            // returns the peak resident set size of the process in MB
+            double peakMemory()
+            {
+#ifdef __linux__
+                struct rusage usage;
+                getrusage(RUSAGE_SELF, &usage);
+                return usage.ru_maxrss / 1024.0;
+#else
+                return 0.0;
+#endif
+            }
+        }
+        
+        class ZipFileOutputBenchmark : public CPPUNIT_NS :: TestFixture
+        {
+            CPPUNIT_TEST_SUITE (ZipFileOutputBenchmark);
+            CPPUNIT_TEST(testPeakMemory);
+            CPPUNIT_TEST_SUITE_END ();
+            
+        protected:
+            // serializes large matrix parameters one after another as the 
+            // XML writer does when it saves a stream
+            void testPeakMemory()
+            {
+                using namespace boost::chrono;
+                
+                const double memoryBefore = peakMemory();
+                const steady_clock::time_point start = steady_clock::now();
+                
+                {
+                    ZipFileOutput output("ZipFileOutputBenchmark_testPeakMemory.zip");
+                    MatrixImpl matrix(ROWS, COLS, Matrix::UINT_8);
+                    for(unsigned int i = 0; i < NUM_PARAMETERS; ++i)
+                    {
+                        for(unsigned int j = 0; j < ROWS; ++j)
+                            matrix.at<uint8_t>(j, j) = uint8_t(i + j);
+                        
+                        output.initialize("parameter" + boost::lexical_cast<std::string>(i));
+                        matrix.serialize(output);
+                    }
+                    output.close();
+                }
+                
+                const double elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+                const double growth = peakMemory() - memoryBefore;
+                const double numBytes = double(NUM_PARAMETERS) * ROWS * COLS;
+                
+                // the timings are written to a file in the working directory
+                std::ofstream results("ZipFileOutputBenchmark.txt");
+                results << "saved " << numBytes / (1024 * 1024) << " MB in " << elapsed 
+                        << " ms, peak memory grew by " << growth << " MB" << std::endl;
+                
+                ZipFileInput input("ZipFileOutputBenchmark_testPeakMemory.zip");
+                input.initialize("", "parameter" + boost::lexical_cast<std::string>(NUM_PARAMETERS - 1) + ".npy");
+                MatrixImpl matrix;
+                matrix.deserialize(input, Version(0, 1, 0));
+                CPPUNIT_ASSERT_EQUAL(ROWS, matrix.rows());
+                CPPUNIT_ASSERT_EQUAL(uint8_t(NUM_PARAMETERS - 1), matrix.at<uint8_t>(0, 0));
+                std::remove("ZipFileOutputBenchmark_testPeakMemory.zip");
+                
+                // the archive must not be buffered in memory
+                CPPUNIT_ASSERT(growth < numBytes / (1024 * 1024) / 4);
+            }
+        };
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::ZipFileOutputBenchmark);
@@ -14,7 +14,9 @@
 *  limitations under the License.
 */
 
+#include <boost/filesystem.hpp>
 #include "stromx/runtime/Exception.h"
+#include "stromx/runtime/File.h"
 #include "stromx/runtime/ZipFileOutput.h"
 #include "stromx/runtime/ZipFileInput.h"
 #include "stromx/runtime/test/ZipFileOutputTest.h"
@@ -129,5 +131,55 @@ namespace stromx
             output.openFile(".bin", OutputProvider::BINARY);
             output.file() << 6;
         }
+        
+        void ZipFileOutputTest::testFileContent()
+        {
+            const std::string content(1000000, 'a');
+            
+            {
+                ZipFileOutput output("ZipFileOutputTest_testFileContent.zip");
+                output.initialize("testFile1");
+                output.openFile(".bin", OutputProvider::BINARY);
+                output.file() << content;
+                output.initialize("testFile2");
+                output.openFile(".txt", OutputProvider::TEXT);
+                output.file() << 6;
+                output.close();
+            }
+            
+            ZipFileInput input("ZipFileOutputTest_testFileContent.zip");
+            input.initialize("", "testFile1.bin");
+            std::string value;
+            input.openFile(InputProvider::BINARY) >> value;
+            CPPUNIT_ASSERT(content == value);
+            
+            input.initialize("", "testFile2.txt");
+            int number = 0;
+            input.openFile(InputProvider::TEXT) >> number;
+            CPPUNIT_ASSERT_EQUAL(6, number);
+        }
+        
+        void ZipFileOutputTest::testTempFilesRemoved()
+        {
+            const std::string tempDir = "ZipFileOutputTest_testTempFilesRemoved";
+            boost::filesystem::remove_all(tempDir);
+            boost::filesystem::create_directory(tempDir);
+            File::setTempDir(tempDir);
+            
+            {
+                ZipFileOutput output("ZipFileOutputTest_testTempFilesRemoved.zip");
+                output.initialize("testFile");
+                output.openFile(".bin", OutputProvider::BINARY);
+                output.file() << 5;
+                output.initialize("testFile");
+                output.openFile(".bin", OutputProvider::BINARY);
+                output.file() << 6;
+                CPPUNIT_ASSERT(! boost::filesystem::is_empty(tempDir));
+                output.close();
+            }
+            
+            File::setTempDir("");
+            CPPUNIT_ASSERT(boost::filesystem::is_empty(tempDir));
+        }
     }
 }
\ No newline at end of file
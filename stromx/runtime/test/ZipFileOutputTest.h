@@ -36,6 +36,8 @@ namespace stromx
             CPPUNIT_TEST(testNoAccess);
             CPPUNIT_TEST(testOverwrite);
             CPPUNIT_TEST(testPeriodInFileName);
+            CPPUNIT_TEST(testFileContent);
+            CPPUNIT_TEST(testTempFilesRemoved);
             CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -52,6 +54,8 @@ namespace stromx
             void testNoAccess();
             void testOverwrite();
             void testPeriodInFileName();
+            void testFileContent();
+            void testTempFilesRemoved();
         };
     }
 }
@@ -0,0 +1,96 @@
+/* 
+ *  Copyright 2011 Matthias Fuchs
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "stromx/runtime/test/ZipIndexTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "stromx/runtime/impl/ZipIndex.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (stromx::runtime::ZipIndexTest);
+
+namespace stromx
+{
+    namespace runtime
+    {
+        using impl::ZipIndex;
+        
+        namespace
+        {
+            // archive.zip contains the uncompressed files data1.txt and data2.txt
+            const std::vector<char> readArchive()
+            {
+                std::ifstream in("archive.zip", std::ios_base::in | std::ios_base::binary);
+                return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+            
+            const std::string content(const std::vector<char> & archive, const ZipIndex::Entry* entry)
+            {
+                return std::string(&archive[0] + entry->offset, entry->size);
+            }
+        }
+        
+        void ZipIndexTest::testStoredEntries()
+        {
+            const std::vector<char> archive = readArchive();
+            
+            ZipIndex index(&archive[0], archive.size());
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(2), index.numEntries());
+            CPPUNIT_ASSERT_EQUAL(std::string("191079"), content(archive, index.find("data1.txt")));
+            CPPUNIT_ASSERT_EQUAL(std::string("11092011"), content(archive, index.find("data2.txt")));
+            CPPUNIT_ASSERT(! index.find("data3.txt"));
+        }
+        
+        void ZipIndexTest::testCompressedEntry()
+        {
+            std::vector<char> archive = readArchive();
+            
+            // set the compression method of data1.txt in the central directory to deflate
+            const char signature[] = { 'P', 'K', 1, 2 };
+            std::vector<char>::iterator entry = std::search(archive.begin(), archive.end(), 
+                                                            signature, signature + 4);
+            CPPUNIT_ASSERT(entry != archive.end());
+            *(entry + 10) = 8;
+            
+            ZipIndex index(&archive[0], archive.size());
+            
+            CPPUNIT_ASSERT(! index.find("data1.txt"));
+            CPPUNIT_ASSERT(index.find("data2.txt"));
+        }
+        
+        void ZipIndexTest::testTruncatedArchive()
+        {
+            const std::vector<char> archive = readArchive();
+            
+            ZipIndex index(&archive[0], archive.size() - 10);
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(0), index.numEntries());
+        }
+        
+        void ZipIndexTest::testInvalidArchive()
+        {
+            const std::string data = "nonsense";
+            
+            CPPUNIT_ASSERT_EQUAL(std::size_t(0), ZipIndex(data.c_str(), data.size()).numEntries());
+            CPPUNIT_ASSERT_EQUAL(std::size_t(0), ZipIndex(0, 0).numEntries());
+        }
+    }
+}